@@ -0,0 +1,43 @@
+#.rst:
+# FindBenchmark
+# -------------
+# Finds the Google Benchmark library
+#
+# This will define the following variables::
+#
+# BENCHMARK_FOUND - system has Google Benchmark
+# BENCHMARK_INCLUDE_DIRS - the Google Benchmark include directory
+# BENCHMARK_LIBRARIES - the Google Benchmark libraries
+#
+# and the following imported targets::
+#
+#   Benchmark::Benchmark   - The Google Benchmark library
+
+if(PKG_CONFIG_FOUND)
+  pkg_check_modules(PC_BENCHMARK benchmark QUIET)
+endif()
+
+find_path(BENCHMARK_INCLUDE_DIR benchmark/benchmark.h
+                                PATHS ${PC_BENCHMARK_INCLUDEDIR})
+find_library(BENCHMARK_LIBRARY benchmark
+                               PATHS ${PC_BENCHMARK_LIBDIR})
+set(BENCHMARK_VERSION ${PC_BENCHMARK_VERSION})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Benchmark
+                                  REQUIRED_VARS BENCHMARK_LIBRARY BENCHMARK_INCLUDE_DIR
+                                  VERSION_VAR BENCHMARK_VERSION)
+
+if(BENCHMARK_FOUND)
+  set(BENCHMARK_LIBRARIES ${BENCHMARK_LIBRARY} ${CMAKE_THREAD_LIBS_INIT})
+  set(BENCHMARK_INCLUDE_DIRS ${BENCHMARK_INCLUDE_DIR})
+
+  if(NOT TARGET Benchmark::Benchmark)
+    add_library(Benchmark::Benchmark UNKNOWN IMPORTED)
+    set_target_properties(Benchmark::Benchmark PROPERTIES
+                                               IMPORTED_LOCATION "${BENCHMARK_LIBRARY}"
+                                               INTERFACE_INCLUDE_DIRECTORIES "${BENCHMARK_INCLUDE_DIR}")
+  endif()
+endif()
+
+mark_as_advanced(BENCHMARK_INCLUDE_DIR BENCHMARK_LIBRARY)
@@ -30,7 +30,9 @@
 #include <cerrno>
 #include <dirent.h>
 #include <map>
+#include <vector>
 
+#include "guilib/DXTCodec.h"
 #include "guilib/XBTF.h"
 #include "guilib/XBTFReader.h"
 
@@ -48,6 +50,7 @@
 #include <sys/stat.h>
 
 #define FLAGS_USE_LZO     1
+#define FLAGS_USE_DXT     2
 
 #define DIR_SEPARATOR "/"
 
@@ -193,6 +196,23 @@ bool HasAlpha(unsigned char *argb, unsigned int width, unsigned int height)
   return false;
 }
 
+void ComputeMSE(const unsigned char *argb, const unsigned char *decoded, unsigned int width, unsigned int height, double &colorMSE, double &alphaMSE)
+{
+  colorMSE = 0.0;
+  alphaMSE = 0.0;
+  for (unsigned int i = 0; i < 4*width*height; i += 4)
+  {
+    for (unsigned int c = 0; c < 3; c++)
+      colorMSE += (argb[i + c] - decoded[i + c]) * (argb[i + c] - decoded[i + c]);
+    alphaMSE += (argb[i + 3] - decoded[i + 3]) * (argb[i + 3] - decoded[i + 3]);
+  }
+  if (width * height > 0)
+  {
+    colorMSE /= 3.0 * width * height;
+    alphaMSE /= width * height;
+  }
+}
+
 CXBTFFrame createXBTFFrame(RGBAImage &image, CXBTFWriter& writer, double maxMSE, unsigned int flags)
 {
 
@@ -205,6 +225,22 @@ CXBTFFrame createXBTFFrame(RGBAImage &image, CXBTFWriter& writer, double maxMSE,
   bool hasAlpha = HasAlpha(argb, width, height);
 
   CXBTFFrame frame;
+  if ((flags & FLAGS_USE_DXT) == FLAGS_USE_DXT)
+  {
+    // compress and only keep the result if it's close enough to the original
+    format = hasAlpha ? XB_FMT_DXT5 : XB_FMT_DXT1;
+    std::vector<unsigned char> compressed(CDXTCodec::GetStorageSize(width, height, format));
+    std::vector<unsigned char> decoded(width * height * 4);
+    if (CDXTCodec::Compress(argb, width, height, width * 4, format, compressed.data()) &&
+        CDXTCodec::Decompress(compressed.data(), width, height, format, decoded.data(), width * 4))
+    {
+      double colorMSE, alphaMSE;
+      ComputeMSE(argb, decoded.data(), width, height, colorMSE, alphaMSE);
+      if (colorMSE <= maxMSE && alphaMSE <= maxMSE)
+        return appendContent(writer, width, height, compressed.data(), compressed.size(), format, hasAlpha, flags);
+    }
+  }
+
   format = XB_FMT_A8R8G8B8;
   frame = appendContent(writer, width, height, argb, (width * height * 4), format, hasAlpha, flags);
 
@@ -218,6 +254,7 @@ void Usage()
   puts("  -input <dir>     Input directory. Default: current dir");
   puts("  -output <dir>    Output directory/filename. Default: Textures.xbt");
   puts("  -dupecheck       Enable duplicate file detection. Reduces output file size. Default: off");
+  puts("  -dxt             Store textures as DXT1/DXT5 where the quality loss is small. Default: off");
 }
 
 static bool checkDupe(struct MD5Context* ctx,
@@ -380,6 +417,10 @@ int main(int argc, char* argv[])
     {
       dupecheck = true;
     }
+    else if (!strcmp(args[i], "-dxt"))
+    {
+      flags |= FLAGS_USE_DXT;
+    }
     else if (!platform_stricmp(args[i], "-output") || !platform_stricmp(args[i], "-o"))
     {
       OutputFilename = args[++i];
@@ -19,6 +19,7 @@
 #include "utils/JobManager.h"
 #include "utils/Variant.h"
 #include "LangInfo.h"
+#include "LibraryWatcher.h"
 #include "utils/Screenshot.h"
 #include "Util.h"
 #include "URL.h"
@@ -552,6 +553,17 @@ bool CApplication::Create(const CAppParamParser &params)
 
   update_emu_environ();//apply the GUI settings
 
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = m_pSettingsComponent->GetAdvancedSettings();
+  if (advancedSettings->m_jobManagerWorkStealing)
+  {
+    unsigned int workers = advancedSettings->m_jobManagerWorkers;
+    if (workers == 0)
+      workers = CServiceBroker::GetCPUInfo()->GetCPUCount();
+    CJobManager::GetInstance().EnableWorkStealing(workers);
+  }
+
+  g_directoryCache.SetMaxItems(advancedSettings->m_directoryCacheItems);
+
   //! @todo - move to CPlatformXXX
 #ifdef TARGET_WINDOWS
   CWIN32Util::SetThreadLocalLocale(true); // enable independent locale for each thread, see https://connect.microsoft.com/VisualStudio/feedback/details/794122
@@ -668,6 +680,8 @@ bool CApplication::CreateGUI()
 
   m_pGUI.reset(new CGUIComponent());
   m_pGUI->Init();
+  m_pGUI->GetTextureManager().SetMemoryBudget(
+      static_cast<uint64_t>(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTextureMemoryBudget) * 1024 * 1024);
 
   // Splash requires gui component!!
   CServiceBroker::GetRenderSystem()->ShowSplash("");
@@ -946,6 +960,8 @@ void CApplication::StopServices()
 {
   m_ServiceManager->GetNetwork().NetworkMessage(CNetwork::SERVICES_DOWN, 0);
 
+  StopLibraryWatcher();
+
 #if !defined(TARGET_WINDOWS) && defined(HAS_DVD_DRIVE)
   CLog::Log(LOGNOTICE, "stop dvd detect media");
   m_DetectDVDType.StopThread();
@@ -4650,6 +4666,16 @@ void CApplication::UpdateLibraries()
     CLog::LogF(LOGNOTICE, "Starting music library startup scan");
     StartMusicScan("", !settings->GetBool(CSettings::SETTING_MUSICLIBRARY_BACKGROUNDUPDATE));
   }
+
+  if (!m_libraryWatcher)
+    m_libraryWatcher.reset(new CLibraryWatcher);
+  m_libraryWatcher->Start();
+}
+
+void CApplication::StopLibraryWatcher()
+{
+  if (m_libraryWatcher)
+    m_libraryWatcher->Stop();
 }
 
 void CApplication::UpdateCurrentPlayArt()
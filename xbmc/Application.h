@@ -53,6 +53,7 @@ class CBookmark;
 class IActionListener;
 class CGUIComponent;
 class CAppInboundProtocol;
+class CLibraryWatcher;
 class CSettingsComponent;
 
 namespace ADDON
@@ -285,7 +286,11 @@ public:
   void StartMusicAlbumScan(const std::string& strDirectory, bool refresh = false);
   void StartMusicArtistScan(const std::string& strDirectory, bool refresh = false);
 
+  /*!
+   \brief Scans the libraries if they are set to update on startup, and (re)starts the library watcher.
+   */
   void UpdateLibraries();
+  void StopLibraryWatcher();
 
   void UpdateCurrentPlayArt();
 
@@ -448,6 +453,7 @@ protected:
   bool m_bSystemScreenSaverEnable = false;
 
   std::unique_ptr<MUSIC_INFO::CMusicInfoScanner> m_musicInfoScanner;
+  std::unique_ptr<CLibraryWatcher> m_libraryWatcher;
 
   bool m_muted = false;
   float m_volumeLevel = VOLUME_MAXIMUM;
@@ -1596,6 +1596,26 @@ bool CFileItem::IsAlbum() const
   return m_bIsAlbum;
 }
 
+size_t CFileItem::GetMemoryUsage() const
+{
+  size_t usage = CGUIListItem::GetMemoryUsage() - sizeof(CGUIListItem) + sizeof(CFileItem);
+  usage += GetStringMemoryUsage(m_strPath) + GetStringMemoryUsage(m_strDynPath) +
+           GetStringMemoryUsage(m_mimetype) + GetStringMemoryUsage(m_extrainfo) +
+           GetStringMemoryUsage(m_strDVDLabel) + GetStringMemoryUsage(m_strTitle) +
+           GetStringMemoryUsage(m_strLockCode);
+
+  // tags are counted by their size only, the PVR ones belong to the PVR manager
+  if (m_musicInfoTag)
+    usage += sizeof(MUSIC_INFO::CMusicInfoTag);
+  if (m_videoInfoTag)
+    usage += sizeof(CVideoInfoTag);
+  if (m_pictureInfoTag)
+    usage += sizeof(CPictureInfoTag);
+  if (m_gameInfoTag)
+    usage += sizeof(CGameInfoTag);
+  return usage;
+}
+
 void CFileItem::UpdateInfo(const CFileItem &item, bool replaceLabels /*=true*/)
 {
   if (item.HasVideoInfoTag())
@@ -3495,6 +3515,16 @@ void CFileItemList::SetReplaceListing(bool replace)
   m_replaceListing = replace;
 }
 
+size_t CFileItemList::GetMemoryUsage() const
+{
+  CSingleLock lock(m_lock);
+  size_t usage = CFileItem::GetMemoryUsage() - sizeof(CFileItem) + sizeof(CFileItemList);
+  usage += m_items.capacity() * sizeof(CFileItemPtr);
+  for (const auto& item : m_items)
+    usage += item->GetMemoryUsage();
+  return usage;
+}
+
 void CFileItemList::ClearSortState()
 {
   m_sortDescription.sortBy = SortByNone;
@@ -497,6 +497,8 @@ public:
 
   bool IsAlbum() const;
 
+  size_t GetMemoryUsage() const override;
+
   /*! \brief Sets details using the information from the CVideoInfoTag object
    Sets the videoinfotag and uses its information to set the label and path.
    \param video video details to use and set
@@ -756,6 +758,11 @@ public:
   void SetContent(const std::string &content) { m_content = content; };
   const std::string &GetContent() const { return m_content; };
 
+  /*! \brief Get the approximate memory used by the list and its items.
+   Items that are shared with other lists are counted as well.
+   */
+  size_t GetMemoryUsage() const override;
+
   void ClearSortState();
 
   VECFILEITEMS::iterator begin() { return m_items.begin(); }
@@ -10090,9 +10090,9 @@ INFO::InfoPtr CGUIInfoManager::Register(const std::string &expression, int conte
   std::pair<INFOBOOLTYPE::iterator, bool> res;
 
   if (condition.find_first_of("|+[]!") != condition.npos)
-    res = m_bools.insert(std::make_shared<InfoExpression>(condition, context, m_refreshCounter));
+    res = m_bools.insert(std::make_shared<InfoExpression>(condition, context, m_refreshCounters));
   else
-    res = m_bools.insert(std::make_shared<InfoSingle>(condition, context, m_refreshCounter));
+    res = m_bools.insert(std::make_shared<InfoSingle>(condition, context, m_refreshCounters));
 
   if (res.second)
     res.first->get()->Initialize();
@@ -10427,6 +10427,9 @@ void CGUIInfoManager::Clear()
   // log which ones are used - they should all be gone by now
   for (INFOBOOLTYPE::const_iterator i = m_bools.begin(); i != m_bools.end(); ++i)
     CLog::Log(LOGDEBUG, "Infobool '%s' still used by %u instances", (*i)->GetExpression().c_str(), (unsigned int) i->use_count());
+
+  // the remaining ones may be picked up by the next skin, make sure they are evaluated again
+  m_refreshCounters.Invalidate(INFO::INFO_SOURCE_ALL);
 }
 
 void CGUIInfoManager::UpdateAVInfo()
@@ -10673,7 +10676,31 @@ void CGUIInfoManager::ResetCache()
 {
   // mark our infobools as dirty
   CSingleLock lock(m_critInfo);
-  ++m_refreshCounter;
+  unsigned int sources = INFO::INFO_SOURCE_FRAME;
+
+  // library bools may change from any thread, pick them up here
+  const unsigned int libraryChangeCounter = m_infoProviders.GetLibraryInfoProvider().GetChangeCounter();
+  if (libraryChangeCounter != m_libraryChangeCounter)
+  {
+    m_libraryChangeCounter = libraryChangeCounter;
+    sources |= INFO::INFO_SOURCE_LIBRARY;
+  }
+
+  m_refreshCounters.Invalidate(sources);
+  m_lastFrameEvaluations = m_refreshCounters.m_evaluations.exchange(0, std::memory_order_relaxed);
+}
+
+void CGUIInfoManager::InvalidateSources(unsigned int sources)
+{
+  CSingleLock lock(m_critInfo);
+  m_refreshCounters.Invalidate(sources);
+}
+
+void CGUIInfoManager::GetBoolEvaluations(unsigned int &lastFrame, unsigned int &registered)
+{
+  CSingleLock lock(m_critInfo);
+  lastFrame = m_lastFrameEvaluations;
+  registered = m_bools.size();
 }
 
 void CGUIInfoManager::SetCurrentVideoTag(const CVideoInfoTag &tag)
@@ -61,6 +61,19 @@ public:
   void Clear();
   void ResetCache();
 
+  /*! \brief Mark info bools depending on the given sources as dirty
+   Sources other than INFO::INFO_SOURCE_FRAME must call this whenever their
+   information changes, as info bools depending on them are cached across frames.
+   \param sources combination of INFO::InfoSource flags
+   */
+  void InvalidateSources(unsigned int sources);
+
+  /*! \brief Get the number of info bool evaluations
+   \param lastFrame [out] evaluations between the last two cache resets (usually one frame)
+   \param registered [out] number of registered info bools
+   */
+  void GetBoolEvaluations(unsigned int &lastFrame, unsigned int &registered);
+
   // KODI::MESSAGING::IMessageTarget implementation
   int GetMessageMask() override;
   void OnApplicationMessage(KODI::MESSAGING::ThreadMessage* pMsg) override;
@@ -201,7 +214,9 @@ private:
 
   typedef std::set<INFO::InfoPtr, bool(*)(const INFO::InfoPtr&, const INFO::InfoPtr&)> INFOBOOLTYPE;
   INFOBOOLTYPE m_bools;
-  unsigned int m_refreshCounter = 0;
+  INFO::InfoRefreshCounters m_refreshCounters;
+  unsigned int m_lastFrameEvaluations = 0;
+  unsigned int m_libraryChangeCounter = 0;
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   CCriticalSection m_critInfo;
@@ -0,0 +1,556 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "LibraryWatcher.h"
+
+#include "Application.h"
+#include "FileItem.h"
+#include "MediaSource.h"
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "addons/Scraper.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/MediaSourceSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/SystemClock.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoInfoScanner.h"
+
+#include <set>
+
+#if defined(HAVE_INOTIFY)
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace XFILE;
+
+namespace
+{
+// the events that change what the scanners find in a directory. Files that are created are only
+// scanned once they have been written (IN_CLOSE_WRITE), created directories right away.
+#if defined(HAVE_INOTIFY)
+const uint32_t WATCH_EVENTS = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+#endif
+
+void GetSubdirectories(const std::string& directory, CFileItemList& items)
+{
+  CDirectory::GetDirectory(directory, items, "/", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO | DIR_FLAG_BYPASS_CACHE);
+}
+
+int64_t GetModificationTime(const struct __stat64& buffer)
+{
+  return buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
+}
+}
+
+CLibraryWatcher::CLibraryWatcher()
+  : CThread("LibraryWatcher")
+{
+}
+
+CLibraryWatcher::~CLibraryWatcher()
+{
+  Stop();
+}
+
+void CLibraryWatcher::Start()
+{
+  Stop();
+
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  if (!advancedSettings->m_bLibraryWatcherEnabled)
+    return;
+
+  m_delay = advancedSettings->m_iLibraryWatcherDelay * 1000;
+  m_pollInterval = advancedSettings->m_iLibraryWatcherPollInterval * 1000;
+
+  // the sources are read here as they belong to the main thread
+  m_sources.clear();
+  for (const char* type : {"video", "music"})
+  {
+    VECSOURCES* sources = CMediaSourceSettings::GetInstance().GetSources(type);
+    if (!sources)
+      continue;
+
+    for (const CMediaSource& source : *sources)
+    {
+      for (const std::string& path : source.vecPaths)
+      {
+        if (!URIUtils::IsHD(CSpecialProtocol::TranslatePath(path)) && !URIUtils::IsSmb(path) && !URIUtils::IsNfs(path))
+          continue;
+
+        SSource watched;
+        watched.path = path;
+        URIUtils::AddSlashAtEnd(watched.path);
+        watched.video = StringUtils::EqualsNoCase(type, "video");
+        m_sources.push_back(watched);
+      }
+    }
+  }
+
+  if (!m_sources.empty())
+    Create();
+}
+
+void CLibraryWatcher::Stop()
+{
+  StopThread();
+}
+
+void CLibraryWatcher::Process()
+{
+  CLog::Log(LOGNOTICE, "CLibraryWatcher: watching %u sources for changes", static_cast<unsigned int>(m_sources.size()));
+
+#if defined(HAVE_INOTIFY)
+  m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_inotify < 0)
+    CLog::Log(LOGWARNING, "CLibraryWatcher: inotify_init1 failed (%s)", strerror(errno));
+#endif
+
+  WatchSources();
+  m_lastPoll = XbmcThreads::SystemClockMillis();
+
+  while (!m_bStop)
+  {
+#if defined(HAVE_INOTIFY)
+    if (m_inotify >= 0)
+    {
+      struct pollfd pollDesc = { m_inotify, POLLIN, 0 };
+      if (poll(&pollDesc, 1, 1000) > 0)
+        ReadEvents();
+    }
+    else
+#endif
+      Sleep(1000);
+
+    if (m_bStop)
+      break;
+
+    if (m_pollInterval > 0 && XbmcThreads::SystemClockMillis() - m_lastPoll >= m_pollInterval)
+    {
+      PollSources();
+      m_lastPoll = XbmcThreads::SystemClockMillis();
+    }
+
+    ScanChanges();
+  }
+
+#if defined(HAVE_INOTIFY)
+  if (m_inotify >= 0)
+    close(m_inotify);
+  m_inotify = -1;
+#endif
+  m_watches.clear();
+  m_polledDirs.clear();
+  m_polledIds.clear();
+  m_changes.clear();
+}
+
+void CLibraryWatcher::WatchSources()
+{
+  for (SSource& source : m_sources)
+  {
+    if (m_bStop)
+      return;
+    Watch(source);
+  }
+}
+
+void CLibraryWatcher::Watch(SSource& source)
+{
+  if (m_inotify >= 0 && URIUtils::IsHD(CSpecialProtocol::TranslatePath(source.path)))
+  {
+    if (AddWatches(source.path))
+      return;
+    CLog::Log(LOGWARNING, "CLibraryWatcher: unable to watch '%s', the inotify watch limit "
+              "(fs.inotify.max_user_watches) may be too low", CURL::GetRedacted(source.path).c_str());
+  }
+
+  Poll(source);
+}
+
+void CLibraryWatcher::Poll(SSource& source)
+{
+  source.polled = true;
+  if (m_pollInterval > 0)
+  {
+    CLog::Log(LOGDEBUG, "CLibraryWatcher: checking '%s' for changes every %u seconds",
+              CURL::GetRedacted(source.path).c_str(), m_pollInterval / 1000);
+    AddPolledDirectory(source.path);
+  }
+}
+
+bool CLibraryWatcher::AddWatches(const std::string& directory)
+{
+#if defined(HAVE_INOTIFY)
+  const int watch = inotify_add_watch(m_inotify, CSpecialProtocol::TranslatePath(directory).c_str(), WATCH_EVENTS);
+  if (watch < 0)
+  {
+    // the directory may be gone already, that's a change the parent will report
+    return errno != ENOSPC && errno != ENOMEM;
+  }
+
+  // the same watch is returned for a directory that is reached twice through symlinks
+  if (m_watches.find(watch) != m_watches.end())
+    return true;
+  m_watches[watch] = directory;
+
+  CFileItemList items;
+  GetSubdirectories(directory, items);
+  for (const auto& item : items)
+  {
+    if (m_bStop)
+      break;
+    if (!item->m_bIsFolder || item->IsParentFolder())
+      continue;
+
+    std::string path = item->GetPath();
+    URIUtils::AddSlashAtEnd(path);
+    if (!AddWatches(path))
+      return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CLibraryWatcher::RemoveWatches(const std::string& directory)
+{
+#if defined(HAVE_INOTIFY)
+  for (auto it = m_watches.begin(); it != m_watches.end();)
+  {
+    if (StringUtils::StartsWith(it->second, directory))
+    {
+      inotify_rm_watch(m_inotify, it->first);
+      it = m_watches.erase(it);
+    }
+    else
+      ++it;
+  }
+#endif
+}
+
+void CLibraryWatcher::ReadEvents()
+{
+#if defined(HAVE_INOTIFY)
+  alignas(struct inotify_event) char buffer[4096];
+  while (!m_bStop)
+  {
+    const ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+    if (length <= 0)
+      break;
+
+    const struct inotify_event* event;
+    for (const char* ptr = buffer; ptr < buffer + length; ptr += sizeof(struct inotify_event) + event->len)
+    {
+      event = reinterpret_cast<const struct inotify_event*>(ptr);
+
+      if (event->mask & IN_Q_OVERFLOW)
+      {
+        // events were lost, so anything could have changed
+        CLog::Log(LOGWARNING, "CLibraryWatcher: inotify event queue overflowed, scanning all watched sources");
+        for (const SSource& source : m_sources)
+        {
+          if (!source.polled)
+            OnChanged(source.path);
+        }
+        continue;
+      }
+
+      auto watch = m_watches.find(event->wd);
+      if (watch == m_watches.end())
+        continue;
+
+      if (event->mask & IN_IGNORED)
+      {
+        // the directory was removed
+        m_watches.erase(watch);
+        continue;
+      }
+
+      const std::string directory = watch->second;
+      if ((event->mask & IN_ISDIR) && event->len > 0)
+      {
+        std::string path = URIUtils::AddFileToFolder(directory, event->name);
+        URIUtils::AddSlashAtEnd(path);
+
+        // a directory that was moved away keeps its watches, which would report the old path
+        if (event->mask & IN_MOVED_FROM)
+          RemoveWatches(path);
+
+        if ((event->mask & (IN_CREATE | IN_MOVED_TO)) && !AddWatches(path))
+        {
+          for (SSource& source : m_sources)
+          {
+            if (!source.polled && URIUtils::PathHasParent(path, source.path))
+            {
+              CLog::Log(LOGWARNING, "CLibraryWatcher: unable to watch '%s', checking its source for changes instead",
+                        CURL::GetRedacted(path).c_str());
+              Poll(source);
+            }
+          }
+        }
+      }
+      else if (!(event->mask & IN_ISDIR) && (event->mask & IN_CREATE))
+        continue; // wait until the file has been written
+
+      OnChanged(directory);
+    }
+  }
+#endif
+}
+
+void CLibraryWatcher::PollSources()
+{
+  // PollDirectory() adds and removes directories
+  std::vector<std::string> directories;
+  directories.reserve(m_polledDirs.size());
+  for (const auto& directory : m_polledDirs)
+    directories.push_back(directory.first);
+
+  for (const std::string& directory : directories)
+  {
+    if (m_bStop)
+      return;
+    PollDirectory(directory);
+  }
+}
+
+void CLibraryWatcher::PollDirectory(const std::string& directory)
+{
+  auto it = m_polledDirs.find(directory);
+  if (it == m_polledDirs.end())
+    return;
+
+  // an unreachable directory (e.g. the server is down) is left as it is until it's back
+  struct __stat64 buffer;
+  if (CFile::Stat(directory, &buffer) != 0)
+    return;
+  const int64_t time = GetModificationTime(buffer);
+  if (time == it->second.time)
+    return;
+
+  // reached for the first time, see AddPolledDirectory()
+  if (it->second.inode == 0 && buffer.st_ino != 0)
+  {
+    if (!m_polledIds.insert(std::make_pair(buffer.st_dev, buffer.st_ino)).second)
+    {
+      m_polledDirs.erase(it);
+      return;
+    }
+    it->second.device = buffer.st_dev;
+    it->second.inode = buffer.st_ino;
+  }
+  it->second.time = time;
+  OnChanged(directory);
+
+  // the modification time of a directory changes when entries are added or removed,
+  // so this is when subdirectories come and go
+  CFileItemList items;
+  GetSubdirectories(directory, items);
+  std::set<std::string> subdirs;
+  for (const auto& item : items)
+  {
+    if (!item->m_bIsFolder || item->IsParentFolder())
+      continue;
+
+    std::string path = item->GetPath();
+    URIUtils::AddSlashAtEnd(path);
+    subdirs.insert(path);
+  }
+
+  it = m_polledDirs.upper_bound(directory);
+  while (it != m_polledDirs.end() && StringUtils::StartsWith(it->first, directory))
+  {
+    const std::string path = it->first;
+    if (URIUtils::GetParentPath(path) == directory && subdirs.find(path) == subdirs.end())
+    {
+      // removed, along with everything below it
+      while (it != m_polledDirs.end() && StringUtils::StartsWith(it->first, path))
+        it = RemovePolledDirectory(it);
+    }
+    else
+      ++it;
+  }
+
+  for (const std::string& subdir : subdirs)
+    AddPolledDirectory(subdir);
+}
+
+void CLibraryWatcher::AddPolledDirectory(const std::string& directory)
+{
+  if (m_polledDirs.find(directory) != m_polledDirs.end())
+    return;
+
+  struct __stat64 buffer;
+  if (CFile::Stat(directory, &buffer) != 0)
+  {
+    m_polledDirs[directory] = SPolledDir();
+    return;
+  }
+
+  // a directory that is reached again through a symlink is polled at the path it was found at
+  // first, following it would never end for links to a parent
+  if (buffer.st_ino != 0 && !m_polledIds.insert(std::make_pair(buffer.st_dev, buffer.st_ino)).second)
+    return;
+
+  SPolledDir& polled = m_polledDirs[directory];
+  polled.time = GetModificationTime(buffer);
+  polled.device = buffer.st_dev;
+  polled.inode = buffer.st_ino;
+
+  CFileItemList items;
+  GetSubdirectories(directory, items);
+  for (const auto& item : items)
+  {
+    if (m_bStop)
+      return;
+    if (!item->m_bIsFolder || item->IsParentFolder())
+      continue;
+
+    std::string path = item->GetPath();
+    URIUtils::AddSlashAtEnd(path);
+    AddPolledDirectory(path);
+  }
+}
+
+std::map<std::string, CLibraryWatcher::SPolledDir>::iterator CLibraryWatcher::RemovePolledDirectory(std::map<std::string, SPolledDir>::iterator it)
+{
+  if (it->second.inode != 0)
+    m_polledIds.erase(std::make_pair(it->second.device, it->second.inode));
+  return m_polledDirs.erase(it);
+}
+
+void CLibraryWatcher::OnChanged(const std::string& directory)
+{
+  bool video = false;
+  bool music = false;
+  for (const SSource& source : m_sources)
+  {
+    if (URIUtils::PathHasParent(directory, source.path))
+    {
+      if (source.video)
+        video = true;
+      else
+        music = true;
+    }
+  }
+  if (!video && !music)
+    return;
+
+  SChange& change = m_changes[directory];
+  change.time = XbmcThreads::SystemClockMillis();
+  change.video = change.video || video;
+  change.music = change.music || music;
+}
+
+void CLibraryWatcher::ScanChanges()
+{
+  if (m_changes.empty())
+    return;
+
+  bool videoIdle = !IsScanning(true);
+  bool musicIdle = !IsScanning(false);
+  const unsigned int now = XbmcThreads::SystemClockMillis();
+
+  // parents come before their subdirectories, and scanning them covers those as well
+  for (auto it = m_changes.begin(); it != m_changes.end() && (videoIdle || musicIdle); ++it)
+  {
+    if (now - it->second.time < m_delay)
+      continue;
+
+    if (it->second.video && videoIdle)
+    {
+      const std::string path = GetVideoScanPath(it->first);
+      if (!path.empty())
+      {
+        CLog::Log(LOGDEBUG, "CLibraryWatcher: '%s' changed, scanning '%s' for videos",
+                  CURL::GetRedacted(it->first).c_str(), CURL::GetRedacted(path).c_str());
+        StartScan(path, true);
+        videoIdle = false;
+
+        for (auto change = m_changes.lower_bound(path); change != m_changes.end() && StringUtils::StartsWith(change->first, path); ++change)
+          change->second.video = false;
+      }
+      it->second.video = false;
+    }
+
+    if (it->second.music && musicIdle)
+    {
+      CLog::Log(LOGDEBUG, "CLibraryWatcher: '%s' changed, scanning it for music", CURL::GetRedacted(it->first).c_str());
+      StartScan(it->first, false);
+      musicIdle = false;
+
+      for (auto change = it; change != m_changes.end() && StringUtils::StartsWith(change->first, it->first); ++change)
+        change->second.music = false;
+    }
+  }
+
+  for (auto it = m_changes.begin(); it != m_changes.end();)
+  {
+    if (!it->second.video && !it->second.music)
+      it = m_changes.erase(it);
+    else
+      ++it;
+  }
+}
+
+bool CLibraryWatcher::IsScanning(bool video) const
+{
+  return video ? g_application.IsVideoScanning() : g_application.IsMusicScanning();
+}
+
+void CLibraryWatcher::StartScan(const std::string& path, bool video)
+{
+  if (video)
+    g_application.StartVideoScan(path, false);
+  else
+    g_application.StartMusicScan(path, false);
+}
+
+std::string CLibraryWatcher::GetVideoScanPath(const std::string& directory) const
+{
+  CVideoDatabase database;
+  if (!database.Open())
+    return "";
+
+  VIDEO::SScanSettings settings;
+  bool foundDirectly = false;
+  ADDON::ScraperPtr scraper = database.GetScraperForPath(directory, settings, foundDirectly);
+  if (!scraper || scraper->Content() == CONTENT_NONE)
+    return "";
+
+  if (scraper->Content() != CONTENT_TVSHOWS || foundDirectly)
+    return directory;
+
+  // the scanner can only scan whole tv shows, which are the folders right below the
+  // one the content is set on
+  std::string path = directory;
+  while (true)
+  {
+    const std::string parent = URIUtils::GetParentPath(path);
+    if (parent.empty() || parent == path)
+      return "";
+
+    database.GetScraperForPath(parent, settings, foundDirectly);
+    if (foundDirectly)
+      return path;
+    path = parent;
+  }
+}
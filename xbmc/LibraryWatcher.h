@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/Thread.h"
+
+#include <map>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+ \brief Watches the music and video sources and scans only the directories that changed.
+
+ Local sources are watched with inotify where it's available. Network sources (smb and nfs), and
+ local ones that can't be watched, are checked for changed directory modification times every
+ pollinterval seconds instead. Changes are collected until nothing happened in a directory for a
+ while, and then handed to the library scanners one directory at a time, whenever they are idle.
+
+ Enabled with <librarywatcher><enabled> in advancedsettings.xml.
+ */
+class CLibraryWatcher : private CThread
+{
+public:
+  CLibraryWatcher();
+  ~CLibraryWatcher() override;
+
+  /*!
+   \brief Start watching the sources of the current profile.
+   Restarts the watcher if it's running already, so changed sources are picked up.
+   */
+  void Start();
+  void Stop();
+
+protected:
+  void Process() override;
+
+  struct SSource
+  {
+    std::string path;
+    bool video = false;
+    bool polled = false; //!< not watched with inotify, the directory modification times are compared
+  };
+
+  struct SChange
+  {
+    unsigned int time = 0; //!< of the last event
+    bool video = false;
+    bool music = false;
+  };
+
+  struct SPolledDir
+  {
+    int64_t time = -1; //!< modification time, -1 while the directory can't be reached
+    uint64_t device = 0;
+    uint64_t inode = 0; //!< 0 when the filesystem doesn't tell
+  };
+
+  void AddPolledDirectory(const std::string& directory);
+  void OnChanged(const std::string& directory);
+  void ScanChanges();
+
+  // the parts that depend on the rest of the application
+  virtual bool IsScanning(bool video) const;
+  virtual void StartScan(const std::string& path, bool video);
+  virtual std::string GetVideoScanPath(const std::string& directory) const;
+
+  std::vector<SSource> m_sources;
+  std::map<std::string, SChange> m_changes;        //!< changed directories by path
+  std::map<std::string, SPolledDir> m_polledDirs;  //!< the polled directories by path
+  unsigned int m_delay = 0;
+
+private:
+  void WatchSources();
+  void Watch(SSource& source);
+  void Poll(SSource& source);
+  bool AddWatches(const std::string& directory);
+  void RemoveWatches(const std::string& directory);
+  void ReadEvents();
+  void PollSources();
+  void PollDirectory(const std::string& directory);
+  std::map<std::string, SPolledDir>::iterator RemovePolledDirectory(std::map<std::string, SPolledDir>::iterator it);
+
+  std::set<std::pair<uint64_t, uint64_t>> m_polledIds; //!< device and inode of the polled directories
+  std::map<int, std::string> m_watches;                //!< watched directories by inotify watch descriptor
+  int m_inotify = -1;
+  unsigned int m_lastPoll = 0;
+  unsigned int m_pollInterval = 0;
+};
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+// Built with AVX2 enabled, only to be called if the CPU supports it. The remainder of a
+// plane that doesn't fill a whole vector is handled by the scalar kernels.
+// Nothing from headers that might be inlined elsewhere (like std::max) may be used here,
+// the linker could pick the copy built for this instruction set.
+
+namespace
+{
+void MulAVX2(float* data, float mul, unsigned int count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), m));
+  CAEKernels::GetScalar()->Mul(data + i, mul, count - i);
+}
+
+void MulAddAVX2(float* data, const float* add, float mul, unsigned int count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 product = _mm256_mul_ps(_mm256_loadu_ps(add + i), m);
+    _mm256_storeu_ps(data + i, _mm256_add_ps(_mm256_loadu_ps(data + i), product));
+  }
+  CAEKernels::GetScalar()->MulAdd(data + i, add + i, mul, count - i);
+}
+
+void ClampAVX2(float* data, unsigned int count)
+{
+  const __m256 min = _mm256_set1_ps(-1.0f);
+  const __m256 max = _mm256_set1_ps(1.0f);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(data + i), min), max));
+  CAEKernels::GetScalar()->Clamp(data + i, count - i);
+}
+
+void SoftClipAVX2(float* data, unsigned int count)
+{
+  const __m256 min = _mm256_set1_ps(-3.0f);
+  const __m256 max = _mm256_set1_ps(3.0f);
+  const __m256 c1 = _mm256_set1_ps(27.0f);
+  const __m256 c2 = _mm256_set1_ps(9.0f);
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 x = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(data + i), min), max);
+    const __m256 y = _mm256_mul_ps(x, x);
+    const __m256 numerator = _mm256_mul_ps(x, _mm256_add_ps(c1, y));
+    const __m256 denominator = _mm256_add_ps(c1, _mm256_mul_ps(c2, y));
+    _mm256_storeu_ps(data + i, _mm256_div_ps(numerator, denominator));
+  }
+  CAEKernels::GetScalar()->SoftClip(data + i, count - i);
+}
+
+float PeakAVX2(const float* data, unsigned int count)
+{
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  __m256 peak = _mm256_setzero_ps();
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    peak = _mm256_max_ps(peak, _mm256_andnot_ps(sign, _mm256_loadu_ps(data + i)));
+
+  float lanes[8];
+  _mm256_storeu_ps(lanes, peak);
+  float result = CAEKernels::GetScalar()->Peak(data + i, count - i);
+  for (float lane : lanes)
+    result = lane > result ? lane : result;
+  return result;
+}
+}
+
+const CAEKernels* CAEKernels::GetAVX2()
+{
+  static const CAEKernels kernels = {MulAVX2, MulAddAVX2, ClampAVX2, SoftClipAVX2, PeakAVX2,
+                                     "AVX2"};
+  return &kernels;
+}
+
+#else
+
+const CAEKernels* CAEKernels::GetAVX2()
+{
+  return nullptr;
+}
+
+#endif
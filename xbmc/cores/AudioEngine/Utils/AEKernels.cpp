@@ -0,0 +1,192 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#include "ServiceBroker.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <math.h>
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+// This file, as well as the AVX2 and NEON ones, has to be built without contracting
+// multiplications and additions into fused instructions, otherwise the results differ.
+
+namespace
+{
+void MulScalar(float* data, float mul, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    data[i] *= mul;
+}
+
+void MulAddScalar(float* data, const float* add, float mul, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    data[i] += add[i] * mul;
+}
+
+void ClampScalar(float* data, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    data[i] = data[i] < -1.0f ? -1.0f : (data[i] > 1.0f ? 1.0f : data[i]);
+}
+
+inline float SoftClip(float x)
+{
+  x = x < -3.0f ? -3.0f : (x > 3.0f ? 3.0f : x);
+  const float y = x * x;
+  return x * (27.0f + y) / (27.0f + 9.0f * y);
+}
+
+void SoftClipScalar(float* data, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    data[i] = SoftClip(data[i]);
+}
+
+float PeakScalar(const float* data, unsigned int count)
+{
+  float peak = 0.0f;
+  for (unsigned int i = 0; i < count; i++)
+    peak = std::max(peak, fabsf(data[i]));
+  return peak;
+}
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+void MulSSE(float* data, float mul, unsigned int count)
+{
+  const __m128 m = _mm_set1_ps(mul);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), m));
+  MulScalar(data + i, mul, count - i);
+}
+
+void MulAddSSE(float* data, const float* add, float mul, unsigned int count)
+{
+  const __m128 m = _mm_set1_ps(mul);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128 product = _mm_mul_ps(_mm_loadu_ps(add + i), m);
+    _mm_storeu_ps(data + i, _mm_add_ps(_mm_loadu_ps(data + i), product));
+  }
+  MulAddScalar(data + i, add + i, mul, count - i);
+}
+
+void ClampSSE(float* data, unsigned int count)
+{
+  const __m128 min = _mm_set1_ps(-1.0f);
+  const __m128 max = _mm_set1_ps(1.0f);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(data + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(data + i), min), max));
+  ClampScalar(data + i, count - i);
+}
+
+void SoftClipSSE(float* data, unsigned int count)
+{
+  const __m128 min = _mm_set1_ps(-3.0f);
+  const __m128 max = _mm_set1_ps(3.0f);
+  const __m128 c1 = _mm_set1_ps(27.0f);
+  const __m128 c2 = _mm_set1_ps(9.0f);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(data + i), min), max);
+    const __m128 y = _mm_mul_ps(x, x);
+    const __m128 numerator = _mm_mul_ps(x, _mm_add_ps(c1, y));
+    const __m128 denominator = _mm_add_ps(c1, _mm_mul_ps(c2, y));
+    _mm_storeu_ps(data + i, _mm_div_ps(numerator, denominator));
+  }
+  SoftClipScalar(data + i, count - i);
+}
+
+float PeakSSE(const float* data, unsigned int count)
+{
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  __m128 peak = _mm_setzero_ps();
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    peak = _mm_max_ps(peak, _mm_andnot_ps(sign, _mm_loadu_ps(data + i)));
+
+  float lanes[4];
+  _mm_storeu_ps(lanes, peak);
+  float result = PeakScalar(data + i, count - i);
+  for (float lane : lanes)
+    result = std::max(result, lane);
+  return result;
+}
+#endif
+
+unsigned int GetCPUFeatures()
+{
+  std::shared_ptr<CCPUInfo> cpuInfo = CServiceBroker::GetCPUInfo();
+  if (!cpuInfo)
+    cpuInfo = CCPUInfo::GetCPUInfo();
+  return cpuInfo->GetCPUFeatures();
+}
+
+const CAEKernels* SelectKernels()
+{
+  const CAEKernels* kernels = CAEKernels::GetSupported().back();
+  CLog::Log(LOGDEBUG, "CAEKernels: using %s kernels", kernels->name);
+  return kernels;
+}
+}
+
+const CAEKernels& CAEKernels::Get()
+{
+  static const CAEKernels* kernels = SelectKernels();
+  return *kernels;
+}
+
+std::vector<const CAEKernels*> CAEKernels::GetSupported()
+{
+  const unsigned int features = GetCPUFeatures();
+
+  // from slowest to fastest
+  std::vector<const CAEKernels*> supported;
+  supported.push_back(GetScalar());
+  if (GetSSE())
+    supported.push_back(GetSSE());
+  if (GetAVX2() && (features & CPU_FEATURE_AVX2))
+    supported.push_back(GetAVX2());
+#if defined(__aarch64__)
+  // NEON is part of the base instruction set
+  if (GetNEON())
+#else
+  if (GetNEON() && (features & CPU_FEATURE_NEON))
+#endif
+    supported.push_back(GetNEON());
+
+  return supported;
+}
+
+const CAEKernels* CAEKernels::GetScalar()
+{
+  static const CAEKernels kernels = {MulScalar, MulAddScalar, ClampScalar, SoftClipScalar,
+                                     PeakScalar, "scalar"};
+  return &kernels;
+}
+
+const CAEKernels* CAEKernels::GetSSE()
+{
+#if defined(HAVE_SSE) && defined(__SSE__)
+  static const CAEKernels kernels = {MulSSE, MulAddSSE, ClampSSE, SoftClipSSE, PeakSSE, "SSE"};
+  return &kernels;
+#else
+  return nullptr;
+#endif
+}
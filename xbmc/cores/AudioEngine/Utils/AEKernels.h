@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <vector>
+
+/*!
+ \brief Kernels working on planes of float samples, used for volume scaling, mixing and clipping.
+
+ There is a scalar implementation and ones for SSE, AVX2 and NEON. They give bit identical
+ results for normal numbers, so which one runs doesn't change the output. Get() picks the best
+ one the CPU supports on first use.
+ */
+class CAEKernels
+{
+public:
+  /*! \brief data[i] *= mul */
+  void (*Mul)(float* data, float mul, unsigned int count);
+  /*! \brief data[i] += add[i] * mul */
+  void (*MulAdd)(float* data, const float* add, float mul, unsigned int count);
+  /*! \brief Limit samples to -1..1 */
+  void (*Clamp)(float* data, unsigned int count);
+  /*!
+   \brief Limit samples to -1..1 with a tanh like curve.
+   A rational approximation of tanh that reaches exactly +-1 at +-3 and is flat beyond.
+   See http://www.musicdsp.org/showone.php?id=238
+   */
+  void (*SoftClip)(float* data, unsigned int count);
+  /*! \brief The largest absolute sample value, 0 if there are no samples */
+  float (*Peak)(const float* data, unsigned int count);
+
+  const char* name;
+
+  /*!
+   \brief The fastest kernels for this CPU.
+   */
+  static const CAEKernels& Get();
+
+  /*!
+   \brief All kernels this build has and this CPU can run, from the slowest (scalar) to the fastest.
+   */
+  static std::vector<const CAEKernels*> GetSupported();
+
+  // the implementations, nullptr if they aren't part of this build
+  static const CAEKernels* GetScalar();
+  static const CAEKernels* GetSSE();
+  static const CAEKernels* GetAVX2();
+  static const CAEKernels* GetNEON();
+};
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AEKernels.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+
+// Built with NEON enabled, only to be called if the CPU supports it. The remainder of a
+// plane that doesn't fill a whole vector is handled by the scalar kernels.
+// Nothing from headers that might be inlined elsewhere (like std::max) may be used here,
+// the linker could pick the copy built for this instruction set.
+
+namespace
+{
+void MulNEON(float* data, float mul, unsigned int count)
+{
+  const float32x4_t m = vdupq_n_f32(mul);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), m));
+  CAEKernels::GetScalar()->Mul(data + i, mul, count - i);
+}
+
+void MulAddNEON(float* data, const float* add, float mul, unsigned int count)
+{
+  // no vmlaq_f32, it isn't guaranteed to round like a separate multiplication and addition
+  const float32x4_t m = vdupq_n_f32(mul);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t product = vmulq_f32(vld1q_f32(add + i), m);
+    vst1q_f32(data + i, vaddq_f32(vld1q_f32(data + i), product));
+  }
+  CAEKernels::GetScalar()->MulAdd(data + i, add + i, mul, count - i);
+}
+
+void ClampNEON(float* data, unsigned int count)
+{
+  const float32x4_t min = vdupq_n_f32(-1.0f);
+  const float32x4_t max = vdupq_n_f32(1.0f);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(data + i, vminq_f32(vmaxq_f32(vld1q_f32(data + i), min), max));
+  CAEKernels::GetScalar()->Clamp(data + i, count - i);
+}
+
+void SoftClipNEON(float* data, unsigned int count)
+{
+#if defined(__aarch64__)
+  const float32x4_t min = vdupq_n_f32(-3.0f);
+  const float32x4_t max = vdupq_n_f32(3.0f);
+  const float32x4_t c1 = vdupq_n_f32(27.0f);
+  const float32x4_t c2 = vdupq_n_f32(9.0f);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    const float32x4_t x = vminq_f32(vmaxq_f32(vld1q_f32(data + i), min), max);
+    const float32x4_t y = vmulq_f32(x, x);
+    const float32x4_t numerator = vmulq_f32(x, vaddq_f32(c1, y));
+    const float32x4_t denominator = vaddq_f32(c1, vmulq_f32(c2, y));
+    vst1q_f32(data + i, vdivq_f32(numerator, denominator));
+  }
+  CAEKernels::GetScalar()->SoftClip(data + i, count - i);
+#else
+  // 32 bit NEON only has a reciprocal estimate, which would change the results
+  CAEKernels::GetScalar()->SoftClip(data, count);
+#endif
+}
+
+float PeakNEON(const float* data, unsigned int count)
+{
+  float32x4_t peak = vdupq_n_f32(0.0f);
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    peak = vmaxq_f32(peak, vabsq_f32(vld1q_f32(data + i)));
+
+  float lanes[4];
+  vst1q_f32(lanes, peak);
+  float result = CAEKernels::GetScalar()->Peak(data + i, count - i);
+  for (float lane : lanes)
+    result = lane > result ? lane : result;
+  return result;
+}
+}
+
+const CAEKernels* CAEKernels::GetNEON()
+{
+  static const CAEKernels kernels = {MulNEON, MulAddNEON, ClampNEON, SoftClipNEON, PeakNEON,
+                                     "NEON"};
+  return &kernels;
+}
+
+#else
+
+const CAEKernels* CAEKernels::GetNEON()
+{
+  return nullptr;
+}
+
+#endif
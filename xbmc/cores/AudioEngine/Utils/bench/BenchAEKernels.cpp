@@ -0,0 +1,129 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEKernels.h"
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// a period of 8 channel audio as ActiveAE mixes it
+const unsigned int PlaneSize = 8 * 1024;
+
+// the argument selects the kernels, from scalar to the fastest this CPU supports
+const CAEKernels* GetKernels(benchmark::State& state)
+{
+  const std::vector<const CAEKernels*> supported = CAEKernels::GetSupported();
+  if (static_cast<size_t>(state.range(0)) >= supported.size())
+  {
+    state.SkipWithError("not supported by this CPU");
+    return nullptr;
+  }
+
+  state.SetLabel(supported[state.range(0)]->name);
+  return supported[state.range(0)];
+}
+
+std::vector<float> CreatePlane(float range)
+{
+  std::mt19937 generator(PlaneSize);
+  std::uniform_real_distribution<float> distribution(-range, range);
+  std::vector<float> plane(PlaneSize);
+  for (float& sample : plane)
+    sample = distribution(generator);
+  return plane;
+}
+}
+
+static void BM_AEKernels_Mul(benchmark::State& state)
+{
+  const CAEKernels* kernels = GetKernels(state);
+  if (!kernels)
+    return;
+
+  std::vector<float> plane = CreatePlane(1.0f);
+  for (auto _ : state)
+  {
+    // scaling up and down again keeps the samples in range
+    kernels->Mul(plane.data(), 0.5f, PlaneSize);
+    kernels->Mul(plane.data(), 2.0f, PlaneSize);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * PlaneSize * 2);
+}
+BENCHMARK(BM_AEKernels_Mul)->DenseRange(0, 3);
+
+static void BM_AEKernels_MulAdd(benchmark::State& state)
+{
+  const CAEKernels* kernels = GetKernels(state);
+  if (!kernels)
+    return;
+
+  std::vector<float> plane = CreatePlane(1.0f);
+  const std::vector<float> add = CreatePlane(1.0f);
+  for (auto _ : state)
+  {
+    kernels->MulAdd(plane.data(), add.data(), 0.5f, PlaneSize);
+    kernels->MulAdd(plane.data(), add.data(), -0.5f, PlaneSize);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * PlaneSize * 2);
+}
+BENCHMARK(BM_AEKernels_MulAdd)->DenseRange(0, 3);
+
+static void BM_AEKernels_Clamp(benchmark::State& state)
+{
+  const CAEKernels* kernels = GetKernels(state);
+  if (!kernels)
+    return;
+
+  const std::vector<float> source = CreatePlane(2.0f);
+  std::vector<float> plane(PlaneSize);
+  for (auto _ : state)
+  {
+    plane = source;
+    kernels->Clamp(plane.data(), PlaneSize);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * PlaneSize);
+}
+BENCHMARK(BM_AEKernels_Clamp)->DenseRange(0, 3);
+
+static void BM_AEKernels_SoftClip(benchmark::State& state)
+{
+  const CAEKernels* kernels = GetKernels(state);
+  if (!kernels)
+    return;
+
+  const std::vector<float> source = CreatePlane(2.0f);
+  std::vector<float> plane(PlaneSize);
+  for (auto _ : state)
+  {
+    plane = source;
+    kernels->SoftClip(plane.data(), PlaneSize);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * PlaneSize);
+}
+BENCHMARK(BM_AEKernels_SoftClip)->DenseRange(0, 3);
+
+static void BM_AEKernels_Peak(benchmark::State& state)
+{
+  const CAEKernels* kernels = GetKernels(state);
+  if (!kernels)
+    return;
+
+  const std::vector<float> plane = CreatePlane(1.0f);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(kernels->Peak(plane.data(), PlaneSize));
+  state.SetItemsProcessed(state.iterations() * PlaneSize);
+}
+BENCHMARK(BM_AEKernels_Peak)->DenseRange(0, 3);
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEKernels.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// odd sizes and offsets so every kernel runs into its scalar remainder and unaligned data
+const unsigned int Counts[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 1021};
+const unsigned int Offsets[] = {0, 1, 3};
+
+std::vector<float> CreateSamples(unsigned int count, float range, unsigned int seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<float> distribution(-range, range);
+  std::vector<float> samples(count);
+  for (float& sample : samples)
+    sample = distribution(generator);
+  return samples;
+}
+
+void ExpectBitExact(const std::vector<float>& expected, const std::vector<float>& actual,
+                    const char* kernels)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++)
+    ASSERT_EQ(0, memcmp(&expected[i], &actual[i], sizeof(float)))
+        << kernels << ": sample " << i << " is " << actual[i] << " instead of " << expected[i];
+}
+}
+
+TEST(TestAEKernels, Supported)
+{
+  const std::vector<const CAEKernels*> supported = CAEKernels::GetSupported();
+  ASSERT_FALSE(supported.empty());
+  EXPECT_EQ(CAEKernels::GetScalar(), supported.front());
+  EXPECT_EQ(supported.back(), &CAEKernels::Get());
+}
+
+TEST(TestAEKernels, Scalar)
+{
+  const CAEKernels* scalar = CAEKernels::GetScalar();
+
+  std::vector<float> data = {0.5f, -0.25f, 2.0f};
+  scalar->Mul(data.data(), 2.0f, data.size());
+  EXPECT_EQ(std::vector<float>({1.0f, -0.5f, 4.0f}), data);
+
+  const std::vector<float> add = {1.0f, 1.0f, -1.0f};
+  scalar->MulAdd(data.data(), add.data(), 0.5f, data.size());
+  EXPECT_EQ(std::vector<float>({1.5f, 0.0f, 3.5f}), data);
+
+  EXPECT_EQ(3.5f, scalar->Peak(data.data(), data.size()));
+  EXPECT_EQ(0.0f, scalar->Peak(data.data(), 0));
+
+  std::vector<float> clamped = {-2.0f, 0.5f, 1.5f};
+  scalar->Clamp(clamped.data(), clamped.size());
+  EXPECT_EQ(std::vector<float>({-1.0f, 0.5f, 1.0f}), clamped);
+
+  std::vector<float> clipped = {-4.0f, -3.0f, 0.0f, 0.5f, 3.0f, 100.0f};
+  scalar->SoftClip(clipped.data(), clipped.size());
+  EXPECT_EQ(-1.0f, clipped[0]);
+  EXPECT_EQ(-1.0f, clipped[1]);
+  EXPECT_EQ(0.0f, clipped[2]);
+  EXPECT_GT(clipped[3], 0.45f);
+  EXPECT_LT(clipped[3], 0.5f);
+  EXPECT_EQ(1.0f, clipped[4]);
+  EXPECT_EQ(1.0f, clipped[5]);
+}
+
+TEST(TestAEKernels, BitExact)
+{
+  const CAEKernels* scalar = CAEKernels::GetScalar();
+
+  for (const CAEKernels* kernels : CAEKernels::GetSupported())
+  {
+    for (unsigned int count : Counts)
+    {
+      for (unsigned int offset : Offsets)
+      {
+        const std::vector<float> data = CreateSamples(count + offset, 4.0f, count);
+        const std::vector<float> add = CreateSamples(count + offset, 1.0f, count + 1);
+
+        std::vector<float> expected = data;
+        std::vector<float> actual = data;
+        scalar->Mul(expected.data() + offset, 0.7f, count);
+        kernels->Mul(actual.data() + offset, 0.7f, count);
+        ExpectBitExact(expected, actual, kernels->name);
+
+        expected = data;
+        actual = data;
+        scalar->MulAdd(expected.data() + offset, add.data() + offset, 0.3f, count);
+        kernels->MulAdd(actual.data() + offset, add.data() + offset, 0.3f, count);
+        ExpectBitExact(expected, actual, kernels->name);
+
+        expected = data;
+        actual = data;
+        scalar->Clamp(expected.data() + offset, count);
+        kernels->Clamp(actual.data() + offset, count);
+        ExpectBitExact(expected, actual, kernels->name);
+
+        expected = data;
+        actual = data;
+        scalar->SoftClip(expected.data() + offset, count);
+        kernels->SoftClip(actual.data() + offset, count);
+        ExpectBitExact(expected, actual, kernels->name);
+
+        EXPECT_EQ(scalar->Peak(data.data() + offset, count),
+                  kernels->Peak(data.data() + offset, count))
+            << kernels->name;
+      }
+    }
+  }
+}
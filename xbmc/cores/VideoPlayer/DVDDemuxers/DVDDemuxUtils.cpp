@@ -19,7 +19,12 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
 {
   if (pPacket)
   {
-    if (pPacket->pData)
+    if (pPacket->pBufferRef)
+    {
+      AVBufferRef* buffer = static_cast<AVBufferRef*>(pPacket->pBufferRef);
+      av_buffer_unref(&buffer);
+    }
+    else if (pPacket->pData)
       KODI::MEMORY::AlignedFree(pPacket->pData);
     if (pPacket->iSideDataElems)
     {
@@ -70,6 +75,39 @@ DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(unsigned int iDataSize, unsigne
   return ret;
 }
 
+DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(const AVPacket& src)
+{
+  // decoders may read past the end of the data, so the buffer has to provide the same zeroed
+  // padding as a copy would
+  static const uint8_t padding[AV_INPUT_BUFFER_PADDING_SIZE] = {};
+  if (src.buf && src.data && src.size > 0 &&
+      src.data >= src.buf->data &&
+      src.data + src.size + AV_INPUT_BUFFER_PADDING_SIZE <= src.buf->data + src.buf->size &&
+      memcmp(src.data + src.size, padding, AV_INPUT_BUFFER_PADDING_SIZE) == 0)
+  {
+    AVBufferRef* buffer = av_buffer_ref(src.buf);
+    if (buffer)
+    {
+      DemuxPacket* pPacket = new DemuxPacket();
+      pPacket->pBufferRef = buffer;
+      pPacket->pData = src.data;
+      pPacket->iSize = src.size;
+      return pPacket;
+    }
+  }
+
+  DemuxPacket* pPacket = AllocateDemuxPacket(src.size);
+  if (!pPacket)
+    return nullptr;
+
+  if (src.data && src.size > 0)
+  {
+    memcpy(pPacket->pData, src.data, src.size);
+    pPacket->iSize = src.size;
+  }
+  return pPacket;
+}
+
 void CDVDDemuxUtils::StoreSideData(DemuxPacket *pkt, AVPacket *src)
 {
   AVPacket avPkt;
@@ -19,6 +19,12 @@ public:
   static void FreeDemuxPacket(DemuxPacket* pPacket);
   static DemuxPacket* AllocateDemuxPacket(int iDataSize = 0);
   static DemuxPacket* AllocateDemuxPacket(unsigned int iDataSize, unsigned int encryptedSubsampleCount);
+  /*!
+   \brief Create a packet with the data of an AVPacket.
+   Reference counted data is shared rather than copied, the packet must not be written to.
+   Other packets, or packets without zeroed input padding, get a copy of the data.
+   */
+  static DemuxPacket* AllocateDemuxPacket(const AVPacket& src);
   static void StoreSideData(DemuxPacket *pkt, AVPacket *src);
 };
 
@@ -44,6 +44,8 @@ extern "C"
     bool recoveryPoint = false;
 
     std::shared_ptr<DemuxCryptoInfo> cryptoInfo;
+
+    void* pBufferRef = nullptr; // AVBufferRef owning pData if it wasn't copied, managed by Kodi
   } DemuxPacket;
 
 #ifdef __cplusplus
@@ -19,6 +19,8 @@
 #include "DbUrl.h"
 #include "ServiceBroker.h"
 
+#include <algorithm>
+
 #if defined(HAS_MYSQL) || defined(HAS_MARIADB)
 #include "mysqldataset.h"
 #endif
@@ -294,6 +296,26 @@ std::string CDatabase::GetSingleValue(const std::string &query)
   return GetSingleValue(query, m_pDS);
 }
 
+std::string CDatabase::GetSingleValue(const std::string &query, const BindList &params)
+{
+  std::string ret;
+  try
+  {
+    if (!m_pDB || !m_pDS)
+      return ret;
+
+    if (m_pDS->query_with_params(query, params) && m_pDS->num_rows() > 0)
+      ret = m_pDS->fv(0).get_asString();
+
+    m_pDS->close();
+  }
+  catch(...)
+  {
+    CLog::Log(LOGERROR, "%s - failed on query '%s'", __FUNCTION__, query.c_str());
+  }
+  return ret;
+}
+
 bool CDatabase::DeleteValues(const std::string &strTable, const Filter &filter /* = Filter() */)
 {
   std::string strQuery;
@@ -352,6 +374,36 @@ bool CDatabase::ExecuteQuery(const std::string &strQuery)
   return bReturn;
 }
 
+bool CDatabase::ExecuteQuery(const std::string &strQuery, const BindList &params)
+{
+  bool bReturn = false;
+
+  try
+  {
+    if (nullptr == m_pDB)
+      return bReturn;
+    if (nullptr == m_pDS)
+      return bReturn;
+
+    // queued queries are executed as text, so bind the values as literals
+    if (m_multipleExecute)
+    {
+      m_multipleQueries.push_back(m_pDB->bind_params(strQuery, params));
+      return true;
+    }
+
+    m_pDS->exec_with_params(strQuery, params);
+    bReturn = true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to execute query '%s'",
+        __FUNCTION__, strQuery.c_str());
+  }
+
+  return bReturn;
+}
+
 bool CDatabase::ResultQuery(const std::string &strQuery)
 {
   bool bReturn = false;
@@ -376,6 +428,29 @@ bool CDatabase::ResultQuery(const std::string &strQuery)
   return bReturn;
 }
 
+bool CDatabase::ResultQuery(const std::string &strQuery, const BindList &params)
+{
+  bool bReturn = false;
+
+  try
+  {
+    if (nullptr == m_pDB)
+      return bReturn;
+    if (nullptr == m_pDS)
+      return bReturn;
+
+    // the values are bound, so the SQL is passed on unformatted
+    bReturn = m_pDS->query_with_params(strQuery, params);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to execute query '%s'",
+        __FUNCTION__, strQuery.c_str());
+  }
+
+  return bReturn;
+}
+
 bool CDatabase::QueueInsertQuery(const std::string &strQuery)
 {
   if (strQuery.empty())
@@ -743,6 +818,89 @@ bool CDatabase::BuildSQL(const std::string &strQuery, const Filter &filter, std:
   return true;
 }
 
+bool CDatabase::CreateFullTextIndex(const std::string &index, const std::string &table, const std::string &id, const std::vector<std::string> &columns)
+{
+  if (!m_sqlite)
+    return false;
+
+  const std::string columnList = StringUtils::Join(columns, ", ");
+  std::vector<std::string> newValues;
+  std::vector<std::string> oldValues;
+  for (const auto &column : columns)
+  {
+    newValues.push_back("new." + column);
+    oldValues.push_back("old." + column);
+  }
+
+  try
+  {
+    // the text is read from the table, the index only holds the tokens
+    m_pDS->exec(PrepareSQL("DROP TABLE IF EXISTS %s", index.c_str()));
+    m_pDS->exec(PrepareSQL("CREATE VIRTUAL TABLE %s USING fts5(%s, content='%s', content_rowid='%s')",
+                           index.c_str(), columnList.c_str(), table.c_str(), id.c_str()));
+  }
+  catch (...)
+  {
+    CLog::Log(LOGINFO, "%s - no full text search on %s, sqlite lacks FTS5", __FUNCTION__, table.c_str());
+    return false;
+  }
+
+  // an external content index can't look up what to remove, it has to be given the old values
+  const std::string insert = PrepareSQL("INSERT INTO %s (rowid, %s) VALUES (new.%s, %s);",
+                                        index.c_str(), columnList.c_str(), id.c_str(),
+                                        StringUtils::Join(newValues, ", ").c_str());
+  const std::string remove = PrepareSQL("INSERT INTO %s (%s, rowid, %s) VALUES ('delete', old.%s, %s);",
+                                        index.c_str(), index.c_str(), columnList.c_str(), id.c_str(),
+                                        StringUtils::Join(oldValues, ", ").c_str());
+
+  m_pDS->exec(PrepareSQL("INSERT INTO %s (%s) VALUES ('rebuild')", index.c_str(), index.c_str()));
+  m_pDS->exec(PrepareSQL("CREATE TRIGGER %s_insert AFTER INSERT ON %s FOR EACH ROW BEGIN %s END",
+                         index.c_str(), table.c_str(), insert.c_str()));
+  m_pDS->exec(PrepareSQL("CREATE TRIGGER %s_update AFTER UPDATE OF %s ON %s FOR EACH ROW BEGIN %s %s END",
+                         index.c_str(), columnList.c_str(), table.c_str(), remove.c_str(), insert.c_str()));
+  m_pDS->exec(PrepareSQL("CREATE TRIGGER %s_delete AFTER DELETE ON %s FOR EACH ROW BEGIN %s END",
+                         index.c_str(), table.c_str(), remove.c_str()));
+  return true;
+}
+
+bool CDatabase::HasFullTextIndex(const std::string &index)
+{
+  if (!m_sqlite)
+    return false;
+
+  // m_pDS2, callers may be about to use m_pDS
+  const std::string query = PrepareSQL("SELECT name FROM sqlite_master WHERE type='table' AND name='%s'", index.c_str());
+  return !GetSingleValue(query, m_pDS2).empty();
+}
+
+void CDatabase::AppendFullTextSearch(Filter &filter, const std::string &index, const std::string &id, const std::string &match) const
+{
+  filter.AppendJoin(PrepareSQL("JOIN %s ON %s.rowid = %s", index.c_str(), index.c_str(), id.c_str()));
+  filter.AppendWhere(PrepareSQL("%s MATCH '%s'", index.c_str(), match.c_str()));
+  filter.AppendOrder(PrepareSQL("%s.rank", index.c_str()));
+}
+
+std::string CDatabase::GetFullTextQuery(const std::string &search, const std::vector<std::string> &columns /* = {} */, bool fromStart /* = false */)
+{
+  // the default tokenizer splits words at ascii characters other than letters and digits,
+  // a phrase without any words is a syntax error
+  if (std::none_of(search.begin(), search.end(), [](char c) {
+        return StringUtils::isasciialphanum(c) || static_cast<unsigned char>(c) >= 0x80;
+      }))
+    return "";
+
+  std::string phrase(search);
+  StringUtils::Replace(phrase, "\"", "\"\"");
+
+  std::string query;
+  if (!columns.empty())
+    query = "{" + StringUtils::Join(columns, " ") + "} : ";
+  if (fromStart)
+    query += "^ ";
+  query += "\"" + phrase + "\"*";
+  return query;
+}
+
 bool CDatabase::BuildSQL(const std::string &strBaseDir, const std::string &strQuery, Filter &filter, std::string &strSQL, CDbUrl &dbUrl)
 {
   SortDescription sorting;
@@ -11,6 +11,7 @@
 namespace dbiplus {
   class Database;
   class Dataset;
+  class field_value;
 }
 
 #include <memory>
@@ -121,6 +122,14 @@ public:
   std::string GetSingleValue(const std::string &strTable, const std::string &strColumn, const std::string &strWhereClause = std::string(), const std::string &strOrderBy = std::string());
   std::string GetSingleValue(const std::string &query);
 
+  /*!
+   * @brief Get a single value from a query with bound parameters.
+   * @param query The query in question, with one '?' placeholder per parameter.
+   * @param params The values to bind to the placeholders, in order.
+   * @return The requested value or an empty string if it wasn't found.
+   */
+  std::string GetSingleValue(const std::string &query, const std::vector<dbiplus::field_value> &params);
+
   /*! \brief Get a single value from a query on a dataset.
    \param query the query in question.
    \param ds the dataset to use for the query.
@@ -146,6 +155,18 @@ public:
    */
   bool ExecuteQuery(const std::string &strQuery);
 
+  /*!
+   * @brief Execute a query that does not return any result, binding values
+   *        to its '?' placeholders instead of formatting them into the SQL.
+   *        The statement is compiled once and reused from the statement cache
+   *        where the backend supports it.
+   * @param strQuery The query to execute, with one '?' placeholder per parameter.
+   * @param params The values to bind to the placeholders, in order.
+   * @return True if the query was executed successfully, false otherwise.
+   * @sa ExecuteQuery
+   */
+  bool ExecuteQuery(const std::string &strQuery, const std::vector<dbiplus::field_value> &params);
+
   /*!
    * @brief Execute a query that returns a result.
    * @remarks Call m_pDS->close(); to clean up the dataset when done.
@@ -154,6 +175,18 @@ public:
    */
   bool ResultQuery(const std::string &strQuery);
 
+  /*!
+   * @brief Execute a query that returns a result, binding values to its '?'
+   *        placeholders instead of formatting them into the SQL.
+   * @remarks The query isn't passed through PrepareSQL, so '%' needs no escaping.
+   *          Call m_pDS->close(); to clean up the dataset when done.
+   * @param strQuery The query to execute, with one '?' placeholder per parameter.
+   * @param params The values to bind to the placeholders, in order.
+   * @return True if the query was executed successfully, false otherwise.
+   * @sa ResultQuery
+   */
+  bool ResultQuery(const std::string &strQuery, const std::vector<dbiplus::field_value> &params);
+
   /*!
    * @brief Start a multiple execution queue. Any ExecuteQuery() function
    *        following this call will be queued rather than executed until
@@ -193,6 +226,17 @@ public:
 
   bool Connect(const std::string &dbName, const DatabaseSettings &db, bool create);
 
+  /*!
+   * @brief Get the FTS5 query for a search that matches at the start of words, case insensitive.
+   *        The words of the search have to follow each other, the last one may be incomplete.
+   * @param search The search.
+   * @param columns The columns to search in, all columns of the index if empty.
+   * @param fromStart Only match at the start of the columns.
+   * @return The query, or an empty string if the search has no characters the index could match.
+   * @sa AppendFullTextSearch
+   */
+  static std::string GetFullTextQuery(const std::string &search, const std::vector<std::string> &columns = {}, bool fromStart = false);
+
 protected:
   friend class CDatabaseManager;
 
@@ -234,6 +278,37 @@ protected:
 
   bool BuildSQL(const std::string &strQuery, const Filter &filter, std::string &strSQL);
 
+  /*!
+   * @brief Create a full text search index on text columns of a table.
+   *        The index is an external content sqlite FTS5 table over the table, its rowids are the
+   *        table's integer primary key. Triggers keep it up to date, so call this from
+   *        CreateAnalytics(). An existing index is rebuilt. Rows removed by REPLACE INTO don't fire
+   *        the delete trigger, tables written that way need a trigger of their own.
+   *        Other databases, and sqlite builds without FTS5, don't get an index.
+   * @param index The name of the index.
+   * @param table The table to index.
+   * @param id The integer primary key of the table.
+   * @param columns The columns to index.
+   * @return True if the index was created, false otherwise.
+   */
+  bool CreateFullTextIndex(const std::string &index, const std::string &table, const std::string &id, const std::vector<std::string> &columns);
+
+  /*!
+   * @brief Whether a full text search index created by CreateFullTextIndex() exists.
+   *        Searches should fall back to LIKE if it doesn't.
+   */
+  bool HasFullTextIndex(const std::string &index);
+
+  /*!
+   * @brief Restrict a query to the rows matching a full text search, best matches first.
+   * @param filter The filter of the query, gets the join, condition and order.
+   * @param index The full text search index.
+   * @param id The primary key of the indexed table as used in the query, e.g. "song.idSong".
+   * @param match The FTS5 query.
+   * @sa GetFullTextQuery
+   */
+  void AppendFullTextSearch(Filter &filter, const std::string &index, const std::string &id, const std::string &match) const;
+
   bool m_sqlite; ///< \brief whether we use sqlite (defaults to true)
 
   std::unique_ptr<dbiplus::Database> m_pDB;
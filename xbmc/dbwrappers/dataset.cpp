@@ -68,6 +68,62 @@ std::string Database::prepare(const char *format, ...)
   return result;
 }
 
+std::string Database::bind_params(const std::string &sql, const BindList &params)
+{
+  std::string result;
+  result.reserve(sql.size() + params.size() * 8);
+
+  size_t param = 0;
+  char quote = 0;
+  for (char c : sql)
+  {
+    // don't treat question marks inside string literals as placeholders
+    if (quote)
+    {
+      if (c == quote)
+        quote = 0;
+    }
+    else if (c == '\'' || c == '"')
+      quote = c;
+    else if (c == '?')
+    {
+      if (param >= params.size())
+        throw DbErrors("Not enough parameters bound to query: %s", sql.c_str());
+
+      const field_value &value = params[param++];
+      if (value.get_isNull())
+        result += "NULL";
+      else
+      {
+        switch (value.get_fType())
+        {
+        case ft_String:
+        case ft_Char:
+          result += prepare("'%s'", value.get_asString().c_str());
+          break;
+        case ft_Boolean:
+          result += value.get_asBool() ? "1" : "0";
+          break;
+        case ft_Float:
+        case ft_Double:
+          result += prepare("%.17g", value.get_asDouble());
+          break;
+        default:
+          result += std::to_string(value.get_asInt64());
+          break;
+        }
+      }
+      continue;
+    }
+    result += c;
+  }
+
+  if (param != params.size())
+    throw DbErrors("Too many parameters bound to query: %s", sql.c_str());
+
+  return result;
+}
+
 //************* Dataset implementation ***************
 
 Dataset::Dataset():
@@ -147,6 +203,18 @@ void Dataset::setSqlParams(const char *sqlFrmt, sqlType t, ...) {
 
 
 
+bool Dataset::query_with_params(const std::string &sql, const BindList &params) {
+  if (db == NULL) throw DbErrors("No Database Connection");
+  return query(db->bind_params(sql, params));
+}
+
+
+int Dataset::exec_with_params(const std::string &sql, const BindList &params) {
+  if (db == NULL) throw DbErrors("No Database Connection");
+  return exec(db->bind_params(sql, params));
+}
+
+
 void Dataset::set_select_sql(const char *sel_sql) {
  select_sql = sel_sql;
 }
@@ -343,7 +411,7 @@ bool Dataset::get_index_map_entry(const char *f_name) {
 }
 /********* INDEXMAP SECTION END *********/
 
-const field_value Dataset::get_field_value(const char *f_name) {
+const field_value& Dataset::get_field_value(const char *f_name) {
   if (ds_state != dsInactive)
   {
     if (ds_state == dsEdit || ds_state == dsInsert){
@@ -376,7 +444,7 @@ const field_value Dataset::get_field_value(const char *f_name) {
   //return fv;
 }
 
-const field_value Dataset::get_field_value(int index) {
+const field_value& Dataset::get_field_value(int index) {
   if (ds_state != dsInactive) {
     if (ds_state == dsEdit || ds_state == dsInsert){
       if (index < 0 || index >= field_count())
@@ -395,12 +463,13 @@ const field_value Dataset::get_field_value(int index) {
   throw DbErrors("Dataset state is Inactive");
 }
 
-const sql_record* Dataset::get_sql_record()
+row_view Dataset::get_row()
 {
-  if (result.records.empty() || frecno >= (int)result.records.size())
-    return NULL;
+  // a view past the last row is invalid rather than an error
+  if (frecno < 0)
+    return row_view(result, result.size());
 
-  return result.records[frecno];
+  return row_view(result, frecno);
 }
 
 const field_value Dataset::f_old(const char *f_name) {
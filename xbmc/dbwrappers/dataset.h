@@ -24,6 +24,8 @@
 namespace dbiplus {
 class Dataset;		// forward declaration of class Dataset
 
+typedef std::vector<field_value> BindList;	// values bound to '?' placeholders
+
 
 #define S_NO_CONNECTION "No active connection";
 
@@ -148,6 +150,14 @@ public:
    */
   virtual std::string vprepare(const char *format, va_list args) = 0;
 
+  /*! \brief Substitute the '?' placeholders of a SQL statement with the escaped literal values of params.
+   Used by backends without native parameter binding and for statements that have to be queued as text.
+   \param sql - SQL statement containing one '?' placeholder per bound value.
+   \param params - values to substitute, in placeholder order.
+   \return SQL statement with all placeholders replaced.
+   */
+  virtual std::string bind_params(const std::string &sql, const BindList &params);
+
   virtual bool in_transaction() {return false;};
 
 };
@@ -293,6 +303,10 @@ public:
   virtual const void* getExecRes()=0;
 /* as open, but with our query exec Sql */
   virtual bool query(const std::string &sql) = 0;
+/* as query, but with the '?' placeholders in sql bound to params */
+  virtual bool query_with_params(const std::string &sql, const BindList &params);
+/* as exec, but with the '?' placeholders in sql bound to params */
+  virtual int exec_with_params(const std::string &sql, const BindList &params);
 /* Close SQL Query*/
   virtual void close();
 /* This function looks for field Field_name with value equal Field_value
@@ -371,11 +385,12 @@ public:
 //  virtual char *field_name(int f_index) { return field_by_index(f_index)->get_field_name(); };
 
 /* Getting value of field for current record */
-  virtual const field_value get_field_value(const char *f_name);
-  virtual const field_value get_field_value(int index);
+/* The returned reference stays valid until the dataset is moved to another record */
+  virtual const field_value& get_field_value(const char *f_name);
+  virtual const field_value& get_field_value(int index);
 /* Alias to get_field_value */
-  const field_value fv(const char *f) { return get_field_value(f); }
-  const field_value fv(int index) { return get_field_value(index); }
+  const field_value& fv(const char *f) { return get_field_value(f); }
+  const field_value& fv(int index) { return get_field_value(index); }
 
 /* ------------ for transaction ------------------- */
   void set_autocommit(bool v) { autocommit = v; }
@@ -387,7 +402,8 @@ public:
 
 /* --------------- for fast access ---------------- */
   const result_set& get_result_set() { return result; }
-  const sql_record* get_sql_record();
+/* view of the current row, invalid when there is none */
+  row_view get_row();
 
  private:
   Dataset(const Dataset&) = delete;
@@ -18,6 +18,8 @@
 #include "qry_dat.h"
 
 #include <inttypes.h>
+#include <limits>
+#include <stdexcept>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -640,6 +642,10 @@ void field_value::set_asString(const std::string & s) {
   str_value = s;
   field_type = ft_String;}
 
+void field_value::set_asString(const char *s, size_t len) {
+  str_value.assign(s, len);
+  field_type = ft_String;}
+
 void field_value::set_asBool(const bool b) {
   bool_value = b;
   field_type = ft_Boolean;}
@@ -725,4 +731,219 @@ std::string field_value::gft() {
   return tmp;
   }
 
+
+//************* result_columns implementation ***************
+
+void result_columns::reset(unsigned int ncols) {
+  for (auto &col : columns) {
+    col.types.clear();
+    col.values.clear();
+  }
+  columns.resize(ncols);
+  strings.clear();
+  freed_rows.clear();
+  num_freed = 0;
+}
+
+void result_columns::clear() {
+  std::vector<column>().swap(columns);
+  std::string().swap(strings);
+  std::vector<bool>().swap(freed_rows);
+  num_freed = 0;
+}
+
+void result_columns::push_null(unsigned int col) {
+  cell c;
+  c.int64_value = 0;
+  columns[col].types.push_back(ct_Null);
+  columns[col].values.push_back(c);
+}
+
+void result_columns::push_int64(unsigned int col, int64_t value) {
+  cell c;
+  c.int64_value = value;
+  columns[col].types.push_back(ct_Int64);
+  columns[col].values.push_back(c);
+}
+
+void result_columns::push_double(unsigned int col, double value) {
+  cell c;
+  c.double_value = value;
+  columns[col].types.push_back(ct_Double);
+  columns[col].values.push_back(c);
+}
+
+void result_columns::push_string(unsigned int col, const char *s, size_t len) {
+  if (strings.size() + len > std::numeric_limits<uint32_t>::max())
+    throw std::length_error("result_columns: string data exceeds 4GB");
+
+  cell c;
+  c.str_value.offset = static_cast<uint32_t>(strings.size());
+  c.str_value.length = static_cast<uint32_t>(len);
+  strings.append(s, len);
+  columns[col].types.push_back(ct_String);
+  columns[col].values.push_back(c);
+}
+
+void result_columns::get(unsigned int row, unsigned int col, field_value &v) const {
+  const cell &c = columns[col].values[row];
+  switch (columns[col].types[row]) {
+    case ct_Int64:
+      v.set_asInt64(c.int64_value);
+      v.set_isNull(false);
+      break;
+    case ct_Double:
+      v.set_asDouble(c.double_value);
+      v.set_isNull(false);
+      break;
+    case ct_String:
+      v.set_asString(strings.data() + c.str_value.offset, c.str_value.length);
+      v.set_isNull(false);
+      break;
+    case ct_Null:
+    default:
+      v.set_asString("", 0);
+      v.set_isNull();
+      break;
+  }
+}
+
+bool result_columns::is_null(unsigned int row, unsigned int col) const {
+  return columns[col].types[row] == ct_Null;
+}
+
+bool result_columns::get_string(unsigned int row, unsigned int col, std::string &s) const {
+  if (columns[col].types[row] != ct_String)
+    return false;
+
+  const str_ref &ref = columns[col].values[row].str_value;
+  s.assign(strings.data() + ref.offset, ref.length);
+  return true;
+}
+
+void result_columns::free_row(unsigned int row) {
+  if (row >= num_rows())
+    return;
+
+  if (freed_rows.empty())
+    freed_rows.resize(num_rows(), false);
+  if (freed_rows[row])
+    return;
+
+  freed_rows[row] = true;
+  for (auto &col : columns)
+    col.types[row] = ct_Null;
+
+  // the types are kept, so the row count and the NULL reads stay valid
+  if (++num_freed == num_rows())
+  {
+    for (auto &col : columns)
+      std::vector<cell>().swap(col.values);
+    std::string().swap(strings);
+  }
+}
+
+//************* row_view implementation ***************
+
+bool row_view::valid() const {
+  return row < rs->size();
+}
+
+unsigned int row_view::size() const {
+  if (!rs->records.empty())
+    return rs->record_header.size();
+  return rs->columns.num_columns();
+}
+
+cell_view row_view::at(unsigned int col) const {
+  if (!valid() || col >= size())
+    throw std::out_of_range("row_view::at");
+  return cell_view(*rs, row, col);
+}
+
+const field_value* cell_view::stored() const {
+  if (rs.records.empty())
+    return NULL;
+
+  static const field_value null_value = []() {
+    field_value v;
+    v.set_isNull();
+    return v;
+  }();
+  const sql_record *rec = rs.records[row];
+  return rec ? &rec->at(col) : &null_value;
+}
+
+field_value cell_view::value() const {
+  field_value v;
+  rs.columns.get(row, col, v);
+  return v;
+}
+
+bool cell_view::get_isNull() const {
+  if (const field_value *v = stored())
+    return v->get_isNull();
+  return rs.columns.is_null(row, col);
+}
+
+std::string cell_view::get_asString() const {
+  if (const field_value *v = stored())
+    return v->get_asString();
+  std::string s;
+  if (rs.columns.get_string(row, col, s))
+    return s;
+  return value().get_asString();
+}
+
+bool cell_view::get_asBool() const {
+  if (const field_value *v = stored())
+    return v->get_asBool();
+  return value().get_asBool();
+}
+
+int cell_view::get_asInt() const {
+  if (const field_value *v = stored())
+    return v->get_asInt();
+  return value().get_asInt();
+}
+
+unsigned int cell_view::get_asUInt() const {
+  if (const field_value *v = stored())
+    return v->get_asUInt();
+  return value().get_asUInt();
+}
+
+float cell_view::get_asFloat() const {
+  if (const field_value *v = stored())
+    return v->get_asFloat();
+  return value().get_asFloat();
+}
+
+double cell_view::get_asDouble() const {
+  if (const field_value *v = stored())
+    return v->get_asDouble();
+  return value().get_asDouble();
+}
+
+int64_t cell_view::get_asInt64() const {
+  if (const field_value *v = stored())
+    return v->get_asInt64();
+  return value().get_asInt64();
+}
+
+void cell_view::get(field_value &v) const {
+  if (const field_value *stored_value = stored())
+    v = *stored_value;
+  else
+    rs.columns.get(row, col, v);
+}
+
+//************* result_set implementation ***************
+
+row_view result_set::row(unsigned int n) const {
+  if (n >= size())
+    throw std::out_of_range("result_set::row");
+  return row_view(*this, n);
+}
+
 } //namespace
@@ -162,9 +162,10 @@ public:
   }
   }
 
-  void set_isNull(){is_null=true;}
+  void set_isNull(bool null = true){is_null=null;}
   void set_asString(const char *s);
   void set_asString(const std::string & s);
+  void set_asString(const char *s, size_t len);
   void set_asBool(const bool b);
   void set_asChar(const char c);
   void set_asShort(const short s);
@@ -206,6 +207,115 @@ typedef sql_record::iterator rec_itor;
 typedef record_prop::iterator recprop_itor;
 typedef query_data::iterator qry_itor;
 
+/* Columnar storage for a whole query result.
+   The string data of all cells is kept in one contiguous buffer and the
+   fixed-width values in one typed array per column, so filling a result
+   allocates O(columns) blocks rather than one or more per cell. */
+class result_columns
+{
+public:
+  result_columns() = default;
+
+/* drops all rows and prepares storage for ncols columns */
+  void reset(unsigned int ncols);
+/* drops all rows and releases the memory */
+  void clear();
+
+  unsigned int num_columns() const { return columns.size(); }
+  unsigned int num_rows() const { return columns.empty() ? 0 : columns[0].types.size(); }
+
+/* append a value to a column; every column gets one value per row */
+  void push_null(unsigned int col);
+  void push_int64(unsigned int col, int64_t value);
+  void push_double(unsigned int col, double value);
+  void push_string(unsigned int col, const char *s, size_t len);
+
+/* reads a cell into v, reusing the string storage v already owns */
+  void get(unsigned int row, unsigned int col, field_value &v) const;
+  bool is_null(unsigned int row, unsigned int col) const;
+/* copies a string cell into s, returns false for cells of other types */
+  bool get_string(unsigned int row, unsigned int col, std::string &s) const;
+
+/* Drops the values of a row, which then reads as NULL. The values of a
+   single row can't be given back, so the memory is released once every
+   row has been freed. */
+  void free_row(unsigned int row);
+
+private:
+  enum cell_type : unsigned char { ct_Null, ct_Int64, ct_Double, ct_String };
+
+  struct str_ref {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  union cell {
+    int64_t int64_value;
+    double double_value;
+    str_ref str_value;
+  };
+
+  struct column {
+    std::vector<unsigned char> types;
+    std::vector<cell> values;
+  };
+
+  std::vector<column> columns;
+  std::string strings;	// string data of all cells
+  std::vector<bool> freed_rows;
+  unsigned int num_freed = 0;
+};
+
+class result_set;
+
+/* A read-only reference to one cell of a result_set. It reads the cell in
+   place and converts it the way field_value does. */
+class cell_view
+{
+public:
+  bool get_isNull() const;
+  std::string get_asString() const;
+  bool get_asBool() const;
+  int get_asInt() const;
+  unsigned int get_asUInt() const;
+  float get_asFloat() const;
+  double get_asDouble() const;
+  int64_t get_asInt64() const;
+/* reads the cell into v, reusing the string storage v already owns */
+  void get(field_value &v) const;
+
+private:
+  friend class row_view;
+  cell_view(const result_set &rs, unsigned int row, unsigned int col)
+    : rs(rs), row(row), col(col) {}
+
+/* the stored value of a record based result, NULL for columnar results */
+  const field_value* stored() const;
+  field_value value() const;
+
+  const result_set &rs;
+  unsigned int row;
+  unsigned int col;
+};
+
+/* A read-only view of one row of a result_set. It copies none of the cells
+   and stays valid, along with the views of other rows, until the result set
+   is refilled or cleared. */
+class row_view
+{
+public:
+  row_view(const result_set &rs, unsigned int row) : rs(&rs), row(row) {}
+
+/* false for a view past the last row of the result */
+  bool valid() const;
+  unsigned int size() const;
+  cell_view at(unsigned int col) const;
+
+private:
+  const result_set *rs;
+  unsigned int row;
+};
+
 class result_set
 {
 public:
@@ -221,10 +331,17 @@ public:
         delete records[i];
     records.clear();
     record_header.clear();
+    columns.clear();
   };
 
+/* number of rows, in whichever storage the backend filled */
+  unsigned int size() const { return records.empty() ? columns.num_rows() : records.size(); }
+/* returns a view of row n, whichever storage the backend filled */
+  row_view row(unsigned int n) const;
+
   record_prop record_header;
   query_data records;
+  result_columns columns;
 };
 
 #ifdef TARGET_WINDOWS_STORE
@@ -154,6 +154,9 @@ const std::map<int, const char*> g_SqliteErrorStrings =
 #endif
 };
 #undef X
+
+// number of idle prepared statements kept per connection
+const size_t MAX_CACHED_STATEMENTS = 64;
 }
 
 namespace dbiplus {
@@ -350,6 +353,7 @@ bool SqliteDatabase::exists(void)
 
 void SqliteDatabase::disconnect(void) {
   if (active == false) return;
+  clear_statement_cache();
   sqlite3_close(conn);
   active = false;
 }
@@ -505,6 +509,56 @@ void SqliteDatabase::rollback_transaction() {
 }
 
 
+// methods for the prepared statement cache
+// ---------------------------------------------
+sqlite3_stmt *SqliteDatabase::acquire_statement(const std::string &sql) {
+  auto it = stmt_index.find(sql);
+  if (it != stmt_index.end()) {
+    sqlite3_stmt *stmt = it->second->second;
+    stmt_lru.erase(it->second);
+    stmt_index.erase(it);
+    return stmt;
+  }
+
+  sqlite3_stmt *stmt = NULL;
+  if (setErr(sqlite3_prepare_v2(conn, sql.c_str(), -1, &stmt, NULL), sql.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", getErrorMsg());
+  return stmt;
+}
+
+void SqliteDatabase::release_statement(const std::string &sql, sqlite3_stmt *stmt) {
+  if (stmt == NULL) return;
+
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+
+  // only statements with placeholders are kept, one-off queries with the values
+  // formatted into the SQL would just push the reusable ones out of the cache.
+  // another copy of the same statement may have been released in the meantime
+  if (!active || sqlite3_bind_parameter_count(stmt) == 0 ||
+      stmt_index.find(sql) != stmt_index.end()) {
+    sqlite3_finalize(stmt);
+    return;
+  }
+
+  stmt_lru.emplace_front(sql, stmt);
+  stmt_index[sql] = stmt_lru.begin();
+
+  if (stmt_lru.size() > MAX_CACHED_STATEMENTS) {
+    sqlite3_finalize(stmt_lru.back().second);
+    stmt_index.erase(stmt_lru.back().first);
+    stmt_lru.pop_back();
+  }
+}
+
+void SqliteDatabase::clear_statement_cache() {
+  for (auto &entry : stmt_lru)
+    sqlite3_finalize(entry.second);
+  stmt_lru.clear();
+  stmt_index.clear();
+}
+
+
 // methods for formatting
 // ---------------------------------------------
 std::string SqliteDatabase::vprepare(const char *format, va_list args)
@@ -671,8 +725,8 @@ void SqliteDataset::make_deletion() {
 
 
 void SqliteDataset::fill_fields() {
-  //cout <<"rr "<<result.records.size()<<"|" << frecno <<"\n";
-  if ((db == NULL) || (result.record_header.empty()) || (result.records.size() < (unsigned int)frecno)) return;
+  //cout <<"rr "<<result.size()<<"|" << frecno <<"\n";
+  if ((db == NULL) || (result.record_header.empty()) || (result.size() < (unsigned int)frecno)) return;
 
   if (fields_object->size() == 0) // Filling columns name
   {
@@ -683,7 +737,7 @@ void SqliteDataset::fill_fields() {
   }
 
   //Filling result
-  if (result.records.size() != 0)
+  if (!result.records.empty())
   {
     const sql_record *row = result.records[frecno];
     if (row)
@@ -695,6 +749,15 @@ void SqliteDataset::fill_fields() {
       return;
     }
   }
+  else if ((unsigned int)frecno < result.columns.num_rows())
+  {
+    // read the cells straight from the columns, reusing the field storage
+    const unsigned int ncols = result.columns.num_columns();
+    fields_object->resize(ncols);
+    for (unsigned int i = 0; i < ncols; i++)
+      result.columns.get(frecno, i, (*fields_object)[i].val);
+    return;
+  }
   const unsigned int ncols = result.record_header.size();
   fields_object->resize(ncols);
   for (unsigned int i = 0; i < ncols; i++)
@@ -702,6 +765,88 @@ void SqliteDataset::fill_fields() {
 }
 
 
+void SqliteDataset::bind(sqlite3_stmt *stmt, const std::string &sql, const BindList &params) {
+  if (static_cast<int>(params.size()) != sqlite3_bind_parameter_count(stmt))
+    throw DbErrors("Wrong number of parameters bound to query: %s", sql.c_str());
+
+  for (unsigned int i = 0; i < params.size(); i++)
+  {
+    const field_value &v = params[i];
+    const int pos = i + 1;
+    int rc;
+    if (v.get_isNull())
+      rc = sqlite3_bind_null(stmt, pos);
+    else
+    {
+      switch (v.get_fType())
+      {
+      case ft_String:
+      case ft_Char:
+      {
+        const std::string str = v.get_asString();
+        rc = sqlite3_bind_text(stmt, pos, str.c_str(), str.size(), SQLITE_TRANSIENT);
+        break;
+      }
+      case ft_Float:
+      case ft_Double:
+        rc = sqlite3_bind_double(stmt, pos, v.get_asDouble());
+        break;
+      default:
+        rc = sqlite3_bind_int64(stmt, pos, v.get_asInt64());
+        break;
+      }
+    }
+    if (db->setErr(rc, sql.c_str()) != SQLITE_OK)
+      throw DbErrors("%s", db->getErrorMsg());
+  }
+}
+
+
+bool SqliteDataset::fetch_rows(sqlite3_stmt *stmt, const std::string &sql, result_set &res) {
+  // column headers
+  const unsigned int numColumns = sqlite3_column_count(stmt);
+  res.record_header.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+    res.record_header[i].name = sqlite3_column_name(stmt, i);
+
+  // returned rows, stored column by column
+  res.columns.reset(numColumns);
+  int rc;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+  { // have a row of data
+    for (unsigned int i = 0; i < numColumns; i++)
+    {
+      switch (sqlite3_column_type(stmt, i))
+      {
+      case SQLITE_INTEGER:
+        res.columns.push_int64(i, sqlite3_column_int64(stmt, i));
+        break;
+      case SQLITE_FLOAT:
+        res.columns.push_double(i, sqlite3_column_double(stmt, i));
+        break;
+      case SQLITE_TEXT:
+      case SQLITE_BLOB:
+      {
+        // fetch the pointer before the size, as the latter may depend on the conversion
+        const char *text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
+        if (text)
+          res.columns.push_string(i, text, sqlite3_column_bytes(stmt, i));
+        else
+          res.columns.push_string(i, "", 0);
+        break;
+      }
+      case SQLITE_NULL:
+      default:
+        res.columns.push_null(i);
+        break;
+      }
+    }
+  }
+
+  return db->setErr(rc == SQLITE_DONE ? SQLITE_OK : rc, sql.c_str()) == SQLITE_OK;
+}
+
+
 //------------- public functions implementation -----------------//
 bool SqliteDataset::dropIndex(const char *table, const char *index)
 {
@@ -778,6 +923,10 @@ const void* SqliteDataset::getExecRes() {
 
 
 bool SqliteDataset::query(const std::string &query) {
+  return query_with_params(query, BindList());
+}
+
+bool SqliteDataset::query_with_params(const std::string &query, const BindList &params) {
     if(!handle()) throw DbErrors("No Database Connection");
     std::string qry = query;
     int fs = qry.find("select");
@@ -787,48 +936,22 @@ bool SqliteDataset::query(const std::string &query) {
 
   close();
 
-  sqlite3_stmt *stmt = NULL;
-  if (db->setErr(sqlite3_prepare_v2(handle(),query.c_str(),-1,&stmt, NULL),query.c_str()) != SQLITE_OK)
-    throw DbErrors("%s", db->getErrorMsg());
-
-  // column headers
-  const unsigned int numColumns = sqlite3_column_count(stmt);
-  result.record_header.resize(numColumns);
-  for (unsigned int i = 0; i < numColumns; i++)
-    result.record_header[i].name = sqlite3_column_name(stmt, i);
-
-  // returned rows
-  while (sqlite3_step(stmt) == SQLITE_ROW)
-  { // have a row of data
-    sql_record *res = new sql_record;
-    res->resize(numColumns);
-    for (unsigned int i = 0; i < numColumns; i++)
-    {
-      field_value &v = res->at(i);
-      switch (sqlite3_column_type(stmt, i))
-      {
-      case SQLITE_INTEGER:
-        v.set_asInt64(sqlite3_column_int64(stmt, i));
-        break;
-      case SQLITE_FLOAT:
-        v.set_asDouble(sqlite3_column_double(stmt, i));
-        break;
-      case SQLITE_TEXT:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_BLOB:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_NULL:
-      default:
-        v.set_asString("");
-        v.set_isNull();
-        break;
-      }
-    }
-    result.records.push_back(res);
+  SqliteDatabase *sqlite = static_cast<SqliteDatabase*>(db);
+  sqlite3_stmt *stmt = sqlite->acquire_statement(query);
+  bool ok;
+  try
+  {
+    bind(stmt, query, params);
+    ok = fetch_rows(stmt, query, result);
+  }
+  catch (...)
+  {
+    sqlite->release_statement(query, stmt);
+    throw;
   }
-  if (db->setErr(sqlite3_finalize(stmt),query.c_str()) == SQLITE_OK)
+  sqlite->release_statement(query, stmt);
+
+  if (ok)
   {
     active = true;
     ds_state = dsSelect;
@@ -841,6 +964,30 @@ bool SqliteDataset::query(const std::string &query) {
   }
 }
 
+int SqliteDataset::exec_with_params(const std::string &sql, const BindList &params) {
+  if (!handle()) throw DbErrors("No Database Connection");
+  exec_res.clear();
+
+  SqliteDatabase *sqlite = static_cast<SqliteDatabase*>(db);
+  sqlite3_stmt *stmt = sqlite->acquire_statement(sql);
+  bool ok;
+  try
+  {
+    bind(stmt, sql, params);
+    ok = fetch_rows(stmt, sql, exec_res);
+  }
+  catch (...)
+  {
+    sqlite->release_statement(sql, stmt);
+    throw;
+  }
+  sqlite->release_statement(sql, stmt);
+
+  if (!ok)
+    throw DbErrors("%s", db->getErrorMsg());
+  return SQLITE_OK;
+}
+
 void SqliteDataset::open(const std::string &sql) {
   set_select_sql(sql);
   open();
@@ -877,7 +1024,7 @@ void SqliteDataset::cancel() {
 
 
 int SqliteDataset::num_rows() {
-  return result.records.size();
+  return result.size();
 }
 
 
@@ -914,7 +1061,16 @@ void SqliteDataset::next(void) {
 
 void SqliteDataset::free_row(void)
 {
-  if (frecno < 0 || (unsigned int)frecno >= result.records.size())
+  if (frecno < 0)
+    return;
+
+  if (result.records.empty())
+  {
+    result.columns.free_row(frecno);
+    return;
+  }
+
+  if ((unsigned int)frecno >= result.records.size())
     return;
 
   sql_record *row = result.records[frecno];
@@ -14,7 +14,10 @@
 
 #include "dataset.h"
 
+#include <list>
 #include <stdio.h>
+#include <unordered_map>
+#include <utility>
 
 #include <sqlite3.h>
 
@@ -82,6 +85,21 @@ public:
 
   bool in_transaction() override {return _in_transaction;};
 
+/* prepared statement cache, keyed by SQL text */
+
+/* returns a reset statement for sql, compiling it only when no idle one is cached */
+  sqlite3_stmt *acquire_statement(const std::string &sql);
+/* hands a statement obtained by acquire_statement back, it is only cached when it has placeholders */
+  void release_statement(const std::string &sql, sqlite3_stmt *stmt);
+/* finalizes all idle cached statements */
+  void clear_statement_cache();
+/* number of idle cached statements */
+  size_t cached_statements() const { return stmt_lru.size(); }
+
+private:
+  typedef std::list<std::pair<std::string, sqlite3_stmt*> > StatementList;
+  StatementList stmt_lru; // idle statements, most recently used first
+  std::unordered_map<std::string, StatementList::iterator> stmt_index;
 };
 
 
@@ -112,6 +130,10 @@ protected:
   void fill_fields() override;
 /* Changing field values during dataset navigation */
   virtual void free_row();  // free the memory allocated for the current row
+/* Binds params to the placeholders of stmt */
+  void bind(sqlite3_stmt *stmt, const std::string &sql, const BindList &params);
+/* Steps through stmt, reading the rows into res */
+  bool fetch_rows(sqlite3_stmt *stmt, const std::string &sql, result_set &res);
 
 public:
 /* constructor */
@@ -134,6 +156,8 @@ or insert() operations default = false) */
   const void* getExecRes() override;
 /* as open, but with our query exec Sql */
   bool query(const std::string &query) override;
+  bool query_with_params(const std::string &query, const BindList &params) override;
+  int exec_with_params(const std::string &sql, const BindList &params) override;
 /* func. closes a query */
   void close(void) override;
 /* Cancel changes, made in insert or edit states of dataset */
@@ -0,0 +1,38 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/Database.h"
+
+#include <gtest/gtest.h>
+
+TEST(TestDatabase, FullTextQuery)
+{
+  EXPECT_EQ("\"news\"*", CDatabase::GetFullTextQuery("news"));
+  EXPECT_EQ("\"the late show\"*", CDatabase::GetFullTextQuery("the late show"));
+  EXPECT_EQ("\"café\"*", CDatabase::GetFullTextQuery("café"));
+  EXPECT_EQ("{strTitle strPlot} : \"news\"*", CDatabase::GetFullTextQuery("news", {"strTitle", "strPlot"}));
+  EXPECT_EQ("{strTitle} : ^ \"the m\"*", CDatabase::GetFullTextQuery("the m", {"strTitle"}, true));
+}
+
+TEST(TestDatabase, FullTextQueryQuoting)
+{
+  // the search is a single phrase, FTS5 syntax in it is just text
+  EXPECT_EQ("\"say \"\"hi\"\"\"*", CDatabase::GetFullTextQuery("say \"hi\""));
+  EXPECT_EQ("\"a OR b NOT c\"*", CDatabase::GetFullTextQuery("a OR b NOT c"));
+  EXPECT_EQ("\"it's 50%\"*", CDatabase::GetFullTextQuery("it's 50%"));
+  EXPECT_EQ("\"x {y} : ^z\"*", CDatabase::GetFullTextQuery("x {y} : ^z"));
+}
+
+TEST(TestDatabase, FullTextQueryWithoutWords)
+{
+  // punctuation isn't indexed, so there is nothing to match
+  EXPECT_EQ("", CDatabase::GetFullTextQuery(""));
+  EXPECT_EQ("", CDatabase::GetFullTextQuery("  "));
+  EXPECT_EQ("", CDatabase::GetFullTextQuery("--"));
+  EXPECT_EQ("", CDatabase::GetFullTextQuery("\"*\"", {"strTitle"}));
+}
@@ -0,0 +1,288 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/qry_dat.h"
+#include "dbwrappers/sqlitedataset.h"
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+#include "utils/URIUtils.h"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace dbiplus;
+
+namespace
+{
+void FillColumns(result_set& res)
+{
+  res.record_header.resize(3);
+  res.columns.reset(3);
+
+  res.columns.push_int64(0, 1);
+  res.columns.push_string(1, "first", 5);
+  res.columns.push_double(2, 1.5);
+
+  res.columns.push_int64(0, 2);
+  res.columns.push_null(1);
+  res.columns.push_null(2);
+
+  res.columns.push_int64(0, 3);
+  res.columns.push_string(1, "42", 2);
+  res.columns.push_double(2, 3.25);
+}
+}
+
+TEST(TestResultSet, RowViews)
+{
+  result_set res;
+  FillColumns(res);
+  ASSERT_EQ(3u, res.size());
+
+  // views of several rows are usable side by side
+  const row_view first = res.row(0);
+  const row_view second = res.row(1);
+  const row_view third = res.row(2);
+  EXPECT_EQ(3u, first.size());
+
+  EXPECT_EQ(1, first.at(0).get_asInt());
+  EXPECT_EQ("first", first.at(1).get_asString());
+  EXPECT_DOUBLE_EQ(1.5, first.at(2).get_asDouble());
+  EXPECT_EQ(3, third.at(0).get_asInt());
+  EXPECT_EQ(42, third.at(1).get_asInt());
+  EXPECT_FLOAT_EQ(3.25f, third.at(2).get_asFloat());
+  EXPECT_EQ("first", first.at(1).get_asString());
+
+  EXPECT_FALSE(second.at(0).get_isNull());
+  EXPECT_TRUE(second.at(1).get_isNull());
+  EXPECT_EQ("", second.at(1).get_asString());
+  EXPECT_TRUE(second.at(2).get_isNull());
+  EXPECT_EQ(0, second.at(2).get_asInt());
+
+  EXPECT_THROW(res.row(3), std::out_of_range);
+  EXPECT_THROW(first.at(3), std::out_of_range);
+}
+
+TEST(TestResultSet, GetReusesFieldValue)
+{
+  result_set res;
+  FillColumns(res);
+
+  field_value value;
+  res.row(0).at(1).get(value);
+  EXPECT_EQ(ft_String, value.get_fType());
+  EXPECT_EQ("first", value.get_asString());
+  res.row(1).at(1).get(value);
+  EXPECT_TRUE(value.get_isNull());
+  res.row(2).at(0).get(value);
+  EXPECT_FALSE(value.get_isNull());
+  EXPECT_EQ(ft_Int64, value.get_fType());
+  EXPECT_EQ(3, value.get_asInt64());
+}
+
+TEST(TestResultSet, FreeRows)
+{
+  result_set res;
+  FillColumns(res);
+
+  res.columns.free_row(0);
+  EXPECT_TRUE(res.row(0).at(1).get_isNull());
+  EXPECT_EQ("42", res.row(2).at(1).get_asString());
+
+  res.columns.free_row(1);
+  res.columns.free_row(1);
+  res.columns.free_row(2);
+  // the row count survives releasing the values
+  ASSERT_EQ(3u, res.size());
+  for (unsigned int row = 0; row < res.size(); row++)
+  {
+    for (unsigned int col = 0; col < 3; col++)
+      EXPECT_TRUE(res.row(row).at(col).get_isNull());
+  }
+}
+
+class TestSqliteDataset : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_file = XBMC_CREATETEMPFILE(".db");
+    ASSERT_NE(nullptr, m_file);
+    const std::string path = XBMC_TEMPFILEPATH(m_file);
+    m_db.setHostName(URIUtils::GetDirectory(path).c_str());
+    m_db.setDatabase(URIUtils::GetFileName(path).c_str());
+    ASSERT_EQ(DB_CONNECTION_OK, m_db.connect(false));
+
+    m_ds.reset(m_db.CreateDataset());
+    m_ds->exec("CREATE TABLE item (id INTEGER PRIMARY KEY, name TEXT, rating REAL)");
+    m_ds->exec("INSERT INTO item VALUES (1, 'one', 1.5)");
+    m_ds->exec("INSERT INTO item VALUES (2, NULL, NULL)");
+    m_ds->exec("INSERT INTO item VALUES (3, 'three', 3.5)");
+    m_ds->exec("INSERT INTO item VALUES (4, 'four', NULL)");
+  }
+
+  void TearDown() override
+  {
+    m_ds.reset();
+    m_db.disconnect();
+    XBMC_DELETETEMPFILE(m_file);
+  }
+
+  XFILE::CFile* m_file = nullptr;
+  SqliteDatabase m_db;
+  std::unique_ptr<Dataset> m_ds;
+};
+
+TEST_F(TestSqliteDataset, IterateRows)
+{
+  ASSERT_TRUE(m_ds->query("SELECT id, name, rating FROM item ORDER BY id"));
+  ASSERT_EQ(4, m_ds->num_rows());
+
+  int id = 0;
+  while (!m_ds->eof())
+  {
+    id++;
+    EXPECT_EQ(id, m_ds->fv(0).get_asInt());
+    EXPECT_EQ(id, m_ds->get_row().at(0).get_asInt());
+    EXPECT_EQ(id == 2, m_ds->fv(1).get_isNull());
+    EXPECT_EQ(id == 2, m_ds->get_row().at(1).get_isNull());
+    EXPECT_EQ(id == 2 || id == 4, m_ds->get_row().at(2).get_isNull());
+    m_ds->next();
+  }
+  EXPECT_EQ(4, id);
+}
+
+TEST_F(TestSqliteDataset, Seek)
+{
+  ASSERT_TRUE(m_ds->query("SELECT id, name FROM item ORDER BY id"));
+
+  const row_view first = m_ds->get_row();
+  m_ds->seek(2);
+  EXPECT_EQ(3, m_ds->fv(0).get_asInt());
+  EXPECT_EQ("three", m_ds->fv(1).get_asString());
+  const row_view third = m_ds->get_row();
+  EXPECT_EQ("three", third.at(1).get_asString());
+
+  m_ds->seek(1);
+  EXPECT_EQ(2, m_ds->fv(0).get_asInt());
+  EXPECT_TRUE(m_ds->fv(1).get_isNull());
+
+  // moving the dataset doesn't affect the views taken before
+  EXPECT_EQ("one", first.at(1).get_asString());
+  EXPECT_EQ(3, third.at(0).get_asInt());
+
+  // seeking past the end stops at the last row
+  m_ds->seek(10);
+  EXPECT_EQ(4, m_ds->fv(0).get_asInt());
+  EXPECT_TRUE(m_ds->get_row().valid());
+}
+
+TEST_F(TestSqliteDataset, EmptyResult)
+{
+  ASSERT_TRUE(m_ds->query("SELECT id FROM item WHERE id > 10"));
+  EXPECT_EQ(0, m_ds->num_rows());
+  EXPECT_TRUE(m_ds->eof());
+  EXPECT_FALSE(m_ds->get_row().valid());
+}
+
+TEST_F(TestSqliteDataset, BindTypes)
+{
+  BindList params;
+  params.emplace_back(static_cast<int>(-7));
+  params.emplace_back(static_cast<int64_t>(1) << 40);
+  params.emplace_back(2.5);
+  params.emplace_back(true);
+  params.emplace_back("it's 100%");
+  ASSERT_TRUE(m_ds->query_with_params("SELECT ?, ?, ?, ?, ?", params));
+  ASSERT_EQ(1, m_ds->num_rows());
+
+  EXPECT_EQ(ft_Int64, m_ds->fv(0).get_fType());
+  EXPECT_EQ(-7, m_ds->fv(0).get_asInt());
+  EXPECT_EQ(static_cast<int64_t>(1) << 40, m_ds->fv(1).get_asInt64());
+  EXPECT_EQ(ft_Double, m_ds->fv(2).get_fType());
+  EXPECT_DOUBLE_EQ(2.5, m_ds->fv(2).get_asDouble());
+  EXPECT_EQ(1, m_ds->fv(3).get_asInt());
+  EXPECT_EQ(ft_String, m_ds->fv(4).get_fType());
+  EXPECT_EQ("it's 100%", m_ds->fv(4).get_asString());
+
+  // a missing value is an error rather than a NULL
+  params.pop_back();
+  EXPECT_THROW(m_ds->query_with_params("SELECT ?, ?, ?, ?, ?", params), DbErrors);
+}
+
+TEST_F(TestSqliteDataset, BindNull)
+{
+  field_value null;
+  null.set_isNull();
+
+  m_ds->exec_with_params("INSERT INTO item VALUES (?, ?, ?)", {field_value(5), null, null});
+  ASSERT_TRUE(m_ds->query_with_params("SELECT name, rating FROM item WHERE id = ?", {field_value(5)}));
+  ASSERT_EQ(1, m_ds->num_rows());
+  EXPECT_TRUE(m_ds->fv(0).get_isNull());
+  EXPECT_TRUE(m_ds->fv(1).get_isNull());
+
+  // NULL never equals a bound NULL
+  ASSERT_TRUE(m_ds->query_with_params("SELECT id FROM item WHERE name = ?", {null}));
+  EXPECT_EQ(0, m_ds->num_rows());
+  ASSERT_TRUE(m_ds->query_with_params("SELECT id FROM item WHERE name IS ?", {null}));
+  EXPECT_EQ(2, m_ds->num_rows());
+}
+
+TEST_F(TestSqliteDataset, BindAsLiterals)
+{
+  field_value null;
+  null.set_isNull();
+  const BindList params = {field_value(3), field_value("it's"), null, field_value(0.5)};
+
+  // question marks in string literals aren't placeholders
+  EXPECT_EQ("SELECT 3, 'it''s', NULL, 0.5 WHERE '?' = '?'",
+            m_db.bind_params("SELECT ?, ?, ?, ? WHERE '?' = '?'", params));
+  EXPECT_THROW(m_db.bind_params("SELECT ?, ?, ?, ?, ?", params), DbErrors);
+}
+
+TEST_F(TestSqliteDataset, StatementCache)
+{
+  m_db.clear_statement_cache();
+
+  // statements without placeholders aren't kept
+  ASSERT_TRUE(m_ds->query("SELECT id FROM item WHERE id = 1"));
+  EXPECT_EQ(0u, m_db.cached_statements());
+
+  const std::string sql = "SELECT name FROM item WHERE id = ?";
+  ASSERT_TRUE(m_ds->query_with_params(sql, {field_value(1)}));
+  EXPECT_EQ(1u, m_db.cached_statements());
+  EXPECT_EQ("one", m_ds->fv(0).get_asString());
+
+  // the cached statement is reused with the new value
+  ASSERT_TRUE(m_ds->query_with_params(sql, {field_value(3)}));
+  EXPECT_EQ(1u, m_db.cached_statements());
+  EXPECT_EQ("three", m_ds->fv(0).get_asString());
+
+  sqlite3_stmt* stmt = m_db.acquire_statement(sql);
+  EXPECT_EQ(0u, m_db.cached_statements());
+  m_db.release_statement(sql, stmt);
+  EXPECT_EQ(stmt, m_db.acquire_statement(sql));
+  m_db.release_statement(sql, stmt);
+
+  // the least recently used statements are finalized once the cache is full
+  for (int i = 0; i < 100; i++)
+  {
+    const std::string other = "SELECT name FROM item WHERE id = ? AND " + std::to_string(i) + " = " +
+                              std::to_string(i);
+    ASSERT_TRUE(m_ds->query_with_params(other, {field_value(i)}));
+  }
+  const size_t cached = m_db.cached_statements();
+  EXPECT_EQ(64u, cached);
+
+  // sql was evicted, so acquiring it compiles a new statement and leaves the cache as it was
+  stmt = m_db.acquire_statement(sql);
+  EXPECT_EQ(cached, m_db.cached_statements());
+  m_db.release_statement(sql, stmt);
+}
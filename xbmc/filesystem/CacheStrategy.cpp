@@ -393,3 +393,160 @@ CCacheStrategy *CDoubleCache::CreateNew()
   return new CDoubleCache(m_pCache->CreateNew());
 }
 
+
+CMultiSegmentCache::CMultiSegmentCache(CCacheStrategy *impl, unsigned int maxSegments)
+  : m_maxSegments(std::max(maxSegments, 1u))
+{
+  assert(NULL != impl);
+  m_segments.emplace_back(impl);
+}
+
+CMultiSegmentCache::~CMultiSegmentCache() = default;
+
+int CMultiSegmentCache::Open()
+{
+  return m_segments.front()->Open();
+}
+
+void CMultiSegmentCache::Close()
+{
+  m_segments.front()->Close();
+  m_segments.resize(1);
+}
+
+size_t CMultiSegmentCache::GetMaxWriteSize(const size_t& iRequestSize)
+{
+  return m_segments.front()->GetMaxWriteSize(iRequestSize);
+}
+
+int CMultiSegmentCache::WriteToCache(const char *pBuffer, size_t iSize)
+{
+  return m_segments.front()->WriteToCache(pBuffer, iSize);
+}
+
+int CMultiSegmentCache::ReadFromCache(char *pBuffer, size_t iMaxSize)
+{
+  const int iRead = m_segments.front()->ReadFromCache(pBuffer, iMaxSize);
+  if (iRead > 0)
+    m_space.Set();
+  return iRead;
+}
+
+int64_t CMultiSegmentCache::WaitForData(unsigned int iMinAvail, unsigned int iMillis)
+{
+  return m_segments.front()->WaitForData(iMinAvail, iMillis);
+}
+
+int64_t CMultiSegmentCache::Seek(int64_t iFilePosition)
+{
+  // let a seek event switch segments rather than waiting for data in the active one
+  if (!m_segments.front()->IsCachedPosition(iFilePosition) && IsCachedPosition(iFilePosition))
+    return CACHE_RC_ERROR;
+
+  return m_segments.front()->Seek(iFilePosition);
+}
+
+bool CMultiSegmentCache::Reset(int64_t iSourcePosition, bool clearAnyway)
+{
+  if (clearAnyway)
+    return m_segments.front()->Reset(iSourcePosition, clearAnyway);
+
+  // continue in the segment holding the most data from the requested position on,
+  // this has to match CachedDataEndPosIfSeekTo()
+  size_t best = m_segments.size();
+  int64_t bestEnd = -1;
+  for (size_t i = 0; i < m_segments.size(); i++)
+  {
+    if (!m_segments[i]->IsCachedPosition(iSourcePosition))
+      continue;
+    const int64_t end = m_segments[i]->CachedDataEndPosIfSeekTo(iSourcePosition);
+    if (end > bestEnd)
+    {
+      best = i;
+      bestEnd = end;
+    }
+  }
+
+  if (best < m_segments.size())
+  {
+    Activate(best);
+    return m_segments.front()->Reset(iSourcePosition, false);
+  }
+
+  if (m_segments.size() < m_maxSegments)
+  {
+    std::unique_ptr<CCacheStrategy> segment(m_segments.front()->CreateNew());
+    if (segment->Open() == CACHE_RC_OK)
+    {
+      m_segments.insert(m_segments.begin(), std::move(segment));
+      return m_segments.front()->Reset(iSourcePosition, true);
+    }
+    CLog::Log(LOGWARNING, "CMultiSegmentCache::Reset - failed to open new segment, recycling an existing one");
+  }
+
+  Activate(Recycle());
+  return m_segments.front()->Reset(iSourcePosition, true);
+}
+
+void CMultiSegmentCache::Activate(size_t index)
+{
+  if (index == 0)
+    return;
+
+  std::rotate(m_segments.begin(), m_segments.begin() + index, m_segments.begin() + index + 1);
+  m_segments.front()->ClearEndOfInput();
+}
+
+size_t CMultiSegmentCache::Recycle() const
+{
+  // least recently used segment first, but keep the head of the file as long as possible
+  for (size_t i = m_segments.size() - 1; i > 0; i--)
+  {
+    if (!m_segments[i]->IsCachedPosition(0))
+      return i;
+  }
+  return m_segments.size() - 1;
+}
+
+void CMultiSegmentCache::EndOfInput()
+{
+  m_segments.front()->EndOfInput();
+}
+
+bool CMultiSegmentCache::IsEndOfInput()
+{
+  return m_segments.front()->IsEndOfInput();
+}
+
+void CMultiSegmentCache::ClearEndOfInput()
+{
+  m_segments.front()->ClearEndOfInput();
+}
+
+int64_t CMultiSegmentCache::CachedDataEndPos()
+{
+  return m_segments.front()->CachedDataEndPos();
+}
+
+int64_t CMultiSegmentCache::CachedDataEndPosIfSeekTo(int64_t iFilePosition)
+{
+  int64_t ret = iFilePosition;
+  for (const auto& segment : m_segments)
+    ret = std::max(ret, segment->CachedDataEndPosIfSeekTo(iFilePosition));
+  return ret;
+}
+
+bool CMultiSegmentCache::IsCachedPosition(int64_t iFilePosition)
+{
+  for (const auto& segment : m_segments)
+  {
+    if (segment->IsCachedPosition(iFilePosition))
+      return true;
+  }
+  return false;
+}
+
+CCacheStrategy *CMultiSegmentCache::CreateNew()
+{
+  return new CMultiSegmentCache(m_segments.front()->CreateNew(), m_maxSegments);
+}
@@ -10,8 +10,10 @@
 
 #include "threads/Event.h"
 
+#include <memory>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace XFILE {
 
@@ -127,5 +129,48 @@ protected:
   CCacheStrategy *m_pCacheOld;
 };
 
+/*!
+ \brief Cache strategy keeping several independently filled segments of the same source.
+
+ Generalizes CDoubleCache: a seek outside the active segment switches to another segment
+ that already holds the target position, or restarts the least recently used one there.
+ This keeps e.g. the file header, the index at the end of an MKV/MP4 file and the current
+ playback window in memory at the same time. A segment holding the start of the file is only
+ recycled when there is no other choice.
+ */
+class CMultiSegmentCache : public CCacheStrategy
+{
+public:
+  CMultiSegmentCache(CCacheStrategy *impl, unsigned int maxSegments);
+  ~CMultiSegmentCache() override;
+
+  int Open() override;
+  void Close() override;
+
+  size_t GetMaxWriteSize(const size_t& iRequestSize) override;
+  int WriteToCache(const char *pBuffer, size_t iSize) override;
+  int ReadFromCache(char *pBuffer, size_t iMaxSize) override;
+  int64_t WaitForData(unsigned int iMinAvail, unsigned int iMillis) override;
+
+  int64_t Seek(int64_t iFilePosition) override;
+  bool Reset(int64_t iSourcePosition, bool clearAnyway=true) override;
+  void EndOfInput() override;
+  bool IsEndOfInput() override;
+  void ClearEndOfInput() override;
+
+  int64_t CachedDataEndPosIfSeekTo(int64_t iFilePosition) override;
+  int64_t CachedDataEndPos() override;
+  bool IsCachedPosition(int64_t iFilePosition) override;
+
+  CCacheStrategy *CreateNew() override;
+
+protected:
+  void Activate(size_t index);
+  size_t Recycle() const;
+
+  std::vector<std::unique_ptr<CCacheStrategy>> m_segments; ///< most recently used first, front is the active segment
+  unsigned int m_maxSegments;
+};
+
 }
 
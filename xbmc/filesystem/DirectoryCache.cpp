@@ -17,10 +17,12 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <climits>
+#include <functional>
 
-// Maximum number of directories to keep in our cache
-#define MAX_CACHED_DIRS 50
+// Default maximum number of items to keep in our cache, each cached directory counts as one item too
+#define MAX_CACHED_ITEMS 10000
 
 using namespace XFILE;
 
@@ -38,7 +40,7 @@ CDirectoryCache::CDir::~CDir()
   delete m_Items;
 }
 
-void CDirectoryCache::CDir::SetLastAccess(unsigned int &accessCounter)
+void CDirectoryCache::CDir::SetLastAccess(std::atomic<unsigned int> &accessCounter)
 {
   m_lastAccess = accessCounter++;
 }
@@ -46,37 +48,46 @@ void CDirectoryCache::CDir::SetLastAccess(unsigned int &accessCounter)
 CDirectoryCache::CDirectoryCache(void)
 {
   m_accessCounter = 0;
-#ifdef _DEBUG
+  m_items = 0;
+  m_maxItems = MAX_CACHED_ITEMS;
   m_cacheHits = 0;
   m_cacheMisses = 0;
-#endif
+  m_cacheEvictions = 0;
+}
+
+CDirectoryCache::~CDirectoryCache(void)
+{
+  Clear();
 }
 
-CDirectoryCache::~CDirectoryCache(void) = default;
+CDirectoryCache::CShard& CDirectoryCache::GetShard(const std::string& storedPath)
+{
+  return m_shards[std::hash<std::string>()(storedPath) % NUM_SHARDS];
+}
 
 bool CDirectoryCache::GetDirectory(const std::string& strPath, CFileItemList &items, bool retrieveAll)
 {
-  CSingleLock lock (m_cs);
-
   // Get rid of any URL options, else the compare may be wrong
   std::string storedPath = CURL(strPath).GetWithoutOptions();
   URIUtils::RemoveSlashAtEnd(storedPath);
 
-  ciCache i = m_cache.find(storedPath);
-  if (i != m_cache.end())
+  CShard& shard = GetShard(storedPath);
+  CSingleLock lock (shard.m_cs);
+
+  iCache i = shard.m_cache.find(storedPath);
+  if (i != shard.m_cache.end())
   {
-    CDir* dir = i->second;
+    CDir* dir = i->second.dir;
     if (dir->m_cacheType == XFILE::DIR_CACHE_ALWAYS ||
        (dir->m_cacheType == XFILE::DIR_CACHE_ONCE && retrieveAll))
     {
       items.Copy(*dir->m_Items);
-      dir->SetLastAccess(m_accessCounter);
-#ifdef _DEBUG
-      m_cacheHits+=items.Size();
-#endif
+      Touch(shard, i->second);
+      m_cacheHits++;
       return true;
     }
   }
+  m_cacheMisses++;
   return false;
 }
 
@@ -96,20 +107,37 @@ void CDirectoryCache::SetDirectory(const std::string& strPath, const CFileItemLi
   // IDEALLY, any further processing on the item would actually create a new item
   // instead of altering it, but we can't really enforce that in an easy way, so
   // this is the best solution for now.
-  CSingleLock lock (m_cs);
 
   // Get rid of any URL options, else the compare may be wrong
   std::string storedPath = CURL(strPath).GetWithoutOptions();
   URIUtils::RemoveSlashAtEnd(storedPath);
 
-  ClearDirectory(storedPath);
+  {
+    CShard& shard = GetShard(storedPath);
+    CSingleLock lock (shard.m_cs);
 
-  CheckIfFull();
+    iCache i = shard.m_cache.find(storedPath);
+    if (i != shard.m_cache.end())
+      Delete(shard, i);
+
+    CDir* dir = new CDir(cacheType);
+    dir->m_Items->Copy(items);
+    dir->SetLastAccess(m_accessCounter);
 
-  CDir* dir = new CDir(cacheType);
-  dir->m_Items->Copy(items);
-  dir->SetLastAccess(m_accessCounter);
-  m_cache.insert(std::pair<std::string, CDir*>(storedPath, dir));
+    CacheEntry entry;
+    entry.dir = dir;
+    entry.lru = shard.m_lru.end();
+    // ensure dirs that are always cached aren't cleared
+    if (cacheType != DIR_CACHE_ALWAYS)
+    {
+      shard.m_lru.push_front(storedPath);
+      entry.lru = shard.m_lru.begin();
+      m_items += dir->m_Items->Size() + 1;
+    }
+    shard.m_cache.insert(std::make_pair(storedPath, entry));
+  }
+
+  CheckIfFull();
 }
 
 void CDirectoryCache::ClearFile(const std::string& strFile)
@@ -122,55 +150,65 @@ void CDirectoryCache::ClearFile(const std::string& strFile)
 
 void CDirectoryCache::ClearDirectory(const std::string& strPath)
 {
-  CSingleLock lock (m_cs);
-
   // Get rid of any URL options, else the compare may be wrong
   std::string storedPath = CURL(strPath).GetWithoutOptions();
   URIUtils::RemoveSlashAtEnd(storedPath);
 
-  iCache i = m_cache.find(storedPath);
-  if (i != m_cache.end())
-    Delete(i);
+  CShard& shard = GetShard(storedPath);
+  CSingleLock lock (shard.m_cs);
+
+  iCache i = shard.m_cache.find(storedPath);
+  if (i != shard.m_cache.end())
+    Delete(shard, i);
 }
 
 void CDirectoryCache::ClearSubPaths(const std::string& strPath)
 {
-  CSingleLock lock (m_cs);
-
   // Get rid of any URL options, else the compare may be wrong
   std::string storedPath = CURL(strPath).GetWithoutOptions();
 
-  iCache i = m_cache.begin();
-  while (i != m_cache.end())
+  for (CShard& shard : m_shards)
   {
-    if (URIUtils::PathHasParent(i->first, storedPath))
-      Delete(i++);
-    else
-      i++;
+    CSingleLock lock (shard.m_cs);
+
+    iCache i = shard.m_cache.begin();
+    while (i != shard.m_cache.end())
+    {
+      if (URIUtils::PathHasParent(i->first, storedPath))
+        Delete(shard, i++);
+      else
+        i++;
+    }
   }
 }
 
 void CDirectoryCache::AddFile(const std::string& strFile)
 {
-  CSingleLock lock (m_cs);
-
   // Get rid of any URL options, else the compare may be wrong
   std::string strPath = URIUtils::GetDirectory(CURL(strFile).GetWithoutOptions());
   URIUtils::RemoveSlashAtEnd(strPath);
 
-  ciCache i = m_cache.find(strPath);
-  if (i != m_cache.end())
   {
-    CDir *dir = i->second;
+    CShard& shard = GetShard(strPath);
+    CSingleLock lock (shard.m_cs);
+
+    iCache i = shard.m_cache.find(strPath);
+    if (i == shard.m_cache.end())
+      return;
+
+    CDir *dir = i->second.dir;
     CFileItemPtr item(new CFileItem(strFile, false));
     dir->m_Items->Add(item);
-    dir->SetLastAccess(m_accessCounter);
+    if (dir->m_cacheType != DIR_CACHE_ALWAYS)
+      m_items++;
+    Touch(shard, i->second);
   }
+
+  CheckIfFull();
 }
 
 bool CDirectoryCache::FileExists(const std::string& strFile, bool& bInCache)
 {
-  CSingleLock lock (m_cs);
   bInCache = false;
 
   // Get rid of any URL options, else the compare may be wrong
@@ -179,31 +217,33 @@ bool CDirectoryCache::FileExists(const std::string& strFile, bool& bInCache)
   std::string storedPath = URIUtils::GetDirectory(strPath);
   URIUtils::RemoveSlashAtEnd(storedPath);
 
-  ciCache i = m_cache.find(storedPath);
-  if (i != m_cache.end())
+  CShard& shard = GetShard(storedPath);
+  CSingleLock lock (shard.m_cs);
+
+  iCache i = shard.m_cache.find(storedPath);
+  if (i != shard.m_cache.end())
   {
     bInCache = true;
-    CDir *dir = i->second;
-    dir->SetLastAccess(m_accessCounter);
-#ifdef _DEBUG
+    CDir *dir = i->second.dir;
+    Touch(shard, i->second);
     m_cacheHits++;
-#endif
     return (URIUtils::PathEquals(strPath, storedPath) || dir->m_Items->Contains(strFile));
   }
-#ifdef _DEBUG
   m_cacheMisses++;
-#endif
   return false;
 }
 
 void CDirectoryCache::Clear()
 {
   // this routine clears everything
-  CSingleLock lock (m_cs);
+  for (CShard& shard : m_shards)
+  {
+    CSingleLock lock (shard.m_cs);
 
-  iCache i = m_cache.begin();
-  while (i != m_cache.end() )
-    Delete(i++);
+    iCache i = shard.m_cache.begin();
+    while (i != shard.m_cache.end() )
+      Delete(shard, i++);
+  }
 }
 
 void CDirectoryCache::InitCache(std::set<std::string>& dirs)
@@ -218,60 +258,123 @@ void CDirectoryCache::InitCache(std::set<std::string>& dirs)
 
 void CDirectoryCache::ClearCache(std::set<std::string>& dirs)
 {
-  iCache i = m_cache.begin();
-  while (i != m_cache.end())
+  for (CShard& shard : m_shards)
   {
-    if (dirs.find(i->first) != dirs.end())
-      Delete(i++);
-    else
-      i++;
+    CSingleLock lock (shard.m_cs);
+
+    iCache i = shard.m_cache.begin();
+    while (i != shard.m_cache.end())
+    {
+      if (dirs.find(i->first) != dirs.end())
+        Delete(shard, i++);
+      else
+        i++;
+    }
   }
 }
 
+void CDirectoryCache::SetMaxItems(unsigned int maxItems)
+{
+  m_maxItems = maxItems;
+  CheckIfFull();
+}
+
 void CDirectoryCache::CheckIfFull()
 {
-  CSingleLock lock (m_cs);
+  // only one thread evicts at a time, it takes the shard locks one after the other
+  CSingleLock evictionLock(m_evictionSection);
 
-  // find the last accessed folder, and remove if the number of cached folders is too many
-  iCache lastAccessed = m_cache.end();
-  unsigned int numCached = 0;
-  for (iCache i = m_cache.begin(); i != m_cache.end(); i++)
+  // remove the least recently used folders of all shards until the cache is within its budget,
+  // but always keep the most recent one, even if it is too big on its own
+  while (m_items > m_maxItems)
   {
-    // ensure dirs that are always cached aren't cleared
-    if (i->second->m_cacheType != DIR_CACHE_ALWAYS)
+    CShard* oldest = nullptr;
+    unsigned int oldestAccess = 0;
+    size_t evictable = 0;
+    for (CShard& shard : m_shards)
     {
-      if (lastAccessed == m_cache.end() || i->second->GetLastAccess() < lastAccessed->second->GetLastAccess())
-        lastAccessed = i;
-      numCached++;
+      CSingleLock lock (shard.m_cs);
+      if (shard.m_lru.empty())
+        continue;
+
+      evictable += shard.m_lru.size();
+      unsigned int access = shard.m_cache.find(shard.m_lru.back())->second.dir->GetLastAccess();
+      if (!oldest || access < oldestAccess)
+      {
+        oldest = &shard;
+        oldestAccess = access;
+      }
     }
+    if (!oldest || evictable <= 1)
+      break;
+
+    CSingleLock lock (oldest->m_cs);
+    if (oldest->m_lru.empty())
+      continue;
+
+    // the dir was used since the scan, look again
+    iCache lastAccessed = oldest->m_cache.find(oldest->m_lru.back());
+    if (lastAccessed->second.dir->GetLastAccess() != oldestAccess)
+      continue;
+
+    Delete(*oldest, lastAccessed);
+    m_cacheEvictions++;
   }
-  if (lastAccessed != m_cache.end() && numCached >= MAX_CACHED_DIRS)
-    Delete(lastAccessed);
 }
 
-void CDirectoryCache::Delete(iCache it)
+void CDirectoryCache::Touch(CShard& shard, CacheEntry& entry)
+{
+  entry.dir->SetLastAccess(m_accessCounter);
+  if (entry.lru != shard.m_lru.end())
+    shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, entry.lru);
+}
+
+void CDirectoryCache::Delete(CShard& shard, iCache it)
 {
-  CDir* dir = it->second;
+  CDir* dir = it->second.dir;
+  if (it->second.lru != shard.m_lru.end())
+  {
+    m_items -= dir->m_Items->Size() + 1;
+    shard.m_lru.erase(it->second.lru);
+  }
   delete dir;
-  m_cache.erase(it);
+  shard.m_cache.erase(it);
+}
+
+CDirectoryCache::Stats CDirectoryCache::GetStats() const
+{
+  Stats stats;
+  stats.hits = m_cacheHits;
+  stats.misses = m_cacheMisses;
+  stats.evictions = m_cacheEvictions;
+  for (const CShard& shard : m_shards)
+  {
+    CSingleLock lock (shard.m_cs);
+    stats.directories += shard.m_cache.size();
+    for (const auto& i : shard.m_cache)
+      stats.items += i.second.dir->m_Items->Size();
+  }
+  return stats;
 }
 
 #ifdef _DEBUG
 void CDirectoryCache::PrintStats() const
 {
-  CSingleLock lock (m_cs);
-  CLog::Log(LOGDEBUG, "%s - total of %u cache hits, and %u cache misses", __FUNCTION__, m_cacheHits, m_cacheMisses);
-  // run through and find the oldest and the number of items cached
+  const Stats stats = GetStats();
+  CLog::Log(LOGDEBUG,
+            "%s - total of %" PRIu64 " cache hits, %" PRIu64 " cache misses and %" PRIu64
+            " evictions",
+            __FUNCTION__, stats.hits, stats.misses, stats.evictions);
+  // run through and find the oldest
   unsigned int oldest = UINT_MAX;
-  unsigned int numItems = 0;
-  unsigned int numDirs = 0;
-  for (ciCache i = m_cache.begin(); i != m_cache.end(); i++)
+  for (const CShard& shard : m_shards)
   {
-    CDir *dir = i->second;
-    oldest = std::min(oldest, dir->GetLastAccess());
-    numItems += dir->m_Items->Size();
-    numDirs++;
+    CSingleLock lock (shard.m_cs);
+    for (const auto& i : shard.m_cache)
+      oldest = std::min(oldest, i.second.dir->GetLastAccess());
   }
-  CLog::Log(LOGDEBUG, "%s - %u folders cached, with %u items total.  Oldest is %u, current is %u", __FUNCTION__, numDirs, numItems, oldest, m_accessCounter);
+  CLog::Log(LOGDEBUG, "%s - %u folders cached, with %u items total.  Oldest is %u, current is %u",
+            __FUNCTION__, stats.directories, stats.items, oldest,
+            static_cast<unsigned int>(m_accessCounter));
 }
 #endif
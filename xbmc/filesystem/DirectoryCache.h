@@ -11,8 +11,12 @@
 #include "IDirectory.h"
 #include "threads/CriticalSection.h"
 
-#include <map>
+#include <atomic>
+#include <list>
 #include <set>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
 
 class CFileItem;
 
@@ -26,7 +30,7 @@ namespace XFILE
       explicit CDir(DIR_CACHE_TYPE cacheType);
       virtual ~CDir();
 
-      void SetLastAccess(unsigned int &accessCounter);
+      void SetLastAccess(std::atomic<unsigned int> &accessCounter);
       unsigned int GetLastAccess() const { return m_lastAccess; };
 
       CFileItemList* m_Items;
@@ -36,7 +40,38 @@ namespace XFILE
       CDir& operator=(const CDir&) = delete;
       unsigned int m_lastAccess;
     };
+
+    typedef std::list<std::string> LruList;
+
+    struct CacheEntry
+    {
+      CDir* dir;
+      LruList::iterator lru; ///< position in the shard's LRU list, only valid for evictable dirs
+    };
+
+    /*!
+     \brief One independently locked part of the cache.
+     Paths are spread over the shards by hash, so concurrent lookups of
+     different directories rarely contend for the same lock. The item budget
+     is shared by all shards.
+     */
+    struct CShard
+    {
+      std::unordered_map<std::string, CacheEntry> m_cache;
+      LruList m_lru; ///< evictable dirs, most recently used first
+      mutable CCriticalSection m_cs;
+    };
+
   public:
+    struct Stats
+    {
+      uint64_t hits = 0;
+      uint64_t misses = 0;
+      uint64_t evictions = 0;
+      unsigned int directories = 0;
+      unsigned int items = 0;
+    };
+
     CDirectoryCache(void);
     virtual ~CDirectoryCache(void);
     bool GetDirectory(const std::string& strPath, CFileItemList &items, bool retrieveAll = false);
@@ -47,6 +82,14 @@ namespace XFILE
     void Clear();
     void AddFile(const std::string& strFile);
     bool FileExists(const std::string& strPath, bool& bInCache);
+    Stats GetStats() const;
+
+    /*!
+     \brief Set the number of items the evictable dirs may hold in total.
+     Each cached directory counts as one item too. The least recently used dirs
+     are evicted above it, but the most recent one is always kept.
+     */
+    void SetMaxItems(unsigned int maxItems);
 #ifdef _DEBUG
     void PrintStats() const;
 #endif
@@ -55,19 +98,22 @@ namespace XFILE
     void ClearCache(std::set<std::string>& dirs);
     void CheckIfFull();
 
-    std::map<std::string, CDir*> m_cache;
-    typedef std::map<std::string, CDir*>::iterator iCache;
-    typedef std::map<std::string, CDir*>::const_iterator ciCache;
-    void Delete(iCache i);
+    typedef std::unordered_map<std::string, CacheEntry>::iterator iCache;
+    typedef std::unordered_map<std::string, CacheEntry>::const_iterator ciCache;
+    CShard& GetShard(const std::string& storedPath);
+    void Touch(CShard& shard, CacheEntry& entry);
+    void Delete(CShard& shard, iCache i);
 
-    mutable CCriticalSection m_cs;
+    static const unsigned int NUM_SHARDS = 16;
+    CShard m_shards[NUM_SHARDS];
 
-    unsigned int m_accessCounter;
-
-#ifdef _DEBUG
-    unsigned int m_cacheHits;
-    unsigned int m_cacheMisses;
-#endif
+    std::atomic<unsigned int> m_accessCounter;
+    std::atomic<unsigned int> m_items; ///< items held by evictable dirs
+    std::atomic<unsigned int> m_maxItems;
+    CCriticalSection m_evictionSection;
+    std::atomic<uint64_t> m_cacheHits;
+    std::atomic<uint64_t> m_cacheMisses;
+    std::atomic<uint64_t> m_cacheEvictions;
   };
 }
 extern XFILE::CDirectoryCache g_directoryCache;
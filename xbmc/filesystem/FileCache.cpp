@@ -145,6 +145,9 @@ bool CFileCache::Open(const CURL& url)
 
   if (!m_pCache)
   {
+    // Several independently filled segments keep e.g. header, index and playback window cached
+    unsigned int segments = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheSegments;
+
     if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheMemSize == 0)
     {
       // Use cache on disk
@@ -160,6 +163,9 @@ bool CFileCache::Open(const CURL& url)
         // We don't need to take into account READ_MULTI_STREAM here as that's only used for audio/video
         cacheSize = m_fileSize;
 
+        // The whole file fits, no need for segments
+        segments = 1;
+
         // Cap chunk size by cache size
         if (m_chunkSize > cacheSize)
           m_chunkSize = cacheSize;
@@ -169,7 +175,12 @@ bool CFileCache::Open(const CURL& url)
         cacheSize = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheMemSize;
 
         // NOTE: READ_MULTI_STREAM is only used with READ_AUDIO_VIDEO
-        if (m_flags & READ_MULTI_STREAM)
+        if (segments > 1)
+        {
+          // Share the memory between the segments
+          cacheSize /= segments;
+        }
+        else if (m_flags & READ_MULTI_STREAM)
         {
           // READ_MULTI_STREAM requires double buffering, so use half the amount of memory for each buffer
           cacheSize /= 2;
@@ -180,7 +191,10 @@ bool CFileCache::Open(const CURL& url)
           cacheSize = m_chunkSize * 2;
       }
 
-      if (m_flags & READ_MULTI_STREAM)
+      if (segments > 1)
+        CLog::Log(LOGDEBUG, "CFileCache::Open - Using %u memory cache segments each sized %i bytes",
+                  segments, cacheSize);
+      else if (m_flags & READ_MULTI_STREAM)
         CLog::Log(LOGDEBUG, "CFileCache::Open - Using double memory cache each sized %i bytes",
                   cacheSize);
       else
@@ -194,7 +208,12 @@ bool CFileCache::Open(const CURL& url)
       m_forwardCacheSize = front;
     }
 
-    if (m_flags & READ_MULTI_STREAM)
+    if (segments > 1)
+    {
+      // Segments also cover the double buffering READ_MULTI_STREAM requires
+      m_pCache = std::unique_ptr<CMultiSegmentCache>(new CMultiSegmentCache(m_pCache.release(), segments)); // C++14 - Replace with std::make_unique
+    }
+    else if (m_flags & READ_MULTI_STREAM)
     {
       // If READ_MULTI_STREAM flag is set: Double buffering is required
       m_pCache = std::unique_ptr<CDoubleCache>(new CDoubleCache(m_pCache.release())); // C++14 - Replace with std::make_unique
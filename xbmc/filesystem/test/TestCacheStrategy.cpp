@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/CacheStrategy.h"
+#include "filesystem/CircularCache.h"
+
+#include <string.h>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+// fill the active segment with the file content starting at pos
+void Fill(CCacheStrategy& cache, const std::vector<char>& file, int64_t pos, size_t size)
+{
+  while (size > 0)
+  {
+    const int written = cache.WriteToCache(file.data() + pos, size);
+    ASSERT_GT(written, 0);
+    pos += written;
+    size -= written;
+  }
+}
+
+std::vector<char> CreateFile()
+{
+  std::vector<char> file(1024 * 1024);
+  for (size_t i = 0; i < file.size(); i++)
+    file[i] = static_cast<char>(i * 7);
+  return file;
+}
+}
+
+TEST(TestCacheStrategy, MultiSegmentKeepsHeadTailAndPlayback)
+{
+  const std::vector<char> file = CreateFile();
+  const int64_t tail = file.size() - 16 * 1024;
+  CMultiSegmentCache cache(new CCircularCache(48 * 1024, 16 * 1024), 3);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+
+  // header probing
+  Fill(cache, file, 0, 32 * 1024);
+  EXPECT_TRUE(cache.IsCachedPosition(0));
+
+  // index at the end of the file opens a second segment
+  EXPECT_EQ(CACHE_RC_ERROR, cache.Seek(tail));
+  EXPECT_EQ(tail, cache.CachedDataEndPosIfSeekTo(tail));
+  EXPECT_TRUE(cache.Reset(tail, false));
+  Fill(cache, file, tail, 16 * 1024);
+
+  // back to the start is served from the first segment without a full reset
+  EXPECT_EQ(CACHE_RC_ERROR, cache.Seek(1000));
+  EXPECT_EQ(32 * 1024, cache.CachedDataEndPosIfSeekTo(1000));
+  EXPECT_FALSE(cache.Reset(1000, false));
+  EXPECT_EQ(32 * 1024, cache.CachedDataEndPos());
+
+  char buffer[100];
+  ASSERT_EQ(100, cache.ReadFromCache(buffer, sizeof(buffer)));
+  EXPECT_EQ(0, memcmp(buffer, file.data() + 1000, sizeof(buffer)));
+
+  // a chapter skip opens the third segment, everything is still cached
+  const int64_t chapter = 512 * 1024;
+  EXPECT_TRUE(cache.Reset(chapter, false));
+  Fill(cache, file, chapter, 8 * 1024);
+  EXPECT_TRUE(cache.IsCachedPosition(0));
+  EXPECT_TRUE(cache.IsCachedPosition(tail + 100));
+  EXPECT_TRUE(cache.IsCachedPosition(chapter + 100));
+
+  // the tail is served from memory
+  EXPECT_FALSE(cache.Reset(tail + 100, false));
+  EXPECT_EQ(static_cast<int64_t>(file.size()), cache.CachedDataEndPos());
+  ASSERT_EQ(100, cache.ReadFromCache(buffer, sizeof(buffer)));
+  EXPECT_EQ(0, memcmp(buffer, file.data() + tail + 100, sizeof(buffer)));
+
+  // the next chapter recycles the least recently used segment but keeps the head
+  const int64_t nextChapter = 768 * 1024;
+  EXPECT_TRUE(cache.Reset(nextChapter, false));
+  EXPECT_TRUE(cache.IsCachedPosition(0));
+  EXPECT_TRUE(cache.IsCachedPosition(tail + 100));
+  EXPECT_FALSE(cache.IsCachedPosition(chapter + 100));
+
+  cache.Close();
+}
+
+TEST(TestCacheStrategy, MultiSegmentSingleSegment)
+{
+  const std::vector<char> file = CreateFile();
+  CMultiSegmentCache cache(new CCircularCache(48 * 1024, 16 * 1024), 1);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+
+  Fill(cache, file, 0, 32 * 1024);
+  EXPECT_TRUE(cache.Reset(512 * 1024, false));
+  EXPECT_FALSE(cache.IsCachedPosition(0));
+  EXPECT_TRUE(cache.IsCachedPosition(512 * 1024));
+
+  cache.Close();
+}
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "filesystem/DirectoryCache.h"
+#include "utils/StringUtils.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+// caches a listing of count files, which takes count + 1 items of the budget
+void SetDirectory(CDirectoryCache& cache,
+                  const std::string& path,
+                  int count,
+                  DIR_CACHE_TYPE cacheType = DIR_CACHE_ONCE)
+{
+  CFileItemList items;
+  for (int i = 0; i < count; i++)
+    items.Add(CFileItemPtr(new CFileItem(StringUtils::Format("%s/file%i", path.c_str(), i), false)));
+  cache.SetDirectory(path, items, cacheType);
+}
+
+bool IsCached(CDirectoryCache& cache, const std::string& path)
+{
+  CFileItemList items;
+  return cache.GetDirectory(path, items, true);
+}
+}
+
+TEST(TestDirectoryCache, EvictsLeastRecentlyUsed)
+{
+  CDirectoryCache cache;
+  cache.SetMaxItems(12);
+
+  SetDirectory(cache, "/cache/a", 3);
+  SetDirectory(cache, "/cache/b", 3);
+  SetDirectory(cache, "/cache/c", 3);
+  EXPECT_EQ(0u, cache.GetStats().evictions);
+
+  // a is used again, so b is the least recently used dir now
+  EXPECT_TRUE(IsCached(cache, "/cache/a"));
+  SetDirectory(cache, "/cache/d", 3);
+  EXPECT_EQ(1u, cache.GetStats().evictions);
+  EXPECT_FALSE(IsCached(cache, "/cache/b"));
+  EXPECT_TRUE(IsCached(cache, "/cache/c"));
+  EXPECT_TRUE(IsCached(cache, "/cache/a"));
+  EXPECT_TRUE(IsCached(cache, "/cache/d"));
+
+  // c is the oldest after the lookups above
+  SetDirectory(cache, "/cache/e", 3);
+  EXPECT_EQ(2u, cache.GetStats().evictions);
+  EXPECT_FALSE(IsCached(cache, "/cache/c"));
+}
+
+TEST(TestDirectoryCache, LargeDirectoryKeepsOthers)
+{
+  CDirectoryCache cache;
+  cache.SetMaxItems(100);
+
+  for (int i = 0; i < 20; i++)
+  {
+    const std::string path = StringUtils::Format("/cache/small%i", i);
+    SetDirectory(cache, path, 1);
+  }
+
+  // the budget is shared by all shards, so only as many dirs are evicted as are needed
+  SetDirectory(cache, "/cache/large", 69);
+  EXPECT_EQ(5u, cache.GetStats().evictions);
+  for (int i = 0; i < 20; i++)
+    EXPECT_EQ(i >= 5, IsCached(cache, StringUtils::Format("/cache/small%i", i))) << i;
+  EXPECT_TRUE(IsCached(cache, "/cache/large"));
+
+  // the most recent dir is kept even if it is too big on its own
+  SetDirectory(cache, "/cache/huge", 200);
+  EXPECT_TRUE(IsCached(cache, "/cache/huge"));
+  EXPECT_EQ(1u, cache.GetStats().directories);
+}
+
+TEST(TestDirectoryCache, AlwaysCachedDirsAreNotEvicted)
+{
+  CDirectoryCache cache;
+  cache.SetMaxItems(10);
+
+  SetDirectory(cache, "/cache/always", 50, DIR_CACHE_ALWAYS);
+  SetDirectory(cache, "/cache/a", 3);
+  SetDirectory(cache, "/cache/b", 3);
+  EXPECT_EQ(0u, cache.GetStats().evictions);
+  EXPECT_TRUE(IsCached(cache, "/cache/always"));
+
+  // lowering the budget evicts right away
+  cache.SetMaxItems(5);
+  EXPECT_EQ(1u, cache.GetStats().evictions);
+  EXPECT_FALSE(IsCached(cache, "/cache/a"));
+  EXPECT_TRUE(IsCached(cache, "/cache/b"));
+  EXPECT_TRUE(IsCached(cache, "/cache/always"));
+}
+
+TEST(TestDirectoryCache, Stats)
+{
+  CDirectoryCache cache;
+
+  EXPECT_FALSE(IsCached(cache, "/cache/a"));
+  SetDirectory(cache, "/cache/a", 2);
+  SetDirectory(cache, "/cache/b", 3, DIR_CACHE_ALWAYS);
+  EXPECT_TRUE(IsCached(cache, "/cache/a"));
+  EXPECT_TRUE(IsCached(cache, "/cache/b/"));
+
+  // once cached dirs are only returned when everything is retrieved
+  CFileItemList items;
+  EXPECT_FALSE(cache.GetDirectory("/cache/a", items, false));
+
+  bool inCache = false;
+  EXPECT_TRUE(cache.FileExists("/cache/a/file1", inCache));
+  EXPECT_TRUE(inCache);
+  EXPECT_FALSE(cache.FileExists("/cache/c/file1", inCache));
+  EXPECT_FALSE(inCache);
+
+  cache.AddFile("/cache/b/file3");
+
+  CDirectoryCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(3u, stats.hits);
+  EXPECT_EQ(3u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(2u, stats.directories);
+  EXPECT_EQ(6u, stats.items);
+
+  cache.ClearDirectory("/cache/a");
+  stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.directories);
+  EXPECT_EQ(4u, stats.items);
+}
@@ -0,0 +1,388 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DXTCodec.h"
+
+#include "TextureFormats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdint.h>
+#include <string.h>
+
+namespace
+{
+// a 4x4 block of pixels in BGRA byte order
+typedef unsigned char Block[16][4];
+
+unsigned int GetBlockSize(unsigned int format)
+{
+  switch (format)
+  {
+  case XB_FMT_DXT1:
+    return 8;
+  case XB_FMT_DXT3:
+  case XB_FMT_DXT5:
+    return 16;
+  default:
+    return 0;
+  }
+}
+
+uint16_t PackColor(const float* color)
+{
+  int r = std::min(std::max(static_cast<int>(color[2] * 31.0f / 255.0f + 0.5f), 0), 31);
+  int g = std::min(std::max(static_cast<int>(color[1] * 63.0f / 255.0f + 0.5f), 0), 63);
+  int b = std::min(std::max(static_cast<int>(color[0] * 31.0f / 255.0f + 0.5f), 0), 31);
+  return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void UnpackColor(uint16_t packed, unsigned char* color)
+{
+  unsigned int r = (packed >> 11) & 31;
+  unsigned int g = (packed >> 5) & 63;
+  unsigned int b = packed & 31;
+  color[0] = static_cast<unsigned char>((b << 3) | (b >> 2));
+  color[1] = static_cast<unsigned char>((g << 2) | (g >> 4));
+  color[2] = static_cast<unsigned char>((r << 3) | (r >> 2));
+  color[3] = 255;
+}
+
+// the palette a color block decodes to, opaque selects the four color mode regardless of the endpoints
+void GetColorPalette(uint16_t c0, uint16_t c1, bool opaque, unsigned char palette[4][4])
+{
+  UnpackColor(c0, palette[0]);
+  UnpackColor(c1, palette[1]);
+  for (int i = 0; i < 3; i++)
+  {
+    if (opaque || c0 > c1)
+    {
+      palette[2][i] = static_cast<unsigned char>((2 * palette[0][i] + palette[1][i]) / 3);
+      palette[3][i] = static_cast<unsigned char>((palette[0][i] + 2 * palette[1][i]) / 3);
+    }
+    else
+    {
+      palette[2][i] = static_cast<unsigned char>((palette[0][i] + palette[1][i]) / 2);
+      palette[3][i] = 0;
+    }
+  }
+  palette[2][3] = 255;
+  palette[3][3] = (opaque || c0 > c1) ? 255 : 0;
+}
+
+void GetAlphaPalette(unsigned char a0, unsigned char a1, unsigned char palette[8])
+{
+  palette[0] = a0;
+  palette[1] = a1;
+  if (a0 > a1)
+  {
+    for (int i = 1; i < 7; i++)
+      palette[i + 1] = static_cast<unsigned char>(((7 - i) * a0 + i * a1) / 7);
+  }
+  else
+  {
+    for (int i = 1; i < 5; i++)
+      palette[i + 1] = static_cast<unsigned char>(((5 - i) * a0 + i * a1) / 5);
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+}
+
+// choose the palette entry of each pixel, c0 and c1 are swapped if needed to get the four color mode
+int FitColorIndices(const Block& block, uint16_t& c0, uint16_t& c1, uint32_t& indices)
+{
+  if (c0 < c1)
+    std::swap(c0, c1);
+
+  unsigned char palette[4][4];
+  GetColorPalette(c0, c1, true, palette);
+
+  // with equal endpoints the block is in three color mode, where only the first entry is safe
+  const int entries = c0 != c1 ? 4 : 1;
+  int totalError = 0;
+  indices = 0;
+  for (int i = 0; i < 16; i++)
+  {
+    int best = 0;
+    int bestError = 0;
+    for (int p = 0; p < entries; p++)
+    {
+      int error = 0;
+      for (int c = 0; c < 3; c++)
+        error += (block[i][c] - palette[p][c]) * (block[i][c] - palette[p][c]);
+      if (p == 0 || error < bestError)
+      {
+        best = p;
+        bestError = error;
+      }
+    }
+    indices |= static_cast<uint32_t>(best) << (2 * i);
+    totalError += bestError;
+  }
+  return totalError;
+}
+
+void CompressColorBlock(const Block& block, unsigned char* dest)
+{
+  // the endpoints are the extremes of the block along its principal axis
+  float mean[3] = { 0.0f, 0.0f, 0.0f };
+  for (int i = 0; i < 16; i++)
+    for (int c = 0; c < 3; c++)
+      mean[c] += block[i][c] / 16.0f;
+
+  float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+  for (int i = 0; i < 16; i++)
+  {
+    float d[3] = { block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2] };
+    covariance[0] += d[0] * d[0];
+    covariance[1] += d[0] * d[1];
+    covariance[2] += d[0] * d[2];
+    covariance[3] += d[1] * d[1];
+    covariance[4] += d[1] * d[2];
+    covariance[5] += d[2] * d[2];
+  }
+
+  float axis[3] = { 1.0f, 1.0f, 1.0f };
+  for (int iteration = 0; iteration < 8; iteration++)
+  {
+    float next[3] = { covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                      covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                      covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2] };
+    float length = std::max(std::max(std::abs(next[0]), std::abs(next[1])), std::abs(next[2]));
+    if (length <= 0.0f)
+      break;
+    for (int c = 0; c < 3; c++)
+      axis[c] = next[c] / length;
+  }
+
+  int minIndex = 0;
+  int maxIndex = 0;
+  float minProjection = 0.0f;
+  float maxProjection = 0.0f;
+  for (int i = 0; i < 16; i++)
+  {
+    float projection = block[i][0] * axis[0] + block[i][1] * axis[1] + block[i][2] * axis[2];
+    if (i == 0 || projection < minProjection)
+    {
+      minProjection = projection;
+      minIndex = i;
+    }
+    if (i == 0 || projection > maxProjection)
+    {
+      maxProjection = projection;
+      maxIndex = i;
+    }
+  }
+
+  // inset the endpoints a little, the interpolated colors cover the extremes well enough
+  float maxColor[3];
+  float minColor[3];
+  for (int c = 0; c < 3; c++)
+  {
+    float inset = (block[maxIndex][c] - block[minIndex][c]) / 16.0f;
+    maxColor[c] = block[maxIndex][c] - inset;
+    minColor[c] = block[minIndex][c] + inset;
+  }
+
+  uint16_t c0 = PackColor(maxColor);
+  uint16_t c1 = PackColor(minColor);
+  uint32_t indices = 0;
+  int error = FitColorIndices(block, c0, c1, indices);
+
+  // refine the endpoints with a least squares fit to the chosen indices
+  float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+  float ax[3] = { 0.0f, 0.0f, 0.0f };
+  float bx[3] = { 0.0f, 0.0f, 0.0f };
+  for (int i = 0; i < 16; i++)
+  {
+    static const float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    float a = weights[(indices >> (2 * i)) & 3];
+    float b = 1.0f - a;
+    aa += a * a;
+    bb += b * b;
+    ab += a * b;
+    for (int c = 0; c < 3; c++)
+    {
+      ax[c] += a * block[i][c];
+      bx[c] += b * block[i][c];
+    }
+  }
+  float determinant = aa * bb - ab * ab;
+  if (std::abs(determinant) > 1e-6f)
+  {
+    for (int c = 0; c < 3; c++)
+    {
+      maxColor[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+      minColor[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+    }
+    uint16_t refined0 = PackColor(maxColor);
+    uint16_t refined1 = PackColor(minColor);
+    uint32_t refinedIndices = 0;
+    int refinedError = FitColorIndices(block, refined0, refined1, refinedIndices);
+    if (refinedError < error)
+    {
+      c0 = refined0;
+      c1 = refined1;
+      indices = refinedIndices;
+    }
+  }
+
+  dest[0] = c0 & 0xff;
+  dest[1] = c0 >> 8;
+  dest[2] = c1 & 0xff;
+  dest[3] = c1 >> 8;
+  for (int i = 0; i < 4; i++)
+    dest[4 + i] = (indices >> (8 * i)) & 0xff;
+}
+
+void CompressAlphaBlock(const Block& block, unsigned char* dest)
+{
+  unsigned char a0 = 0;
+  unsigned char a1 = 255;
+  for (int i = 0; i < 16; i++)
+  {
+    a0 = std::max(a0, block[i][3]);
+    a1 = std::min(a1, block[i][3]);
+  }
+
+  unsigned char palette[8];
+  GetAlphaPalette(a0, a1, palette);
+
+  uint64_t indices = 0;
+  if (a0 != a1)
+  {
+    for (int i = 0; i < 16; i++)
+    {
+      int best = 0;
+      for (int p = 1; p < 8; p++)
+      {
+        if (std::abs(block[i][3] - palette[p]) < std::abs(block[i][3] - palette[best]))
+          best = p;
+      }
+      indices |= static_cast<uint64_t>(best) << (3 * i);
+    }
+  }
+
+  dest[0] = a0;
+  dest[1] = a1;
+  for (int i = 0; i < 6; i++)
+    dest[2 + i] = (indices >> (8 * i)) & 0xff;
+}
+
+void DecompressColorBlock(const unsigned char* data, bool opaque, Block& block)
+{
+  uint16_t c0 = data[0] | (data[1] << 8);
+  uint16_t c1 = data[2] | (data[3] << 8);
+  uint32_t indices = data[4] | (data[5] << 8) | (data[6] << 16) | (static_cast<uint32_t>(data[7]) << 24);
+
+  unsigned char palette[4][4];
+  GetColorPalette(c0, c1, opaque, palette);
+  for (int i = 0; i < 16; i++)
+    memcpy(block[i], palette[(indices >> (2 * i)) & 3], 4);
+}
+
+void DecompressAlphaBlock(const unsigned char* data, Block& block)
+{
+  unsigned char palette[8];
+  GetAlphaPalette(data[0], data[1], palette);
+
+  uint64_t indices = 0;
+  for (int i = 0; i < 6; i++)
+    indices |= static_cast<uint64_t>(data[2 + i]) << (8 * i);
+  for (int i = 0; i < 16; i++)
+    block[i][3] = palette[(indices >> (3 * i)) & 7];
+}
+
+void DecompressExplicitAlphaBlock(const unsigned char* data, Block& block)
+{
+  for (int i = 0; i < 16; i++)
+  {
+    unsigned int alpha = (data[i / 2] >> (4 * (i % 2))) & 15;
+    block[i][3] = static_cast<unsigned char>(alpha * 17);
+  }
+}
+}
+
+unsigned int CDXTCodec::GetStorageSize(unsigned int width, unsigned int height, unsigned int format)
+{
+  return ((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+}
+
+bool CDXTCodec::Compress(const unsigned char* pixels, unsigned int width, unsigned int height,
+                         unsigned int pitch, unsigned int format, unsigned char* dest)
+{
+  if (format != XB_FMT_DXT1 && format != XB_FMT_DXT5)
+    return false;
+
+  const unsigned int blockSize = GetBlockSize(format);
+  for (unsigned int y = 0; y < height; y += 4)
+  {
+    for (unsigned int x = 0; x < width; x += 4)
+    {
+      // pixels outside the image repeat the edge
+      Block block;
+      for (unsigned int i = 0; i < 16; i++)
+      {
+        unsigned int px = std::min(x + i % 4, width - 1);
+        unsigned int py = std::min(y + i / 4, height - 1);
+        memcpy(block[i], pixels + py * pitch + px * 4, 4);
+      }
+
+      if (format == XB_FMT_DXT5)
+      {
+        CompressAlphaBlock(block, dest);
+        CompressColorBlock(block, dest + 8);
+      }
+      else
+        CompressColorBlock(block, dest);
+      dest += blockSize;
+    }
+  }
+  return true;
+}
+
+bool CDXTCodec::Decompress(const unsigned char* data, unsigned int width, unsigned int height,
+                           unsigned int format, unsigned char* pixels, unsigned int pitch)
+{
+  const unsigned int blockSize = GetBlockSize(format);
+  if (blockSize == 0)
+    return false;
+
+  for (unsigned int y = 0; y < height; y += 4)
+  {
+    for (unsigned int x = 0; x < width; x += 4)
+    {
+      Block block;
+      switch (format)
+      {
+      case XB_FMT_DXT1:
+        DecompressColorBlock(data, false, block);
+        break;
+      case XB_FMT_DXT3:
+        DecompressColorBlock(data + 8, true, block);
+        DecompressExplicitAlphaBlock(data, block);
+        break;
+      case XB_FMT_DXT5:
+        DecompressColorBlock(data + 8, true, block);
+        DecompressAlphaBlock(data, block);
+        break;
+      }
+      data += blockSize;
+
+      for (unsigned int i = 0; i < 16; i++)
+      {
+        unsigned int px = x + i % 4;
+        unsigned int py = y + i / 4;
+        if (px < width && py < height)
+          memcpy(pixels + py * pitch + px * 4, block[i], 4);
+      }
+    }
+  }
+  return true;
+}
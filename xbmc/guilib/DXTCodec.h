@@ -0,0 +1,50 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+/*!
+ \ingroup textures
+ \brief Software encoder and decoder for the S3TC/BC block compressed texture formats.
+
+ Textures are compressed at pack time (TexturePacker) and uploaded as is if the GPU supports
+ them. Otherwise they are decoded here. Pixels are 32 bit in XB_FMT_A8R8G8B8 byte order (BGRA).
+ This has no dependencies on the rest of Kodi so it can be built into TexturePacker as well.
+ */
+class CDXTCodec
+{
+public:
+  /*!
+   \brief Size of a compressed image.
+   \param format one of XB_FMT_DXT1, XB_FMT_DXT3 or XB_FMT_DXT5
+   \return the size in bytes, 0 for formats that aren't block compressed
+   */
+  static unsigned int GetStorageSize(unsigned int width, unsigned int height, unsigned int format);
+
+  /*!
+   \brief Compress an image.
+   \param pixels the image in XB_FMT_A8R8G8B8 byte order
+   \param pitch bytes per row of pixels
+   \param format XB_FMT_DXT1 (alpha is ignored) or XB_FMT_DXT5
+   \param dest buffer of GetStorageSize() bytes
+   \return true on success, false if the format isn't supported
+   */
+  static bool Compress(const unsigned char* pixels, unsigned int width, unsigned int height,
+                       unsigned int pitch, unsigned int format, unsigned char* dest);
+
+  /*!
+   \brief Decompress an image.
+   \param data the compressed image as produced by Compress()
+   \param format one of XB_FMT_DXT1, XB_FMT_DXT3 or XB_FMT_DXT5
+   \param pixels buffer for the image in XB_FMT_A8R8G8B8 byte order
+   \param pitch bytes per row of pixels
+   \return true on success, false if the format isn't supported
+   */
+  static bool Decompress(const unsigned char* data, unsigned int width, unsigned int height,
+                         unsigned int format, unsigned char* pixels, unsigned int pitch);
+};
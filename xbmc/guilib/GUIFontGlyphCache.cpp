@@ -0,0 +1,348 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIFontGlyphCache.h"
+
+#include "FileItem.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#if defined(TARGET_POSIX)
+#include "platform/posix/utils/Mmap.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+const std::string CGUIFontGlyphCache::CACHE_PATH = "special://temp/fontcache/";
+
+namespace
+{
+const char GLYPH_CACHE_MAGIC[4] = { 'K', 'G', 'L', 'Y' };
+const uint32_t GLYPH_CACHE_VERSION = 2;
+
+/*! Layout of a cache file, all numbers are little endian:
+ magic, version, key length, key, texture width, texture rows, posX, posY, number of glyphs,
+ the glyphs (offsetX, offsetY, left, top, right, bottom, advance, letterAndStyle) and the
+ pixels of the texture rows.
+ */
+const size_t GLYPH_SIZE = 2 * sizeof(int16_t) + 5 * sizeof(float) + sizeof(uint32_t);
+
+class CWriter
+{
+public:
+  void PutBytes(const void* data, size_t size)
+  {
+    m_data.append(static_cast<const char*>(data), size);
+  }
+
+  void Put16(uint16_t value)
+  {
+    m_data.push_back(static_cast<char>(value & 0xff));
+    m_data.push_back(static_cast<char>(value >> 8));
+  }
+
+  void Put32(uint32_t value)
+  {
+    Put16(static_cast<uint16_t>(value & 0xffff));
+    Put16(static_cast<uint16_t>(value >> 16));
+  }
+
+  void PutFloat(float value)
+  {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    Put32(bits);
+  }
+
+  const std::string& Data() const { return m_data; }
+
+private:
+  std::string m_data;
+};
+
+class CReader
+{
+public:
+  CReader(const unsigned char* data, size_t size) : m_data(data), m_left(size) {}
+
+  const unsigned char* GetBytes(size_t size)
+  {
+    if (size > m_left)
+      return nullptr;
+    const unsigned char* bytes = m_data;
+    m_data += size;
+    m_left -= size;
+    return bytes;
+  }
+
+  bool Get16(uint16_t& value)
+  {
+    const unsigned char* bytes = GetBytes(2);
+    if (!bytes)
+      return false;
+    value = static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+    return true;
+  }
+
+  bool Get32(uint32_t& value)
+  {
+    uint16_t low, high;
+    if (!Get16(low) || !Get16(high))
+      return false;
+    value = low | (static_cast<uint32_t>(high) << 16);
+    return true;
+  }
+
+  bool GetInt(int& value)
+  {
+    uint32_t bits;
+    if (!Get32(bits))
+      return false;
+    value = static_cast<int32_t>(bits);
+    return true;
+  }
+
+  bool GetFloat(float& value)
+  {
+    uint32_t bits;
+    if (!Get32(bits))
+      return false;
+    memcpy(&value, &bits, sizeof(value));
+    return true;
+  }
+
+  bool GetGlyph(CGUIFontGlyphCache::Glyph& glyph)
+  {
+    uint16_t offsetX, offsetY;
+    if (!Get16(offsetX) || !Get16(offsetY) || !GetFloat(glyph.left) || !GetFloat(glyph.top) ||
+        !GetFloat(glyph.right) || !GetFloat(glyph.bottom) || !GetFloat(glyph.advance) ||
+        !Get32(glyph.letterAndStyle))
+      return false;
+    glyph.offsetX = static_cast<int16_t>(offsetX);
+    glyph.offsetY = static_cast<int16_t>(offsetY);
+    return true;
+  }
+
+  size_t Left() const { return m_left; }
+
+private:
+  const unsigned char* m_data;
+  size_t m_left;
+};
+}
+
+// read only view of a cache file, memory mapped where the platform allows it
+class CGUIFontGlyphCache::CFileView
+{
+public:
+  bool Open(const std::string& path)
+  {
+#if defined(TARGET_POSIX)
+    int fd = open(CSpecialProtocol::TranslatePath(path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      try
+      {
+        m_map.reset(new KODI::UTILS::POSIX::CMmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0));
+      }
+      catch (const std::system_error&)
+      {
+      }
+    }
+    close(fd);
+    if (m_map)
+      return true;
+#endif
+    XFILE::CFile file;
+    return file.LoadFile(path, m_buffer) > 0;
+  }
+
+  const unsigned char* Data() const
+  {
+#if defined(TARGET_POSIX)
+    if (m_map)
+      return static_cast<const unsigned char*>(m_map->Data());
+#endif
+    return reinterpret_cast<const unsigned char*>(m_buffer.get());
+  }
+
+  size_t Size() const
+  {
+#if defined(TARGET_POSIX)
+    if (m_map)
+      return m_map->Size();
+#endif
+    return m_buffer.size();
+  }
+
+private:
+#if defined(TARGET_POSIX)
+  std::unique_ptr<KODI::UTILS::POSIX::CMmap> m_map;
+#endif
+  XUTILS::auto_buffer m_buffer;
+};
+
+CGUIFontGlyphCache::CGUIFontGlyphCache(const std::string& key)
+  : m_key(key),
+    m_path(CACHE_PATH + StringUtils::Format("%08x.glyphs", Crc32::Compute(key)))
+{
+}
+
+CGUIFontGlyphCache::~CGUIFontGlyphCache() = default;
+
+bool CGUIFontGlyphCache::Load(Atlas& atlas)
+{
+  m_file.reset(new CFileView);
+  if (!m_file->Open(m_path))
+  {
+    m_file.reset();
+    return false;
+  }
+
+  CReader reader(m_file->Data(), m_file->Size());
+  const unsigned char* magic = reader.GetBytes(sizeof(GLYPH_CACHE_MAGIC));
+  uint32_t version, keyLength;
+  if (!magic || memcmp(magic, GLYPH_CACHE_MAGIC, sizeof(GLYPH_CACHE_MAGIC)) != 0 ||
+      !reader.Get32(version) || version != GLYPH_CACHE_VERSION || !reader.Get32(keyLength) ||
+      keyLength != m_key.size())
+    return false;
+
+  const unsigned char* key = reader.GetBytes(keyLength);
+  uint32_t textureWidth, textureRows, numGlyphs;
+  if (!key || memcmp(key, m_key.c_str(), keyLength) != 0 || !reader.Get32(textureWidth) ||
+      !reader.Get32(textureRows) || !reader.GetInt(atlas.posX) || !reader.GetInt(atlas.posY) ||
+      !reader.Get32(numGlyphs) || numGlyphs == 0 || numGlyphs > reader.Left() / GLYPH_SIZE)
+    return false;
+
+  atlas.glyphs.resize(numGlyphs);
+  for (auto& glyph : atlas.glyphs)
+    reader.GetGlyph(glyph);
+
+  // the pixels take up the rest of the file
+  if (static_cast<uint64_t>(textureRows) * textureWidth != reader.Left())
+    return false;
+  atlas.textureWidth = textureWidth;
+  atlas.textureRows = textureRows;
+  atlas.pixels = reader.GetBytes(reader.Left());
+  atlas.pitch = textureWidth;
+
+#if defined(TARGET_POSIX)
+  // atime isn't updated on most mounts, so mark the file as used for Prune()
+  utime(CSpecialProtocol::TranslatePath(m_path).c_str(), nullptr);
+#endif
+  return true;
+}
+
+bool CGUIFontGlyphCache::Save(const Atlas& atlas) const
+{
+  if (!XFILE::CDirectory::Exists(CACHE_PATH) && !XFILE::CDirectory::Create(CACHE_PATH))
+    return false;
+
+  CWriter writer;
+  writer.PutBytes(GLYPH_CACHE_MAGIC, sizeof(GLYPH_CACHE_MAGIC));
+  writer.Put32(GLYPH_CACHE_VERSION);
+  writer.Put32(m_key.size());
+  writer.PutBytes(m_key.c_str(), m_key.size());
+  writer.Put32(atlas.textureWidth);
+  writer.Put32(atlas.textureRows);
+  writer.Put32(static_cast<uint32_t>(atlas.posX));
+  writer.Put32(static_cast<uint32_t>(atlas.posY));
+  writer.Put32(atlas.glyphs.size());
+  for (const auto& glyph : atlas.glyphs)
+  {
+    writer.Put16(static_cast<uint16_t>(glyph.offsetX));
+    writer.Put16(static_cast<uint16_t>(glyph.offsetY));
+    writer.PutFloat(glyph.left);
+    writer.PutFloat(glyph.top);
+    writer.PutFloat(glyph.right);
+    writer.PutFloat(glyph.bottom);
+    writer.PutFloat(glyph.advance);
+    writer.Put32(glyph.letterAndStyle);
+  }
+
+  // write to a temporary file first so a partially written cache is never picked up
+  const std::string tempPath = m_path + ".tmp";
+  XFILE::CFile file;
+  if (!file.OpenForWrite(tempPath, true))
+  {
+    CLog::Log(LOGDEBUG, "%s: unable to write glyph cache %s", __FUNCTION__, tempPath.c_str());
+    return false;
+  }
+
+  const ssize_t size = writer.Data().size();
+  bool success = file.Write(writer.Data().c_str(), size) == size;
+  for (unsigned int y = 0; success && y < atlas.textureRows; y++)
+    success = file.Write(atlas.pixels + y * atlas.pitch, atlas.textureWidth) ==
+              static_cast<ssize_t>(atlas.textureWidth);
+  file.Close();
+
+  if (!success || (XFILE::CFile::Exists(m_path) && !XFILE::CFile::Delete(m_path)) ||
+      !XFILE::CFile::Rename(tempPath, m_path))
+  {
+    CLog::Log(LOGDEBUG, "%s: unable to write glyph cache %s", __FUNCTION__, m_path.c_str());
+    XFILE::CFile::Delete(tempPath);
+    return false;
+  }
+  return true;
+}
+
+void CGUIFontGlyphCache::Prune(time_t maxAge, uint64_t maxSize)
+{
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(CACHE_PATH, items, ".glyphs|.tmp",
+                                       XFILE::DIR_FLAG_NO_FILE_DIRS | XFILE::DIR_FLAG_BYPASS_CACHE))
+    return;
+
+  struct SFile
+  {
+    std::string path;
+    time_t used;
+    uint64_t size;
+  };
+  std::vector<SFile> files;
+  for (const auto& item : items)
+  {
+    struct __stat64 st;
+    if (item->m_bIsFolder || XFILE::CFile::Stat(item->GetPath(), &st) != 0)
+      continue;
+    files.push_back({item->GetPath(), std::max<time_t>(st.st_atime, st.st_mtime),
+                     static_cast<uint64_t>(st.st_size)});
+  }
+
+  // most recently used first
+  std::sort(files.begin(), files.end(),
+            [](const SFile& a, const SFile& b) { return a.used > b.used; });
+
+  const time_t now = time(nullptr);
+  uint64_t size = 0;
+  unsigned int removed = 0;
+  for (const auto& file : files)
+  {
+    size += file.size;
+    if ((now - file.used > maxAge || size > maxSize) && XFILE::CFile::Delete(file.path))
+      removed++;
+  }
+  if (removed > 0)
+    CLog::Log(LOGDEBUG, "%s: removed %u of %u glyph cache files", __FUNCTION__, removed,
+              static_cast<unsigned int>(files.size()));
+}
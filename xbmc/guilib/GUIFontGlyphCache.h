@@ -0,0 +1,85 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+/*!
+\file GUIFontGlyphCache.h
+\brief
+*/
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <time.h>
+#include <vector>
+
+/*! \brief On disk cache of the characters a font rendered and the texture rows holding them.
+ Every font size and style has a file of its own in special://temp/fontcache/. The fields are
+ written one by one in little endian order, so the format doesn't depend on the layout of the
+ structs the font uses in memory. Files of another format version are ignored and replaced.
+ */
+class CGUIFontGlyphCache
+{
+public:
+  struct Glyph
+  {
+    int16_t offsetX = 0;
+    int16_t offsetY = 0;
+    float left = 0.0f;
+    float top = 0.0f;
+    float right = 0.0f;
+    float bottom = 0.0f;
+    float advance = 0.0f;
+    uint32_t letterAndStyle = 0;
+  };
+
+  struct Atlas
+  {
+    unsigned int textureWidth = 0;
+    unsigned int textureRows = 0; //!< rows of the texture holding glyphs
+    int posX = 0; //!< where the next glyph goes in the texture
+    int posY = 0;
+    std::vector<Glyph> glyphs;
+    const unsigned char* pixels = nullptr; //!< 8 bit alpha, textureWidth bytes per row
+    unsigned int pitch = 0; //!< distance between the rows of pixels
+  };
+
+  /*! \param key identifies the font file, its size and style. Different keys may share a file
+   name, the full key is stored in the file and checked on load.
+   */
+  explicit CGUIFontGlyphCache(const std::string& key);
+  ~CGUIFontGlyphCache();
+
+  /*! \brief Read the cached glyphs.
+   \param atlas receives the glyphs, its pixels are valid as long as this object is.
+   \return true if there was a cache of the current format for the key.
+   */
+  bool Load(Atlas& atlas);
+
+  /*! \brief Write the glyphs, replacing the file only once it was written completely.
+   */
+  bool Save(const Atlas& atlas) const;
+
+  /*! \brief Remove the files not used for maxAge seconds, then the least recently used ones until
+   the cache takes up no more than maxSize bytes.
+   Loading a file counts as using it.
+   */
+  static void Prune(time_t maxAge, uint64_t maxSize);
+
+  const std::string& GetPath() const { return m_path; }
+
+  static const std::string CACHE_PATH;
+
+private:
+  class CFileView;
+
+  std::string m_key;
+  std::string m_path;
+  std::unique_ptr<CFileView> m_file;
+};
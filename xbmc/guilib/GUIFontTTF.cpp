@@ -8,6 +8,7 @@
 
 #include "GUIFont.h"
 #include "GUIFontTTF.h"
+#include "GUIFontGlyphCache.h"
 #include "GUIFontManager.h"
 #include "Texture.h"
 #include "windowing/GraphicContext.h"
@@ -19,11 +20,19 @@
 #include "windowing/WinSystem.h"
 #include "URL.h"
 #include "filesystem/File.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
+#include "utils/JobManager.h"
+#include "utils/StringUtils.h"
 
+#include <algorithm>
+#include <atomic>
 #include <math.h>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <thread>
 
 // stuff for freetype
 #include <ft2build.h>
@@ -41,6 +50,10 @@
 #define CHAR_CHUNK    64      // 64 chars allocated at a time (1024 bytes)
 #define GLYPH_STRENGTH_BOLD 24
 #define GLYPH_STRENGTH_LIGHT -48
+#define MIN_PARALLEL_CHARACTERS 16  // fewer missing characters are rendered on the calling thread
+#define MAX_RASTERIZER_THREADS 4    // threads rendering the missing characters of a text
+#define GLYPH_CACHE_MAX_AGE (30 * 24 * 60 * 60)  // glyph cache files unused for longer are removed
+#define GLYPH_CACHE_MAX_SIZE (64 * 1024 * 1024)  // size the glyph cache is trimmed to
 
 
 class CFreeTypeLibrary
@@ -94,6 +107,30 @@ public:
       return NULL;
 #endif // ! TARGET_WINDOWS
 
+    return SetSize(face, size, aspect);
+  };
+
+  /*! \brief Open another face of a font that was opened with GetFont() before.
+   A font in memory is shared with the existing face instead of loading it again, so
+   memoryBuf has to outlive the new face.
+   */
+  FT_Face GetSharedFont(const std::string &filename, float size, float aspect, const XUTILS::auto_buffer& memoryBuf)
+  {
+    if (memoryBuf.size() == 0)
+    {
+      XUTILS::auto_buffer unused;
+      return GetFont(filename, size, aspect, unused);
+    }
+
+    FT_Face face;
+    if (!m_library || FT_New_Memory_Face(m_library, (const FT_Byte*)memoryBuf.get(), memoryBuf.size(), 0, &face) != 0)
+      return NULL;
+
+    return SetSize(face, size, aspect);
+  }
+
+  static FT_Face SetSize(FT_Face face, float size, float aspect)
+  {
     unsigned int ydpi = 72; // 72 points to the inch is the freetype default
     unsigned int xdpi = (unsigned int)MathUtils::round_int(ydpi * aspect);
 
@@ -110,6 +147,28 @@ public:
     return face;
   };
 
+  FT_Stroker GetStroker(FT_Face face)
+  {
+    FT_Stroker stroker = GetStroker();
+    if (stroker)
+    {
+      /*
+       add on the strength of any border - the non-bordered font needs
+       aligning with the bordered font by utilising GetTextBaseLine()
+       */
+      FT_Stroker_Set(stroker, GetBorderStrength(face), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+    }
+    return stroker;
+  }
+
+  static FT_Pos GetBorderStrength(FT_Face face)
+  {
+    FT_Pos strength = FT_MulFix( face->units_per_EM, face->size->metrics.y_scale) / 12;
+    if (strength < 128)
+      strength = 128;
+    return strength;
+  }
+
   FT_Stroker GetStroker()
   {
     if (!m_library)
@@ -141,6 +200,83 @@ private:
 XBMC_GLOBAL_REF(CFreeTypeLibrary, g_freeTypeLibrary); // our freetype library
 #define g_freeTypeLibrary XBMC_GLOBAL_USE(CFreeTypeLibrary)
 
+struct CGUIFontTTFBase::RenderedGlyph
+{
+  character_t letterAndStyle = 0;
+  FT_Glyph glyph = nullptr; // bitmap of the character once rendered
+  FT_Pos advance = 0;
+};
+
+/*! \brief Missing characters of a text, rendered by the calling thread and jobs together.
+ FreeType faces must not be shared between threads, so each thread takes a face of its own
+ from the batch. Jobs that start after the batch is done leave right away.
+ */
+class CGUIFontTTFBase::CRasterizerBatch
+{
+public:
+  struct Face
+  {
+    FT_Face face = nullptr;
+    FT_Stroker stroker = nullptr;
+  };
+
+  explicit CRasterizerBatch(std::vector<RenderedGlyph>&& glyphs) : m_glyphs(std::move(glyphs)) {}
+
+  std::vector<RenderedGlyph>& Glyphs() { return m_glyphs; }
+
+  void AddFace(const Face& face) { m_faces.push_back(face); }
+  std::vector<Face> Faces() const { return m_faces; }
+
+  //! render glyphs with one of the faces for as long as there are glyphs left
+  void Work()
+  {
+    Face face;
+    {
+      CSingleLock lock(m_section);
+      if (m_done || m_faces.empty())
+        return;
+      face = m_faces.back();
+      m_faces.pop_back();
+      m_busy++;
+    }
+
+    Render(face.face, face.stroker);
+
+    CSingleLock lock(m_section);
+    m_faces.push_back(face);
+    if (--m_busy == 0)
+      m_idle.Set();
+  }
+
+  void Render(FT_Face face, FT_Stroker stroker)
+  {
+    for (size_t i = m_next++; i < m_glyphs.size(); i = m_next++)
+      RenderGlyph(face, stroker, m_glyphs[i]);
+  }
+
+  //! wait for the jobs that are rendering, the ones that didn't start yet won't render anything
+  void Finish()
+  {
+    {
+      CSingleLock lock(m_section);
+      m_done = true;
+      if (m_busy == 0)
+        return;
+      m_idle.Reset();
+    }
+    m_idle.Wait();
+  }
+
+private:
+  std::vector<RenderedGlyph> m_glyphs;
+  std::atomic<size_t> m_next{0};
+  CCriticalSection m_section;
+  std::vector<Face> m_faces; // faces that aren't in use
+  unsigned int m_busy = 0;
+  bool m_done = false;
+  CEvent m_idle;
+};
+
 CGUIFontTTFBase::CGUIFontTTFBase(const std::string& strFileName) : m_staticCache(*this), m_dynamicCache(*this)
 {
   m_texture = NULL;
@@ -152,6 +288,8 @@ CGUIFontTTFBase::CGUIFontTTFBase(const std::string& strFileName) : m_staticCache
 
   m_face = NULL;
   m_stroker = NULL;
+  m_aspect = 1.0f;
+  m_border = false;
   memset(m_charquick, 0, sizeof(m_charquick));
   m_strFileName = strFileName;
   m_referenceCount = 0;
@@ -207,6 +345,9 @@ void CGUIFontTTFBase::ClearCharacterCache()
 
 void CGUIFontTTFBase::Clear()
 {
+  SaveGlyphCache();
+  m_glyphCacheKey.clear();
+
   delete(m_texture);
   m_texture = NULL;
   delete[] m_char;
@@ -264,20 +405,11 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
 
   if (border)
   {
-    /*
-     add on the strength of any border - the non-bordered font needs
-     aligning with the bordered font by utilising GetTextBaseLine()
-     */
-    FT_Pos strength = FT_MulFix( m_face->units_per_EM, m_face->size->metrics.y_scale) / 12;
-    if (strength < 128)
-      strength = 128;
-
+    FT_Pos strength = CFreeTypeLibrary::GetBorderStrength(m_face);
     cellDescender -= strength;
     cellAscender  += strength;
 
-    m_stroker = g_freeTypeLibrary.GetStroker();
-    if (m_stroker)
-      FT_Stroker_Set(m_stroker, strength, FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+    m_stroker = g_freeTypeLibrary.GetStroker(m_face);
   }
 
   // scale to pixel sizing, rounding so that maximal extent is obtained
@@ -289,6 +421,8 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
   m_cellHeight   = cellAscender - cellDescender;
 
   m_height = height;
+  m_aspect = aspect;
+  m_border = border;
 
   delete(m_texture);
   m_texture = NULL;
@@ -313,6 +447,22 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
   m_posX = m_textureWidth;
   m_posY = -(int)GetTextureLineHeight();
 
+  // characters rendered by an earlier session of this font are picked up from the glyph cache
+  static std::once_flag pruneGlyphCache;
+  std::call_once(pruneGlyphCache, []() {
+    CGUIFontGlyphCache::Prune(GLYPH_CACHE_MAX_AGE, GLYPH_CACHE_MAX_SIZE);
+  });
+
+  struct __stat64 st;
+  if (XFILE::CFile::Stat(strFilename, &st) == 0)
+  {
+    m_glyphCacheKey = StringUtils::Format("%s|%lld|%lld|%f|%f|%d|%u", strFilename.c_str(),
+                                          static_cast<long long>(st.st_size),
+                                          static_cast<long long>(st.st_mtime), height, aspect,
+                                          border ? 1 : 0, m_textureWidth);
+    LoadGlyphCache();
+  }
+
   // cache the ellipses width
   Character *ellipse = GetCharacter(L'.');
   if (ellipse) m_ellipsesWidth = ellipse->advance;
@@ -444,9 +594,9 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS
     std::queue<Character> characters;
     if (alignment & XBFONT_TRUNCATED)
       GetCharacter(L'.');
-    for (const auto& pos : text)
+    for (vecText::const_iterator pos = text.begin(); pos != text.end(); ++pos)
     {
-      Character* ch = GetCharacter(pos);
+      Character* ch = GetCharacter(*pos, pos, text.end());
       if (!ch)
       {
         Character null = { 0 };
@@ -557,7 +707,8 @@ float CGUIFontTTFBase::GetTextWidthInternal(vecText::const_iterator start, vecTe
   float width = 0;
   while (start != end)
   {
-    Character *c = GetCharacter(*start++);
+    Character *c = GetCharacter(*start, start, end);
+    ++start;
     if (c)
     {
       // If last character in line, we want to add render width
@@ -598,7 +749,7 @@ unsigned int CGUIFontTTFBase::GetTextureLineHeight() const
   return m_cellHeight + spacing_between_characters_in_texture;
 }
 
-CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
+CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr, vecText::const_iterator lookAheadStart, vecText::const_iterator lookAheadEnd)
 {
   wchar_t letter = (wchar_t)(chr & 0xffff);
   character_t style = (chr & 0x7000000) >> 24;
@@ -618,17 +769,16 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   // letters are stored based on style and letter
   character_t ch = (style << 16) | letter;
 
-  int low = 0;
-  int high = m_numChars - 1;
-  while (low <= high)
+  int low = FindCharacter(ch);
+  if (low < m_numChars && m_char[low].letterAndStyle == ch)
+    return &m_char[low];
+
+  // the rest of the text is likely to miss as well, so render all of it at once
+  if (lookAheadStart != lookAheadEnd && CacheCharacters(chr, lookAheadStart, lookAheadEnd))
   {
-    int mid = (low + high) >> 1;
-    if (ch > m_char[mid].letterAndStyle)
-      low = mid + 1;
-    else if (ch < m_char[mid].letterAndStyle)
-      high = mid - 1;
-    else
-      return &m_char[mid];
+    low = FindCharacter(ch);
+    if (low < m_numChars && m_char[low].letterAndStyle == ch)
+      return &m_char[low];
   }
   // if we get to here, then low is where we should insert the new character
 
@@ -670,8 +820,15 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   }
   if (nestedBeginCount) Begin();
   m_nestedBeginCount = nestedBeginCount;
+  m_glyphCacheDirty = true;
+
+  UpdateQuickLookup();
 
-  // fixup quick access
+  return m_char + low;
+}
+
+void CGUIFontTTFBase::UpdateQuickLookup()
+{
   memset(m_charquick, 0, sizeof(m_charquick));
   for(int i=0;i<m_numChars;i++)
   {
@@ -681,44 +838,280 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
       m_charquick[ch] = m_char+i;
     }
   }
+}
 
-  return m_char + low;
+int CGUIFontTTFBase::FindCharacter(character_t letterAndStyle) const
+{
+  int low = 0;
+  int high = m_numChars - 1;
+  while (low <= high)
+  {
+    int mid = (low + high) >> 1;
+    if (letterAndStyle > m_char[mid].letterAndStyle)
+      low = mid + 1;
+    else if (letterAndStyle < m_char[mid].letterAndStyle)
+      high = mid - 1;
+    else
+      return mid;
+  }
+  return low;
 }
 
-bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
+bool CGUIFontTTFBase::CacheCharacters(character_t letter, vecText::const_iterator start, vecText::const_iterator end)
 {
-  int glyph_index = FT_Get_Char_Index( m_face, letter );
+  // collect the characters of the text we don't have yet
+  std::vector<RenderedGlyph> glyphs(1);
+  glyphs[0].letterAndStyle = (((letter & 0x7000000) >> 24) << 16) | (letter & 0xffff);
+  for (; start != end; ++start)
+  {
+    character_t ch = (((*start & 0x7000000) >> 24) << 16) | (*start & 0xffff);
+    if ((ch & 0xffff) == L'\r')
+      continue;
+    int pos = FindCharacter(ch);
+    if (pos >= m_numChars || m_char[pos].letterAndStyle != ch)
+    {
+      glyphs.emplace_back();
+      glyphs.back().letterAndStyle = ch;
+    }
+  }
+  std::sort(glyphs.begin(), glyphs.end(), [](const RenderedGlyph& a, const RenderedGlyph& b) { return a.letterAndStyle < b.letterAndStyle; });
+  glyphs.erase(std::unique(glyphs.begin(), glyphs.end(), [](const RenderedGlyph& a, const RenderedGlyph& b) { return a.letterAndStyle == b.letterAndStyle; }), glyphs.end());
+  if (glyphs.size() < 2)
+    return false;
+
+  // render them with a face per thread, the calling thread uses our own face. The extra faces
+  // share the font file with ours and are only kept for this text.
+  unsigned int threads = 1;
+  if (glyphs.size() >= MIN_PARALLEL_CHARACTERS)
+    threads = std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<unsigned int>(MAX_RASTERIZER_THREADS)));
+  auto batch = std::make_shared<CRasterizerBatch>(std::move(glyphs));
+  for (unsigned int i = 1; i < threads; ++i)
+  {
+    CRasterizerBatch::Face face;
+    face.face = g_freeTypeLibrary.GetSharedFont(m_strFilename, m_height, m_aspect, m_fontFileInMemory);
+    if (face.face && m_border)
+    {
+      face.stroker = g_freeTypeLibrary.GetStroker(face.face);
+      if (!face.stroker)
+      {
+        g_freeTypeLibrary.ReleaseFont(face.face);
+        face.face = nullptr;
+      }
+    }
+    if (!face.face)
+      break;
+    batch->AddFace(face);
+    CJobManager::GetInstance().Submit([batch]() { batch->Work(); }, CJob::PRIORITY_HIGH);
+  }
+  batch->Render(m_face, m_stroker);
+  batch->Finish();
+
+  for (const CRasterizerBatch::Face& face : batch->Faces())
+  {
+    if (face.stroker)
+      g_freeTypeLibrary.ReleaseStroker(face.stroker);
+    g_freeTypeLibrary.ReleaseFont(face.face);
+  }
+  glyphs = std::move(batch->Glyphs());
+
+  // and copy them to our texture, must End() as we can't render text to our texture during a Begin(), End() block
+  unsigned int nestedBeginCount = m_nestedBeginCount;
+  m_nestedBeginCount = 1;
+  if (nestedBeginCount) End();
+
+  bool cached = false;
+  for (const RenderedGlyph& glyph : glyphs)
+  {
+    if (!glyph.glyph)
+      continue;
+
+    int low = FindCharacter(glyph.letterAndStyle);
+    if (m_numChars >= m_maxChars)
+    {
+      Character *newTable = new Character[m_maxChars + CHAR_CHUNK];
+      if (m_char)
+      {
+        memcpy(newTable, m_char, low * sizeof(Character));
+        memcpy(newTable + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
+        delete[] m_char;
+      }
+      m_char = newTable;
+      m_maxChars += CHAR_CHUNK;
+    }
+    else
+      memmove(m_char + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
+
+    if (!CacheCharacter(glyph, m_char + low))
+    {
+      // out of texture space, take the slow path for the requested character
+      memmove(m_char + low, m_char + low + 1, (m_numChars - low) * sizeof(Character));
+      break;
+    }
+    cached = true;
+  }
+
+  for (RenderedGlyph& glyph : glyphs)
+  {
+    if (glyph.glyph)
+      FT_Done_Glyph(glyph.glyph);
+  }
+
+  if (nestedBeginCount) Begin();
+  m_nestedBeginCount = nestedBeginCount;
+
+  if (cached)
+  {
+    m_glyphCacheDirty = true;
+    UpdateQuickLookup();
+  }
+  return cached;
+}
+
+bool CGUIFontTTFBase::LoadGlyphCache()
+{
+  if (m_glyphCacheKey.empty())
+    return false;
+
+  CGUIFontGlyphCache cache(m_glyphCacheKey);
+  CGUIFontGlyphCache::Atlas atlas;
+  if (!cache.Load(atlas) || atlas.textureWidth != m_textureWidth ||
+      atlas.textureRows > m_renderSystem->GetMaxTextureSize())
+  {
+    CLog::Log(LOGDEBUG, "%s: no glyph cache for %s", __FUNCTION__, m_strFilename.c_str());
+    return false;
+  }
+
+  if (atlas.textureRows > 0)
+  {
+    unsigned int newHeight = atlas.textureRows;
+    CBaseTexture* newTexture = ReallocTexture(newHeight);
+    if (newTexture == NULL)
+    {
+      CLog::Log(LOGDEBUG, "%s: Failed to allocate new texture of height %u", __FUNCTION__, newHeight);
+      return false;
+    }
+    m_texture = newTexture;
+    CopyCharToTexture(atlas.pixels, atlas.pitch, 0, 0, m_textureWidth, atlas.textureRows);
+  }
+
+  delete[] m_char;
+  m_numChars = atlas.glyphs.size();
+  m_maxChars = (m_numChars / CHAR_CHUNK + 1) * CHAR_CHUNK;
+  m_char = new Character[m_maxChars];
+  for (int i = 0; i < m_numChars; i++)
+  {
+    const CGUIFontGlyphCache::Glyph& glyph = atlas.glyphs[i];
+    Character& ch = m_char[i];
+    ch.offsetX = glyph.offsetX;
+    ch.offsetY = glyph.offsetY;
+    ch.left = glyph.left;
+    ch.top = glyph.top;
+    ch.right = glyph.right;
+    ch.bottom = glyph.bottom;
+    ch.advance = glyph.advance;
+    ch.letterAndStyle = glyph.letterAndStyle;
+  }
+  m_posX = atlas.posX;
+  m_posY = atlas.posY;
+  UpdateQuickLookup();
+
+  m_glyphCacheDirty = false;
+  CLog::Log(LOGDEBUG, "%s: restored %i characters of %s from the glyph cache", __FUNCTION__, m_numChars, m_strFilename.c_str());
+  return true;
+}
+
+void CGUIFontTTFBase::SaveGlyphCache()
+{
+  if (!m_glyphCacheDirty || m_glyphCacheKey.empty() || m_numChars == 0)
+    return;
+  m_glyphCacheDirty = false;
+
+  CGUIFontGlyphCache::Atlas atlas;
+  atlas.textureWidth = m_textureWidth;
+  atlas.posX = m_posX;
+  atlas.posY = m_posY;
+  // only the rows up to the current texture line hold characters
+  if (m_texture && m_posY >= 0)
+  {
+    atlas.textureRows = std::min(m_posY + GetTextureLineHeight(), m_texture->GetHeight());
+    atlas.pixels = m_texture->GetPixels();
+    atlas.pitch = m_texture->GetPitch();
+  }
+
+  atlas.glyphs.resize(m_numChars);
+  for (int i = 0; i < m_numChars; i++)
+  {
+    const Character& ch = m_char[i];
+    CGUIFontGlyphCache::Glyph& glyph = atlas.glyphs[i];
+    glyph.offsetX = ch.offsetX;
+    glyph.offsetY = ch.offsetY;
+    glyph.left = ch.left;
+    glyph.top = ch.top;
+    glyph.right = ch.right;
+    glyph.bottom = ch.bottom;
+    glyph.advance = ch.advance;
+    glyph.letterAndStyle = ch.letterAndStyle;
+  }
+
+  CGUIFontGlyphCache(m_glyphCacheKey).Save(atlas);
+}
+
+bool CGUIFontTTFBase::RenderGlyph(FT_Face face, FT_Stroker stroker, RenderedGlyph& rendered)
+{
+  wchar_t letter = rendered.letterAndStyle & 0xffff;
+  uint32_t style = rendered.letterAndStyle >> 16;
+  int glyph_index = FT_Get_Char_Index( face, letter );
 
   FT_Glyph glyph = NULL;
-  if (FT_Load_Glyph( m_face, glyph_index, FT_LOAD_TARGET_LIGHT ))
+  if (FT_Load_Glyph( face, glyph_index, FT_LOAD_TARGET_LIGHT ))
   {
     CLog::Log(LOGDEBUG, "%s Failed to load glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
     return false;
   }
   // make bold if applicable
   if (style & FONT_STYLE_BOLD)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_BOLD);
+    SetGlyphStrength(face->glyph, GLYPH_STRENGTH_BOLD);
   // and italics if applicable
   if (style & FONT_STYLE_ITALICS)
-    ObliqueGlyph(m_face->glyph);
+    ObliqueGlyph(face->glyph);
   // and light if applicable
   if (style & FONT_STYLE_LIGHT)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_LIGHT);
+    SetGlyphStrength(face->glyph, GLYPH_STRENGTH_LIGHT);
   // grab the glyph
-  if (FT_Get_Glyph(m_face->glyph, &glyph))
+  if (FT_Get_Glyph(face->glyph, &glyph))
   {
     CLog::Log(LOGDEBUG, "%s Failed to get glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
     return false;
   }
-  if (m_stroker)
-    FT_Glyph_StrokeBorder(&glyph, m_stroker, 0, 1);
+  if (stroker)
+    FT_Glyph_StrokeBorder(&glyph, stroker, 0, 1);
   // render the glyph
   if (FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, NULL, 1))
   {
     CLog::Log(LOGDEBUG, "%s Failed to render glyph %x to a bitmap", __FUNCTION__, static_cast<uint32_t>(letter));
+    FT_Done_Glyph(glyph);
     return false;
   }
-  FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph;
+  rendered.glyph = glyph;
+  rendered.advance = face->glyph->advance.x;
+  return true;
+}
+
+bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
+{
+  RenderedGlyph glyph;
+  glyph.letterAndStyle = (style << 16) | letter;
+  if (!RenderGlyph(m_face, m_stroker, glyph))
+    return false;
+
+  bool cached = CacheCharacter(glyph, ch);
+  FT_Done_Glyph(glyph.glyph);
+  return cached;
+}
+
+bool CGUIFontTTFBase::CacheCharacter(const RenderedGlyph& glyph, Character *ch)
+{
+  FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph.glyph;
   FT_Bitmap bitmap = bitGlyph->bitmap;
   bool isEmptyGlyph = (bitmap.width == 0 || bitmap.rows == 0);
 
@@ -744,7 +1137,6 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
         if (newHeight > m_renderSystem->GetMaxTextureSize())
         {
           CLog::Log(LOGDEBUG, "%s: New cache texture is too large (%u > %u pixels long)", __FUNCTION__, newHeight, m_renderSystem->GetMaxTextureSize());
-          FT_Done_Glyph(glyph);
           return false;
         }
 
@@ -752,7 +1144,6 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
         newTexture = ReallocTexture(newHeight);
         if(newTexture == NULL)
         {
-          FT_Done_Glyph(glyph);
           CLog::Log(LOGDEBUG, "%s: Failed to allocate new texture of height %u", __FUNCTION__, newHeight);
           return false;
         }
@@ -762,20 +1153,19 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
 
     if(m_texture == NULL)
     {
-      FT_Done_Glyph(glyph);
       CLog::Log(LOGDEBUG, "%s: no texture to cache character to", __FUNCTION__);
       return false;
     }
   }
   // set the character in our table
-  ch->letterAndStyle = (style << 16) | letter;
+  ch->letterAndStyle = glyph.letterAndStyle;
   ch->offsetX = (short)bitGlyph->left;
   ch->offsetY = (short)m_cellBaseLine - bitGlyph->top;
   ch->left = isEmptyGlyph ? 0 : ((float)m_posX + ch->offsetX);
   ch->top = isEmptyGlyph ? 0 : ((float)m_posY + ch->offsetY);
   ch->right = ch->left + bitmap.width;
   ch->bottom = ch->top + bitmap.rows;
-  ch->advance = (float)MathUtils::round_int( (float)m_face->glyph->advance.x / 64 );
+  ch->advance = (float)MathUtils::round_int( (float)glyph.advance / 64 );
 
   // we need only render if we actually have some pixels
   if (!isEmptyGlyph)
@@ -785,15 +1175,12 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
     unsigned int y1 = std::max(m_posY + ch->offsetY, 0);
     unsigned int x2 = std::min(x1 + bitmap.width, m_textureWidth);
     unsigned int y2 = std::min(y1 + bitmap.rows, m_textureHeight);
-    CopyCharToTexture(bitGlyph, x1, y1, x2, y2);
+    CopyCharToTexture(bitmap.buffer, bitmap.pitch, x1, y1, x2, y2);
 
     m_posX += spacing_between_characters_in_texture + (unsigned short)std::max(ch->right - ch->left + ch->offsetX, ch->advance);
   }
   m_numChars++;
 
-  // free the glyph
-  FT_Done_Glyph(glyph);
-
   return true;
 }
 
@@ -968,8 +1355,8 @@ void CGUIFontTTFBase::SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength)
     return;
 
   /* some reasonable strength */
-  FT_Pos strength = FT_MulFix( m_face->units_per_EM,
-                    m_face->size->metrics.y_scale ) / glyphStrength;
+  FT_Pos strength = FT_MulFix( slot->face->units_per_EM,
+                    slot->face->size->metrics.y_scale ) / glyphStrength;
 
   FT_BBox bbox_before, bbox_after;
   FT_Outline_Get_CBox( &slot->outline, &bbox_before );
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <stdint.h>
 #include <vector>
@@ -110,17 +111,40 @@ protected:
   std::string m_strFilename;
 
   // Stuff for pre-rendering for speed
-  inline Character *GetCharacter(character_t letter);
+  struct RenderedGlyph;
+  class CRasterizerBatch;
+
+  /*! \brief Get a character, rendering it to our texture if needed.
+   \param letter the character with its style
+   \param lookAheadStart,lookAheadEnd the rest of the text the character is part of. Should the
+   character be missing, all missing characters of the text are rendered in one go.
+   */
+  inline Character *GetCharacter(character_t letter,
+                                 vecText::const_iterator lookAheadStart = vecText::const_iterator(),
+                                 vecText::const_iterator lookAheadEnd = vecText::const_iterator());
+  int FindCharacter(character_t letterAndStyle) const;
   bool CacheCharacter(wchar_t letter, uint32_t style, Character *ch);
+  bool CacheCharacter(const RenderedGlyph& glyph, Character *ch);
+  bool CacheCharacters(character_t letter, vecText::const_iterator start, vecText::const_iterator end);
+  static bool RenderGlyph(FT_Face face, FT_Stroker stroker, RenderedGlyph& glyph);
   void RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices);
   void ClearCharacterCache();
+  void UpdateQuickLookup();
+
+  /*! \brief Restore the characters and texture of an earlier session from the glyph cache.
+   The cache is keyed by the font file, its size and style, so no FreeType work is needed
+   for any character that was rendered with this font before.
+   \return true if characters were restored.
+   */
+  bool LoadGlyphCache();
+  void SaveGlyphCache();
 
   virtual CBaseTexture* ReallocTexture(unsigned int& newHeight) = 0;
-  virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
+  virtual bool CopyCharToTexture(const unsigned char* pixels, unsigned int pitch, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
   virtual void DeleteHardwareTexture() = 0;
 
   // modifying glyphs
-  void SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength);
+  static void SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength);
   static void ObliqueGlyph(FT_GlyphSlot slot);
 
   CBaseTexture* m_texture;        // texture that holds our rendered characters (8bit alpha only)
@@ -153,6 +177,8 @@ protected:
   // freetype stuff
   FT_Face    m_face;
   FT_Stroker m_stroker;
+  float m_aspect;
+  bool m_border;
 
   float m_originX;
   float m_originY;
@@ -177,6 +203,9 @@ protected:
   std::string m_strFileName;
   XUTILS::auto_buffer m_fontFileInMemory; // used only in some cases, see CFreeTypeLibrary::GetFont()
 
+  std::string m_glyphCacheKey;       // identifies font file, size and style in the glyph cache
+  bool m_glyphCacheDirty = false;    // characters were added since the glyph cache was loaded
+
   CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue> m_staticCache;
   CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue> m_dynamicCache;
 
@@ -14,6 +14,8 @@
 #include "rendering/dx/RenderContext.h"
 #include "utils/log.h"
 
+#include <algorithm>
+
 // stuff for freetype
 #include <ft2build.h>
 
@@ -30,6 +32,7 @@ CGUIFontTTFDX::CGUIFontTTFDX(const std::string& strFileName)
 : CGUIFontTTFBase(strFileName)
 {
   m_speedupTexture = nullptr;
+  m_updateY1 = m_updateY2 = 0;
   m_vertexBuffer   = nullptr;
   m_vertexWidth    = 0;
   m_buffers.clear();
@@ -63,6 +66,15 @@ bool CGUIFontTTFDX::FirstBegin()
   if (!DX::DeviceResources::Get()->GetD3DContext())
     return false;
 
+  // upload the characters cached since the last frame in one go
+  if (m_updateY2 > m_updateY1 && m_texture && m_speedupTexture && m_speedupTexture->Get())
+  {
+    CD3D11_BOX dstBox(0, m_updateY1, 0, m_textureWidth, m_updateY2, 1);
+    DX::DeviceResources::Get()->GetImmediateContext()->UpdateSubresource(m_speedupTexture->Get(), 0, &dstBox,
+      m_texture->GetPixels() + m_updateY1 * m_texture->GetPitch(), m_texture->GetPitch(), 0);
+  }
+  m_updateY1 = m_updateY2 = 0;
+
   CGUIShaderDX* pGUIShader = DX::Windowing()->GetGUIShader();
   pGUIShader->Begin(SHADER_METHOD_RENDER_FONT);
 
@@ -225,6 +237,7 @@ CBaseTexture* CGUIFontTTFDX::ReallocTexture(unsigned int& newHeight)
     m_texture = nullptr;
     delete m_speedupTexture;
     m_speedupTexture = nullptr;
+    m_updateY1 = m_updateY2 = 0;
   }
   m_staticCache.Flush();
   m_dynamicCache.Flush();
@@ -246,8 +259,13 @@ CBaseTexture* CGUIFontTTFDX::ReallocTexture(unsigned int& newHeight)
     pContext->CopySubresourceRegion(newSpeedupTexture->Get(), 0, 0, 0, 0, m_speedupTexture->Get(), 0, &rect);
   }
 
+  // keep the characters in system memory as well, the glyph cache is written from there
+  memset(pNewTexture->GetPixels(), 0, newHeight * pNewTexture->GetPitch());
   if (m_texture)
   {
+    for (unsigned int y = 0; y < std::min(m_texture->GetHeight(), newHeight); y++)
+      memcpy(pNewTexture->GetPixels() + y * pNewTexture->GetPitch(),
+             m_texture->GetPixels() + y * m_texture->GetPitch(), m_texture->GetPitch());
     delete m_texture;
     m_texture = nullptr;
   }
@@ -263,15 +281,25 @@ CBaseTexture* CGUIFontTTFDX::ReallocTexture(unsigned int& newHeight)
   return pNewTexture;
 }
 
-bool CGUIFontTTFDX::CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2)
+bool CGUIFontTTFDX::CopyCharToTexture(const unsigned char* pixels, unsigned int pitch, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2)
 {
-  FT_Bitmap bitmap = bitGlyph->bitmap;
-
-  ComPtr<ID3D11DeviceContext> pContext = DX::DeviceResources::Get()->GetImmediateContext();
-  if (m_speedupTexture && m_speedupTexture->Get() && pContext && bitmap.buffer)
+  if (m_speedupTexture && m_speedupTexture->Get() && pixels)
   {
-    CD3D11_BOX dstBox(x1, y1, 0, x2, y2, 1);
-    pContext->UpdateSubresource(m_speedupTexture->Get(), 0, &dstBox, bitmap.buffer, bitmap.pitch, 0);
+    unsigned char* target = m_texture->GetPixels() + y1 * m_texture->GetPitch() + x1;
+    for (unsigned int y = y1; y < y2; y++, pixels += pitch, target += m_texture->GetPitch())
+      memcpy(target, pixels, x2 - x1);
+
+    // the rows are uploaded on the next FirstBegin()
+    if (m_updateY2 > m_updateY1)
+    {
+      m_updateY1 = std::min(m_updateY1, y1);
+      m_updateY2 = std::max(m_updateY2, y2);
+    }
+    else
+    {
+      m_updateY1 = y1;
+      m_updateY2 = y2;
+    }
     return true;
   }
 
@@ -46,7 +46,7 @@ public:
 
 protected:
   CBaseTexture* ReallocTexture(unsigned int& newHeight) override;
-  bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) override;
+  bool CopyCharToTexture(const unsigned char* pixels, unsigned int pitch, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) override;
   void DeleteHardwareTexture() override;
 
 private:
@@ -56,6 +56,8 @@ private:
 
   unsigned m_vertexWidth;
   CD3DTexture* m_speedupTexture;  // extra texture to speed up reallocations
+  unsigned int m_updateY1;        // rows of m_texture not yet uploaded to m_speedupTexture
+  unsigned int m_updateY2;
   Microsoft::WRL::ComPtr<ID3D11Buffer> m_vertexBuffer;
   std::list<CD3DBuffer*> m_buffers;
 
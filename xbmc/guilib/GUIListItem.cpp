@@ -14,11 +14,71 @@
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
+#include <algorithm>
+#include <functional>
 #include <utility>
 
-bool CGUIListItem::icompare::operator()(const std::string &s1, const std::string &s2) const
+namespace
 {
-  return StringUtils::CompareNoCase(s1, s2) < 0;
+struct PropertyKeyLess
+{
+  template<typename Property>
+  bool operator()(const Property &property, const std::string &strKey) const
+  {
+    return StringUtils::CompareNoCase(property.first.Get(), strKey) < 0;
+  }
+};
+
+bool KeyLessNoCase(const std::string &left, const std::string &right)
+{
+  return StringUtils::CompareNoCase(left, right) < 0;
+}
+
+// the keys set on (nearly) every library item, sorted case insensitive
+const std::vector<std::string>& GetSharedKeys()
+{
+  // never destroyed, items may still be around when static objects are torn down
+  static const std::vector<std::string>* keys = []()
+  {
+    std::vector<std::string>* sharedKeys = new std::vector<std::string>{
+        "album_artist", "album_artist_array", "album_description", "album_genre",
+        "album_genre_array", "album_isboxset", "album_label", "album_mood", "album_mood_array",
+        "album_path", "album_rating", "album_releasetype", "album_style", "album_style_array",
+        "album_theme", "album_theme_array", "album_title", "album_totaldiscs", "album_type",
+        "album_userrating", "album_votes", "albumartistid", "artist_born", "artist_description",
+        "artist_died", "artist_disambiguation", "artist_disbanded", "artist_formed",
+        "artist_gender", "artist_genre", "artist_genre_array", "artist_instrument",
+        "artist_instrument_array", "artist_mood", "artist_mood_array", "artist_sortname",
+        "artist_style", "artist_style_array", "artist_type", "artist_yearsactive",
+        "artist_yearsactive_array", "artistid", "IsPlayable", "inprogressepisodes",
+        "isalbumartist", "item_start", "libraryartfilled", "numepisodes", "original_listitem_url",
+        "resumepoint", "roles", "songgenres", "sourceid", "StartPercent", "total", "totalepisodes",
+        "totalseasons", "unwatchedepisodes", "watchedepisodes"};
+    std::sort(sharedKeys->begin(), sharedKeys->end(), KeyLessNoCase);
+    return sharedKeys;
+  }();
+  return *keys;
+}
+
+template<typename T>
+size_t GetHeapUsage(const std::basic_string<T> &str)
+{
+  // short strings are stored in the string object itself
+  const char *data = reinterpret_cast<const char*>(str.data());
+  const char *object = reinterpret_cast<const char*>(&str);
+  if (data >= object && data < object + sizeof(str))
+    return 0;
+  return (str.capacity() + 1) * sizeof(T);
+}
+
+size_t GetHeapUsage(const CGUIListItem::ArtMap &art)
+{
+  // a map node has three pointers and a color next to the value
+  size_t usage = art.size() * (sizeof(CGUIListItem::ArtMap::value_type) + 4 * sizeof(void*));
+  for (const auto &i : art)
+    usage += GetHeapUsage(i.first) + GetHeapUsage(i.second);
+  return usage;
+}
 }
 
 CGUIListItem::CGUIListItem(const CGUIListItem& item)
@@ -229,7 +289,7 @@ void CGUIListItem::Archive(CArchive &ar)
     ar << (int)m_mapProperties.size();
     for (const auto& it : m_mapProperties)
     {
-      ar << it.first;
+      ar << it.first.Get();
       ar << it.second;
     }
     ar << (int)m_art.size();
@@ -296,7 +356,7 @@ void CGUIListItem::Serialize(CVariant &value)
 
   for (const auto& it : m_mapProperties)
   {
-    value["properties"][it.first] = it.second;
+    value["properties"][it.first.Get()] = it.second;
   }
   for (const auto& it : m_art)
     value["art"][it.first] = it.second;
@@ -351,10 +411,10 @@ void CGUIListItem::SetInvalid()
 
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
+  PropertyMap::iterator iter = std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey, PropertyKeyLess());
+  if (iter == m_mapProperties.end() || StringUtils::CompareNoCase(iter->first.Get(), strKey) != 0)
   {
-    m_mapProperties.insert(make_pair(strKey, value));
+    m_mapProperties.emplace(iter, CPropertyKey(strKey), value);
     SetInvalid();
   }
   else if (iter->second != value)
@@ -366,7 +426,7 @@ void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 
 const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::const_iterator iter = FindProperty(strKey);
   static CVariant nullVariant = CVariant(CVariant::VariantTypeNull);
 
   if (iter == m_mapProperties.end())
@@ -377,16 +437,21 @@ const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 
 bool CGUIListItem::HasProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::const_iterator iter = FindProperty(strKey);
   if (iter == m_mapProperties.end())
     return false;
 
   return true;
 }
 
+bool CGUIListItem::HasProperties() const
+{
+  return !m_mapProperties.empty();
+}
+
 void CGUIListItem::ClearProperty(const std::string &strKey)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::iterator iter = FindProperty(strKey);
   if (iter != m_mapProperties.end())
   {
     m_mapProperties.erase(iter);
@@ -427,7 +492,7 @@ void CGUIListItem::IncrementProperty(const std::string &strKey, double dVal)
 void CGUIListItem::AppendProperties(const CGUIListItem &item)
 {
   for (const auto& i : item.m_mapProperties)
-    SetProperty(i.first, i.second);
+    SetProperty(i.first.Get(), i.second);
 }
 
 void CGUIListItem::SetCurrentItem(unsigned int position)
@@ -439,3 +504,92 @@ unsigned int CGUIListItem::GetCurrentItem() const
 {
   return m_currentItem;
 }
+
+size_t CGUIListItem::GetMemoryUsage() const
+{
+  size_t usage = sizeof(CGUIListItem);
+  usage += GetHeapUsage(m_strLabel) + GetHeapUsage(m_strLabel2) + GetHeapUsage(m_sortLabel);
+
+  // other than strings the values are rarely more than a number
+  static const size_t inPlace = std::string().capacity();
+  usage += m_mapProperties.capacity() * sizeof(PropertyMap::value_type);
+  for (const auto& i : m_mapProperties)
+  {
+    if (!i.first.IsShared())
+      usage += sizeof(std::string) + GetHeapUsage(i.first.Get());
+    if (i.second.isString() && i.second.size() > inPlace)
+      usage += i.second.size() + 1;
+  }
+
+  usage += GetHeapUsage(m_art) + GetHeapUsage(m_artFallbacks);
+  return usage;
+}
+
+size_t CGUIListItem::GetStringMemoryUsage(const std::string &str)
+{
+  return GetHeapUsage(str);
+}
+
+CGUIListItem::PropertyMap::iterator CGUIListItem::FindProperty(const std::string &strKey)
+{
+  PropertyMap::iterator iter = std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey, PropertyKeyLess());
+  if (iter != m_mapProperties.end() && StringUtils::CompareNoCase(iter->first.Get(), strKey) == 0)
+    return iter;
+  return m_mapProperties.end();
+}
+
+CGUIListItem::PropertyMap::const_iterator CGUIListItem::FindProperty(const std::string &strKey) const
+{
+  PropertyMap::const_iterator iter = std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey, PropertyKeyLess());
+  if (iter != m_mapProperties.end() && StringUtils::CompareNoCase(iter->first.Get(), strKey) == 0)
+    return iter;
+  return m_mapProperties.end();
+}
+
+CGUIListItem::CPropertyKey::CPropertyKey(const std::string &key)
+{
+  // share the key only if it's spelled the same, the item keeps the spelling it was given
+  const std::vector<std::string>& keys = GetSharedKeys();
+  auto shared = std::lower_bound(keys.begin(), keys.end(), key, KeyLessNoCase);
+  if (shared != keys.end() && *shared == key)
+    m_key = &*shared;
+  else
+    m_key = new std::string(key);
+}
+
+CGUIListItem::CPropertyKey::CPropertyKey(const CPropertyKey &other)
+  : m_key(other.IsShared() ? other.m_key : new std::string(*other.m_key))
+{
+}
+
+CGUIListItem::CPropertyKey::CPropertyKey(CPropertyKey &&other) noexcept
+  : m_key(other.m_key)
+{
+  other.m_key = &GetSharedKeys().front();
+}
+
+CGUIListItem::CPropertyKey::~CPropertyKey()
+{
+  if (!IsShared())
+    delete m_key;
+}
+
+CGUIListItem::CPropertyKey& CGUIListItem::CPropertyKey::operator=(const CPropertyKey &other)
+{
+  if (&other != this)
+    *this = CPropertyKey(other);
+  return *this;
+}
+
+CGUIListItem::CPropertyKey& CGUIListItem::CPropertyKey::operator=(CPropertyKey &&other) noexcept
+{
+  std::swap(m_key, other.m_key);
+  return *this;
+}
+
+bool CGUIListItem::CPropertyKey::IsShared() const
+{
+  const std::vector<std::string>& keys = GetSharedKeys();
+  return std::less_equal<const std::string*>()(&keys.front(), m_key) &&
+         std::less_equal<const std::string*>()(m_key, &keys.back());
+}
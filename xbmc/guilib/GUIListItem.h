@@ -16,6 +16,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 //  Forward
 class CGUIListItemLayout;
@@ -156,7 +158,7 @@ public:
   void Serialize(CVariant& value);
 
   bool       HasProperty(const std::string &strKey) const;
-  bool       HasProperties() const { return !m_mapProperties.empty(); };
+  bool       HasProperties() const;
   void       ClearProperty(const std::string &strKey);
 
   const CVariant &GetProperty(const std::string &strKey) const;
@@ -175,7 +177,18 @@ public:
    */
   unsigned int GetCurrentItem() const;
 
+  /*! \brief Get the approximate memory used by the item.
+   Counts the item itself, its labels, properties and art. Meant to compare the cost of items and
+   listings, e.g. in debug logs, rather than to be exact.
+   \return the memory used in bytes.
+   */
+  virtual size_t GetMemoryUsage() const;
+
 protected:
+  /*! \brief Get the heap memory used by a string, 0 if it's short enough to be stored in place.
+   */
+  static size_t GetStringMemoryUsage(const std::string &str);
+
   std::string m_strLabel2;     // text of column2
   GUIIconOverlay m_overlayIcon; // type of overlay icon
 
@@ -184,14 +197,37 @@ protected:
   bool m_bSelected;     // item is selected or not
   unsigned int m_currentItem; // current item number within container (starting at 1)
 
-  struct icompare
+  /*! \brief Key of a property.
+   The keys the library sets on its items point into a fixed table shared by all items, any other
+   key is a copy owned by the item.
+   */
+  class CPropertyKey
   {
-    bool operator()(const std::string &s1, const std::string &s2) const;
+  public:
+    explicit CPropertyKey(const std::string &key);
+    CPropertyKey(const CPropertyKey &other);
+    CPropertyKey(CPropertyKey &&other) noexcept;
+    ~CPropertyKey();
+    CPropertyKey& operator=(const CPropertyKey &other);
+    CPropertyKey& operator=(CPropertyKey &&other) noexcept;
+
+    const std::string& Get() const { return *m_key; }
+    bool IsShared() const;
+
+  private:
+    const std::string* m_key;
   };
 
-  typedef std::map<std::string, CVariant, icompare> PropertyMap;
+  /*! \brief Properties sorted by key, case insensitive.
+   Items have a handful of properties and there can be tens of thousands of items in a listing, so
+   they are kept in a vector rather than a map.
+   */
+  typedef std::vector<std::pair<CPropertyKey, CVariant>> PropertyMap;
   PropertyMap m_mapProperties;
 private:
+  PropertyMap::iterator FindProperty(const std::string &strKey);
+  PropertyMap::const_iterator FindProperty(const std::string &strKey) const;
+
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
 
@@ -11,6 +11,7 @@
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 #include "DDSImage.h"
+#include "DXTCodec.h"
 #include "filesystem/File.h"
 #include "filesystem/ResourceFile.h"
 #include "filesystem/XbtFile.h"
@@ -25,6 +26,8 @@
 #include "rendering/RenderSystem.h"
 #include "utils/MemUtils.h"
 
+#include <vector>
+
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
@@ -110,8 +113,20 @@ void CBaseTexture::Update(unsigned int width, unsigned int height, unsigned int
   if (pixels == NULL)
     return;
 
-  if (format & XB_FMT_DXT_MASK)
-    return;
+  std::vector<unsigned char> decoded;
+  if ((format & XB_FMT_DXT_MASK) && !CServiceBroker::GetRenderSystem()->SupportsDXT())
+  {
+    // the GPU can't sample block compressed textures, decode them to ARGB
+    decoded.resize(width * height * 4);
+    if (!CDXTCodec::Decompress(pixels, width, height, format, decoded.data(), width * 4))
+    {
+      CLog::Log(LOGERROR, "%s - unsupported compressed texture format %u", __FUNCTION__, format);
+      return;
+    }
+    pixels = decoded.data();
+    pitch = width * 4;
+    format = XB_FMT_A8R8G8B8;
+  }
 
   Allocate(width, height, format);
 
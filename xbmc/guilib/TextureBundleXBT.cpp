@@ -57,6 +57,8 @@ void CTextureBundleXBT::CloseBundle()
     XFILE::CXbtManager::GetInstance().Release(CURL(m_path));
     CLog::Log(LOGDEBUG, "%s - Closed %sbundle", __FUNCTION__, m_themeBundle ? "theme " : "");
   }
+  m_unpackBuffer.clear();
+  m_unpackBuffer.shrink_to_fit();
 }
 
 bool CTextureBundleXBT::OpenBundle()
@@ -208,50 +210,39 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename, CBaseTexture*** ppT
 
 bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture)
 {
-  // found texture - allocate the necessary buffers
-  unsigned char *buffer = new unsigned char [(size_t)frame.GetPackedSize()];
-  if (buffer == NULL)
+  // frames of a memory mapped bundle are used straight from the mapping
+  std::unique_ptr<unsigned char[]> buffer;
+  const unsigned char* packed = m_XBTFReader->GetFrameData(frame);
+  if (packed == nullptr)
   {
-    CLog::Log(LOGERROR, "Out of memory loading texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetPackedSize());
-    return false;
-  }
-
-  // load the compressed texture
-  if (!m_XBTFReader->Load(frame, buffer))
-  {
-    CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
-    delete[] buffer;
-    return false;
+    buffer.reset(new unsigned char[static_cast<size_t>(frame.GetPackedSize())]);
+    if (!m_XBTFReader->Load(frame, buffer.get()))
+    {
+      CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
+      return false;
+    }
+    packed = buffer.get();
   }
 
   // check if it's packed with lzo
+  const unsigned char* pixels = packed;
   if (frame.IsPacked())
-  { // unpack
-    unsigned char *unpacked = new unsigned char[(size_t)frame.GetUnpackedSize()];
-    if (unpacked == NULL)
-    {
-      CLog::Log(LOGERROR, "Out of memory unpacking texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetUnpackedSize());
-      delete[] buffer;
-      return false;
-    }
+  { // unpack into our scratch buffer, it's reused for all textures of the bundle
+    if (m_unpackBuffer.size() < frame.GetUnpackedSize())
+      m_unpackBuffer.resize(static_cast<size_t>(frame.GetUnpackedSize()));
     lzo_uint s = (lzo_uint)frame.GetUnpackedSize();
-    if (lzo1x_decompress_safe(buffer, (lzo_uint)frame.GetPackedSize(), unpacked, &s, NULL) != LZO_E_OK ||
+    if (lzo1x_decompress_safe(packed, (lzo_uint)frame.GetPackedSize(), m_unpackBuffer.data(), &s, NULL) != LZO_E_OK ||
         s != frame.GetUnpackedSize())
     {
       CLog::Log(LOGERROR, "Error loading texture: %s: Decompression error", name.c_str());
-      delete[] buffer;
-      delete[] unpacked;
       return false;
     }
-    delete[] buffer;
-    buffer = unpacked;
+    pixels = m_unpackBuffer.data();
   }
 
   // create an xbmc texture
   *ppTexture = new CTexture();
-  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), buffer);
-
-  delete[] buffer;
+  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), pixels);
 
   return true;
 }
@@ -276,24 +267,32 @@ std::string CTextureBundleXBT::Normalize(const std::string &name)
 
 uint8_t* CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame)
 {
-  uint8_t* packedBuffer = new uint8_t[static_cast<size_t>(frame.GetPackedSize())];
-  if (packedBuffer == nullptr)
+  // packed frames of a memory mapped bundle are decompressed straight from the mapping
+  const uint8_t* mappedFrame = frame.IsPacked() ? reader.GetFrameData(frame) : nullptr;
+  uint8_t* packedBuffer = nullptr;
+  if (mappedFrame == nullptr)
   {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: out of memory loading frame with %" PRIu64" packed bytes", frame.GetPackedSize());
-    return nullptr;
-  }
+    packedBuffer = new uint8_t[static_cast<size_t>(frame.GetPackedSize())];
+    if (packedBuffer == nullptr)
+    {
+      CLog::Log(LOGERROR, "CTextureBundleXBT: out of memory loading frame with %" PRIu64" packed bytes", frame.GetPackedSize());
+      return nullptr;
+    }
 
-  // load the compressed texture
-  if (!reader.Load(frame, packedBuffer))
-  {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: error loading frame");
-    delete[] packedBuffer;
-    return nullptr;
-  }
+    // load the compressed texture
+    if (!reader.Load(frame, packedBuffer))
+    {
+      CLog::Log(LOGERROR, "CTextureBundleXBT: error loading frame");
+      delete[] packedBuffer;
+      return nullptr;
+    }
+
+    // if the frame isn't packed there's nothing else to be done
+    if (!frame.IsPacked())
+      return packedBuffer;
 
-  // if the frame isn't packed there's nothing else to be done
-  if (!frame.IsPacked())
-    return packedBuffer;
+    mappedFrame = packedBuffer;
+  }
 
   uint8_t* unpackedBuffer = new uint8_t[static_cast<size_t>(frame.GetUnpackedSize())];
   if (unpackedBuffer == nullptr)
@@ -313,7 +312,7 @@ uint8_t* CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader, const CXBTFFr
   }
 
   lzo_uint size = static_cast<lzo_uint>(frame.GetUnpackedSize());
-  if (lzo1x_decompress_safe(packedBuffer, static_cast<lzo_uint>(frame.GetPackedSize()), unpackedBuffer, &size, nullptr) != LZO_E_OK || size != frame.GetUnpackedSize())
+  if (lzo1x_decompress_safe(mappedFrame, static_cast<lzo_uint>(frame.GetPackedSize()), unpackedBuffer, &size, nullptr) != LZO_E_OK || size != frame.GetUnpackedSize())
   {
     CLog::Log(LOGERROR, "CTextureBundleXBT: failed to decompress frame with %" PRIu64" unpacked bytes to %" PRIu64" bytes", frame.GetPackedSize(), frame.GetUnpackedSize());
     delete[] packedBuffer;
@@ -49,6 +49,7 @@ private:
   bool m_themeBundle;
   std::string m_path;
   std::shared_ptr<CXBTFReader> m_XBTFReader;
+  std::vector<unsigned char> m_unpackBuffer; // scratch buffer for decompressing frames
 };
 
 
@@ -37,6 +37,7 @@
 #include "FFmpegImage.h"
 
 #include <inttypes.h>
+#include <iterator>
 
 /************************************************************************/
 /*                                                                      */
@@ -259,14 +260,10 @@ bool CGUITextureManager::HasTexture(const std::string &textureName, std::string
 
   // Check our loaded and bundled textures - we store in bundles using \\.
   std::string bundledName = CTextureBundle::Normalize(textureName);
-  for (int i = 0; i < (int)m_vecTextures.size(); ++i)
+  if (m_textures.find(textureName) != m_textures.end())
   {
-    CTextureMap *pMap = m_vecTextures[i];
-    if (pMap->GetName() == textureName)
-    {
-      if (size) *size = 1;
-      return true;
-    }
+    if (size) *size = 1;
+    return true;
   }
 
   for (int i = 0; i < 2; i++)
@@ -300,33 +297,34 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
 
   if (size) // we found the texture
   {
-    for (int i = 0; i < (int)m_vecTextures.size(); ++i)
+    auto it = m_textures.find(strTextureName);
+    if (it != m_textures.end())
     {
-      CTextureMap *pMap = m_vecTextures[i];
-      if (pMap->GetName() == strTextureName)
-      {
-        //CLog::Log(LOGDEBUG, "Total memusage %u", GetMemoryUsage());
-        return pMap->GetTexture();
-      }
+      //CLog::Log(LOGDEBUG, "Total memusage %u", GetMemoryUsage());
+      m_stats.hits++;
+      return it->second->GetTexture();
     }
     // Whoops, not there.
     return emptyTexture;
   }
 
-  for (ilistUnused i = m_unusedTextures.begin(); i != m_unusedTextures.end(); ++i)
+  auto unused = m_unusedIndex.find(strTextureName);
+  if (unused != m_unusedIndex.end())
   {
-    CTextureMap* pMap = i->first;
-    if (pMap->GetName() == strTextureName && i->second > 0)
-    {
-      m_vecTextures.push_back(pMap);
-      m_unusedTextures.erase(i);
-      return pMap->GetTexture();
-    }
+    CTextureMap* pMap = unused->second->map;
+    m_unusedMemory -= pMap->GetMemoryUsage();
+    m_unusedTextures.erase(unused->second);
+    m_unusedIndex.erase(unused);
+    AddTexture(pMap);
+    m_stats.hits++;
+    return pMap->GetTexture();
   }
 
   if (checkBundleOnly && bundle == -1)
     return emptyTexture;
 
+  m_stats.misses++;
+
   //Lock here, we will do stuff that could break rendering
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
@@ -366,7 +364,7 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
     delete[] pTextures;
     delete[] Delay;
 
-    m_vecTextures.push_back(pMap);
+    AddTexture(pMap);
     return pMap->GetTexture();
   }
   else if (StringUtils::EndsWithNoCase(strPath, ".gif") ||
@@ -423,7 +421,7 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
 
     file.Close();
 
-    m_vecTextures.push_back(pMap);
+    AddTexture(pMap);
     return pMap->GetTexture();
   }
 
@@ -450,7 +448,7 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
 
   CTextureMap* pMap = new CTextureMap(strTextureName, width, height, 0);
   pMap->Add(pTexture, 100);
-  m_vecTextures.push_back(pMap);
+  AddTexture(pMap);
 
 #ifdef _DEBUG_TEXTURES
   int64_t end, freq;
@@ -465,45 +463,70 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
 }
 
 
+void CGUITextureManager::AddTexture(CTextureMap* pMap)
+{
+  m_textures[pMap->GetName()] = pMap;
+  m_usedMemory += pMap->GetMemoryUsage();
+}
+
 void CGUITextureManager::ReleaseTexture(const std::string& strTextureName, bool immediately /*= false */)
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
-  ivecTextures i;
-  i = m_vecTextures.begin();
-  while (i != m_vecTextures.end())
+  auto it = m_textures.find(strTextureName);
+  if (it == m_textures.end())
+  {
+    CLog::Log(LOGWARNING, "%s: Unable to release texture %s", __FUNCTION__, strTextureName.c_str());
+    return;
+  }
+
+  CTextureMap* pMap = it->second;
+  if (pMap->Release())
   {
-    CTextureMap* pMap = *i;
-    if (pMap->GetName() == strTextureName)
+    //CLog::Log(LOGINFO, "  cleanup:%s", strTextureName.c_str());
+    // add to our textures to free
+    m_textures.erase(it);
+    m_usedMemory -= pMap->GetMemoryUsage();
+    m_unusedMemory += pMap->GetMemoryUsage();
+    if (immediately)
     {
-      if (pMap->Release())
-      {
-        //CLog::Log(LOGINFO, "  cleanup:%s", strTextureName.c_str());
-        // add to our textures to free
-        m_unusedTextures.emplace_back(pMap, immediately ? 0 : XbmcThreads::SystemClockMillis());
-        i = m_vecTextures.erase(i);
-      }
-      return;
+      // freed at the next opportunity and never revived, so it is kept out of the index
+      m_unusedTextures.emplace_front(pMap, 0);
+    }
+    else
+    {
+      // release times only grow, so appending keeps the list ordered
+      m_unusedTextures.emplace_back(pMap, XbmcThreads::SystemClockMillis());
+      m_unusedIndex[strTextureName] = std::prev(m_unusedTextures.end());
     }
-    ++i;
   }
-  CLog::Log(LOGWARNING, "%s: Unable to release texture %s", __FUNCTION__, strTextureName.c_str());
+}
+
+void CGUITextureManager::FreeUnusedTexture(UnusedList::iterator it)
+{
+  auto index = m_unusedIndex.find(it->map->GetName());
+  if (index != m_unusedIndex.end() && index->second == it)
+    m_unusedIndex.erase(index);
+
+  m_unusedMemory -= it->map->GetMemoryUsage();
+  m_stats.evictions++;
+  delete it->map;
+  m_unusedTextures.erase(it);
 }
 
 void CGUITextureManager::FreeUnusedTextures(unsigned int timeDelay)
 {
   unsigned int currFrameTime = XbmcThreads::SystemClockMillis();
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
-  for (ilistUnused i = m_unusedTextures.begin(); i != m_unusedTextures.end();)
-  {
-    if (currFrameTime - i->second >= timeDelay)
-    {
-      delete i->first;
-      i = m_unusedTextures.erase(i);
-    }
-    else
-      ++i;
-  }
+  while (!m_unusedTextures.empty() &&
+         (m_unusedTextures.front().releaseTime == 0 ||
+          currFrameTime - m_unusedTextures.front().releaseTime >= timeDelay))
+    FreeUnusedTexture(m_unusedTextures.begin());
+
+  // free the least recently released textures early if we're over budget
+  while (m_memoryBudget > 0 && !m_unusedTextures.empty() &&
+         m_usedMemory + m_unusedMemory > m_memoryBudget)
+    FreeUnusedTexture(m_unusedTextures.begin());
 
 #if defined(HAS_GL) || defined(HAS_GLES)
   for (unsigned int i = 0; i < m_unusedHwTextures.size(); ++i)
@@ -531,15 +554,13 @@ void CGUITextureManager::Cleanup()
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
-  ivecTextures i;
-  i = m_vecTextures.begin();
-  while (i != m_vecTextures.end())
+  for (const auto& it : m_textures)
   {
-    CTextureMap* pMap = *i;
-    CLog::Log(LOGWARNING, "%s: Having to cleanup texture %s", __FUNCTION__, pMap->GetName().c_str());
-    delete pMap;
-    i = m_vecTextures.erase(i);
+    CLog::Log(LOGWARNING, "%s: Having to cleanup texture %s", __FUNCTION__, it.first.c_str());
+    delete it.second;
   }
+  m_textures.clear();
+  m_usedMemory = 0;
   m_TexBundle[0].Close();
   m_TexBundle[1].Close();
   m_TexBundle[0] = CTextureBundle(true);
@@ -549,11 +570,14 @@ void CGUITextureManager::Cleanup()
 
 void CGUITextureManager::Dump() const
 {
-  CLog::Log(LOGDEBUG, "{0}: total texturemaps size: {1}", __FUNCTION__, m_vecTextures.size());
+  CLog::Log(LOGDEBUG, "{0}: total texturemaps size: {1}", __FUNCTION__, m_textures.size());
+  CLog::Log(LOGDEBUG, "{0}: {1} released texturemaps using {2} bytes, {3} hits {4} misses {5} evictions",
+            __FUNCTION__, m_unusedTextures.size(), m_unusedMemory, m_stats.hits, m_stats.misses,
+            m_stats.evictions);
 
-  for (int i = 0; i < (int)m_vecTextures.size(); ++i)
+  for (const auto& it : m_textures)
   {
-    const CTextureMap* pMap = m_vecTextures[i];
+    const CTextureMap* pMap = it.second;
     if (!pMap->IsEmpty())
       pMap->Dump();
   }
@@ -563,16 +587,16 @@ void CGUITextureManager::Flush()
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
-  ivecTextures i;
-  i = m_vecTextures.begin();
-  while (i != m_vecTextures.end())
+  auto i = m_textures.begin();
+  while (i != m_textures.end())
   {
-    CTextureMap* pMap = *i;
+    CTextureMap* pMap = i->second;
     pMap->Flush();
     if (pMap->IsEmpty() )
     {
+      m_usedMemory -= pMap->GetMemoryUsage();
       delete pMap;
-      i = m_vecTextures.erase(i);
+      i = m_textures.erase(i);
     }
     else
     {
@@ -583,12 +607,17 @@ void CGUITextureManager::Flush()
 
 unsigned int CGUITextureManager::GetMemoryUsage() const
 {
-  unsigned int memUsage = 0;
-  for (int i = 0; i < (int)m_vecTextures.size(); ++i)
-  {
-    memUsage += m_vecTextures[i]->GetMemoryUsage();
-  }
-  return memUsage;
+  return static_cast<unsigned int>(m_usedMemory);
+}
+
+void CGUITextureManager::SetMemoryBudget(uint64_t bytes)
+{
+  m_memoryBudget = bytes;
+}
+
+CGUITextureManager::Stats CGUITextureManager::GetStats() const
+{
+  return m_stats;
 }
 
 void CGUITextureManager::SetTexturePath(const std::string &texturePath)
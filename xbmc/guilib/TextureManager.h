@@ -13,6 +13,7 @@
 #include "threads/CriticalSection.h"
 
 #include <list>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -89,6 +90,16 @@ protected:
 class CGUITextureManager
 {
 public:
+  /*!
+   \brief Cache efficiency counters of the texture manager
+   */
+  struct Stats
+  {
+    uint64_t hits = 0;      ///< Load() calls served by a texture in use or recently released
+    uint64_t misses = 0;    ///< Load() calls that had to load the texture from a bundle or file
+    uint64_t evictions = 0; ///< released textures that were freed
+  };
+
   CGUITextureManager(void);
   virtual ~CGUITextureManager(void);
 
@@ -109,16 +120,39 @@ public:
 
   void FreeUnusedTextures(unsigned int timeDelay = 0); ///< Free textures (called from app thread only)
   void ReleaseHwTexture(unsigned int texture);
+
+  /*!
+   \brief Set the texture memory budget
+   Once the textures in use plus the released ones awaiting their free delay
+   exceed the budget, the least recently released textures are freed early.
+   \param bytes the budget in bytes, 0 for no limit
+   */
+  void SetMemoryBudget(uint64_t bytes);
+  Stats GetStats() const;
+
 protected:
-  std::vector<CTextureMap*> m_vecTextures;
-  std::list<std::pair<CTextureMap*, unsigned int> > m_unusedTextures;
+  struct UnusedTexture
+  {
+    UnusedTexture(CTextureMap* map, unsigned int releaseTime) : map(map), releaseTime(releaseTime) {}
+    CTextureMap* map;
+    unsigned int releaseTime; ///< 0 if the texture should be freed at the next opportunity
+  };
+  typedef std::list<UnusedTexture> UnusedList;
+
+  void AddTexture(CTextureMap* pMap);
+  void FreeUnusedTexture(UnusedList::iterator it);
+
+  std::unordered_map<std::string, CTextureMap*> m_textures; ///< textures in use, by name
+  UnusedList m_unusedTextures; ///< released textures, the next to be freed first
+  std::unordered_map<std::string, UnusedList::iterator> m_unusedIndex; ///< released textures that may be revived, by name
   std::vector<unsigned int> m_unusedHwTextures;
-  typedef std::vector<CTextureMap*>::iterator ivecTextures;
-  typedef std::list<std::pair<CTextureMap*, unsigned int> >::iterator ilistUnused;
+  uint64_t m_usedMemory = 0;
+  uint64_t m_unusedMemory = 0;
+  uint64_t m_memoryBudget = 0;
+  Stats m_stats;
   // we have 2 texture bundles (one for the base textures, one for the theme)
   CTextureBundle m_TexBundle[2];
 
   std::vector<std::string> m_texturePaths;
   CCriticalSection m_section;
 };
-
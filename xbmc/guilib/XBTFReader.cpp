@@ -21,6 +21,12 @@
 #include "platform/win32/PlatformDefs.h"
 #endif
 
+#if defined(TARGET_POSIX)
+#include "platform/posix/utils/Mmap.h"
+
+#include <system_error>
+#endif
+
 static bool ReadString(FILE* file, char* str, size_t max_length)
 {
   if (file == nullptr || str == nullptr || max_length <= 0)
@@ -164,6 +170,23 @@ bool CXBTFReader::Open(const std::string& path)
   if (pos != GetHeaderSize())
     return false;
 
+#if defined(TARGET_POSIX)
+  // map the whole file so frames can be used without reading them into a buffer first
+  struct stat fileStat;
+  if (fstat(fileno(m_file), &fileStat) == 0 && fileStat.st_size > 0)
+  {
+    try
+    {
+      m_map.reset(new KODI::UTILS::POSIX::CMmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fileno(m_file), 0));
+      m_mapModified = fileStat.st_mtime;
+    }
+    catch (const std::system_error&)
+    {
+      // fall back to reading the frames
+    }
+  }
+#endif
+
   return true;
 }
 
@@ -174,6 +197,9 @@ bool CXBTFReader::IsOpen() const
 
 void CXBTFReader::Close()
 {
+#if defined(TARGET_POSIX)
+  m_map.reset();
+#endif
   if (m_file != nullptr)
   {
     fclose(m_file);
@@ -196,11 +222,43 @@ time_t CXBTFReader::GetLastModificationTimestamp() const
   return fileStat.st_mtime;
 }
 
+#if defined(TARGET_POSIX)
+bool CXBTFReader::IsMapValid() const
+{
+  if (!m_map)
+    return false;
+
+  // the bundle may be rewritten in place while we're running (e.g. by TexturePacker), touching a
+  // mapped page past the new end of the file would raise SIGBUS
+  struct stat fileStat;
+  if (fstat(fileno(m_file), &fileStat) == -1)
+    return false;
+
+  return static_cast<uint64_t>(fileStat.st_size) >= m_map->Size() && fileStat.st_mtime == m_mapModified;
+}
+#endif
+
+const unsigned char* CXBTFReader::GetFrameData(const CXBTFFrame& frame) const
+{
+#if defined(TARGET_POSIX)
+  if (IsMapValid() && frame.GetOffset() <= m_map->Size() && frame.GetPackedSize() <= m_map->Size() - frame.GetOffset())
+    return static_cast<const unsigned char*>(m_map->Data()) + frame.GetOffset();
+#endif
+  return nullptr;
+}
+
 bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer) const
 {
   if (m_file == nullptr)
     return false;
 
+  const unsigned char* data = GetFrameData(frame);
+  if (data != nullptr)
+  {
+    memcpy(buffer, data, static_cast<size_t>(frame.GetPackedSize()));
+    return true;
+  }
+
 #if defined(TARGET_DARWIN) || defined(TARGET_FREEBSD)
   if (fseeko(m_file, static_cast<off_t>(frame.GetOffset()), SEEK_SET) == -1)
 #elif defined(TARGET_ANDROID)
@@ -15,6 +15,19 @@
 #include <string>
 #include <vector>
 
+#if defined(TARGET_POSIX)
+namespace KODI
+{
+namespace UTILS
+{
+namespace POSIX
+{
+class CMmap;
+}
+}
+}
+#endif
+
 class CXBTFReader : public CXBTFBase
 {
 public:
@@ -29,9 +42,22 @@ public:
 
   bool Load(const CXBTFFrame& frame, unsigned char* buffer) const;
 
+  /*!
+   \brief Get the (packed) data of a frame without copying it.
+   \return pointer into the memory mapped file or nullptr if the file isn't mapped or has been
+   changed since it was opened
+   */
+  const unsigned char* GetFrameData(const CXBTFFrame& frame) const;
+
 private:
   std::string m_path;
   FILE* m_file = nullptr;
+#if defined(TARGET_POSIX)
+  bool IsMapValid() const;
+
+  std::unique_ptr<KODI::UTILS::POSIX::CMmap> m_map;
+  time_t m_mapModified = 0;
+#endif
 };
 
 typedef std::shared_ptr<CXBTFReader> CXBTFReaderPtr;
@@ -10,6 +10,7 @@
 
 #include "guilib/guiinfo/GUIInfoProvider.h"
 
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
@@ -39,7 +40,15 @@ public:
   void SetLibraryBool(int condition, bool value);
   void ResetLibraryBools();
 
+  /*!
+   \brief Get a counter that changes whenever the library bools are set or reset.
+   \return the counter
+   */
+  unsigned int GetChangeCounter() const { return m_changeCounter; }
+
 private:
+  std::atomic<unsigned int> m_changeCounter{0};
+
   mutable int m_libraryHasMusic;
   mutable int m_libraryHasMovies;
   mutable int m_libraryHasTVShows;
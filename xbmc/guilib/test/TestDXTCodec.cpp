@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/DXTCodec.h"
+#include "guilib/TextureFormats.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::vector<unsigned char> CreateImage(unsigned int width, unsigned int height, bool alpha)
+{
+  std::vector<unsigned char> pixels(width * height * 4);
+  for (unsigned int y = 0; y < height; y++)
+  {
+    for (unsigned int x = 0; x < width; x++)
+    {
+      unsigned char* pixel = &pixels[(y * width + x) * 4];
+      pixel[0] = static_cast<unsigned char>(x * 255 / width);
+      pixel[1] = static_cast<unsigned char>(y * 255 / height);
+      pixel[2] = static_cast<unsigned char>(128 + x * 127 / width);
+      pixel[3] = alpha ? static_cast<unsigned char>((x + y) * 255 / (width + height)) : 255;
+    }
+  }
+  return pixels;
+}
+
+double MeanSquaredError(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b, int channel)
+{
+  double error = 0.0;
+  for (size_t i = channel; i < a.size(); i += 4)
+    error += (a[i] - b[i]) * (a[i] - b[i]);
+  return error / (a.size() / 4);
+}
+
+std::vector<unsigned char> RoundTrip(const std::vector<unsigned char>& pixels, unsigned int width,
+                                     unsigned int height, unsigned int format)
+{
+  std::vector<unsigned char> compressed(CDXTCodec::GetStorageSize(width, height, format));
+  EXPECT_TRUE(CDXTCodec::Compress(pixels.data(), width, height, width * 4, format, compressed.data()));
+
+  std::vector<unsigned char> decompressed(width * height * 4);
+  EXPECT_TRUE(CDXTCodec::Decompress(compressed.data(), width, height, format, decompressed.data(), width * 4));
+  return decompressed;
+}
+}
+
+TEST(TestDXTCodec, StorageSize)
+{
+  EXPECT_EQ(8u, CDXTCodec::GetStorageSize(4, 4, XB_FMT_DXT1));
+  EXPECT_EQ(16u, CDXTCodec::GetStorageSize(4, 4, XB_FMT_DXT5));
+  EXPECT_EQ(4u * 16u, CDXTCodec::GetStorageSize(5, 7, XB_FMT_DXT3));
+  EXPECT_EQ(0u, CDXTCodec::GetStorageSize(4, 4, XB_FMT_A8R8G8B8));
+}
+
+TEST(TestDXTCodec, UnsupportedFormats)
+{
+  unsigned char pixels[64] = {};
+  unsigned char data[16] = {};
+  EXPECT_FALSE(CDXTCodec::Compress(pixels, 4, 4, 16, XB_FMT_DXT3, data));
+  EXPECT_FALSE(CDXTCodec::Compress(pixels, 4, 4, 16, XB_FMT_A8R8G8B8, data));
+  EXPECT_FALSE(CDXTCodec::Decompress(data, 4, 4, XB_FMT_DXT5_YCoCg, pixels, 16));
+}
+
+TEST(TestDXTCodec, DecompressDXT1)
+{
+  // red and blue endpoints, four color mode: every pixel uses the first endpoint
+  const unsigned char fourColors[8] = { 0x00, 0xf8, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00 };
+  unsigned char pixels[64];
+  ASSERT_TRUE(CDXTCodec::Decompress(fourColors, 4, 4, XB_FMT_DXT1, pixels, 16));
+  for (int i = 0; i < 16; i++)
+  {
+    EXPECT_EQ(0, pixels[i * 4 + 0]);
+    EXPECT_EQ(0, pixels[i * 4 + 1]);
+    EXPECT_EQ(255, pixels[i * 4 + 2]);
+    EXPECT_EQ(255, pixels[i * 4 + 3]);
+  }
+
+  // swapped endpoints select the three color mode where index 3 is transparent black
+  const unsigned char threeColors[8] = { 0x1f, 0x00, 0x00, 0xf8, 0xff, 0xff, 0xff, 0xff };
+  ASSERT_TRUE(CDXTCodec::Decompress(threeColors, 4, 4, XB_FMT_DXT1, pixels, 16));
+  for (int i = 0; i < 64; i++)
+    EXPECT_EQ(0, pixels[i]);
+}
+
+TEST(TestDXTCodec, SolidColor)
+{
+  std::vector<unsigned char> pixels(8 * 8 * 4);
+  for (size_t i = 0; i < pixels.size(); i += 4)
+  {
+    pixels[i + 0] = 0x40;
+    pixels[i + 1] = 0x80;
+    pixels[i + 2] = 0xc0;
+    pixels[i + 3] = 0x20;
+  }
+
+  std::vector<unsigned char> decompressed = RoundTrip(pixels, 8, 8, XB_FMT_DXT5);
+  for (size_t i = 0; i < pixels.size(); i += 4)
+  {
+    EXPECT_NEAR(pixels[i + 0], decompressed[i + 0], 4);
+    EXPECT_NEAR(pixels[i + 1], decompressed[i + 1], 2);
+    EXPECT_NEAR(pixels[i + 2], decompressed[i + 2], 4);
+    EXPECT_EQ(pixels[i + 3], decompressed[i + 3]);
+  }
+}
+
+TEST(TestDXTCodec, RoundTripDXT1)
+{
+  std::vector<unsigned char> pixels = CreateImage(256, 128, false);
+  std::vector<unsigned char> decompressed = RoundTrip(pixels, 256, 128, XB_FMT_DXT1);
+  for (int channel = 0; channel < 3; channel++)
+    EXPECT_LT(MeanSquaredError(pixels, decompressed, channel), 8.0);
+  EXPECT_EQ(0.0, MeanSquaredError(pixels, decompressed, 3));
+}
+
+TEST(TestDXTCodec, RoundTripDXT5)
+{
+  std::vector<unsigned char> pixels = CreateImage(256, 128, true);
+  std::vector<unsigned char> decompressed = RoundTrip(pixels, 256, 128, XB_FMT_DXT5);
+  for (int channel = 0; channel < 4; channel++)
+    EXPECT_LT(MeanSquaredError(pixels, decompressed, channel), 8.0);
+}
+
+TEST(TestDXTCodec, PartialBlocks)
+{
+  // images that aren't a multiple of the block size must not be decoded past their edges
+  std::vector<unsigned char> pixels = CreateImage(5, 3, true);
+  std::vector<unsigned char> compressed(CDXTCodec::GetStorageSize(5, 3, XB_FMT_DXT5));
+  ASSERT_TRUE(CDXTCodec::Compress(pixels.data(), 5, 3, 5 * 4, XB_FMT_DXT5, compressed.data()));
+
+  const unsigned int pitch = 6 * 4;
+  std::vector<unsigned char> decompressed(pitch * 4, 0x55);
+  ASSERT_TRUE(CDXTCodec::Decompress(compressed.data(), 5, 3, XB_FMT_DXT5, decompressed.data(), pitch));
+  for (unsigned int y = 0; y < 4; y++)
+  {
+    for (unsigned int x = 0; x < 6; x++)
+    {
+      if (x < 5 && y < 3)
+        continue;
+      for (unsigned int c = 0; c < 4; c++)
+        EXPECT_EQ(0x55, decompressed[y * pitch + x * 4 + c]);
+    }
+  }
+}
@@ -0,0 +1,164 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/SpecialProtocol.h"
+#include "guilib/GUIFontGlyphCache.h"
+
+#include <string>
+#include <vector>
+
+#if defined(TARGET_POSIX)
+#include <utime.h>
+#endif
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const unsigned int WIDTH = 16;
+const unsigned int PITCH = 20;
+const unsigned int ROWS = 3;
+
+CGUIFontGlyphCache::Glyph MakeGlyph(uint32_t letterAndStyle, float position)
+{
+  CGUIFontGlyphCache::Glyph glyph;
+  glyph.offsetX = -3;
+  glyph.offsetY = 12;
+  glyph.left = position;
+  glyph.top = 0.5f;
+  glyph.right = position + 7.25f;
+  glyph.bottom = 14.0f;
+  glyph.advance = 8.125f;
+  glyph.letterAndStyle = letterAndStyle;
+  return glyph;
+}
+}
+
+class TestGUIFontGlyphCache : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    for (unsigned int i = 0; i < m_pixels.size(); i++)
+      m_pixels[i] = static_cast<unsigned char>(i);
+
+    m_atlas.textureWidth = WIDTH;
+    m_atlas.textureRows = ROWS;
+    m_atlas.posX = 9;
+    m_atlas.posY = -1;
+    m_atlas.glyphs.push_back(MakeGlyph('a', 0.0f));
+    m_atlas.glyphs.push_back(MakeGlyph(0x30000 | 0x4e2d, 8.0f));
+    m_atlas.pixels = m_pixels.data();
+    m_atlas.pitch = PITCH;
+  }
+
+  void TearDown() override { CGUIFontGlyphCache::Prune(0, 0); }
+
+  std::vector<unsigned char> m_pixels = std::vector<unsigned char>(PITCH * ROWS);
+  CGUIFontGlyphCache::Atlas m_atlas;
+};
+
+TEST_F(TestGUIFontGlyphCache, SaveAndLoad)
+{
+  const std::string key = "special://xbmc/media/Fonts/arial.ttf|123|456|20.0|1.0|0|1024";
+  ASSERT_TRUE(CGUIFontGlyphCache(key).Save(m_atlas));
+
+  CGUIFontGlyphCache cache(key);
+  CGUIFontGlyphCache::Atlas loaded;
+  ASSERT_TRUE(cache.Load(loaded));
+  EXPECT_EQ(WIDTH, loaded.textureWidth);
+  EXPECT_EQ(ROWS, loaded.textureRows);
+  EXPECT_EQ(9, loaded.posX);
+  EXPECT_EQ(-1, loaded.posY);
+
+  ASSERT_EQ(2u, loaded.glyphs.size());
+  for (unsigned int i = 0; i < loaded.glyphs.size(); i++)
+  {
+    const CGUIFontGlyphCache::Glyph& expected = m_atlas.glyphs[i];
+    const CGUIFontGlyphCache::Glyph& glyph = loaded.glyphs[i];
+    EXPECT_EQ(expected.offsetX, glyph.offsetX);
+    EXPECT_EQ(expected.offsetY, glyph.offsetY);
+    EXPECT_EQ(expected.left, glyph.left);
+    EXPECT_EQ(expected.top, glyph.top);
+    EXPECT_EQ(expected.right, glyph.right);
+    EXPECT_EQ(expected.bottom, glyph.bottom);
+    EXPECT_EQ(expected.advance, glyph.advance);
+    EXPECT_EQ(expected.letterAndStyle, glyph.letterAndStyle);
+  }
+
+  // only the used width of each row is stored
+  ASSERT_NE(nullptr, loaded.pixels);
+  for (unsigned int y = 0; y < ROWS; y++)
+  {
+    for (unsigned int x = 0; x < WIDTH; x++)
+      EXPECT_EQ(m_pixels[y * PITCH + x], loaded.pixels[y * loaded.pitch + x]);
+  }
+}
+
+TEST_F(TestGUIFontGlyphCache, OtherKeys)
+{
+  ASSERT_TRUE(CGUIFontGlyphCache("font|20").Save(m_atlas));
+
+  CGUIFontGlyphCache::Atlas loaded;
+  EXPECT_FALSE(CGUIFontGlyphCache("font|21").Load(loaded));
+  EXPECT_TRUE(CGUIFontGlyphCache("font|20").Load(loaded));
+
+  // a cache without glyphs is of no use
+  m_atlas.glyphs.clear();
+  ASSERT_TRUE(CGUIFontGlyphCache("font|20").Save(m_atlas));
+  EXPECT_FALSE(CGUIFontGlyphCache("font|20").Load(loaded));
+}
+
+TEST_F(TestGUIFontGlyphCache, PruneBySize)
+{
+  ASSERT_TRUE(CGUIFontGlyphCache("font|20").Save(m_atlas));
+  ASSERT_TRUE(CGUIFontGlyphCache("font|30").Save(m_atlas));
+
+  CGUIFontGlyphCache::Atlas loaded;
+  CGUIFontGlyphCache::Prune(3600, 1024 * 1024);
+  EXPECT_TRUE(CGUIFontGlyphCache("font|20").Load(loaded));
+  EXPECT_TRUE(CGUIFontGlyphCache("font|30").Load(loaded));
+
+  // no file fits
+  CGUIFontGlyphCache::Prune(3600, 100);
+  EXPECT_FALSE(CGUIFontGlyphCache("font|20").Load(loaded));
+  EXPECT_FALSE(CGUIFontGlyphCache("font|30").Load(loaded));
+}
+
+#if defined(TARGET_POSIX)
+TEST_F(TestGUIFontGlyphCache, PruneLeastRecentlyUsed)
+{
+  CGUIFontGlyphCache old("font|20");
+  ASSERT_TRUE(old.Save(m_atlas));
+  ASSERT_TRUE(CGUIFontGlyphCache("font|30").Save(m_atlas));
+  ASSERT_TRUE(CGUIFontGlyphCache("font|40").Save(m_atlas));
+
+  const time_t now = time(nullptr);
+  struct utimbuf times = {now - 7200, now - 7200};
+  ASSERT_EQ(0, utime(CSpecialProtocol::TranslatePath(old.GetPath()).c_str(), &times));
+  CGUIFontGlyphCache oldest("font|30");
+  times = {now - 7300, now - 7300};
+  ASSERT_EQ(0, utime(CSpecialProtocol::TranslatePath(oldest.GetPath()).c_str(), &times));
+
+  // the files are just over 100 bytes each, so two of them fit
+  CGUIFontGlyphCache::Prune(24 * 3600, 300);
+  CGUIFontGlyphCache::Atlas loaded;
+  EXPECT_FALSE(CGUIFontGlyphCache("font|30").Load(loaded));
+  EXPECT_TRUE(CGUIFontGlyphCache("font|40").Load(loaded));
+
+  // loading marks a file as used
+  EXPECT_TRUE(old.Load(loaded));
+  CGUIFontGlyphCache::Prune(3600, 1024 * 1024);
+  EXPECT_TRUE(CGUIFontGlyphCache("font|20").Load(loaded));
+  times = {now - 7200, now - 7200};
+  ASSERT_EQ(0, utime(CSpecialProtocol::TranslatePath(old.GetPath()).c_str(), &times));
+  CGUIFontGlyphCache::Prune(3600, 1024 * 1024);
+  EXPECT_FALSE(CGUIFontGlyphCache("font|20").Load(loaded));
+  EXPECT_TRUE(CGUIFontGlyphCache("font|40").Load(loaded));
+}
+#endif
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIListItem.h"
+#include "utils/Variant.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+TEST(TestGUIListItem, Properties)
+{
+  CGUIListItem item;
+  EXPECT_FALSE(item.HasProperties());
+  EXPECT_TRUE(item.GetProperty("missing").isNull());
+
+  item.SetProperty("TotalEpisodes", 24);
+  item.SetProperty("watchedepisodes", 12);
+  item.SetProperty("Artist", "Kodi");
+  EXPECT_TRUE(item.HasProperties());
+
+  // keys are case insensitive
+  EXPECT_TRUE(item.HasProperty("totalepisodes"));
+  EXPECT_EQ(24, item.GetProperty("TOTALEPISODES").asInteger());
+  EXPECT_EQ("Kodi", item.GetProperty("artist").asString());
+
+  item.SetProperty("WatchedEpisodes", 13);
+  EXPECT_EQ(13, item.GetProperty("watchedepisodes").asInteger());
+  item.IncrementProperty("watchedepisodes", 2);
+  EXPECT_EQ(15, item.GetProperty("WatchedEpisodes").asInteger());
+
+  item.ClearProperty("ARTIST");
+  EXPECT_FALSE(item.HasProperty("artist"));
+  EXPECT_TRUE(item.HasProperty("totalepisodes"));
+
+  item.ClearProperties();
+  EXPECT_FALSE(item.HasProperties());
+}
+
+TEST(TestGUIListItem, CopyAndAppendProperties)
+{
+  CGUIListItem item;
+  item.SetProperty("a", 1);
+  item.SetProperty("b", 2);
+
+  CGUIListItem copy(item);
+  copy.SetProperty("a", 3);
+  EXPECT_EQ(1, item.GetProperty("a").asInteger());
+  EXPECT_EQ(3, copy.GetProperty("a").asInteger());
+
+  CGUIListItem other;
+  other.SetProperty("B", 4);
+  other.SetProperty("c", 5);
+  item.AppendProperties(other);
+  EXPECT_EQ(1, item.GetProperty("a").asInteger());
+  EXPECT_EQ(4, item.GetProperty("b").asInteger());
+  EXPECT_EQ(5, item.GetProperty("c").asInteger());
+}
+
+TEST(TestGUIListItem, SerializeProperties)
+{
+  CGUIListItem item;
+  item.SetProperty("Zebra", "z");
+  item.SetProperty("apple", "a");
+  item.SetProperty("Mango", "m");
+
+  CVariant value;
+  item.Serialize(value);
+  ASSERT_TRUE(value["properties"].isObject());
+  EXPECT_EQ(3u, value["properties"].size());
+  // the first spelling of a key is kept
+  EXPECT_EQ("z", value["properties"]["Zebra"].asString());
+  EXPECT_EQ("a", value["properties"]["apple"].asString());
+  EXPECT_EQ("m", value["properties"]["Mango"].asString());
+}
+
+TEST(TestGUIListItem, MemoryUsage)
+{
+  CGUIListItem item;
+  const size_t empty = item.GetMemoryUsage();
+  EXPECT_GE(empty, sizeof(CGUIListItem));
+
+  item.SetLabel(std::string(100, 'x'));
+  const size_t label = item.GetMemoryUsage();
+  EXPECT_GE(label, empty + 100);
+
+  item.SetProperty("a rather long property key that is owned by the item", std::string(200, 'y'));
+  EXPECT_GE(item.GetMemoryUsage(), label + 200);
+
+  item.SetArt("thumb", std::string(300, 'z'));
+  EXPECT_GE(item.GetMemoryUsage(), label + 500);
+
+  item.ClearArt();
+  item.ClearProperties();
+  item.SetLabel("");
+  EXPECT_LT(item.GetMemoryUsage(), label + 500);
+}
+
+namespace
+{
+class CTestListItem : public CGUIListItem
+{
+public:
+  bool IsKeyShared(const std::string& key) const
+  {
+    for (const auto& i : m_mapProperties)
+    {
+      if (i.first.Get() == key)
+        return i.first.IsShared();
+    }
+    return false;
+  }
+};
+}
+
+TEST(TestGUIListItem, PropertyKeys)
+{
+  CTestListItem item;
+  item.SetProperty("watchedepisodes", 1);
+  item.SetProperty("WatchedEpisodes", 2);
+  item.SetProperty("TotalEpisodes", 3);
+  item.SetProperty("some.addon.property", 4);
+
+  // only the library keys spelled as the library does are shared, the rest is owned by the item
+  EXPECT_TRUE(item.IsKeyShared("watchedepisodes"));
+  EXPECT_FALSE(item.IsKeyShared("TotalEpisodes"));
+  EXPECT_FALSE(item.IsKeyShared("some.addon.property"));
+  EXPECT_EQ(2, item.GetProperty("watchedepisodes").asInteger());
+
+  CTestListItem copy;
+  copy = item;
+  item.ClearProperty("some.addon.property");
+  EXPECT_TRUE(copy.IsKeyShared("watchedepisodes"));
+  EXPECT_EQ(4, copy.GetProperty("some.addon.property").asInteger());
+  EXPECT_FALSE(item.HasProperty("some.addon.property"));
+
+  // inserting in front moves the owned keys around
+  copy.SetProperty("a", 5);
+  copy.SetProperty("aa", 6);
+  EXPECT_EQ(3, copy.GetProperty("totalepisodes").asInteger());
+  EXPECT_EQ(4, copy.GetProperty("SOME.ADDON.PROPERTY").asInteger());
+  EXPECT_EQ(6, copy.GetProperty("aa").asInteger());
+}
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "guilib/XBTF.h"
+#include "guilib/XBTFReader.h"
+#include "test/TestUtils.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+void WriteUInt32(FILE* file, uint32_t value)
+{
+  unsigned char data[4];
+  for (int i = 0; i < 4; i++)
+    data[i] = static_cast<unsigned char>(value >> (8 * i));
+  fwrite(data, sizeof(data), 1, file);
+}
+
+void WriteUInt64(FILE* file, uint64_t value)
+{
+  WriteUInt32(file, static_cast<uint32_t>(value));
+  WriteUInt32(file, static_cast<uint32_t>(value >> 32));
+}
+
+// writes a bundle with a single one frame texture like TexturePacker does, truncating the file
+bool WriteBundle(const std::string& path, const std::string& name, const std::vector<unsigned char>& data)
+{
+  FILE* file = fopen(path.c_str(), "wb");
+  if (file == nullptr)
+    return false;
+
+  fwrite(XBTF_MAGIC.c_str(), XBTF_MAGIC.size(), 1, file);
+  fwrite(XBTF_VERSION.c_str(), XBTF_VERSION.size(), 1, file);
+  WriteUInt32(file, 1);
+
+  char filePath[CXBTFFile::MaximumPathLength] = {};
+  strncpy(filePath, name.c_str(), sizeof(filePath) - 1);
+  fwrite(filePath, sizeof(filePath), 1, file);
+  WriteUInt32(file, 0); // loop
+  WriteUInt32(file, 1); // frames
+
+  const uint64_t headerSize = XBTF_MAGIC.size() + XBTF_VERSION.size() + sizeof(uint32_t) +
+                              sizeof(filePath) + 2 * sizeof(uint32_t) + CXBTFFrame().GetHeaderSize();
+  WriteUInt32(file, 1); // width
+  WriteUInt32(file, 1); // height
+  WriteUInt32(file, XB_FMT_A8R8G8B8);
+  WriteUInt64(file, data.size()); // packed size
+  WriteUInt64(file, data.size()); // unpacked size
+  WriteUInt32(file, 0); // duration
+  WriteUInt64(file, headerSize);
+
+  fwrite(data.data(), data.size(), 1, file);
+  return fclose(file) == 0;
+}
+}
+
+TEST(TestXBTFReader, ReadFrame)
+{
+  XFILE::CFile* file = XBMC_CREATETEMPFILE(".xbt");
+  ASSERT_NE(nullptr, file);
+  file->Close();
+  const std::string path = XBMC_TEMPFILEPATH(file);
+
+  const std::vector<unsigned char> data(64 * 1024, 'a');
+  ASSERT_TRUE(WriteBundle(path, "a.png", data));
+
+  CXBTFReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  CXBTFFile xbtfFile;
+  ASSERT_TRUE(reader.Get("a.png", xbtfFile));
+  ASSERT_EQ(1u, xbtfFile.GetFrames().size());
+
+  std::vector<unsigned char> buffer(data.size());
+  ASSERT_TRUE(reader.Load(xbtfFile.GetFrames()[0], buffer.data()));
+  EXPECT_EQ(data, buffer);
+
+  reader.Close();
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+TEST(TestXBTFReader, RewrittenWhileOpen)
+{
+  XFILE::CFile* file = XBMC_CREATETEMPFILE(".xbt");
+  ASSERT_NE(nullptr, file);
+  file->Close();
+  const std::string path = XBMC_TEMPFILEPATH(file);
+
+  ASSERT_TRUE(WriteBundle(path, "a.png", std::vector<unsigned char>(64 * 1024, 'a')));
+
+  CXBTFReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  CXBTFFile xbtfFile;
+  ASSERT_TRUE(reader.Get("a.png", xbtfFile));
+  const CXBTFFrame& frame = xbtfFile.GetFrames()[0];
+
+  // rewrite the bundle in place with a smaller one, the old frame now lies past the end
+  ASSERT_TRUE(WriteBundle(path, "b.png", std::vector<unsigned char>(16, 'b')));
+
+  // neither touches the pages that are gone
+  EXPECT_EQ(nullptr, reader.GetFrameData(frame));
+  std::vector<unsigned char> buffer(static_cast<size_t>(frame.GetPackedSize()));
+  EXPECT_FALSE(reader.Load(frame, buffer.data()));
+
+  // reopening picks up the new bundle
+  reader.Close();
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_FALSE(reader.Exists("a.png"));
+  EXPECT_TRUE(reader.Exists("b.png"));
+
+  reader.Close();
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
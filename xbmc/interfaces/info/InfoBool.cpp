@@ -12,13 +12,14 @@
 
 namespace INFO
 {
-  InfoBool::InfoBool(const std::string &expression, int context, unsigned int &refreshCounter)
+  InfoBool::InfoBool(const std::string &expression, int context, InfoRefreshCounters &refreshCounters)
     : m_value(false),
       m_context(context),
       m_listItemDependent(false),
+      m_sources(INFO_SOURCE_FRAME),
       m_expression(expression),
       m_refreshCounter(0),
-      m_parentRefreshCounter(refreshCounter)
+      m_refreshCounters(refreshCounters)
   {
     StringUtils::ToLower(m_expression);
   }
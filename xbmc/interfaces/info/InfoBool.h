@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -15,6 +16,65 @@ class CGUIListItem;
 
 namespace INFO
 {
+/*!
+ \ingroup info
+ \brief Sources of information an info bool depends on
+ */
+enum InfoSource
+{
+  INFO_SOURCE_NONE    = 0x00, ///< constant, never changes
+  INFO_SOURCE_FRAME   = 0x01, ///< anything that doesn't signal changes, refreshed every frame
+  INFO_SOURCE_SKIN    = 0x02, ///< skin settings and strings
+  INFO_SOURCE_LIBRARY = 0x04, ///< library content
+  INFO_SOURCE_ALL     = 0x07
+};
+
+/*!
+ \ingroup info
+ \brief Refresh counters of the info sources, shared by all info bools
+ */
+class InfoRefreshCounters
+{
+public:
+  /*! \brief Mark the given sources as changed
+   \param sources combination of InfoSource flags
+   */
+  void Invalidate(unsigned int sources)
+  {
+    ++m_generation;
+    for (unsigned int i = 0; i < SOURCE_COUNT; i++)
+    {
+      if (sources & (1 << i))
+        m_counters[i] = m_generation;
+    }
+  }
+
+  /*! \brief Get the refresh counter for the given sources, it changes whenever one of them changes
+   \param sources combination of InfoSource flags
+   */
+  unsigned int Get(unsigned int sources) const
+  {
+    unsigned int counter = 1;
+    for (unsigned int i = 0; i < SOURCE_COUNT; i++)
+    {
+      if ((sources & (1 << i)) && m_counters[i] > counter)
+        counter = m_counters[i];
+    }
+    return counter;
+  }
+
+  /*! \brief Number of info bool updates since last reset.
+   Bools are evaluated on other threads than the render thread too. The count is only a statistic,
+   so it needs no ordering.
+   */
+  std::atomic<unsigned int> m_evaluations{0};
+
+private:
+  static const unsigned int SOURCE_COUNT = 3;
+  unsigned int m_generation = 1;
+  unsigned int m_counters[SOURCE_COUNT] = {1, 1, 1};
+};
+
 /*!
  \ingroup info
  \brief Base class, wrapping boolean conditions and expressions
@@ -22,7 +82,7 @@ namespace INFO
 class InfoBool
 {
 public:
-  InfoBool(const std::string &expression, int context, unsigned int &refreshCounter);
+  InfoBool(const std::string &expression, int context, InfoRefreshCounters &refreshCounters);
   virtual ~InfoBool() = default;
 
   virtual void Initialize() {};
@@ -34,11 +94,19 @@ public:
   inline bool Get(const CGUIListItem *item = NULL)
   {
     if (item && m_listItemDependent)
+    {
       Update(item);
-    else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
+      m_refreshCounters.m_evaluations.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
     {
-      Update(NULL);
-      m_refreshCounter = m_parentRefreshCounter;
+      const unsigned int refreshCounter = m_refreshCounters.Get(m_sources);
+      if (m_refreshCounter != refreshCounter)
+      {
+        Update(NULL);
+        m_refreshCounters.m_evaluations.fetch_add(1, std::memory_order_relaxed);
+        m_refreshCounter = refreshCounter;
+      }
     }
     return m_value;
   }
@@ -66,16 +134,18 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+  unsigned int GetSources() const { return m_sources; }
 protected:
 
   bool m_value;                ///< current value
   int m_context;               ///< contextual information to go with the condition
   bool m_listItemDependent;    ///< do not cache if a listitem pointer is given
+  unsigned int m_sources;      ///< InfoSource flags, only re-evaluate if one of these changed
   std::string  m_expression;   ///< original expression
 
 private:
   unsigned int m_refreshCounter;
-  unsigned int &m_parentRefreshCounter;
+  InfoRefreshCounters &m_refreshCounters;
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
@@ -11,8 +11,10 @@
 #include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "guilib/GUIComponent.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <iterator>
 #include <list>
 #include <memory>
 #include <stack>
@@ -22,6 +24,62 @@ using namespace INFO;
 void InfoSingle::Initialize()
 {
   m_condition = CServiceBroker::GetGUI()->GetInfoManager().TranslateSingleString(m_expression, m_listItemDependent);
+  m_sources = TranslateSources(m_expression);
+}
+
+/* Work out which sources a condition reads from. Only a few sources signal
+ * their changes (see CGUIInfoManager::InvalidateSources), anything else is
+ * assumed to change every frame.
+ */
+unsigned int InfoSingle::TranslateSources(const std::string &condition)
+{
+  if (condition == "true" || condition == "yes" || condition == "false" || condition == "no" ||
+      StringUtils::StartsWith(condition, "system.platform."))
+    return INFO_SOURCE_NONE;
+
+  if (StringUtils::StartsWith(condition, "skin.hassetting(") ||
+      StringUtils::StartsWith(condition, "skin.string(") ||
+      StringUtils::StartsWith(condition, "skin.hastheme("))
+    return INFO_SOURCE_SKIN;
+
+  if (StringUtils::StartsWith(condition, "library.hascontent("))
+    return INFO_SOURCE_LIBRARY;
+
+  if ((StringUtils::StartsWith(condition, "string.") || StringUtils::StartsWith(condition, "integer.")) &&
+      StringUtils::EndsWith(condition, ")"))
+  {
+    // comparisons depend on the info they compare, the remaining parameters are usually literals
+    const size_t pos = condition.find('(');
+    if (pos == std::string::npos)
+      return INFO_SOURCE_FRAME;
+
+    std::vector<std::string> params;
+    int depth = 0;
+    size_t start = pos + 1;
+    for (size_t i = start; i < condition.size() - 1; i++)
+    {
+      if (condition[i] == '(')
+        depth++;
+      else if (condition[i] == ')')
+        depth--;
+      else if (condition[i] == ',' && depth == 0)
+      {
+        params.push_back(condition.substr(start, i - start));
+        start = i + 1;
+      }
+    }
+    params.push_back(condition.substr(start, condition.size() - 1 - start));
+
+    unsigned int sources = TranslateSources(StringUtils::Trim(params[0]));
+    for (size_t i = 1; i < params.size(); i++)
+    {
+      if (params[i].find_first_of(".($") != std::string::npos)
+        return INFO_SOURCE_FRAME;
+    }
+    return sources;
+  }
+
+  return INFO_SOURCE_FRAME;
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
@@ -34,13 +92,58 @@ void InfoExpression::Initialize()
   if (!Parse(m_expression))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression %s", m_expression.c_str());
-    m_expression_tree = std::make_shared<InfoLeaf>(CServiceBroker::GetGUI()->GetInfoManager().Register("false", 0), false);
+    m_expression_tree = std::make_shared<InfoLeaf>(RegisterOperand("false"), false);
+    m_sources = INFO_SOURCE_NONE;
   }
+  Compile();
+}
+
+InfoPtr InfoExpression::RegisterOperand(const std::string &operand)
+{
+  return CServiceBroker::GetGUI()->GetInfoManager().Register(operand, m_context);
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
-  m_value = m_expression_tree->Evaluate(item);
+  if (m_reordered)
+  {
+    m_reordered = false;
+    Compile();
+  }
+
+  /* Run the compiled expression. Every child of a group ends with a test of
+   * the current value, leaving the group as soon as its value is known.
+   */
+  const Instruction *program = m_program.data();
+  const size_t size = m_program.size();
+  bool value = false;
+  size_t pc = 0;
+  while (pc < size)
+  {
+    const Instruction &instruction = program[pc];
+    if (instruction.info)
+      value = instruction.invert ^ instruction.info->Get(item);
+
+    if (instruction.group && value == instruction.exitValue)
+    {
+      if (instruction.child > 0)
+      {
+        /* Move this child to the head of its group so we evaluate faster next time */
+        instruction.group->Promote(instruction.child);
+        m_reordered = true;
+      }
+      pc = instruction.target;
+    }
+    else
+      pc++;
+  }
+  m_value = value;
+}
+
+void InfoExpression::Compile()
+{
+  m_program.clear();
+  m_expression_tree->Compile(m_program);
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
@@ -61,9 +164,10 @@ void InfoExpression::Update(const CGUIListItem *item)
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(const CGUIListItem *item)
+void InfoExpression::InfoLeaf::Compile(std::vector<Instruction> &program)
 {
-  return m_invert ^ m_info->Get(item);
+  Instruction instruction = {m_info.get(), nullptr, 0, 0, m_invert, false};
+  program.push_back(instruction);
 }
 
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
@@ -86,27 +190,44 @@ void InfoExpression::InfoAssociativeGroup::Merge(std::shared_ptr<InfoAssociative
   m_children.splice(m_children.end(), other->m_children);
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(const CGUIListItem *item)
+void InfoExpression::InfoAssociativeGroup::Promote(unsigned int child)
+{
+  std::list<InfoSubexpressionPtr>::iterator it = std::next(m_children.begin(), child);
+  m_children.push_front(*it);
+  m_children.erase(it);
+}
+
+void InfoExpression::InfoAssociativeGroup::Compile(std::vector<Instruction> &program)
 {
-  /* Handle either AND or OR by using the relation
-   * A AND B == !(!A OR !B)
-   * to convert ANDs into ORs
+  /* An OR group is done as soon as a child is true, an AND group as soon as
+   * a child is false. The value of the group is the value of the last child
+   * evaluated, so the last instruction of every child may leave the group.
+   * Leaf children test their value in the same instruction.
    */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(item);
-  while (!result && ++it != last)
+  const size_t start = program.size();
+  unsigned int child = 0;
+  for (const auto &it : m_children)
   {
-    result = use_and ^ (*it)->Evaluate(item);
-    if (result)
+    it->Compile(program);
+    if (it->Type() != NODE_LEAF)
     {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
+      // nested groups need an extra instruction to test their value
+      Instruction instruction = {nullptr, nullptr, 0, 0, false, false};
+      program.push_back(instruction);
     }
+
+    Instruction &exit = program.back();
+    exit.group = this;
+    exit.child = child++;
+    exit.exitValue = (m_type == NODE_OR);
+  }
+
+  const unsigned int end = program.size();
+  for (size_t i = start; i < end; i++)
+  {
+    if (program[i].group == this)
+      program[i].target = end;
   }
-  return use_and ^ result;
 }
 
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
@@ -208,7 +329,8 @@ bool InfoExpression::Parse(const std::string &expression)
   bool after_binaryoperator = true;
   int bracket_count = 0;
 
-  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  // collected from the operands
+  m_sources = INFO_SOURCE_NONE;
 
   char c;
   // Skip leading whitespace - don't want it to count as an operand if that's all there is
@@ -236,14 +358,15 @@ bool InfoExpression::Parse(const std::string &expression)
       }
       if (!operand.empty())
       {
-        InfoPtr info = infoMgr.Register(operand, m_context);
+        InfoPtr info = RegisterOperand(operand);
         if (!info)
         {
           CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
           return false;
         }
-        /* Propagate any listItem dependency from the operand to the expression */
+        /* Propagate any listItem dependency and sources from the operand to the expression */
         m_listItemDependent |= info->ListItemDependent();
+        m_sources |= info->GetSources();
         nodes.push(std::make_shared<InfoLeaf>(info, invert));
         /* Reuse operand string for next operand */
         operand.clear();
@@ -287,14 +410,15 @@ bool InfoExpression::Parse(const std::string &expression)
   }
   if (!operand.empty())
   {
-    InfoPtr info = infoMgr.Register(operand, m_context);
+    InfoPtr info = RegisterOperand(operand);
     if (!info)
     {
       CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
       return false;
     }
-    /* Propagate any listItem dependency from the operand to the expression */
+    /* Propagate any listItem dependency and sources from the operand to the expression */
     m_listItemDependent |= info->ListItemDependent();
+    m_sources |= info->GetSources();
     nodes.push(std::make_shared<InfoLeaf>(info, invert));
   }
   while (!operator_stack.empty())
@@ -23,12 +23,14 @@ namespace INFO
 class InfoSingle : public InfoBool
 {
 public:
-  InfoSingle(const std::string &expression, int context, unsigned int &refreshCounter)
-    : InfoBool(expression, context, refreshCounter) {};
+  InfoSingle(const std::string &expression, int context, InfoRefreshCounters &refreshCounters)
+    : InfoBool(expression, context, refreshCounters) {};
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
 private:
+  static unsigned int TranslateSources(const std::string &condition);
+
   int m_condition;             ///< actual condition this represents
 };
 
@@ -37,13 +39,21 @@ private:
 class InfoExpression : public InfoBool
 {
 public:
-  InfoExpression(const std::string &expression, int context, unsigned int &refreshCounter)
-    : InfoBool(expression, context, refreshCounter) {};
+  InfoExpression(const std::string &expression, int context, InfoRefreshCounters &refreshCounters)
+    : InfoBool(expression, context, refreshCounters) {};
   ~InfoExpression() override = default;
 
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
+
+protected:
+  /*! \brief Register an operand of the expression
+   \param operand the boolean condition
+   \return the info bool evaluated for the operand, empty if the operand is invalid
+   */
+  virtual InfoPtr RegisterOperand(const std::string &operand);
+
 private:
   typedef enum
   {
@@ -62,12 +72,25 @@ private:
     NODE_OR,
   } node_type_t;
 
+  class InfoAssociativeGroup;
+
+  // An instruction of the compiled expression: evaluate an info bool and/or leave a group
+  struct Instruction
+  {
+    InfoBool *info;              // info bool to evaluate, nullptr to only test the current value
+    InfoAssociativeGroup *group; // group to leave once its value is known, nullptr for none
+    unsigned int target;         // instruction following the group
+    unsigned int child;          // position of the child just evaluated within the group
+    bool invert;                 // negate the value of the info bool
+    bool exitValue;              // value deciding the group, true for OR and false for AND
+  };
+
   // An abstract base class for nodes in the expression tree
   class InfoSubexpression
   {
   public:
     virtual ~InfoSubexpression(void) = default; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(const CGUIListItem *item) = 0;
+    virtual void Compile(std::vector<Instruction> &program) = 0;
     virtual node_type_t Type() const=0;
   };
 
@@ -78,7 +101,7 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(info), m_invert(invert) {};
-    bool Evaluate(const CGUIListItem *item) override;
+    void Compile(std::vector<Instruction> &program) override;
     node_type_t Type() const override { return NODE_LEAF; };
   private:
     InfoPtr m_info;
@@ -92,7 +115,8 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(std::shared_ptr<InfoAssociativeGroup> other);
-    bool Evaluate(const CGUIListItem *item) override;
+    void Promote(unsigned int child);
+    void Compile(std::vector<Instruction> &program) override;
     node_type_t Type() const override { return m_type; };
   private:
     node_type_t m_type;
@@ -102,7 +126,11 @@ private:
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
   bool Parse(const std::string &expression);
+  void Compile();
+
   InfoSubexpressionPtr m_expression_tree;
+  std::vector<Instruction> m_program; ///< m_expression_tree compiled to a flat, short-circuiting form
+  bool m_reordered = false;           ///< tree was reordered since m_program was compiled
 };
 
 };
@@ -0,0 +1,153 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/info/InfoExpression.h"
+#include "test/TestUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace INFO;
+
+namespace
+{
+// An operand whose value changes from frame to frame without asking the info manager
+class CBenchInfo : public InfoBool
+{
+public:
+  CBenchInfo(const std::string &expression, InfoRefreshCounters &refreshCounters)
+    : InfoBool(expression, 0, refreshCounters),
+      m_seed(std::hash<std::string>()(expression))
+  {
+  }
+
+  void Update(const CGUIListItem *item) override
+  {
+    m_value = ((m_seed + m_updates++) % 3) == 0;
+  }
+
+private:
+  size_t m_seed;
+  unsigned int m_updates = 0;
+};
+
+class CBenchExpression : public InfoExpression
+{
+public:
+  CBenchExpression(const std::string &expression, InfoRefreshCounters &refreshCounters,
+                   std::map<std::string, InfoPtr> &operands)
+    : InfoExpression(expression, 0, refreshCounters),
+      m_refreshCounters(refreshCounters),
+      m_operands(operands)
+  {
+  }
+
+protected:
+  InfoPtr RegisterOperand(const std::string &operand) override
+  {
+    InfoPtr &info = m_operands[operand];
+    if (!info)
+      info = std::make_shared<CBenchInfo>(operand, m_refreshCounters);
+    return info;
+  }
+
+private:
+  InfoRefreshCounters &m_refreshCounters;
+  std::map<std::string, InfoPtr> &m_operands;
+};
+
+void CollectConditions(const TiXmlElement *element, std::vector<std::string> &conditions)
+{
+  for (; element; element = element->NextSiblingElement())
+  {
+    std::string condition;
+    if ((element->ValueStr() == "visible" || element->ValueStr() == "enable") && element->FirstChild())
+      condition = element->FirstChild()->ValueStr();
+    else if (element->Attribute("condition"))
+      condition = element->Attribute("condition");
+
+    // only expressions, single conditions don't go through InfoExpression
+    if (condition.find_first_of("|+[]!") != std::string::npos)
+      conditions.push_back(condition);
+
+    CollectConditions(element->FirstChildElement(), conditions);
+  }
+}
+
+// Conditions of the default skin's includes, the most widely used ones
+const std::vector<std::string> &Conditions()
+{
+  static std::vector<std::string> conditions;
+  if (conditions.empty())
+  {
+    CXBMCTinyXML doc;
+    if (doc.LoadFile(CXBMCTestUtils::Instance().ReferenceFilePath("addons/skin.estuary/xml/Includes.xml")))
+      CollectConditions(doc.RootElement(), conditions);
+  }
+  return conditions;
+}
+}
+
+static void BM_InfoExpression_Initialize(benchmark::State& state)
+{
+  const std::vector<std::string> &conditions = Conditions();
+  if (conditions.empty())
+  {
+    state.SkipWithError("failed to load skin includes");
+    return;
+  }
+
+  InfoRefreshCounters refreshCounters;
+  std::map<std::string, InfoPtr> operands;
+  for (auto _ : state)
+  {
+    for (const auto &condition : conditions)
+    {
+      CBenchExpression expression(condition, refreshCounters, operands);
+      expression.Initialize();
+      benchmark::DoNotOptimize(expression);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * conditions.size());
+}
+BENCHMARK(BM_InfoExpression_Initialize);
+
+static void BM_InfoExpression_Evaluate(benchmark::State& state)
+{
+  const std::vector<std::string> &conditions = Conditions();
+  if (conditions.empty())
+  {
+    state.SkipWithError("failed to load skin includes");
+    return;
+  }
+
+  InfoRefreshCounters refreshCounters;
+  std::map<std::string, InfoPtr> operands;
+  std::vector<InfoPtr> expressions;
+  for (const auto &condition : conditions)
+  {
+    expressions.emplace_back(std::make_shared<CBenchExpression>(condition, refreshCounters, operands));
+    expressions.back()->Initialize();
+  }
+
+  // every iteration is a frame, operands are evaluated once and cached for the frame
+  for (auto _ : state)
+  {
+    refreshCounters.Invalidate(INFO_SOURCE_FRAME);
+    for (const auto &expression : expressions)
+      benchmark::DoNotOptimize(expression->Get());
+  }
+  state.SetItemsProcessed(state.iterations() * expressions.size());
+}
+BENCHMARK(BM_InfoExpression_Evaluate);
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIListItem.h"
+#include "interfaces/info/InfoBool.h"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace INFO;
+
+namespace
+{
+// counts its updates instead of evaluating anything
+class CTestInfoBool : public InfoBool
+{
+public:
+  CTestInfoBool(unsigned int sources, InfoRefreshCounters& refreshCounters, bool listItemDependent = false)
+    : InfoBool("test", 0, refreshCounters)
+  {
+    m_sources = sources;
+    m_listItemDependent = listItemDependent;
+  }
+
+  void Update(const CGUIListItem* item) override
+  {
+    m_updates++;
+    m_value = !m_value;
+  }
+
+  unsigned int m_updates = 0;
+};
+}
+
+TEST(TestInfoBool, FrameBoolsUpdateEveryFrame)
+{
+  InfoRefreshCounters counters;
+  CTestInfoBool info(INFO_SOURCE_FRAME, counters);
+
+  info.Get();
+  info.Get();
+  EXPECT_EQ(1u, info.m_updates);
+
+  counters.Invalidate(INFO_SOURCE_FRAME);
+  info.Get();
+  EXPECT_EQ(2u, info.m_updates);
+  EXPECT_EQ(2u, counters.m_evaluations);
+}
+
+TEST(TestInfoBool, UpdatesOnlyWhenSourceChanges)
+{
+  InfoRefreshCounters counters;
+  CTestInfoBool info(INFO_SOURCE_SKIN, counters);
+
+  const bool value = info.Get();
+  EXPECT_EQ(1u, info.m_updates);
+
+  // other sources changing leaves the value as it was
+  for (int frame = 0; frame < 10; frame++)
+  {
+    counters.Invalidate(INFO_SOURCE_FRAME);
+    EXPECT_EQ(value, info.Get());
+  }
+  counters.Invalidate(INFO_SOURCE_LIBRARY);
+  EXPECT_EQ(value, info.Get());
+  EXPECT_EQ(1u, info.m_updates);
+
+  counters.Invalidate(INFO_SOURCE_FRAME | INFO_SOURCE_SKIN);
+  EXPECT_NE(value, info.Get());
+  EXPECT_EQ(2u, info.m_updates);
+  EXPECT_EQ(2u, counters.m_evaluations);
+
+  // a constant is evaluated once
+  CTestInfoBool constant(INFO_SOURCE_NONE, counters);
+  constant.Get();
+  counters.Invalidate(INFO_SOURCE_ALL);
+  constant.Get();
+  EXPECT_EQ(1u, constant.m_updates);
+}
+
+TEST(TestInfoBool, ListItemBoolsUpdateEveryTime)
+{
+  InfoRefreshCounters counters;
+  CTestInfoBool info(INFO_SOURCE_SKIN, counters, true);
+  CGUIListItem item;
+
+  info.Get(&item);
+  info.Get(&item);
+  EXPECT_EQ(2u, info.m_updates);
+
+  // without an item the value is cached
+  info.Get();
+  info.Get();
+  EXPECT_EQ(3u, info.m_updates);
+}
+
+TEST(TestInfoBool, CountsEvaluationsOfAllThreads)
+{
+  InfoRefreshCounters counters;
+  const unsigned int threadCount = 4;
+  const unsigned int evaluations = 10000;
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < threadCount; i++)
+  {
+    threads.emplace_back([&counters]() {
+      CTestInfoBool info(INFO_SOURCE_FRAME, counters, true);
+      CGUIListItem item;
+      for (unsigned int j = 0; j < evaluations; j++)
+        info.Get(&item);
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(threadCount * evaluations, counters.m_evaluations);
+}
@@ -180,9 +180,12 @@ void CFileItemHandler::FillDetails(const ISerializable *info, const CFileItemPtr
   if (info == NULL || fields.empty())
     return;
 
+  // the serialization is thrown away once the requested fields are copied out of it
+  CVariant::CArenaScope arena;
   CVariant serialization;
   info->Serialize(serialization);
 
+  CVariant::CHeapScope heap;
   bool fetchedArt = false;
 
   std::set<std::string> originalFields = fields;
@@ -20,6 +20,7 @@
 #include "playlists/SmartPlayList.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/JSONVariantWriter.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -228,7 +229,27 @@ JSONRPC_STATUS CJSONRPC::NotifyAll(const std::string &method, ITransportLayer *t
 
 std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client)
 {
-  CVariant inputroot, outputroot, result;
+  CVariant outputroot;
+  std::string str;
+  if (HandleRequest(inputString, outputroot, transport, client))
+    CJSONVariantWriter::Write(outputroot, str, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+
+  return str;
+}
+
+std::unique_ptr<CJSONVariantStreamWriter> CJSONRPC::MethodCallStream(const std::string &inputString, ITransportLayer *transport, IClient *client)
+{
+  CVariant outputroot;
+  if (!HandleRequest(inputString, outputroot, transport, client))
+    return nullptr;
+
+  return std::unique_ptr<CJSONVariantStreamWriter>(new CJSONVariantStreamWriter(std::move(outputroot),
+    CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact));
+}
+
+bool CJSONRPC::HandleRequest(const std::string &inputString, CVariant &outputroot, ITransportLayer *transport, IClient *client)
+{
+  CVariant inputroot;
   bool hasResponse = false;
 
   CLog::Log(LOGDEBUG, LOGJSONRPC, "JSONRPC: Incoming request: %s", inputString.c_str());
@@ -266,11 +287,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
     hasResponse = true;
   }
 
-  std::string str;
-  if (hasResponse)
-    CJSONVariantWriter::Write(outputroot, str, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
-
-  return str;
+  return hasResponse;
 }
 
 bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client)
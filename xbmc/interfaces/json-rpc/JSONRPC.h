@@ -13,9 +13,11 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
 #include <stdio.h>
 #include <string>
 
+class CJSONVariantStreamWriter;
 class CVariant;
 
 namespace JSONRPC
@@ -53,6 +55,19 @@ namespace JSONRPC
      */
     static std::string MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client);
 
+    /*
+     \brief Handles an incoming JSON-RPC request like MethodCall()
+     \param inputString received JSON-RPC request
+     \param transport Transport protocol on which the request arrived
+     \param client Client which sent the request
+     \return Writer producing the JSON-RPC response in chunks or nullptr if there is no response
+
+     Instead of serializing the whole response into a string the returned
+     writer serializes it piece by piece, which allows transports to send
+     large responses without holding them in memory twice.
+     */
+    static std::unique_ptr<CJSONVariantStreamWriter> MethodCallStream(const std::string &inputString, ITransportLayer *transport, IClient *client);
+
     static JSONRPC_STATUS Introspect(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
     static JSONRPC_STATUS Version(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
     static JSONRPC_STATUS Permission(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
@@ -62,6 +77,7 @@ namespace JSONRPC
     static JSONRPC_STATUS NotifyAll(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
 
   private:
+    static bool HandleRequest(const std::string &inputString, CVariant &outputroot, ITransportLayer *transport, IClient *client);
     static bool HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client);
     static inline bool IsProperJSONRPC(const CVariant& inputroot);
 
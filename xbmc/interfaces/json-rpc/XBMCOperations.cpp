@@ -10,8 +10,13 @@
 
 #include "ServiceBroker.h"
 #include "messaging/ApplicationMessenger.h"
+#include "network/Network.h"
+#include "network/NetworkServices.h"
 #include "powermanagement/PowerManager.h"
 #include "utils/Variant.h"
+#ifdef HAS_WEB_SERVER
+#include "network/WebServer.h"
+#endif
 
 using namespace JSONRPC;
 using namespace KODI::MESSAGING;
@@ -85,3 +90,20 @@ JSONRPC_STATUS CXBMCOperations::GetInfoBooleans(const std::string &method, ITran
 
   return OK;
 }
+
+JSONRPC_STATUS CXBMCOperations::GetWebServerStats(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+#ifdef HAS_WEB_SERVER
+  const CWebServer::Stats stats = CServiceBroker::GetNetwork().GetServices().GetWebServer().GetStats();
+  result["requests"] = stats.requests;
+  result["activerequests"] = stats.activeRequests;
+  result["peakactiverequests"] = stats.peakActiveRequests;
+  result["pendingjobs"] = stats.pendingJobs;
+  result["averagelatency"] = stats.requests > 0 ? stats.totalLatency / stats.requests : 0;
+  result["maxlatency"] = stats.maxLatency;
+
+  return OK;
+#else
+  return FailedToExecute;
+#endif
+}
@@ -288,6 +288,11 @@ void CMusicDatabase::CreateAnalytics()
               "  DELETE FROM source_path WHERE source_path.idSource = old.idSource;"
               "  DELETE FROM album_source WHERE album_source.idSource = old.idSource;"
               " END");
+
+  CLog::Log(LOGINFO, "create search indices");
+  CreateFullTextIndex("artistsearch", "artist", "idArtist", {"strArtist"});
+  CreateFullTextIndex("albumsearch", "album", "idAlbum", {"strAlbum"});
+  CreateFullTextIndex("songsearch", "song", "idSong", {"strTitle"});
   
   // we create views last to ensure all indexes are rolled in
   CreateViews();
@@ -809,12 +814,12 @@ bool CMusicDatabase::GetSong(int idSong, CSong& song)
 
     int songArtistOffset = song_enumCount;
 
-    song = GetSongFromDataset(m_pDS->get_sql_record());
+    song = GetSongFromDataset(m_pDS->get_row());
     while (!m_pDS->eof())
     {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+      const dbiplus::row_view record = m_pDS->get_row();
 
-      int idSongArtistRole = record->at(songArtistOffset + artistCredit_idRole).get_asInt();
+      int idSongArtistRole = record.at(songArtistOffset + artistCredit_idRole).get_asInt();
       if (idSongArtistRole == ROLE_ARTIST)
         song.artistCredits.emplace_back(GetArtistCreditFromDataset(record, songArtistOffset));
       else
@@ -1166,10 +1171,10 @@ bool CMusicDatabase::GetAlbum(int idAlbum, CAlbum& album, bool getSongs /* = tru
 
     int albumArtistOffset = album_enumCount;
 
-    album = GetAlbumFromDataset(m_pDS->get_sql_record(), 0, true); // true to grab and parse the imageURL
+    album = GetAlbumFromDataset(m_pDS->get_row(), 0, true); // true to grab and parse the imageURL
     while (!m_pDS->eof())
     {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+      const dbiplus::row_view record = m_pDS->get_row();
 
       // Album artists always have role = 0 (idRole and strRole columns are in albumartistview to match columns of songartistview)
       // so there is only one row in the result set for each artist credit.
@@ -1200,16 +1205,16 @@ bool CMusicDatabase::GetAlbum(int idAlbum, CAlbum& album, bool getSongs /* = tru
       std::set<int> songs;
       while (!m_pDS->eof())
       {
-        const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+        const dbiplus::row_view record = m_pDS->get_row();
 
-        int idSong = record->at(song_idSong).get_asInt();  //Same as songartist.idSong by join
+        int idSong = record.at(song_idSong).get_asInt();  //Same as songartist.idSong by join
         if (songs.find(idSong) == songs.end())
         {
           album.songs.emplace_back(GetSongFromDataset(record));
           songs.insert(idSong);
         }
 
-        int idSongArtistRole = record->at(songArtistOffset + artistCredit_idRole).get_asInt();
+        int idSongArtistRole = record.at(songArtistOffset + artistCredit_idRole).get_asInt();
         //By query order song is the last one appended to the album song vector.
         if (idSongArtistRole == ROLE_ARTIST)
           album.songs.back().artistCredits.emplace_back(GetArtistCreditFromDataset(record, songArtistOffset));
@@ -1584,14 +1589,14 @@ bool CMusicDatabase::GetArtist(int idArtist, CArtist &artist, bool fetchAll /* =
     int discographyOffset = artist_enumCount;
 
     artist.discography.clear();
-    artist = GetArtistFromDataset(m_pDS->get_sql_record(), 0, true); // inc scraped art URLs
+    artist = GetArtistFromDataset(m_pDS->get_row(), 0, true); // inc scraped art URLs
     if (fetchAll)
     {
       while (!m_pDS->eof())
       {
-        const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+        const dbiplus::row_view record = m_pDS->get_row();
 
-        artist.discography.emplace_back(record->at(discographyOffset + 1).get_asString(), record->at(discographyOffset + 2).get_asString());
+        artist.discography.emplace_back(record.at(discographyOffset + 1).get_asString(), record.at(discographyOffset + 2).get_asString());
         m_pDS->next();
       }
     }
@@ -2021,7 +2026,7 @@ bool CMusicDatabase::GetArtistsByAlbum(int idAlbum, CFileItem* item)
     VECARTISTCREDITS artistCredits;
     while (!m_pDS->eof())
     {
-      artistCredits.emplace_back(GetArtistCreditFromDataset(m_pDS->get_sql_record(), 0));
+      artistCredits.emplace_back(GetArtistCreditFromDataset(m_pDS->get_row(), 0));
       m_pDS->next();
     }
     m_pDS->close();
@@ -2303,101 +2308,101 @@ int CMusicDatabase::AddPath(const std::string& strPath1)
 
 CSong CMusicDatabase::GetSongFromDataset()
 {
-  return GetSongFromDataset(m_pDS->get_sql_record());
+  return GetSongFromDataset(m_pDS->get_row());
 }
 
-CSong CMusicDatabase::GetSongFromDataset(const dbiplus::sql_record* const record, int offset /* = 0 */)
+CSong CMusicDatabase::GetSongFromDataset(const dbiplus::row_view& record, int offset /* = 0 */)
 {
   CSong song;
-  song.idSong = record->at(offset + song_idSong).get_asInt();
+  song.idSong = record.at(offset + song_idSong).get_asInt();
   // Note this function does not populate artist credits, this must be done separately.
   // However artist names are held as a descriptive string
-  song.strArtistDesc = record->at(offset + song_strArtists).get_asString();
-  song.strArtistSort = record->at(offset + song_strArtistSort).get_asString();
+  song.strArtistDesc = record.at(offset + song_strArtists).get_asString();
+  song.strArtistSort = record.at(offset + song_strArtistSort).get_asString();
   // Get the full genre string
-  song.genre = StringUtils::Split(record->at(offset + song_strGenres).get_asString(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator);
+  song.genre = StringUtils::Split(record.at(offset + song_strGenres).get_asString(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator);
   // and the rest...
-  song.strAlbum = record->at(offset + song_strAlbum).get_asString();
-  song.idAlbum = record->at(offset + song_idAlbum).get_asInt();
-  song.iTrack = record->at(offset + song_iTrack).get_asInt() ;
-  song.iDuration = record->at(offset + song_iDuration).get_asInt() ;
-  song.strReleaseDate = record->at(offset + song_strReleaseDate).get_asString();
-  song.strOrigReleaseDate = record->at(offset + song_strOrigReleaseDate).get_asString();
-  song.strTitle = record->at(offset + song_strTitle).get_asString();
-  song.iTimesPlayed = record->at(offset + song_iTimesPlayed).get_asInt();
-  song.lastPlayed.SetFromDBDateTime(record->at(offset + song_lastplayed).get_asString());
-  song.dateAdded.SetFromDBDateTime(record->at(offset + song_dateAdded).get_asString());
-  song.iStartOffset = record->at(offset + song_iStartOffset).get_asInt();
-  song.iEndOffset = record->at(offset + song_iEndOffset).get_asInt();
-  song.strMusicBrainzTrackID = record->at(offset + song_strMusicBrainzTrackID).get_asString();
-  song.rating = record->at(offset + song_rating).get_asFloat();
-  song.userrating = record->at(offset + song_userrating).get_asInt();
-  song.votes = record->at(offset + song_votes).get_asInt();
-  song.strComment = record->at(offset + song_comment).get_asString();
-  song.strMood = record->at(offset + song_mood).get_asString();
-  song.bCompilation = record->at(offset + song_bCompilation).get_asInt() == 1;
-  song.strDiscSubtitle = record->at(offset + song_strDiscSubtitle).get_asString();
+  song.strAlbum = record.at(offset + song_strAlbum).get_asString();
+  song.idAlbum = record.at(offset + song_idAlbum).get_asInt();
+  song.iTrack = record.at(offset + song_iTrack).get_asInt() ;
+  song.iDuration = record.at(offset + song_iDuration).get_asInt() ;
+  song.strReleaseDate = record.at(offset + song_strReleaseDate).get_asString();
+  song.strOrigReleaseDate = record.at(offset + song_strOrigReleaseDate).get_asString();
+  song.strTitle = record.at(offset + song_strTitle).get_asString();
+  song.iTimesPlayed = record.at(offset + song_iTimesPlayed).get_asInt();
+  song.lastPlayed.SetFromDBDateTime(record.at(offset + song_lastplayed).get_asString());
+  song.dateAdded.SetFromDBDateTime(record.at(offset + song_dateAdded).get_asString());
+  song.iStartOffset = record.at(offset + song_iStartOffset).get_asInt();
+  song.iEndOffset = record.at(offset + song_iEndOffset).get_asInt();
+  song.strMusicBrainzTrackID = record.at(offset + song_strMusicBrainzTrackID).get_asString();
+  song.rating = record.at(offset + song_rating).get_asFloat();
+  song.userrating = record.at(offset + song_userrating).get_asInt();
+  song.votes = record.at(offset + song_votes).get_asInt();
+  song.strComment = record.at(offset + song_comment).get_asString();
+  song.strMood = record.at(offset + song_mood).get_asString();
+  song.bCompilation = record.at(offset + song_bCompilation).get_asInt() == 1;
+  song.strDiscSubtitle = record.at(offset + song_strDiscSubtitle).get_asString();
   // Replay gain data (needed for songs from cuesheets, both separate .cue files and embedded metadata)
-  song.replayGain.Set(record->at(offset + song_strReplayGain).get_asString());
+  song.replayGain.Set(record.at(offset + song_strReplayGain).get_asString());
   // Get filename with full path
-  song.strFileName = URIUtils::AddFileToFolder(record->at(offset + song_strPath).get_asString(), record->at(offset + song_strFileName).get_asString());
-  song.iBPM = record->at(offset + song_iBPM).get_asInt();
-  song.iBitRate = record->at(offset + song_iBitRate).get_asInt();
-  song.iSampleRate = record->at(offset + song_iSampleRate).get_asInt();
-  song.iChannels = record->at(offset + song_iChannels).get_asInt();
+  song.strFileName = URIUtils::AddFileToFolder(record.at(offset + song_strPath).get_asString(), record.at(offset + song_strFileName).get_asString());
+  song.iBPM = record.at(offset + song_iBPM).get_asInt();
+  song.iBitRate = record.at(offset + song_iBitRate).get_asInt();
+  song.iSampleRate = record.at(offset + song_iSampleRate).get_asInt();
+  song.iChannels = record.at(offset + song_iChannels).get_asInt();
   return song;
 }
 
 void CMusicDatabase::GetFileItemFromDataset(CFileItem* item, const CMusicDbUrl &baseUrl)
 {
-  GetFileItemFromDataset(m_pDS->get_sql_record(), item, baseUrl);
+  GetFileItemFromDataset(m_pDS->get_row(), item, baseUrl);
 }
 
-void CMusicDatabase::GetFileItemFromDataset(const dbiplus::sql_record* const record, CFileItem* item, const CMusicDbUrl &baseUrl)
+void CMusicDatabase::GetFileItemFromDataset(const dbiplus::row_view& record, CFileItem* item, const CMusicDbUrl &baseUrl)
 {
   // get the artist string from songview (not the song_artist and artist tables)
-  item->GetMusicInfoTag()->SetArtistDesc(record->at(song_strArtists).get_asString());
+  item->GetMusicInfoTag()->SetArtistDesc(record.at(song_strArtists).get_asString());
   // get the artist sort name string from songview (not the song_artist and artist tables)
-  item->GetMusicInfoTag()->SetArtistSort(record->at(song_strArtistSort).get_asString());
+  item->GetMusicInfoTag()->SetArtistSort(record.at(song_strArtistSort).get_asString());
   // and the full genre string
-  item->GetMusicInfoTag()->SetGenre(record->at(song_strGenres).get_asString());
+  item->GetMusicInfoTag()->SetGenre(record.at(song_strGenres).get_asString());
   // and the rest...
-  item->GetMusicInfoTag()->SetAlbum(record->at(song_strAlbum).get_asString());
-  item->GetMusicInfoTag()->SetAlbumId(record->at(song_idAlbum).get_asInt());
-  item->GetMusicInfoTag()->SetTrackAndDiscNumber(record->at(song_iTrack).get_asInt());
-  item->GetMusicInfoTag()->SetDuration(record->at(song_iDuration).get_asInt());
-  item->GetMusicInfoTag()->SetDatabaseId(record->at(song_idSong).get_asInt(), MediaTypeSong);
-  item->GetMusicInfoTag()->SetOriginalDate(record->at(song_strOrigReleaseDate).get_asString());
-  item->GetMusicInfoTag()->SetReleaseDate(record->at(song_strReleaseDate).get_asString());
-  item->GetMusicInfoTag()->SetTitle(record->at(song_strTitle).get_asString());
-  item->GetMusicInfoTag()->SetDiscSubtitle(record->at(song_strDiscSubtitle).get_asString());
-  item->SetLabel(record->at(song_strTitle).get_asString());
-  item->m_lStartOffset = record->at(song_iStartOffset).get_asInt64();
+  item->GetMusicInfoTag()->SetAlbum(record.at(song_strAlbum).get_asString());
+  item->GetMusicInfoTag()->SetAlbumId(record.at(song_idAlbum).get_asInt());
+  item->GetMusicInfoTag()->SetTrackAndDiscNumber(record.at(song_iTrack).get_asInt());
+  item->GetMusicInfoTag()->SetDuration(record.at(song_iDuration).get_asInt());
+  item->GetMusicInfoTag()->SetDatabaseId(record.at(song_idSong).get_asInt(), MediaTypeSong);
+  item->GetMusicInfoTag()->SetOriginalDate(record.at(song_strOrigReleaseDate).get_asString());
+  item->GetMusicInfoTag()->SetReleaseDate(record.at(song_strReleaseDate).get_asString());
+  item->GetMusicInfoTag()->SetTitle(record.at(song_strTitle).get_asString());
+  item->GetMusicInfoTag()->SetDiscSubtitle(record.at(song_strDiscSubtitle).get_asString());
+  item->SetLabel(record.at(song_strTitle).get_asString());
+  item->m_lStartOffset = record.at(song_iStartOffset).get_asInt64();
   item->SetProperty("item_start", item->m_lStartOffset);
-  item->m_lEndOffset = record->at(song_iEndOffset).get_asInt64();
-  item->GetMusicInfoTag()->SetMusicBrainzTrackID(record->at(song_strMusicBrainzTrackID).get_asString());
-  item->GetMusicInfoTag()->SetRating(record->at(song_rating).get_asFloat());
-  item->GetMusicInfoTag()->SetUserrating(record->at(song_userrating).get_asInt());
-  item->GetMusicInfoTag()->SetVotes(record->at(song_votes).get_asInt());
-  item->GetMusicInfoTag()->SetComment(record->at(song_comment).get_asString());
-  item->GetMusicInfoTag()->SetMood(record->at(song_mood).get_asString());
-  item->GetMusicInfoTag()->SetPlayCount(record->at(song_iTimesPlayed).get_asInt());
-  item->GetMusicInfoTag()->SetLastPlayed(record->at(song_lastplayed).get_asString());
-  item->GetMusicInfoTag()->SetDateAdded(record->at(song_dateAdded).get_asString());
-  std::string strRealPath = URIUtils::AddFileToFolder(record->at(song_strPath).get_asString(), record->at(song_strFileName).get_asString());
+  item->m_lEndOffset = record.at(song_iEndOffset).get_asInt64();
+  item->GetMusicInfoTag()->SetMusicBrainzTrackID(record.at(song_strMusicBrainzTrackID).get_asString());
+  item->GetMusicInfoTag()->SetRating(record.at(song_rating).get_asFloat());
+  item->GetMusicInfoTag()->SetUserrating(record.at(song_userrating).get_asInt());
+  item->GetMusicInfoTag()->SetVotes(record.at(song_votes).get_asInt());
+  item->GetMusicInfoTag()->SetComment(record.at(song_comment).get_asString());
+  item->GetMusicInfoTag()->SetMood(record.at(song_mood).get_asString());
+  item->GetMusicInfoTag()->SetPlayCount(record.at(song_iTimesPlayed).get_asInt());
+  item->GetMusicInfoTag()->SetLastPlayed(record.at(song_lastplayed).get_asString());
+  item->GetMusicInfoTag()->SetDateAdded(record.at(song_dateAdded).get_asString());
+  std::string strRealPath = URIUtils::AddFileToFolder(record.at(song_strPath).get_asString(), record.at(song_strFileName).get_asString());
   item->GetMusicInfoTag()->SetURL(strRealPath);
-  item->GetMusicInfoTag()->SetCompilation(record->at(song_bCompilation).get_asInt() == 1);
-  item->GetMusicInfoTag()->SetBoxset(record->at(song_bBoxedSet).get_asInt() == 1);
+  item->GetMusicInfoTag()->SetCompilation(record.at(song_bCompilation).get_asInt() == 1);
+  item->GetMusicInfoTag()->SetBoxset(record.at(song_bBoxedSet).get_asInt() == 1);
   // get the album artist string from songview (not the album_artist and artist tables)
-  item->GetMusicInfoTag()->SetAlbumArtist(record->at(song_strAlbumArtists).get_asString());
-  item->GetMusicInfoTag()->SetAlbumReleaseType(CAlbum::ReleaseTypeFromString(record->at(song_strAlbumReleaseType).get_asString()));
-  item->GetMusicInfoTag()->SetBPM(record->at(song_iBPM).get_asInt());
-  item->GetMusicInfoTag()->SetBitRate(record->at(song_iBitRate).get_asInt());
-  item->GetMusicInfoTag()->SetSampleRate(record->at(song_iSampleRate).get_asInt());
-  item->GetMusicInfoTag()->SetNoOfChannels(record->at(song_iChannels).get_asInt());
+  item->GetMusicInfoTag()->SetAlbumArtist(record.at(song_strAlbumArtists).get_asString());
+  item->GetMusicInfoTag()->SetAlbumReleaseType(CAlbum::ReleaseTypeFromString(record.at(song_strAlbumReleaseType).get_asString()));
+  item->GetMusicInfoTag()->SetBPM(record.at(song_iBPM).get_asInt());
+  item->GetMusicInfoTag()->SetBitRate(record.at(song_iBitRate).get_asInt());
+  item->GetMusicInfoTag()->SetSampleRate(record.at(song_iSampleRate).get_asInt());
+  item->GetMusicInfoTag()->SetNoOfChannels(record.at(song_iChannels).get_asInt());
   // Replay gain data (needed for songs from cuesheets, both separate .cue files and embedded metadata)
   ReplayGain replaygain;
-  replaygain.Set(record->at(song_strReplayGain).get_asString());
+  replaygain.Set(record.at(song_strReplayGain).get_asString());
   item->GetMusicInfoTag()->SetReplayGain(replaygain);
 
   item->GetMusicInfoTag()->SetLoaded(true);
@@ -2407,9 +2412,9 @@ void CMusicDatabase::GetFileItemFromDataset(const dbiplus::sql_record* const rec
   else
   {
     CMusicDbUrl itemUrl = baseUrl;
-    std::string strFileName = record->at(song_strFileName).get_asString();
+    std::string strFileName = record.at(song_strFileName).get_asString();
     std::string strExt = URIUtils::GetExtension(strFileName);
-    std::string path = StringUtils::Format("%i%s", record->at(song_idSong).get_asInt(), strExt.c_str());
+    std::string path = StringUtils::Format("%i%s", record.at(song_idSong).get_asInt(), strExt.c_str());
     itemUrl.AppendPath(path);
     item->SetPath(itemUrl.ToString());
     item->SetDynPath(strRealPath);
@@ -2447,110 +2452,110 @@ void CMusicDatabase::GetFileItemFromArtistCredits(VECARTISTCREDITS& artistCredit
 
 CAlbum CMusicDatabase::GetAlbumFromDataset(dbiplus::Dataset* pDS, int offset /* = 0 */, bool imageURL /* = false*/)
 {
-  return GetAlbumFromDataset(pDS->get_sql_record(), offset, imageURL);
+  return GetAlbumFromDataset(pDS->get_row(), offset, imageURL);
 }
 
-CAlbum CMusicDatabase::GetAlbumFromDataset(const dbiplus::sql_record* const record, int offset /* = 0 */, bool imageURL /* = false*/)
+CAlbum CMusicDatabase::GetAlbumFromDataset(const dbiplus::row_view& record, int offset /* = 0 */, bool imageURL /* = false*/)
 {
   const std::string itemSeparator = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator;
 
   CAlbum album;
-  album.idAlbum = record->at(offset + album_idAlbum).get_asInt();
-  album.strAlbum = record->at(offset + album_strAlbum).get_asString();
+  album.idAlbum = record.at(offset + album_idAlbum).get_asInt();
+  album.strAlbum = record.at(offset + album_strAlbum).get_asString();
   if (album.strAlbum.empty())
     album.strAlbum = g_localizeStrings.Get(1050);
-  album.strMusicBrainzAlbumID = record->at(offset + album_strMusicBrainzAlbumID).get_asString();
-  album.strReleaseGroupMBID = record->at(offset + album_strReleaseGroupMBID).get_asString();
-  album.strArtistDesc = record->at(offset + album_strArtists).get_asString();
-  album.strArtistSort = record->at(offset + album_strArtistSort).get_asString();
-  album.genre = StringUtils::Split(record->at(offset + album_strGenres).get_asString(), itemSeparator);
-  album.strReleaseDate = record->at(offset + album_strReleaseDate).get_asString();
-  album.strOrigReleaseDate = record->at(offset + album_strOrigReleaseDate).get_asString();
-  album.bBoxedSet = record->at(offset + album_bBoxedSet).get_asInt() == 1;
+  album.strMusicBrainzAlbumID = record.at(offset + album_strMusicBrainzAlbumID).get_asString();
+  album.strReleaseGroupMBID = record.at(offset + album_strReleaseGroupMBID).get_asString();
+  album.strArtistDesc = record.at(offset + album_strArtists).get_asString();
+  album.strArtistSort = record.at(offset + album_strArtistSort).get_asString();
+  album.genre = StringUtils::Split(record.at(offset + album_strGenres).get_asString(), itemSeparator);
+  album.strReleaseDate = record.at(offset + album_strReleaseDate).get_asString();
+  album.strOrigReleaseDate = record.at(offset + album_strOrigReleaseDate).get_asString();
+  album.bBoxedSet = record.at(offset + album_bBoxedSet).get_asInt() == 1;
   if (imageURL)
-    album.thumbURL.ParseString(record->at(offset + album_strThumbURL).get_asString());
-  album.fRating = record->at(offset + album_fRating).get_asFloat();
-  album.iUserrating = record->at(offset + album_iUserrating).get_asInt();
-  album.iVotes = record->at(offset + album_iVotes).get_asInt();
-  album.strReview = record->at(offset + album_strReview).get_asString();
-  album.styles = StringUtils::Split(record->at(offset + album_strStyles).get_asString(), itemSeparator);
-  album.moods = StringUtils::Split(record->at(offset + album_strMoods).get_asString(), itemSeparator);
-  album.themes = StringUtils::Split(record->at(offset + album_strThemes).get_asString(), itemSeparator);
-  album.strLabel = record->at(offset + album_strLabel).get_asString();
-  album.strType = record->at(offset + album_strType).get_asString();
-  album.bCompilation = record->at(offset + album_bCompilation).get_asInt() == 1;
-  album.bScrapedMBID = record->at(offset + album_bScrapedMBID).get_asInt() == 1;
-  album.strLastScraped = record->at(offset + album_lastScraped).get_asString();
-  album.iTimesPlayed = record->at(offset + album_iTimesPlayed).get_asInt();
-  album.SetReleaseType(record->at(offset + album_strReleaseType).get_asString());
-  album.iTotalDiscs = record->at(offset + album_iTotalDiscs).get_asInt();
-  album.SetDateAdded(record->at(offset + album_dtDateAdded).get_asString());
-  album.SetLastPlayed(record->at(offset + album_dtLastPlayed).get_asString());
+    album.thumbURL.ParseString(record.at(offset + album_strThumbURL).get_asString());
+  album.fRating = record.at(offset + album_fRating).get_asFloat();
+  album.iUserrating = record.at(offset + album_iUserrating).get_asInt();
+  album.iVotes = record.at(offset + album_iVotes).get_asInt();
+  album.strReview = record.at(offset + album_strReview).get_asString();
+  album.styles = StringUtils::Split(record.at(offset + album_strStyles).get_asString(), itemSeparator);
+  album.moods = StringUtils::Split(record.at(offset + album_strMoods).get_asString(), itemSeparator);
+  album.themes = StringUtils::Split(record.at(offset + album_strThemes).get_asString(), itemSeparator);
+  album.strLabel = record.at(offset + album_strLabel).get_asString();
+  album.strType = record.at(offset + album_strType).get_asString();
+  album.bCompilation = record.at(offset + album_bCompilation).get_asInt() == 1;
+  album.bScrapedMBID = record.at(offset + album_bScrapedMBID).get_asInt() == 1;
+  album.strLastScraped = record.at(offset + album_lastScraped).get_asString();
+  album.iTimesPlayed = record.at(offset + album_iTimesPlayed).get_asInt();
+  album.SetReleaseType(record.at(offset + album_strReleaseType).get_asString());
+  album.iTotalDiscs = record.at(offset + album_iTotalDiscs).get_asInt();
+  album.SetDateAdded(record.at(offset + album_dtDateAdded).get_asString());
+  album.SetLastPlayed(record.at(offset + album_dtLastPlayed).get_asString());
   return album;
 }
 
-CArtistCredit CMusicDatabase::GetArtistCreditFromDataset(const dbiplus::sql_record* const record, int offset /* = 0 */)
+CArtistCredit CMusicDatabase::GetArtistCreditFromDataset(const dbiplus::row_view& record, int offset /* = 0 */)
 {
   CArtistCredit artistCredit;
-  artistCredit.idArtist = record->at(offset + artistCredit_idArtist).get_asInt();
+  artistCredit.idArtist = record.at(offset + artistCredit_idArtist).get_asInt();
   if (artistCredit.idArtist == BLANKARTIST_ID)
     artistCredit.m_strArtist = StringUtils::Empty;
   else
   {
-    artistCredit.m_strArtist = record->at(offset + artistCredit_strArtist).get_asString();
-    artistCredit.m_strMusicBrainzArtistID = record->at(offset + artistCredit_strMusicBrainzArtistID).get_asString();
+    artistCredit.m_strArtist = record.at(offset + artistCredit_strArtist).get_asString();
+    artistCredit.m_strMusicBrainzArtistID = record.at(offset + artistCredit_strMusicBrainzArtistID).get_asString();
   }
   return artistCredit;
 }
 
-CMusicRole CMusicDatabase::GetArtistRoleFromDataset(const dbiplus::sql_record* const record, int offset /* = 0 */)
+CMusicRole CMusicDatabase::GetArtistRoleFromDataset(const dbiplus::row_view& record, int offset /* = 0 */)
 {
-  CMusicRole ArtistRole(record->at(offset + artistCredit_idRole).get_asInt(),
-                        record->at(offset + artistCredit_strRole).get_asString(),
-                        record->at(offset + artistCredit_strArtist).get_asString(),
-                        record->at(offset + artistCredit_idArtist).get_asInt());
+  CMusicRole ArtistRole(record.at(offset + artistCredit_idRole).get_asInt(),
+                        record.at(offset + artistCredit_strRole).get_asString(),
+                        record.at(offset + artistCredit_strArtist).get_asString(),
+                        record.at(offset + artistCredit_idArtist).get_asInt());
   return ArtistRole;
 }
 
 CArtist CMusicDatabase::GetArtistFromDataset(dbiplus::Dataset* pDS, int offset /* = 0 */, bool needThumb /* = true */)
 {
-  return GetArtistFromDataset(pDS->get_sql_record(), offset, needThumb);
+  return GetArtistFromDataset(pDS->get_row(), offset, needThumb);
 }
 
-CArtist CMusicDatabase::GetArtistFromDataset(const dbiplus::sql_record* const record, int offset /* = 0 */, bool needThumb /* = true */)
+CArtist CMusicDatabase::GetArtistFromDataset(const dbiplus::row_view& record, int offset /* = 0 */, bool needThumb /* = true */)
 {
   const std::string itemSeparator = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator;
 
   CArtist artist;
-  artist.idArtist = record->at(offset + artist_idArtist).get_asInt();
+  artist.idArtist = record.at(offset + artist_idArtist).get_asInt();
   if (artist.idArtist == BLANKARTIST_ID && m_translateBlankArtist)
     artist.strArtist = g_localizeStrings.Get(38042);  //Missing artist tag in current language
   else
-    artist.strArtist = record->at(offset + artist_strArtist).get_asString();
-  artist.strSortName = record->at(offset + artist_strSortName).get_asString();
-  artist.strMusicBrainzArtistID = record->at(offset + artist_strMusicBrainzArtistID).get_asString();
-  artist.strType = record->at(offset + artist_strType).get_asString();
-  artist.strGender = record->at(offset + artist_strGender).get_asString();
-  artist.strDisambiguation = record->at(offset + artist_strDisambiguation).get_asString();
-  artist.genre = StringUtils::Split(record->at(offset + artist_strGenres).get_asString(), itemSeparator);
-  artist.strBiography = record->at(offset + artist_strBiography).get_asString();
-  artist.styles = StringUtils::Split(record->at(offset + artist_strStyles).get_asString(), itemSeparator);
-  artist.moods = StringUtils::Split(record->at(offset + artist_strMoods).get_asString(), itemSeparator);
-  artist.strBorn = record->at(offset + artist_strBorn).get_asString();
-  artist.strFormed = record->at(offset + artist_strFormed).get_asString();
-  artist.strDied = record->at(offset + artist_strDied).get_asString();
-  artist.strDisbanded = record->at(offset + artist_strDisbanded).get_asString();
-  artist.yearsActive = StringUtils::Split(record->at(offset + artist_strYearsActive).get_asString(), itemSeparator);
-  artist.instruments = StringUtils::Split(record->at(offset + artist_strInstruments).get_asString(), itemSeparator);
-  artist.bScrapedMBID = record->at(offset + artist_bScrapedMBID).get_asInt() == 1;
-  artist.strLastScraped = record->at(offset + artist_lastScraped).get_asString();
-  artist.SetDateAdded(record->at(offset + artist_dtDateAdded).get_asString());
+    artist.strArtist = record.at(offset + artist_strArtist).get_asString();
+  artist.strSortName = record.at(offset + artist_strSortName).get_asString();
+  artist.strMusicBrainzArtistID = record.at(offset + artist_strMusicBrainzArtistID).get_asString();
+  artist.strType = record.at(offset + artist_strType).get_asString();
+  artist.strGender = record.at(offset + artist_strGender).get_asString();
+  artist.strDisambiguation = record.at(offset + artist_strDisambiguation).get_asString();
+  artist.genre = StringUtils::Split(record.at(offset + artist_strGenres).get_asString(), itemSeparator);
+  artist.strBiography = record.at(offset + artist_strBiography).get_asString();
+  artist.styles = StringUtils::Split(record.at(offset + artist_strStyles).get_asString(), itemSeparator);
+  artist.moods = StringUtils::Split(record.at(offset + artist_strMoods).get_asString(), itemSeparator);
+  artist.strBorn = record.at(offset + artist_strBorn).get_asString();
+  artist.strFormed = record.at(offset + artist_strFormed).get_asString();
+  artist.strDied = record.at(offset + artist_strDied).get_asString();
+  artist.strDisbanded = record.at(offset + artist_strDisbanded).get_asString();
+  artist.yearsActive = StringUtils::Split(record.at(offset + artist_strYearsActive).get_asString(), itemSeparator);
+  artist.instruments = StringUtils::Split(record.at(offset + artist_strInstruments).get_asString(), itemSeparator);
+  artist.bScrapedMBID = record.at(offset + artist_bScrapedMBID).get_asInt() == 1;
+  artist.strLastScraped = record.at(offset + artist_lastScraped).get_asString();
+  artist.SetDateAdded(record.at(offset + artist_dtDateAdded).get_asString());
 
   if (needThumb)
   {
-    artist.fanart.m_xml = record->at(artist_strFanart).get_asString();
+    artist.fanart.m_xml = record.at(artist_strFanart).get_asString();
     artist.fanart.Unpack();
-    artist.thumbURL.ParseString(record->at(artist_strImage).get_asString());
+    artist.thumbURL.ParseString(record.at(artist_strImage).get_asString());
   }
 
   return artist;
@@ -2647,6 +2652,15 @@ int CMusicDatabase::GetSongByArtistAndAlbumAndTitle(const std::string& strArtist
   return -1;
 }
 
+std::string CMusicDatabase::GetFullTextSearch(const std::string& index, const std::string& search)
+{
+  if (!HasFullTextIndex(index))
+    return "";
+
+  // short searches only match at the start of the name, like the LIKE queries
+  return GetFullTextQuery(search, {}, search.size() < MIN_FULL_SEARCH_LENGTH);
+}
+
 bool CMusicDatabase::SearchArtists(const std::string& search, CFileItemList &artists)
 {
   try
@@ -2658,7 +2672,15 @@ bool CMusicDatabase::SearchArtists(const std::string& search, CFileItemList &art
 
     std::string strVariousArtists = g_localizeStrings.Get(340).c_str();
     std::string strSQL;
-    if (search.size() >= MIN_FULL_SEARCH_LENGTH)
+    std::string match = GetFullTextSearch("artistsearch", search);
+    if (!match.empty())
+    {
+      Filter filter;
+      AppendFullTextSearch(filter, "artistsearch", "artist.idArtist", match);
+      filter.AppendWhere(PrepareSQL("artist.strArtist <> '%s'", strVariousArtists.c_str()));
+      BuildSQL("select artist.* from artist ", filter, strSQL);
+    }
+    else if (search.size() >= MIN_FULL_SEARCH_LENGTH)
       strSQL=PrepareSQL("select * from artist "
                                 "where (strArtist like '%s%%' or strArtist like '%% %s%%') and strArtist <> '%s' "
                                 , search.c_str(), search.c_str(), strVariousArtists.c_str() );
@@ -2777,11 +2799,11 @@ bool CMusicDatabase::GetTop100Albums(VECALBUMS& albums)
     int albumId = -1;
     while (!m_pDS->eof())
     {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+      const dbiplus::row_view record = m_pDS->get_row();
 
-      if (albumId != record->at(album_idAlbum).get_asInt())
+      if (albumId != record.at(album_idAlbum).get_asInt())
       { // New album
-        albumId = record->at(album_idAlbum).get_asInt();
+        albumId = record.at(album_idAlbum).get_asInt();
         albums.push_back(GetAlbumFromDataset(record));
       }
       // Get album artists
@@ -2884,11 +2906,11 @@ bool CMusicDatabase::GetRecentlyPlayedAlbums(VECALBUMS& albums)
     int albumId = -1;
     while (!m_pDS->eof())
     {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+      const dbiplus::row_view record = m_pDS->get_row();
 
-      if (albumId != record->at(album_idAlbum).get_asInt())
+      if (albumId != record.at(album_idAlbum).get_asInt())
       { // New album
-        albumId = record->at(album_idAlbum).get_asInt();
+        albumId = record.at(album_idAlbum).get_asInt();
         albums.push_back(GetAlbumFromDataset(record));
       }
       // Get album artists
@@ -2948,10 +2970,10 @@ bool CMusicDatabase::GetRecentlyPlayedAlbumSongs(const std::string& strBaseDir,
     VECARTISTCREDITS artistCredits;
     while (!m_pDS->eof())
     {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+      const dbiplus::row_view record = m_pDS->get_row();
 
-      int idSongArtistRole = record->at(songArtistOffset + artistCredit_idRole).get_asInt();
-      if (songId != record->at(song_idSong).get_asInt())
+      int idSongArtistRole = record.at(songArtistOffset + artistCredit_idRole).get_asInt();
+      if (songId != record.at(song_idSong).get_asInt())
       { //New song
         if (songId > 0 && !artistCredits.empty())
         {
@@ -2959,7 +2981,7 @@ bool CMusicDatabase::GetRecentlyPlayedAlbumSongs(const std::string& strBaseDir,
           GetFileItemFromArtistCredits(artistCredits, items[items.Size() - 1].get());
           artistCredits.clear();
         }
-        songId = record->at(song_idSong).get_asInt();
+        songId = record.at(song_idSong).get_asInt();
         CFileItemPtr item(new CFileItem);
         GetFileItemFromDataset(record, item.get(), baseUrl);
         items.Add(item);
@@ -3023,11 +3045,11 @@ bool CMusicDatabase::GetRecentlyAddedAlbums(VECALBUMS& albums, unsigned int limi
     int albumId = -1;
     while (!m_pDS->eof())
     {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+      const dbiplus::row_view record = m_pDS->get_row();
 
-      if (albumId != record->at(album_idAlbum).get_asInt())
+      if (albumId != record.at(album_idAlbum).get_asInt())
       { // New album
-        albumId = record->at(album_idAlbum).get_asInt();
+        albumId = record.at(album_idAlbum).get_asInt();
         albums.push_back(GetAlbumFromDataset(record));
       }
       // Get album artists
@@ -3086,10 +3108,10 @@ bool CMusicDatabase::GetRecentlyAddedAlbumSongs(const std::string& strBaseDir, C
     VECARTISTCREDITS artistCredits;
     while (!m_pDS->eof())
     {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+      const dbiplus::row_view record = m_pDS->get_row();
 
-      int idSongArtistRole = record->at(songArtistOffset + artistCredit_idRole).get_asInt();
-      if (songId != record->at(song_idSong).get_asInt())
+      int idSongArtistRole = record.at(songArtistOffset + artistCredit_idRole).get_asInt();
+      if (songId != record.at(song_idSong).get_asInt())
       { //New song
         if (songId > 0 && !artistCredits.empty())
         {
@@ -3097,7 +3119,7 @@ bool CMusicDatabase::GetRecentlyAddedAlbumSongs(const std::string& strBaseDir, C
           GetFileItemFromArtistCredits(artistCredits, items[items.Size() - 1].get());
           artistCredits.clear();
         }
-        songId = record->at(song_idSong).get_asInt();
+        songId = record.at(song_idSong).get_asInt();
         CFileItemPtr item(new CFileItem);
         GetFileItemFromDataset(record, item.get(), baseUrl);
         items.Add(item);
@@ -3231,7 +3253,15 @@ bool CMusicDatabase::SearchSongs(const std::string& search, CFileItemList &items
       return false;
 
     std::string strSQL;
-    if (search.size() >= MIN_FULL_SEARCH_LENGTH)
+    std::string match = GetFullTextSearch("songsearch", search);
+    if (!match.empty())
+    {
+      Filter filter;
+      AppendFullTextSearch(filter, "songsearch", "songview.idSong", match);
+      filter.limit = "1000";
+      BuildSQL("select songview.* from songview ", filter, strSQL);
+    }
+    else if (search.size() >= MIN_FULL_SEARCH_LENGTH)
       strSQL=PrepareSQL("select * from songview where strTitle like '%s%%' or strTitle like '%% %s%%' limit 1000", search.c_str(), search.c_str());
     else
       strSQL=PrepareSQL("select * from songview where strTitle like '%s%%' limit 1000", search.c_str());
@@ -3269,7 +3299,14 @@ bool CMusicDatabase::SearchAlbums(const std::string& search, CFileItemList &albu
       return false;
 
     std::string strSQL;
-    if (search.size() >= MIN_FULL_SEARCH_LENGTH)
+    std::string match = GetFullTextSearch("albumsearch", search);
+    if (!match.empty())
+    {
+      Filter filter;
+      AppendFullTextSearch(filter, "albumsearch", "albumview.idAlbum", match);
+      BuildSQL("select albumview.* from albumview ", filter, strSQL);
+    }
+    else if (search.size() >= MIN_FULL_SEARCH_LENGTH)
       strSQL=PrepareSQL("select * from albumview where strAlbum like '%s%%' or strAlbum like '%% %s%%'", search.c_str(), search.c_str());
     else
       strSQL=PrepareSQL("select * from albumview where strAlbum like '%s%%'", search.c_str());
@@ -4597,11 +4634,11 @@ bool CMusicDatabase::GetArtistsByWhere(const std::string& strBaseDir, const Filt
 
     // Get Artists from returned rows
     items.Reserve(results.size());
-    const dbiplus::query_data &data = m_pDS->get_result_set().records;
+    const dbiplus::result_set &data = m_pDS->get_result_set();
     for (const auto &i : results)
     {
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
+      const dbiplus::row_view record = data.row(targetRow);
 
       try
       {
@@ -4803,16 +4840,16 @@ bool CMusicDatabase::GetAlbumsByWhere(const std::string &baseDir, const Filter &
 
     // Get albums from returned rows
     items.Reserve(total);
-    const dbiplus::query_data &data = m_pDS->get_result_set().records;
+    const dbiplus::result_set &data = m_pDS->get_result_set();
     for (const auto &i : results)
     {
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
+      const dbiplus::row_view record = data.row(targetRow);
 
       try
       {
         CMusicDbUrl itemUrl = musicUrl;
-        std::string path = StringUtils::Format("%i/", record->at(album_idAlbum).get_asInt());
+        std::string path = StringUtils::Format("%i/", record.at(album_idAlbum).get_asInt());
         itemUrl.AppendPath(path);
 
         CFileItemPtr pItem(new CFileItem(itemUrl.ToString(), GetAlbumFromDataset(record)));
@@ -4975,21 +5012,21 @@ bool CMusicDatabase::GetDiscsByWhere(CMusicDbUrl& musicUrl,
     CAlbum album;
     bool useTitle = false;
     std::string oldDiscTitle;
-    const dbiplus::query_data& data = m_pDS->get_result_set().records;
+    const dbiplus::result_set& data = m_pDS->get_result_set();
     for (const auto& i : results)
     {
       unsigned int targetRow = static_cast<unsigned int>(i.at(FieldRow).asInteger());
-      const dbiplus::sql_record* const record = data.at(targetRow);
+      const dbiplus::row_view record = data.row(targetRow);
       try
       {
-        if (album.idAlbum != record->at(albumOffset + album_idAlbum).get_asInt())
+        if (album.idAlbum != record.at(albumOffset + album_idAlbum).get_asInt())
         { // New album
           useTitle = false;
           album = GetAlbumFromDataset(record, albumOffset);
         }
 
-        int discnum = record->at(0).get_asInt();
-        std::string strDiscSubtitle = record->at(1).get_asString();
+        int discnum = record.at(0).get_asInt();
+        std::string strDiscSubtitle = record.at(1).get_asString();
         if (strDiscSubtitle.empty())
           // Make (fake) disc title from disc number
           strDiscSubtitle = StringUtils::Format("%s %i", g_localizeStrings.Get(427), discnum);
@@ -5013,7 +5050,7 @@ bool CMusicDatabase::GetDiscsByWhere(CMusicDbUrl& musicUrl,
         else
           itemUrl.AddOption("discid", discnum);
         CFileItemPtr pItem(new CFileItem(itemUrl.ToString(), album));
-        pItem->SetLabel2(record->at(0).get_asString()); // GUI show label2 for disc sort order??
+        pItem->SetLabel2(record.at(0).get_asString()); // GUI show label2 for disc sort order??
         pItem->GetMusicInfoTag()->SetDiscNumber(discnum);
         pItem->GetMusicInfoTag()->SetTitle(strDiscSubtitle);
         pItem->SetLabel(strDiscSubtitle);
@@ -5176,16 +5213,16 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filte
     int songArtistOffset = song_enumCount;
     int songId = -1;
     VECARTISTCREDITS artistCredits;
-    const dbiplus::query_data &data = m_pDS->get_result_set().records;
+    const dbiplus::result_set &data = m_pDS->get_result_set();
     int count = 0;
     for (const auto &i : results)
     {
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
+      const dbiplus::row_view record = data.row(targetRow);
 
       try
       {
-        if (songId != record->at(song_idSong).get_asInt())
+        if (songId != record.at(song_idSong).get_asInt())
         { //New song
           if (songId > 0 && !artistCredits.empty())
           {
@@ -5193,7 +5230,7 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filte
             GetFileItemFromArtistCredits(artistCredits, items[items.Size()-1].get());
             artistCredits.clear();
           }
-          songId = record->at(song_idSong).get_asInt();
+          songId = record.at(song_idSong).get_asInt();
           CFileItemPtr item(new CFileItem);
           GetFileItemFromDataset(record, item.get(), musicUrl);
           // HACK for sorting by database returned order
@@ -5203,7 +5240,7 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filte
         // Get song artist credits and contributors
         if (artistData)
         {
-          int idSongArtistRole = record->at(songArtistOffset + artistCredit_idRole).get_asInt();
+          int idSongArtistRole = record.at(songArtistOffset + artistCredit_idRole).get_asInt();
           if (idSongArtistRole == ROLE_ARTIST)
             artistCredits.push_back(GetArtistCreditFromDataset(record, songArtistOffset));
           else
@@ -5312,12 +5349,12 @@ bool CMusicDatabase::GetSongsByWhere(const std::string &baseDir, const Filter &f
 
     // get data from returned rows
     items.Reserve(results.size());
-    const dbiplus::query_data &data = m_pDS->get_result_set().records;
+    const dbiplus::result_set &data = m_pDS->get_result_set();
     int count = 0;
     for (const auto &i : results)
     {
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
+      const dbiplus::row_view record = data.row(targetRow);
 
       try
       {
@@ -5806,9 +5843,9 @@ bool CMusicDatabase::GetArtistsByWhereJSON(const std::set<std::string>& fields,
     CVariant artistObj;
     while (!m_pDS->eof() || bHaveArtist)
     {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+      const dbiplus::row_view record = m_pDS->get_row();
 
-      if (m_pDS->eof() || artistId != record->at(0).get_asInt())
+      if (m_pDS->eof() || artistId != record.at(0).get_asInt())
       {
         // Store previous or last artist
         if (bHaveArtist)
@@ -5850,15 +5887,15 @@ bool CMusicDatabase::GetArtistsByWhereJSON(const std::set<std::string>& fields,
           continue;  // Having saved the last artist stop
 
         // New artist
-        artistId = record->at(0).get_asInt();
+        artistId = record.at(0).get_asInt();
         bHaveArtist = true;
         artistObj["artistid"] = artistId;
-        artistObj["label"] = record->at(1).get_asString();
-        artistObj["artist"] = record->at(1).get_asString(); // Always have "artist"
+        artistObj["label"] = record.at(1).get_asString();
+        artistObj["artist"] = record.at(1).get_asString(); // Always have "artist"
         bIsAlbumArtist = bJoinAlbumArtist;  //Album artist by default
         if (bJoinSongArtist)
         {
-          bIsAlbumArtist = !record->at(joinLayout.GetRecNo(joinToArtist_isSong)).get_asBool();
+          bIsAlbumArtist = !record.at(joinLayout.GetRecNo(joinToArtist_isSong)).get_asBool();
           if (joinLayout.GetOutput(joinToArtist_isalbumartist))
             artistObj["isalbumartist"] = bIsAlbumArtist;
         }
@@ -5866,16 +5903,16 @@ bool CMusicDatabase::GetArtistsByWhereJSON(const std::set<std::string>& fields,
           if (dbfieldindex[i] > -1)
           {
             if (JSONtoDBArtist[dbfieldindex[i]].formatJSON == "integer")
-              artistObj[JSONtoDBArtist[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asInt();
+              artistObj[JSONtoDBArtist[dbfieldindex[i]].fieldJSON] = record.at(1 + i).get_asInt();
             else if (JSONtoDBArtist[dbfieldindex[i]].formatJSON == "float")
-              artistObj[JSONtoDBArtist[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asFloat();
+              artistObj[JSONtoDBArtist[dbfieldindex[i]].fieldJSON] = record.at(1 + i).get_asFloat();
             else if (JSONtoDBArtist[dbfieldindex[i]].formatJSON == "array")
               artistObj[JSONtoDBArtist[dbfieldindex[i]].fieldJSON] =
-              StringUtils::Split(record->at(1 + i).get_asString(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator);
+              StringUtils::Split(record.at(1 + i).get_asString(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator);
             else if (JSONtoDBArtist[dbfieldindex[i]].formatJSON == "boolean")
-              artistObj[JSONtoDBArtist[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asBool();
+              artistObj[JSONtoDBArtist[dbfieldindex[i]].fieldJSON] = record.at(1 + i).get_asBool();
             else
-              artistObj[JSONtoDBArtist[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asString();
+              artistObj[JSONtoDBArtist[dbfieldindex[i]].fieldJSON] = record.at(1 + i).get_asString();
           }
       }
       if (bJoinAlbumArtist)
@@ -5884,11 +5921,11 @@ bool CMusicDatabase::GetArtistsByWhereJSON(const std::set<std::string>& fields,
         int idRoleRow = -1;
         if (bJoinSongArtist)
         {
-          bAlbumArtistRow = !record->at(joinLayout.GetRecNo(joinToArtist_isSong)).get_asBool();
+          bAlbumArtistRow = !record.at(joinLayout.GetRecNo(joinToArtist_isSong)).get_asBool();
           if (joinLayout.GetRecNo(joinToArtist_idRole) > -1 &&
-            !record->at(joinLayout.GetRecNo(joinToArtist_idRole)).get_isNull())
+            !record.at(joinLayout.GetRecNo(joinToArtist_idRole)).get_isNull())
           {
-            idRoleRow = record->at(joinLayout.GetRecNo(joinToArtist_idRole)).get_asInt();
+            idRoleRow = record.at(joinLayout.GetRecNo(joinToArtist_idRole)).get_asInt();
           }
         }
 
@@ -5896,15 +5933,15 @@ bool CMusicDatabase::GetArtistsByWhereJSON(const std::set<std::string>& fields,
         if (joinLayout.GetFetch(joinToArtist_idSourceAlbum))
         {
           if ((bAlbumArtistRow && joinLayout.GetRecNo(joinToArtist_idSourceAlbum) > -1 &&
-            !record->at(joinLayout.GetRecNo(joinToArtist_idSourceAlbum)).get_isNull() &&
-            sourceId != record->at(joinLayout.GetRecNo(joinToArtist_idSourceAlbum)).get_asInt()) ||
+            !record.at(joinLayout.GetRecNo(joinToArtist_idSourceAlbum)).get_isNull() &&
+            sourceId != record.at(joinLayout.GetRecNo(joinToArtist_idSourceAlbum)).get_asInt()) ||
             (!bAlbumArtistRow && joinLayout.GetRecNo(joinToArtist_idSourceSong) > -1 &&
-              !record->at(joinLayout.GetRecNo(joinToArtist_idSourceSong)).get_isNull() &&
-              sourceId != record->at(joinLayout.GetRecNo(joinToArtist_idSourceSong)).get_asInt()))
+              !record.at(joinLayout.GetRecNo(joinToArtist_idSourceSong)).get_isNull() &&
+              sourceId != record.at(joinLayout.GetRecNo(joinToArtist_idSourceSong)).get_asInt()))
           {
             bArtDone = bArtDone || (sourceId > 0);  // Not first source, skip art repeats
             bool found(false);
-            sourceId = record->at(joinLayout.GetRecNo(joinToArtist_idSourceAlbum)).get_asInt();
+            sourceId = record.at(joinLayout.GetRecNo(joinToArtist_idSourceAlbum)).get_asInt();
             if (!bAlbumArtistRow)
             {
               // Skip other roles (when fetching them)
@@ -5914,7 +5951,7 @@ bool CMusicDatabase::GetArtistsByWhereJSON(const std::set<std::string>& fields,
               }
               else
               {
-                sourceId = record->at(joinLayout.GetRecNo(joinToArtist_idSourceSong)).get_asInt();
+                sourceId = record.at(joinLayout.GetRecNo(joinToArtist_idSourceSong)).get_asInt();
                 // Song artist row may repeat sources found via album artist
                 // Already have that source? 
                 for (const auto& i : sourceidlist)
@@ -5945,23 +5982,23 @@ bool CMusicDatabase::GetArtistsByWhereJSON(const std::set<std::string>& fields,
           std::string strGenre;
           bool newgenre(false);
           if (bAlbumArtistRow && joinLayout.GetRecNo(joinToArtist_idSongGenreAlbum) > -1 &&
-            !record->at(joinLayout.GetRecNo(joinToArtist_idSongGenreAlbum)).get_isNull() &&
-            genreId != record->at(joinLayout.GetRecNo(joinToArtist_idSongGenreAlbum)).get_asInt())
+            !record.at(joinLayout.GetRecNo(joinToArtist_idSongGenreAlbum)).get_isNull() &&
+            genreId != record.at(joinLayout.GetRecNo(joinToArtist_idSongGenreAlbum)).get_asInt())
           {
             bArtDone = bArtDone || (genreId > 0);  // Not first genre, skip art repeats
             newgenre = true;
-            genreId = record->at(joinLayout.GetRecNo(joinToArtist_idSongGenreAlbum)).get_asInt();
-            strGenre = record->at(joinLayout.GetRecNo(joinToArtist_strSongGenreAlbum)).get_asString();
+            genreId = record.at(joinLayout.GetRecNo(joinToArtist_idSongGenreAlbum)).get_asInt();
+            strGenre = record.at(joinLayout.GetRecNo(joinToArtist_strSongGenreAlbum)).get_asString();
           }
           else if (!bAlbumArtistRow && !bGenreFoundViaAlbum &&
             joinLayout.GetRecNo(joinToArtist_idSongGenreSong) > -1 &&
-            !record->at(joinLayout.GetRecNo(joinToArtist_idSongGenreSong)).get_isNull() &&
-            genreId != record->at(joinLayout.GetRecNo(joinToArtist_idSongGenreSong)).get_asInt())
+            !record.at(joinLayout.GetRecNo(joinToArtist_idSongGenreSong)).get_isNull() &&
+            genreId != record.at(joinLayout.GetRecNo(joinToArtist_idSongGenreSong)).get_asInt())
           {
             bArtDone = bArtDone || (genreId > 0);  // Not first genre, skip art repeats
             newgenre = idRoleRow <= 1; // Skip other roles (when fetching them)
-            genreId = record->at(joinLayout.GetRecNo(joinToArtist_idSongGenreSong)).get_asInt();
-            strGenre = record->at(joinLayout.GetRecNo(joinToArtist_strSongGenreSong)).get_asString();
+            genreId = record.at(joinLayout.GetRecNo(joinToArtist_idSongGenreSong)).get_asInt();
+            strGenre = record.at(joinLayout.GetRecNo(joinToArtist_strSongGenreSong)).get_asString();
           }
           bool found(false);
           if (newgenre)
@@ -6006,7 +6043,7 @@ bool CMusicDatabase::GetArtistsByWhereJSON(const std::set<std::string>& fields,
                 roleidlist.emplace_back(roleId);
                 CVariant roleObj;
                 roleObj["roleid"] = roleId;
-                roleObj["role"] = record->at(joinLayout.GetRecNo(joinToArtist_strRole)).get_asString();
+                roleObj["role"] = record.at(joinLayout.GetRecNo(joinToArtist_strRole)).get_asString();
                 artistObj["roles"].append(roleObj);
               }
             }
@@ -6015,25 +6052,25 @@ bool CMusicDatabase::GetArtistsByWhereJSON(const std::set<std::string>& fields,
       }
       // Art
       if (bJoinArt && !bArtDone && 
-        !record->at(joinLayout.GetRecNo(joinToArtist_idArt)).get_isNull() &&
-        record->at(joinLayout.GetRecNo(joinToArtist_idArt)).get_asInt() > 0 && 
-        artId != record->at(joinLayout.GetRecNo(joinToArtist_idArt)).get_asInt())
+        !record.at(joinLayout.GetRecNo(joinToArtist_idArt)).get_isNull() &&
+        record.at(joinLayout.GetRecNo(joinToArtist_idArt)).get_asInt() > 0 && 
+        artId != record.at(joinLayout.GetRecNo(joinToArtist_idArt)).get_asInt())
       {
-        artId = record->at(joinLayout.GetRecNo(joinToArtist_idArt)).get_asInt();
+        artId = record.at(joinLayout.GetRecNo(joinToArtist_idArt)).get_asInt();
         if (joinLayout.GetOutput(joinToArtist_idArt))
         {
-          artistObj["art"][record->at(joinLayout.GetRecNo(joinToArtist_artType)).get_asString()] =
-            CTextureUtils::GetWrappedImageURL(record->at(joinLayout.GetRecNo(joinToArtist_artURL)).get_asString());
+          artistObj["art"][record.at(joinLayout.GetRecNo(joinToArtist_artType)).get_asString()] =
+            CTextureUtils::GetWrappedImageURL(record.at(joinLayout.GetRecNo(joinToArtist_artURL)).get_asString());
         }
         if (joinLayout.GetOutput(joinToArtist_thumbnail) &&
-          record->at(joinLayout.GetRecNo(joinToArtist_artType)).get_asString() == "thumb")
+          record.at(joinLayout.GetRecNo(joinToArtist_artType)).get_asString() == "thumb")
         {
-          artistObj["thumbnail"] = CTextureUtils::GetWrappedImageURL(record->at(joinLayout.GetRecNo(joinToArtist_artURL)).get_asString());
+          artistObj["thumbnail"] = CTextureUtils::GetWrappedImageURL(record.at(joinLayout.GetRecNo(joinToArtist_artURL)).get_asString());
         }
         if (joinLayout.GetOutput(joinToArtist_fanart) &&
-          record->at(joinLayout.GetRecNo(joinToArtist_artType)).get_asString() == "fanart")
+          record.at(joinLayout.GetRecNo(joinToArtist_artType)).get_asString() == "fanart")
         {
-          artistObj["fanart"] = CTextureUtils::GetWrappedImageURL(record->at(joinLayout.GetRecNo(joinToArtist_artURL)).get_asString());
+          artistObj["fanart"] = CTextureUtils::GetWrappedImageURL(record.at(joinLayout.GetRecNo(joinToArtist_artURL)).get_asString());
         }
       }
 
@@ -6327,9 +6364,9 @@ bool CMusicDatabase::GetAlbumsByWhereJSON(const std::set<std::string>& fields, c
     CVariant albumObj;
     while (!m_pDS->eof() || !albumObj.empty())
     {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+      const dbiplus::row_view record = m_pDS->get_row();
 
-      if (m_pDS->eof() || albumId != record->at(0).get_asInt())
+      if (m_pDS->eof() || albumId != record.at(0).get_asInt())
       { 
         // Store previous or last album
         if (!albumObj.empty())
@@ -6357,40 +6394,40 @@ bool CMusicDatabase::GetAlbumsByWhereJSON(const std::set<std::string>& fields, c
           continue; // Having saved last album stop
 
         // New album
-        albumId = record->at(0).get_asInt();
+        albumId = record.at(0).get_asInt();
         albumObj["albumid"] = albumId;
-        albumObj["label"] = record->at(1).get_asString();
+        albumObj["label"] = record.at(1).get_asString();
         for (size_t i = 0; i < dbfieldindex.size(); i++)
           if (dbfieldindex[i] > -1)
           {
             if (JSONtoDBAlbum[dbfieldindex[i]].formatJSON == "integer")
-              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asInt();
+              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = record.at(1 + i).get_asInt();
             else if (JSONtoDBAlbum[dbfieldindex[i]].formatJSON == "unsigned")
-              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = std::max(record->at(1 + i).get_asInt(), 0);
+              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = std::max(record.at(1 + i).get_asInt(), 0);
             else if (JSONtoDBAlbum[dbfieldindex[i]].formatJSON == "float")
-              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = std::max(record->at(1 + i).get_asFloat(), 0.f);
+              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = std::max(record.at(1 + i).get_asFloat(), 0.f);
             else if (JSONtoDBAlbum[dbfieldindex[i]].formatJSON == "array")
-              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = StringUtils::Split(record->at(1 + i).get_asString(),
+              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = StringUtils::Split(record.at(1 + i).get_asString(),
                 CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator);
             else if (JSONtoDBAlbum[dbfieldindex[i]].formatJSON == "boolean")
-              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asBool();
+              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = record.at(1 + i).get_asBool();
             else if (JSONtoDBAlbum[dbfieldindex[i]].formatJSON == "image")
             {
-              std::string url = record->at(1 + i).get_asString();
+              std::string url = record.at(1 + i).get_asString();
               if (!url.empty())
                 url = CTextureUtils::GetWrappedImageURL(url);
               albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = url;
             }
             else
-              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asString();
+              albumObj[JSONtoDBAlbum[dbfieldindex[i]].fieldJSON] = record.at(1 + i).get_asString();
           }
       }
       if (bJoinAlbumArtist && joinLayout.GetRecNo(joinToAlbum_idArtist) > -1)
       {
-        if (artistId != record->at(joinLayout.GetRecNo(joinToAlbum_idArtist)).get_asInt())
+        if (artistId != record.at(joinLayout.GetRecNo(joinToAlbum_idArtist)).get_asInt())
         {
           bSongGenreDone = (artistId > 0);  // Not first artist, skip genre
-          artistId = record->at(joinLayout.GetRecNo(joinToAlbum_idArtist)).get_asInt();
+          artistId = record.at(joinLayout.GetRecNo(joinToAlbum_idArtist)).get_asInt();
           if (joinLayout.GetOutput(joinToAlbum_idArtist))
             albumObj["artistid"].append(artistId);
           if (artistId == BLANKARTIST_ID)
@@ -6403,19 +6440,19 @@ bool CMusicDatabase::GetAlbumsByWhereJSON(const std::set<std::string>& fields, c
           else
           {
             if (joinLayout.GetOutput(joinToAlbum_strArtist) && joinLayout.GetRecNo(joinToAlbum_strArtist) > -1)
-              albumObj["artist"].append(record->at(joinLayout.GetRecNo(joinToAlbum_strArtist)).get_asString());
+              albumObj["artist"].append(record.at(joinLayout.GetRecNo(joinToAlbum_strArtist)).get_asString());
             if (joinLayout.GetOutput(joinToAlbum_strArtistMBID) && joinLayout.GetRecNo(joinToAlbum_strArtistMBID) > -1)
-              albumObj["musicbrainzalbumartistid"].append(record->at(joinLayout.GetRecNo(joinToAlbum_strArtistMBID)).get_asString());
+              albumObj["musicbrainzalbumartistid"].append(record.at(joinLayout.GetRecNo(joinToAlbum_strArtistMBID)).get_asString());
           }
         }        
       }
       if (!bSongGenreDone && joinLayout.GetRecNo(joinToAlbum_idSongGenre) > -1 &&
           joinLayout.GetRecNo(joinToAlbum_strSongGenre) > -1 &&
-          !record->at(joinLayout.GetRecNo(joinToAlbum_idSongGenre)).get_isNull())
+          !record.at(joinLayout.GetRecNo(joinToAlbum_idSongGenre)).get_isNull())
       {
         CVariant genreObj;
-        genreObj["genreid"] = record->at(joinLayout.GetRecNo(joinToAlbum_idSongGenre)).get_asInt();
-        genreObj["title"] = record->at(joinLayout.GetRecNo(joinToAlbum_strSongGenre)).get_asString();
+        genreObj["genreid"] = record.at(joinLayout.GetRecNo(joinToAlbum_idSongGenre)).get_asInt();
+        genreObj["title"] = record.at(joinLayout.GetRecNo(joinToAlbum_strSongGenre)).get_asString();
         albumObj["songgenres"].append(genreObj);
       }
       m_pDS->next();
@@ -6880,9 +6917,9 @@ bool CMusicDatabase::GetSongsByWhereJSON(const std::set<std::string>& fields, co
     CVariant songObj;
     while (!m_pDS->eof() || bHaveSong)
     {
-      const dbiplus::sql_record* const record = m_pDS->get_sql_record();
+      const dbiplus::row_view record = m_pDS->get_row();
 
-      if (m_pDS->eof() || songId != record->at(0).get_asInt())
+      if (m_pDS->eof() || songId != record.at(0).get_asInt())
       {
         // Store previous or last song
         if (bHaveSong)
@@ -6932,25 +6969,25 @@ bool CMusicDatabase::GetSongsByWhereJSON(const std::set<std::string>& fields, co
           continue;  // Having saved the last song stop
 
         // New song
-        songId = record->at(0).get_asInt();
+        songId = record.at(0).get_asInt();
         bHaveSong = true;
         songObj["songid"] = songId;
-        songObj["label"] = record->at(1).get_asString();
+        songObj["label"] = record.at(1).get_asString();
         for (size_t i = 0; i < dbfieldindex.size(); i++)
           if (dbfieldindex[i] > -1)
           {
             if (JSONtoDBSong[dbfieldindex[i]].formatJSON == "integer")
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asInt();
+              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = record.at(1 + i).get_asInt();
             else if (JSONtoDBSong[dbfieldindex[i]].formatJSON == "unsigned")
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = std::max(record->at(1 + i).get_asInt(), 0);
+              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = std::max(record.at(1 + i).get_asInt(), 0);
             else if (JSONtoDBSong[dbfieldindex[i]].formatJSON == "float")
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = std::max(record->at(1 + i).get_asFloat(), 0.f);
+              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = std::max(record.at(1 + i).get_asFloat(), 0.f);
             else if (JSONtoDBSong[dbfieldindex[i]].formatJSON == "array")
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = StringUtils::Split(record->at(1 + i).get_asString(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator);
+              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = StringUtils::Split(record.at(1 + i).get_asString(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicItemSeparator);
             else if (JSONtoDBSong[dbfieldindex[i]].formatJSON == "boolean")
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asBool();
+              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = record.at(1 + i).get_asBool();
             else
-              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = record->at(1 + i).get_asString();
+              songObj[JSONtoDBSong[dbfieldindex[i]].fieldJSON] = record.at(1 + i).get_asString();
           }
 
         // Split sources string into int array
@@ -6965,11 +7002,11 @@ bool CMusicDatabase::GetSongsByWhereJSON(const std::set<std::string>& fields, co
 
       if (bJoinAlbumArtist)
       {
-        if (albumartistId != record->at(joinLayout.GetRecNo(joinToSongs_idAlbumArtist)).get_asInt())
+        if (albumartistId != record.at(joinLayout.GetRecNo(joinToSongs_idAlbumArtist)).get_asInt())
         {
           bSongGenreDone = bSongGenreDone || (albumartistId > 0);  // Not first album artist, skip genre
           bSongArtistDone = bSongArtistDone || (albumartistId > 0);  // Not first album artist, skip song artists
-          albumartistId = record->at(joinLayout.GetRecNo(joinToSongs_idAlbumArtist)).get_asInt();
+          albumartistId = record.at(joinLayout.GetRecNo(joinToSongs_idAlbumArtist)).get_asInt();
           if (joinLayout.GetOutput(joinToSongs_idAlbumArtist))
             songObj["albumartistid"].append(albumartistId);
           if (albumartistId == BLANKARTIST_ID)
@@ -6984,21 +7021,21 @@ bool CMusicDatabase::GetSongsByWhereJSON(const std::set<std::string>& fields, co
             if (joinLayout.GetOutput(joinToSongs_idAlbumArtist))
               songObj["albumartistid"].append(albumartistId);
             if (joinLayout.GetOutput(joinToSongs_strAlbumArtist))
-              songObj["albumartist"].append(record->at(joinLayout.GetRecNo(joinToSongs_strAlbumArtist)).get_asString());
+              songObj["albumartist"].append(record.at(joinLayout.GetRecNo(joinToSongs_strAlbumArtist)).get_asString());
             if (joinLayout.GetOutput(joinToSongs_strAlbumArtistMBID))
-              songObj["musicbrainzalbumartistid"].append(record->at(joinLayout.GetRecNo(joinToSongs_strAlbumArtistMBID)).get_asString());
+              songObj["musicbrainzalbumartistid"].append(record.at(joinLayout.GetRecNo(joinToSongs_strAlbumArtistMBID)).get_asString());
           }
         }
       }
       if (bJoinSongArtist && !bSongArtistDone)
       {
-        if (artistId != record->at(joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt())
+        if (artistId != record.at(joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt())
         {
           bSongGenreDone = bSongGenreDone || (artistId > 0);  // Not first artist, skip genre
           roleId = -1; // Allow for many artists same role
-          artistId = record->at(joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt();
+          artistId = record.at(joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt();
           if (joinLayout.GetRecNo(joinToSongs_idRole) < 0 ||
-              record->at(joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt() == 1)
+              record.at(joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt() == 1)
           {
             if (joinLayout.GetOutput(joinToSongs_idArtist))
               songObj["artistid"].append(artistId);
@@ -7012,26 +7049,26 @@ bool CMusicDatabase::GetSongsByWhereJSON(const std::set<std::string>& fields, co
             else
             {
               if (joinLayout.GetOutput(joinToSongs_strArtist))
-                songObj["artist"].append(record->at(joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString());
+                songObj["artist"].append(record.at(joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString());
               if (joinLayout.GetOutput(joinToSongs_strArtistMBID))
-                songObj["musicbrainzartistid"].append(record->at(joinLayout.GetRecNo(joinToSongs_strArtistMBID)).get_asString());
+                songObj["musicbrainzartistid"].append(record.at(joinLayout.GetRecNo(joinToSongs_strArtistMBID)).get_asString());
             }
           }
         }
         if (joinLayout.GetRecNo(joinToSongs_idRole) > 0 &&
-            roleId != record->at(joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt())
+            roleId != record.at(joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt())
         {
           bSongGenreDone = bSongGenreDone || (roleId > 0);  // Not first role, skip genre
-          roleId = record->at(joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt();
+          roleId = record.at(joinLayout.GetRecNo(joinToSongs_idRole)).get_asInt();
           if (roleId > 1)
           {
             if (bJoinRole)
             {  //Contributors
                CVariant contributor;
-               contributor["name"] = record->at(joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString();
-               contributor["role"] = record->at(joinLayout.GetRecNo(joinToSongs_strRole)).get_asString();
+               contributor["name"] = record.at(joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString();
+               contributor["role"] = record.at(joinLayout.GetRecNo(joinToSongs_strRole)).get_asString();
                contributor["roleid"] = roleId;
-               contributor["artistid"] = record->at(joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt();
+               contributor["artistid"] = record.at(joinLayout.GetRecNo(joinToSongs_idArtist)).get_asInt();
                songObj["contributors"].append(contributor);               
             }
             // "displaycomposer", "displayconductor" etc.
@@ -7039,7 +7076,7 @@ bool CMusicDatabase::GetSongsByWhereJSON(const std::set<std::string>& fields, co
             {
               if (roleidlist[i] == roleId)
               {
-                songObj[rolefieldlist[i]].append(record->at(joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString());
+                songObj[rolefieldlist[i]].append(record.at(joinLayout.GetRecNo(joinToSongs_strArtist)).get_asString());
                 continue;
               }
             }
@@ -7047,9 +7084,9 @@ bool CMusicDatabase::GetSongsByWhereJSON(const std::set<std::string>& fields, co
         }
       }
       if (!bSongGenreDone && joinLayout.GetRecNo(joinToSongs_idGenre) > -1 &&
-          !record->at(joinLayout.GetRecNo(joinToSongs_idGenre)).get_isNull())
+          !record.at(joinLayout.GetRecNo(joinToSongs_idGenre)).get_isNull())
       {
-        songObj["genreid"].append(record->at(joinLayout.GetRecNo(joinToSongs_idGenre)).get_asInt());
+        songObj["genreid"].append(record.at(joinLayout.GetRecNo(joinToSongs_idGenre)).get_asInt());
       }
       m_pDS->next();
     }
@@ -7943,7 +7980,7 @@ void CMusicDatabase::UpdateTables(int version)
 
 int CMusicDatabase::GetSchemaVersion() const
 {
-  return 75;
+  return 77;
 }
 
 int CMusicDatabase::GetMusicNeedsTagScan()
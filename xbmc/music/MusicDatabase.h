@@ -29,8 +29,7 @@ class CFileItem;
 
 namespace dbiplus
 {
-  class field_value;
-  typedef std::vector<field_value> sql_record;
+  class row_view;
 }
 
 #include <set>
@@ -696,13 +695,13 @@ private:
   void SplitPath(const std::string& strFileNameAndPath, std::string& strPath, std::string& strFileName);
 
   CSong GetSongFromDataset();
-  CSong GetSongFromDataset(const dbiplus::sql_record* const record, int offset = 0);
+  CSong GetSongFromDataset(const dbiplus::row_view& record, int offset = 0);
   CArtist GetArtistFromDataset(dbiplus::Dataset* pDS, int offset = 0, bool needThumb = true);
-  CArtist GetArtistFromDataset(const dbiplus::sql_record* const record, int offset = 0, bool needThumb = true);
+  CArtist GetArtistFromDataset(const dbiplus::row_view& record, int offset = 0, bool needThumb = true);
   CAlbum GetAlbumFromDataset(dbiplus::Dataset* pDS, int offset = 0, bool imageURL = false);
-  CAlbum GetAlbumFromDataset(const dbiplus::sql_record* const record, int offset = 0, bool imageURL = false);
-  CArtistCredit GetArtistCreditFromDataset(const dbiplus::sql_record* const record, int offset = 0);
-  CMusicRole GetArtistRoleFromDataset(const dbiplus::sql_record* const record, int offset = 0);
+  CAlbum GetAlbumFromDataset(const dbiplus::row_view& record, int offset = 0, bool imageURL = false);
+  CArtistCredit GetArtistCreditFromDataset(const dbiplus::row_view& record, int offset = 0);
+  CMusicRole GetArtistRoleFromDataset(const dbiplus::row_view& record, int offset = 0);
   /*! \brief Updates the dateAdded field in the song table for the file
   with the given songId and the given path based on the files modification date
   \param songId id of the song in the song table
@@ -710,7 +709,7 @@ private:
   */
   void UpdateFileDateAdded(int songId, const std::string& strFileNameAndPath);
   void GetFileItemFromDataset(CFileItem* item, const CMusicDbUrl &baseUrl);
-  void GetFileItemFromDataset(const dbiplus::sql_record* const record, CFileItem* item, const CMusicDbUrl &baseUrl);
+  void GetFileItemFromDataset(const dbiplus::row_view& record, CFileItem* item, const CMusicDbUrl &baseUrl);
   void GetFileItemFromArtistCredits(VECARTISTCREDITS& artistCredits, CFileItem* item);
     
   bool CleanupSongs(CGUIDialogProgress* progressDialog = nullptr);
@@ -722,6 +721,11 @@ private:
   bool CleanupInfoSettings();
   bool CleanupRoles();
   void UpdateTables(int version) override;
+  /*! \brief FTS5 query for a search of artist, album or song names, empty to search with LIKE
+   \param index the full text search index of the artist, album or song table
+   \param search the name to search for
+   */
+  std::string GetFullTextSearch(const std::string& index, const std::string& search);
   bool SearchArtists(const std::string& search, CFileItemList &artists);
   bool SearchAlbums(const std::string& search, CFileItemList &albums);
   bool SearchSongs(const std::string& strSearch, CFileItemList &songs);
@@ -44,9 +44,12 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/Condition.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "utils/Digest.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
@@ -122,6 +125,11 @@ void CMusicInfoScanner::Process()
       m_bCanInterrupt = false;
       m_needsCleanup = false;
 
+      // the same readers serve all folders of the scan, dedicated as they mostly wait for the storage
+      const unsigned int tagReadThreads = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iMusicLibraryTagReadThreads;
+      if (tagReadThreads > 1)
+        m_tagReaders.reset(new CJobQueue(false, tagReadThreads, CJob::PRIORITY_DEDICATED));
+
       bool commit = true;
       for (const auto& it : m_pathsToScan)
       {
@@ -263,6 +271,7 @@ void CMusicInfoScanner::Process()
   {
     CLog::Log(LOGERROR, "MusicInfoScanner: Exception while scanning.");
   }
+  m_tagReaders.reset();
   m_musicDatabase.Close();
   CLog::Log(LOGDEBUG, "%s - Finished scan", __FUNCTION__);
 
@@ -550,16 +559,29 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   return !m_bStop;
 }
 
+namespace
+{
+void ReadTag(CFileItem& item)
+{
+  CMusicInfoTag& tag = *item.GetMusicInfoTag();
+  if (tag.Loaded())
+    return;
+
+  std::unique_ptr<IMusicInfoTagLoader> pLoader(CMusicInfoTagLoaderFactory::CreateLoader(item));
+  if (nullptr != pLoader)
+    pLoader->Load(item.GetPath(), tag);
+}
+}
+
 CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
                                                    CFileItemList& scannedItems)
 {
-  std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  std::vector<std::string> regexps = advancedSettings->m_audioExcludeFromScanRegExps;
 
+  std::vector<CFileItemPtr> files;
   for (int i = 0; i < items.Size(); ++i)
   {
-    if (m_bStop)
-      return INFO_CANCELLED;
-
     CFileItemPtr pItem = items[i];
 
     if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
@@ -568,16 +590,75 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
     if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics())
       continue;
 
+    files.push_back(pItem);
+  }
+
+  /*
+  Reading tags is mostly waiting for files to be opened and read, which is slow on network shares.
+  So the tags (and the embedded art info) are read by the readers of the scan, which run at most a
+  few files ahead of this loop. Everything else, turning the files into songs and albums and adding
+  them to the library, stays on this thread and in the original order.
+  */
+  struct SReads
+  {
+    CCriticalSection section;
+    XbmcThreads::ConditionVariable cond;
+    std::vector<bool> read;
+  };
+  // the reads are shared with the jobs, which may finish after a stopped scan returned
+  std::shared_ptr<SReads> reads;
+  size_t lookahead = 0;
+  size_t queued = 0;
+  if (m_tagReaders && files.size() > 1)
+  {
+    reads = std::make_shared<SReads>();
+    reads->read.resize(files.size(), false);
+    lookahead = advancedSettings->m_iMusicLibraryTagReadThreads * 4;
+  }
+
+  INFO_RET result = INFO_ADDED;
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    if (m_bStop)
+    {
+      result = INFO_CANCELLED;
+      break;
+    }
+
+    CFileItemPtr pItem = files[i];
+
     m_currentItem++;
 
-    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
+    if (!reads)
+      ReadTag(*pItem);
+    else
     {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (nullptr != pLoader)
-        pLoader->Load(pItem->GetPath(), tag);
+      for (; queued < files.size() && queued < i + lookahead; ++queued)
+      {
+        const CFileItemPtr file = files[queued];
+        const size_t index = queued;
+        m_tagReaders->Submit([reads, file, index]()
+        {
+          ReadTag(*file);
+          CSingleLock lock(reads->section);
+          reads->read[index] = true;
+          reads->cond.notifyAll();
+        });
+      }
+
+      CSingleLock lock(reads->section);
+      // Stop() doesn't wake us up, so check for it every now and then
+      while (!reads->read[i] && !m_bStop)
+        reads->cond.wait(lock, 100);
+      if (!reads->read[i])
+      {
+        result = INFO_CANCELLED;
+        break;
+      }
     }
 
+    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
+
     if (m_handle && m_itemCount>0)
       m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
 
@@ -597,7 +678,12 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
     else
       scannedItems.Add(pItem);
   }
-  return INFO_ADDED;
+
+  // a stopped scan doesn't read the rest
+  if (reads && result == INFO_CANCELLED)
+    m_tagReaders->CancelJobs();
+
+  return result;
 }
 
 static bool SortSongsByTrack(const CSong& song, const CSong& song2)
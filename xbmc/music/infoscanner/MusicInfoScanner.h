@@ -15,9 +15,12 @@
 #include "threads/IRunnable.h"
 #include "threads/Thread.h"
 
+#include <memory>
+
 class CAlbum;
 class CArtist;
 class CGUIDialogProgressBarHandle;
+class CJobQueue;
 
 namespace MUSIC_INFO
 {
@@ -239,5 +242,6 @@ protected:
   std::set<std::string> m_seenPaths;
   int m_flags;
   CThread m_fileCountReader;
+  std::unique_ptr<CJobQueue> m_tagReaders; ///< reads the tags of all folders during a scan, null if they are read in ScanTags()
 };
 }
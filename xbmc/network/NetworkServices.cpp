@@ -529,6 +529,7 @@ bool CNetworkServices::StartWebserver()
   if (IsWebserverRunning())
     return true;
 
+  m_webserver.SetThreadPoolSize(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_webserverThreadPoolSize);
   if (!m_webserver.Start(webPort, m_settings->GetString(CSettings::SETTING_SERVICES_WEBSERVERUSERNAME), m_settings->GetString(CSettings::SETTING_SERVICES_WEBSERVERPASSWORD)))
     return false;
 
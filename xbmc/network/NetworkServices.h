@@ -42,6 +42,9 @@ public:
   bool StartWebserver();
   bool IsWebserverRunning();
   bool StopWebserver();
+#ifdef HAS_WEB_SERVER
+  const CWebServer& GetWebServer() const { return m_webserver; }
+#endif
 
   bool StartAirPlayServer();
   bool IsAirPlayServerRunning();
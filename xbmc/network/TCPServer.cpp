@@ -13,10 +13,19 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 
+#include <algorithm>
+#include <errno.h>
+
+#if defined(HAS_TCPSERVER_EPOLL)
+#include <fcntl.h>
+#include <sys/epoll.h>
+#endif
+
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "interfaces/json-rpc/JSONRPC.h"
 #include "interfaces/AnnouncementManager.h"
+#include "utils/JSONVariantWriter.h"
 #include "utils/log.h"
 #include "utils/Variant.h"
 #include "threads/SingleLock.h"
@@ -49,6 +58,9 @@ static const bdaddr_t bt_bdaddr_local = {{0, 0, 0, 0xff, 0xff, 0xff}};
 using namespace JSONRPC;
 
 #define RECEIVEBUFFER 1024
+#define SENDBUFFER    16384
+#define MAXQUEUED     (16 * 1024 * 1024)
+#define MAXEVENTS     64
 
 CTCPServer *CTCPServer::ServerInstance = NULL;
 
@@ -100,111 +112,251 @@ void CTCPServer::Process()
 
   while (!m_bStop)
   {
-    SOCKET          max_fd = 0;
-    fd_set          rfds;
-    struct timeval  to     = {1, 0};
-    FD_ZERO(&rfds);
+#if defined(HAS_TCPSERVER_EPOLL)
+    ProcessEpoll();
+#else
+    ProcessSelect();
+#endif
+  }
 
-    for (auto& it : m_servers)
+  Deinitialize();
+}
+
+#if defined(HAS_TCPSERVER_EPOLL)
+void CTCPServer::ProcessEpoll()
+{
+  struct epoll_event events[MAXEVENTS];
+  int res = epoll_wait(m_epoll, events, MAXEVENTS, 1000);
+  if (res < 0)
+  {
+    if (errno == EINTR)
+      return;
+
+    CLog::Log(LOGERROR, "JSONRPC Server: epoll_wait failed: %d", errno);
+    CThread::Sleep(1000);
+    Initialize();
+    return;
+  }
+
+  for (int i = 0; i < res; i++)
+  {
+    CTCPClient *client = static_cast<CTCPClient*>(events[i].data.ptr);
+    if (client == NULL)
     {
-      FD_SET(it, &rfds);
-      if ((intptr_t)it > (intptr_t)max_fd)
-        max_fd = it;
+      // one of the listening sockets, they are few so just try all of them
+      bool reinitialized = false;
+      for (auto& it : m_servers)
+      {
+        if (!AcceptConnection(it))
+        {
+          reinitialized = true;
+          break;
+        }
+      }
+      // the connections of this batch are gone
+      if (reinitialized)
+        return;
+      continue;
     }
 
-    for (unsigned int i = 0; i < m_connections.size(); i++)
+    bool close = (events[i].events & (EPOLLERR | EPOLLHUP)) != 0;
+    if (!close && (events[i].events & EPOLLOUT))
+      close = !client->Flush();
+
+    // the sockets are edge triggered, read until there's nothing left
+    while (!close && (events[i].events & (EPOLLIN | EPOLLRDHUP)))
     {
-      FD_SET(m_connections[i]->m_socket, &rfds);
-      if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
-        max_fd = m_connections[i]->m_socket;
+      char buffer[RECEIVEBUFFER] = {};
+      int nread = recv(client->m_socket, buffer, RECEIVEBUFFER, 0);
+      if (nread > 0)
+        client = HandleData(client, buffer, nread, close);
+      else if (nread < 0 && errno == EINTR)
+        continue;
+      else if (nread < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        break;
+      else
+        close = true;
     }
 
-    int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
-    if (res < 0)
+    if (close)
+      CloseConnection(client);
+  }
+}
+
+bool CTCPServer::InitializeEpoll()
+{
+  m_epoll = epoll_create1(EPOLL_CLOEXEC);
+  if (m_epoll < 0)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Failed to create epoll instance: %d", errno);
+    return false;
+  }
+
+  for (auto& it : m_servers)
+  {
+    fcntl(it, F_SETFL, fcntl(it, F_GETFL) | O_NONBLOCK);
+
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, it, &event) < 0)
     {
-      CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
-      CThread::Sleep(1000);
-      Initialize();
+      CLog::Log(LOGERROR, "JSONRPC Server: Failed to watch server socket: %d", errno);
+      return false;
     }
-    else if (res > 0)
+  }
+  return true;
+}
+#else
+void CTCPServer::ProcessSelect()
+{
+  SOCKET          max_fd = 0;
+  fd_set          rfds;
+  struct timeval  to     = {1, 0};
+  FD_ZERO(&rfds);
+
+  for (auto& it : m_servers)
+  {
+    FD_SET(it, &rfds);
+    if ((intptr_t)it > (intptr_t)max_fd)
+      max_fd = it;
+  }
+
+  for (unsigned int i = 0; i < m_connections.size(); i++)
+  {
+    FD_SET(m_connections[i]->m_socket, &rfds);
+    if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
+      max_fd = m_connections[i]->m_socket;
+  }
+
+  int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
+  if (res < 0)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
+    CThread::Sleep(1000);
+    Initialize();
+  }
+  else if (res > 0)
+  {
+    for (int i = m_connections.size() - 1; i >= 0; i--)
     {
-      for (int i = m_connections.size() - 1; i >= 0; i--)
+      CTCPClient *client = m_connections[i];
+      if (FD_ISSET(client->m_socket, &rfds))
       {
-        int socket = m_connections[i]->m_socket;
-        if (FD_ISSET(socket, &rfds))
-        {
-          char buffer[RECEIVEBUFFER] = {};
-          int  nread = 0;
-          nread = recv(socket, (char*)&buffer, RECEIVEBUFFER, 0);
-          bool close = false;
-          if (nread > 0)
-          {
-            std::string response;
-            if (m_connections[i]->IsNew())
-            {
-              CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
-
-              if (!response.empty())
-                m_connections[i]->Send(response.c_str(), response.size());
-
-              if (websocket != NULL)
-              {
-                // Replace the CTCPClient with a CWebSocketClient
-                CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *(m_connections[i]));
-                delete m_connections[i];
-                m_connections.erase(m_connections.begin() + i);
-                m_connections.insert(m_connections.begin() + i, websocketClient);
-              }
-            }
-
-            if (response.size() <= 0)
-              m_connections[i]->PushBuffer(this, buffer, nread);
-
-            close = m_connections[i]->Closing();
-          }
-          else
-            close = true;
+        char buffer[RECEIVEBUFFER] = {};
+        int  nread = 0;
+        nread = recv(client->m_socket, (char*)&buffer, RECEIVEBUFFER, 0);
+        bool close = false;
+        if (nread > 0)
+          client = HandleData(client, buffer, nread, close);
+        else
+          close = true;
 
-          if (close)
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
-            m_connections[i]->Disconnect();
-            delete m_connections[i];
-            m_connections.erase(m_connections.begin() + i);
-          }
-        }
+        if (close)
+          CloseConnection(client);
       }
+    }
 
-      for (auto& it : m_servers)
-      {
-        if (FD_ISSET(it, &rfds))
-        {
-          CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
-          CTCPClient *newconnection = new CTCPClient();
-          newconnection->m_socket =
-              accept(it, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
+    for (auto& it : m_servers)
+    {
+      if (FD_ISSET(it, &rfds) && !AcceptConnection(it))
+        break;
+    }
+  }
+}
+#endif
 
-          if (newconnection->m_socket == INVALID_SOCKET)
-          {
-            CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: %d", errno);
-            if (EBADF == errno)
-            {
-              CThread::Sleep(1000);
-              Initialize();
-              break;
-            }
-          }
-          else
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
-            m_connections.push_back(newconnection);
-          }
-        }
-      }
+bool CTCPServer::AcceptConnection(SOCKET server)
+{
+  CTCPClient *newconnection = new CTCPClient();
+  newconnection->m_socket =
+      accept(server, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
+
+  if (newconnection->m_socket == INVALID_SOCKET)
+  {
+    int error = errno;
+    delete newconnection;
+#if defined(HAS_TCPSERVER_EPOLL)
+    // the listening sockets are non-blocking, this one simply had nothing pending
+    if (error == EAGAIN || error == EWOULDBLOCK)
+      return true;
+#endif
+    CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: %d", error);
+    if (EBADF == error)
+    {
+      CThread::Sleep(1000);
+      Initialize();
+      return false;
     }
+    return true;
   }
 
-  Deinitialize();
+#if defined(HAS_TCPSERVER_EPOLL)
+  fcntl(newconnection->m_socket, F_SETFL, fcntl(newconnection->m_socket, F_GETFL) | O_NONBLOCK);
+
+  // edge triggered, idle connections don't cost anything and EPOLLOUT only fires when a full
+  // socket has room again
+  struct epoll_event event = {};
+  event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+  event.data.ptr = newconnection;
+  if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, newconnection->m_socket, &event) < 0)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Failed to watch new connection: %d", errno);
+    newconnection->Disconnect();
+    delete newconnection;
+    return true;
+  }
+#endif
+
+  CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
+  m_connections.push_back(newconnection);
+  return true;
+}
+
+CTCPServer::CTCPClient* CTCPServer::HandleData(CTCPClient *client, const char *buffer, int length, bool &close)
+{
+  std::string response;
+  if (client->IsNew())
+  {
+    CWebSocket *websocket = CWebSocketManager::Handle(buffer, length, response);
+
+    if (!response.empty())
+      client->Send(response.c_str(), response.size());
+
+    if (websocket != NULL)
+    {
+      // Replace the CTCPClient with a CWebSocketClient
+      CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *client);
+      std::replace(m_connections.begin(), m_connections.end(), client, static_cast<CTCPClient*>(websocketClient));
+      delete client;
+      client = websocketClient;
+
+#if defined(HAS_TCPSERVER_EPOLL)
+      struct epoll_event event = {};
+      event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+      event.data.ptr = client;
+      epoll_ctl(m_epoll, EPOLL_CTL_MOD, client->m_socket, &event);
+#endif
+    }
+  }
+
+  if (response.size() <= 0)
+    client->PushBuffer(this, buffer, length);
+
+  close = client->Closing();
+  return client;
+}
+
+void CTCPServer::CloseConnection(CTCPClient *client)
+{
+  CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+#if defined(HAS_TCPSERVER_EPOLL)
+  // a websocket that is still closing keeps its socket open
+  epoll_ctl(m_epoll, EPOLL_CTL_DEL, client->m_socket, NULL);
+#endif
+  client->Disconnect();
+  m_connections.erase(std::remove(m_connections.begin(), m_connections.end(), client), m_connections.end());
+  delete client;
 }
 
 bool CTCPServer::PrepareDownload(const char *path, CVariant &details, std::string &protocol)
@@ -247,6 +399,14 @@ bool CTCPServer::Initialize()
   started |= InitializeBlue();
   started |= InitializeTCP();
 
+#if defined(HAS_TCPSERVER_EPOLL)
+  if (started && !InitializeEpoll())
+  {
+    Deinitialize();
+    started = false;
+  }
+#endif
+
   if (started)
   {
     CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
@@ -481,6 +641,12 @@ void CTCPServer::Deinitialize()
   m_sdpd = NULL;
 #endif
 
+#if defined(HAS_TCPSERVER_EPOLL)
+  if (m_epoll >= 0)
+    close(m_epoll);
+  m_epoll = -1;
+#endif
+
   CServiceBroker::GetAnnouncementManager()->RemoveAnnouncer(this);
 }
 
@@ -508,6 +674,8 @@ CTCPServer::CTCPClient& CTCPServer::CTCPClient::operator=(const CTCPClient& clie
   return *this;
 }
 
+CTCPServer::CTCPClient::~CTCPClient() = default;
+
 int CTCPServer::CTCPClient::GetPermissionFlags()
 {
   return OPERATION_PERMISSION_ALL;
@@ -524,14 +692,190 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
   return true;
 }
 
+#if defined(HAS_TCPSERVER_EPOLL)
+void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
+{
+  CSingleLock lock (m_critSection);
+  if (m_socket == INVALID_SOCKET)
+    return;
+
+  // never block on a slow client, the message waits behind the data that is already pending
+  // and is sent by the server thread once the socket has room again
+  if (m_queued.size() + size > MAXQUEUED)
+  {
+    // the client doesn't read at all, drop it instead of buffering forever
+    CLog::Log(LOGWARNING, "JSONRPC Server: Client isn't reading, dropping the connection");
+    ClearOutput();
+    shutdown(m_socket, SHUT_RDWR);
+    return;
+  }
+  m_queued.append(data, size);
+
+  // responses are only serialized by the server thread, which sends the message after them
+  if (m_responses.empty())
+    Flush(); // if the connection is gone the server thread notices when reading
+}
+
+void CTCPServer::CTCPClient::SendResponse(std::unique_ptr<CJSONVariantStreamWriter> response)
+{
+  CSingleLock lock (m_critSection);
+  if (m_socket == INVALID_SOCKET)
+    return;
+
+  // the response is serialized piece by piece as the socket takes it, announcements sent in
+  // the meantime wait until it is complete
+  m_responses.push_back(std::move(response));
+  Flush();
+}
+
+bool CTCPServer::CTCPClient::Flush()
+{
+  CSingleLock lock (m_critSection);
+  while (true)
+  {
+    size_t offset = 0;
+    while (offset < m_outgoing.size())
+    {
+      ssize_t sent = send(m_socket, m_outgoing.data() + offset, m_outgoing.size() - offset, MSG_NOSIGNAL);
+      if (sent > 0)
+        offset += sent;
+      else if (sent < 0 && errno == EINTR)
+        continue;
+      else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      {
+        m_outgoing.erase(0, offset);
+        return true;
+      }
+      else
+      {
+        // nobody is going to read the rest, stop serializing it
+        ClearOutput();
+        return false;
+      }
+    }
+    m_outgoing.clear();
+
+    // refill with the next part of the oldest response, queued announcements go after it
+    if (!m_responses.empty())
+    {
+      if (!WriteResponse(*m_responses.front(), m_outgoing))
+        m_responses.pop_front();
+    }
+    else if (!m_queued.empty())
+      m_outgoing.swap(m_queued);
+    else
+      return true;
+  }
+}
+
+#else
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
-  unsigned int sent = 0;
-  do
   {
     CSingleLock lock (m_critSection);
-    sent += send(m_socket, data + sent, size - sent, 0);
-  } while (sent < size);
+    if (m_socket == INVALID_SOCKET)
+      return;
+
+    if (m_queued.size() + size > MAXQUEUED)
+    {
+      // the client doesn't read at all, drop it instead of buffering forever
+      CLog::Log(LOGWARNING, "JSONRPC Server: Client isn't reading, dropping the connection");
+      ClearOutput();
+      shutdown(m_socket, SHUT_RDWR);
+      return;
+    }
+    m_queued.append(data, size);
+  }
+  Flush();
+}
+
+void CTCPServer::CTCPClient::SendResponse(std::unique_ptr<CJSONVariantStreamWriter> response)
+{
+  {
+    CSingleLock lock (m_critSection);
+    if (m_socket == INVALID_SOCKET)
+      return;
+
+    // announcements sent while the response is written wait until it is complete
+    m_responses.push_back(std::move(response));
+  }
+  Flush();
+}
+
+bool CTCPServer::CTCPClient::Flush()
+{
+  CSingleLock lock (m_critSection);
+  // the thread that is sending already picks up what was queued since
+  if (m_sending)
+    return true;
+  m_sending = true;
+
+  // the socket blocks, so the data is taken from the queues under the lock but sent without it
+  bool success = true;
+  std::string data;
+  while (m_socket != INVALID_SOCKET)
+  {
+    if (!m_responses.empty())
+    {
+      // the data is already framed by WriteResponse()
+      if (!WriteResponse(*m_responses.front(), data))
+      {
+        m_responses.pop_front();
+        continue;
+      }
+    }
+    else if (!m_queued.empty())
+    {
+      data.clear();
+      data.swap(m_queued);
+    }
+    else
+      break;
+
+    const SOCKET socket = m_socket;
+    {
+      CSingleExit exit(m_critSection);
+      size_t sent = 0;
+      while (success && sent < data.size())
+      {
+        const int result = send(socket, data.c_str() + sent, data.size() - sent, 0);
+        if (result > 0)
+          sent += result;
+        else
+          success = result < 0 && errno == EINTR;
+      }
+    }
+    if (!success)
+    {
+      // nobody is going to read the rest, stop serializing it
+      ClearOutput();
+      break;
+    }
+  }
+
+  m_sending = false;
+  return success;
+}
+#endif
+
+void CTCPServer::CTCPClient::ClearOutput()
+{
+  m_responses.clear();
+#if defined(HAS_TCPSERVER_EPOLL)
+  m_outgoing.clear();
+#endif
+  m_queued.clear();
+}
+
+bool CTCPServer::CTCPClient::WriteResponse(CJSONVariantStreamWriter &response, std::string &data)
+{
+  data.resize(SENDBUFFER);
+  size_t size = response.Write(&data[0], data.size());
+  data.resize(size);
+
+  if (size == 0 && response.HasFailed())
+    CLog::Log(LOGERROR, "JSONRPC Server: failed to serialize the response");
+  return size > 0;
 }
 
 void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
@@ -597,8 +941,9 @@ void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, in
       }
       if (m_beginBrackets > 0 && m_endBrackets > 0 && m_beginBrackets == m_endBrackets)
       {
-        std::string line = CJSONRPC::MethodCall(m_buffer, host, this);
-        Send(line.c_str(), line.size());
+        std::unique_ptr<CJSONVariantStreamWriter> response = CJSONRPC::MethodCallStream(m_buffer, host, this);
+        if (response != nullptr)
+          SendResponse(std::move(response));
         m_beginChar = m_beginBrackets = m_endBrackets = 0;
         m_buffer.clear();
       }
@@ -614,6 +959,7 @@ void CTCPServer::CTCPClient::Disconnect()
     shutdown(m_socket, SHUT_RDWR);
     closesocket(m_socket);
     m_socket = INVALID_SOCKET;
+    ClearOutput();
   }
 }
 
@@ -629,6 +975,11 @@ void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
   m_beginChar         = client.m_beginChar;
   m_endChar           = client.m_endChar;
   m_buffer            = client.m_buffer;
+  // only new connections are copied, they haven't sent a request yet
+  m_queued            = client.m_queued;
+#if defined(HAS_TCPSERVER_EPOLL)
+  m_outgoing          = client.m_outgoing;
+#endif
 }
 
 CTCPServer::CWebSocketClient::CWebSocketClient(CWebSocket *websocket)
@@ -673,6 +1024,35 @@ void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
     CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
 }
 
+bool CTCPServer::CWebSocketClient::WriteResponse(CJSONVariantStreamWriter &response, std::string &data)
+{
+  data.clear();
+  if (response.IsComplete())
+    return false;
+
+  // every websocket message is sent as a whole so the response has to be collected first
+  std::string message;
+  char buffer[SENDBUFFER];
+  size_t size;
+  while ((size = response.Write(buffer, sizeof(buffer))) > 0)
+    message.append(buffer, size);
+
+  if (response.HasFailed())
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: failed to serialize the response");
+    return false;
+  }
+
+  const CWebSocketMessage *msg = m_websocket->Send(WebSocketTextFrame, message.c_str(), message.size());
+  if (msg == NULL || !msg->IsComplete())
+    return false;
+
+  std::vector<const CWebSocketFrame *> frames = msg->GetFrames();
+  for (unsigned int index = 0; index < frames.size(); index++)
+    data.append(frames.at(index)->GetFrameData(), (size_t)frames.at(index)->GetFrameLength());
+  return true;
+}
+
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
 {
   bool send;
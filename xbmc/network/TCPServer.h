@@ -15,12 +15,19 @@
 #include "threads/Thread.h"
 #include "websocket/WebSocket.h"
 
+#include <deque>
+#include <memory>
 #include <vector>
 
 #include <sys/socket.h>
 
 #include "PlatformDefs.h"
 
+#if defined(TARGET_LINUX)
+#define HAS_TCPSERVER_EPOLL
+#endif
+
+class CJSONVariantStreamWriter;
 class CVariant;
 
 namespace JSONRPC
@@ -46,6 +53,18 @@ namespace JSONRPC
     bool InitializeTCP();
     void Deinitialize();
 
+#if defined(HAS_TCPSERVER_EPOLL)
+    bool InitializeEpoll();
+    void ProcessEpoll();
+#else
+    void ProcessSelect();
+#endif
+
+    class CTCPClient;
+    bool AcceptConnection(SOCKET server);
+    CTCPClient* HandleData(CTCPClient *client, const char *buffer, int length, bool &close);
+    void CloseConnection(CTCPClient *client);
+
     class CTCPClient : public IClient
     {
     public:
@@ -54,16 +73,23 @@ namespace JSONRPC
       //when adding a member variable, make sure to copy it in CTCPClient::Copy
       CTCPClient(const CTCPClient& client);
       CTCPClient& operator=(const CTCPClient& client);
-      ~CTCPClient() override = default;
+      ~CTCPClient() override;
 
       int GetPermissionFlags() override;
       int GetAnnouncementFlags() override;
       bool SetAnnouncementFlags(int flags) override;
 
       virtual void Send(const char *data, unsigned int size);
+      void SendResponse(std::unique_ptr<CJSONVariantStreamWriter> response);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
       virtual void Disconnect();
 
+      /*!
+       \brief Sends the pending responses and messages.
+       \return false if the connection failed
+       */
+      bool Flush();
+
       virtual bool IsNew() const { return m_new; }
       virtual bool Closing() const { return false; }
 
@@ -74,12 +100,29 @@ namespace JSONRPC
 
     protected:
       void Copy(const CTCPClient& client);
+
+      /*!
+       \brief Serializes the next part of a response into the data to send.
+       \param response the response to serialize
+       \param data replaced by the data to send
+       \return false once the whole response has been written
+       */
+      virtual bool WriteResponse(CJSONVariantStreamWriter &response, std::string &data);
     private:
+      void ClearOutput();
+
       bool m_new;
       int m_announcementflags;
       int m_beginBrackets, m_endBrackets;
       char m_beginChar, m_endChar;
       std::string m_buffer;
+      std::deque<std::unique_ptr<CJSONVariantStreamWriter>> m_responses; ///< responses still being serialized, oldest first
+      std::string m_queued;   ///< announcements waiting for the pending responses to be sent
+#if defined(HAS_TCPSERVER_EPOLL)
+      std::string m_outgoing; ///< data the socket didn't take yet, sent once it is writable again
+#else
+      bool m_sending = false; ///< a thread is sending, it sends whatever is queued in the meantime too
+#endif
     };
 
     class CWebSocketClient : public CTCPClient
@@ -98,6 +141,9 @@ namespace JSONRPC
       bool IsNew() const override { return m_websocket == NULL; }
       bool Closing() const override { return m_websocket != NULL && m_websocket->GetState() == WebSocketStateClosed; }
 
+    protected:
+      bool WriteResponse(CJSONVariantStreamWriter &response, std::string &data) override;
+
     private:
       CWebSocket *m_websocket;
     };
@@ -107,6 +153,9 @@ namespace JSONRPC
     int m_port;
     bool m_nonlocal;
     void* m_sdpd;
+#if defined(HAS_TCPSERVER_EPOLL)
+    int m_epoll = -1;
+#endif
 
     static CTCPServer *ServerInstance;
   };
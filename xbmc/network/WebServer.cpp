@@ -27,7 +27,9 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/FileUtils.h"
+#include "utils/JobManager.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -37,6 +39,8 @@
 #include <inttypes.h>
 
 #define MAX_POST_BUFFER_SIZE 2048
+#define STREAM_BLOCK_SIZE    (32 * 1024)
+#define MAX_PENDING_JOBS_WAIT_MS 5000
 
 #define PAGE_FILE_NOT_FOUND "<html><head><title>File not found</title></head><body>File not found</body></html>"
 #define NOT_SUPPORTED       "<html><head><title>Not Supported</title></head><body>The method you are trying to use is not supported by this server</body></html>"
@@ -57,6 +61,10 @@ typedef struct {
   uint64_t writePosition;
 } HttpFileDownloadContext;
 
+typedef struct {
+  std::shared_ptr<IHTTPRequestHandler> handler;
+} HttpStreamDownloadContext;
+
 CWebServer::CWebServer()
   : m_authenticationUsername("kodi"),
     m_authenticationPassword(""),
@@ -162,7 +170,13 @@ int CWebServer::AnswerToConnection(void *cls, struct MHD_Connection *connection,
   if (connectionHandler->isNew)
     webServer->LogRequest(request);
 
-  return webServer->HandlePartialRequest(connection, connectionHandler, request, upload_data, upload_data_size, con_cls);
+  // the connection handler is gone once the request has been answered
+  const unsigned int startTime = connectionHandler->startTime;
+  int ret = webServer->HandlePartialRequest(connection, connectionHandler, request, upload_data, upload_data_size, con_cls);
+  if (*con_cls == nullptr)
+    webServer->RequestFinished(startTime);
+
+  return ret;
 }
 
 int CWebServer::HandlePartialRequest(struct MHD_Connection *connection, ConnectionHandler* connectionHandler, const HTTPRequest& request, const char *upload_data, size_t *upload_data_size, void **con_cls)
@@ -183,52 +197,20 @@ int CWebServer::HandlePartialRequest(struct MHD_Connection *connection, Connecti
   // check if this is the first call to AnswerToConnection for this request
   if (isNewRequest)
   {
+    // blocking request handlers mustn't hold up one of the few threads of the pool
+    if (m_threadPool && request.method != POST)
+    {
+      const IHTTPRequestHandler* requestHandler = GetRequestHandler(request);
+      if (requestHandler != nullptr && requestHandler->IsBlocking())
+        return HandleRequestAsync(conHandler.release(), request, requestHandler, con_cls);
+    }
+
     // look for a IHTTPRequestHandler which can take care of the current request
     auto handler = FindRequestHandler(request);
     if (handler != nullptr)
     {
-      // if we got a GET request we need to check if it should be cached
-      if (request.method == GET)
-      {
-        if (handler->CanBeCached())
-        {
-          bool cacheable = IsRequestCacheable(request);
-
-          CDateTime lastModified;
-          if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
-          {
-            // handle If-Modified-Since or If-Unmodified-Since
-            std::string ifModifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_MODIFIED_SINCE);
-            std::string ifUnmodifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_UNMODIFIED_SINCE);
-
-            CDateTime ifModifiedSinceDate;
-            CDateTime ifUnmodifiedSinceDate;
-            // handle If-Modified-Since (but only if the response is cacheable)
-            if (cacheable &&
-              ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
-              lastModified.GetAsUTCDateTime() <= ifModifiedSinceDate)
-            {
-              struct MHD_Response *response = create_response(0, nullptr, MHD_NO, MHD_NO);
-              if (response == nullptr)
-              {
-                CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP 304 response", m_port);
-                return MHD_NO;
-              }
-
-              return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
-            }
-            // handle If-Unmodified-Since
-            else if (ifUnmodifiedSinceDate.SetFromRFC1123DateTime(ifUnmodifiedSince) &&
-              lastModified.GetAsUTCDateTime() > ifUnmodifiedSinceDate)
-              return SendErrorResponse(request, MHD_HTTP_PRECONDITION_FAILED, request.method);
-          }
-
-          // pass the requested ranges on to the request handler
-          handler->SetRequestRanged(IsRequestRanged(request, lastModified));
-        }
-      }
       // if we got a POST request we need to take care of the POST data
-      else if (request.method == POST)
+      if (request.method == POST)
       {
         // as ownership of the connection handler is passed to libmicrohttpd we must not destroy it
         SetupPostDataProcessing(request, conHandler.get(), handler, con_cls);
@@ -239,9 +221,17 @@ int CWebServer::HandlePartialRequest(struct MHD_Connection *connection, Connecti
         return MHD_YES;
       }
 
+      // if we got a GET request we need to check if it should be cached
+      int status = CheckConditionalRequest(handler);
+      if (status != MHD_HTTP_OK)
+        return AnswerConditionalRequest(handler, status);
+
       return HandleRequest(handler);
     }
   }
+  // the job handling the request is done and the connection has been resumed
+  else if (conHandler->isHandledAsync)
+    return FinishAsyncRequest(request, conHandler.get());
   // this is a subsequent call to AnswerToConnection for this request
   else
   {
@@ -296,13 +286,145 @@ int CWebServer::HandlePostField(void *cls, enum MHD_ValueKind kind, const char *
   return MHD_YES;
 }
 
+int CWebServer::CheckConditionalRequest(const std::shared_ptr<IHTTPRequestHandler>& handler) const
+{
+  const HTTPRequest& request = handler->GetRequest();
+  if (request.method != GET || !handler->CanBeCached())
+    return MHD_HTTP_OK;
+
+  bool cacheable = IsRequestCacheable(request);
+
+  CDateTime lastModified;
+  if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
+  {
+    // handle If-Modified-Since or If-Unmodified-Since
+    std::string ifModifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(request.connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_MODIFIED_SINCE);
+    std::string ifUnmodifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(request.connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_UNMODIFIED_SINCE);
+
+    CDateTime ifModifiedSinceDate;
+    CDateTime ifUnmodifiedSinceDate;
+    // handle If-Modified-Since (but only if the response is cacheable)
+    if (cacheable &&
+      ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
+      lastModified.GetAsUTCDateTime() <= ifModifiedSinceDate)
+      return MHD_HTTP_NOT_MODIFIED;
+    // handle If-Unmodified-Since
+    else if (ifUnmodifiedSinceDate.SetFromRFC1123DateTime(ifUnmodifiedSince) &&
+      lastModified.GetAsUTCDateTime() > ifUnmodifiedSinceDate)
+      return MHD_HTTP_PRECONDITION_FAILED;
+  }
+
+  // pass the requested ranges on to the request handler
+  handler->SetRequestRanged(IsRequestRanged(request, lastModified));
+
+  return MHD_HTTP_OK;
+}
+
+int CWebServer::AnswerConditionalRequest(const std::shared_ptr<IHTTPRequestHandler>& handler, int status)
+{
+  if (status == MHD_HTTP_NOT_MODIFIED)
+  {
+    struct MHD_Response *response = create_response(0, nullptr, MHD_NO, MHD_NO);
+    if (response == nullptr)
+    {
+      CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP 304 response", m_port);
+      return MHD_NO;
+    }
+
+    return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
+  }
+
+  const HTTPRequest& request = handler->GetRequest();
+  return SendErrorResponse(request, status, request.method);
+}
+
+/*!
+ \brief Runs a blocking request handler for a suspended connection.
+ The connection is resumed when the job is destroyed. That also happens if the job manager
+ cancels the job without running it, e.g. while shutting down.
+ */
+class CWebServer::CAsyncRequestJob : public CJob
+{
+public:
+  CAsyncRequestJob(CWebServer& server, ConnectionHandler* connectionHandler, const HTTPRequest& request, const IHTTPRequestHandler* requestHandler)
+    : m_server(server)
+    , m_connectionHandler(connectionHandler)
+    , m_request(request)
+    , m_requestHandler(requestHandler)
+  { }
+
+  ~CAsyncRequestJob() override
+  {
+    // without a request handler FinishAsyncRequest() answers with an error
+    m_connectionHandler->isHandledAsync = true;
+    m_server.ResumeAsyncRequest(m_request.connection);
+  }
+
+  bool DoWork() override
+  {
+    // creating the request handler may already access the file system
+    m_connectionHandler->requestHandler.reset(m_requestHandler->Create(m_request));
+    m_connectionHandler->asyncStatus = m_server.CheckConditionalRequest(m_connectionHandler->requestHandler);
+    if (m_connectionHandler->asyncStatus == MHD_HTTP_OK)
+      m_connectionHandler->asyncResult = m_connectionHandler->requestHandler->HandleRequest();
+    return true;
+  }
+
+  const char* GetType() const override { return "webserverrequest"; }
+
+private:
+  CWebServer& m_server;
+  ConnectionHandler* m_connectionHandler;
+  HTTPRequest m_request;
+  const IHTTPRequestHandler* m_requestHandler;
+};
+
+int CWebServer::HandleRequestAsync(ConnectionHandler *connectionHandler, const HTTPRequest& request, const IHTTPRequestHandler *requestHandler, void **con_cls)
+{
+  // MHD calls AnswerToConnection again once the connection is resumed
+  *con_cls = connectionHandler;
+  MHD_suspend_connection(request.connection);
+  m_pendingJobs++;
+
+  CAsyncRequestJob* job = new CAsyncRequestJob(*this, connectionHandler, request, requestHandler);
+  if (CJobManager::GetInstance().AddJob(job, nullptr, CJob::PRIORITY_NORMAL) == 0)
+    delete job; // the job manager is shutting down, resumes the connection right away
+
+  return MHD_YES;
+}
+
+void CWebServer::ResumeAsyncRequest(struct MHD_Connection *connection)
+{
+  MHD_resume_connection(connection);
+
+  CSingleLock lock(m_statsSection);
+  if (--m_pendingJobs == 0)
+    m_jobsDone.notifyAll();
+}
+
+int CWebServer::FinishAsyncRequest(const HTTPRequest& request, ConnectionHandler *connectionHandler)
+{
+  // the job was cancelled before it ran
+  if (connectionHandler->requestHandler == nullptr)
+    return SendErrorResponse(request, MHD_HTTP_SERVICE_UNAVAILABLE, request.method);
+
+  if (connectionHandler->asyncStatus != MHD_HTTP_OK)
+    return AnswerConditionalRequest(connectionHandler->requestHandler, connectionHandler->asyncStatus);
+
+  return RespondToRequest(connectionHandler->requestHandler, connectionHandler->asyncResult);
+}
+
 int CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>& handler)
 {
   if (handler == nullptr)
     return MHD_NO;
 
+  return RespondToRequest(handler, handler->HandleRequest());
+}
+
+int CWebServer::RespondToRequest(const std::shared_ptr<IHTTPRequestHandler>& handler, int ret)
+{
   HTTPRequest request = handler->GetRequest();
-  int ret = handler->HandleRequest();
   if (ret == MHD_NO)
   {
     CLog::Log(LOGERROR, "CWebServer[%hu]: failed to handle HTTP request for %s", m_port, request.pathUrl.c_str());
@@ -332,6 +454,10 @@ int CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>& handle
       ret = CreateMemoryDownloadResponse(handler, response);
       break;
 
+    case HTTPStreamDownload:
+      ret = CreateStreamDownloadResponse(handler, response);
+      break;
+
     case HTTPError:
       ret = CreateErrorResponse(request.connection, responseDetails.status, request.method, response);
       break;
@@ -418,7 +544,7 @@ int CWebServer::FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler>& hand
   return SendResponse(request, responseStatus, response);
 }
 
-std::shared_ptr<IHTTPRequestHandler> CWebServer::FindRequestHandler(const HTTPRequest& request) const
+IHTTPRequestHandler* CWebServer::GetRequestHandler(const HTTPRequest& request) const
 {
   // look for a IHTTPRequestHandler which can take care of the current request
   auto requestHandlerIt = std::find_if(m_requestHandlers.cbegin(), m_requestHandlers.cend(),
@@ -427,9 +553,18 @@ std::shared_ptr<IHTTPRequestHandler> CWebServer::FindRequestHandler(const HTTPRe
       return requestHandler->CanHandleRequest(request);
     });
 
-  // we found a matching IHTTPRequestHandler so let's get a new instance for this request
   if (requestHandlerIt != m_requestHandlers.cend())
-    return std::shared_ptr<IHTTPRequestHandler>((*requestHandlerIt)->Create(request));
+    return *requestHandlerIt;
+
+  return nullptr;
+}
+
+std::shared_ptr<IHTTPRequestHandler> CWebServer::FindRequestHandler(const HTTPRequest& request) const
+{
+  // we found a matching IHTTPRequestHandler so let's get a new instance for this request
+  IHTTPRequestHandler* requestHandler = GetRequestHandler(request);
+  if (requestHandler != nullptr)
+    return std::shared_ptr<IHTTPRequestHandler>(requestHandler->Create(request));
 
   return nullptr;
 }
@@ -852,6 +987,35 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
   return MHD_YES;
 }
 
+int CWebServer::CreateStreamDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const
+{
+  if (handler == nullptr)
+    return MHD_NO;
+
+  const HTTPRequest &request = handler->GetRequest();
+  if (request.method == HEAD)
+    return CreateMemoryDownloadResponse(request.connection, nullptr, 0, false, false, response);
+
+  // the context keeps the request handler alive until mhd is done with the response
+  std::unique_ptr<HttpStreamDownloadContext> context(new HttpStreamDownloadContext());
+  context->handler = handler;
+
+  // the length isn't known in advance so mhd uses chunked transfer encoding
+  response = MHD_create_response_from_callback(MHD_SIZE_UNKNOWN, STREAM_BLOCK_SIZE,
+                                               &CWebServer::StreamReaderCallback,
+                                               context.get(),
+                                               &CWebServer::StreamReaderFreeCallback);
+  if (response == nullptr)
+  {
+    CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a streamed HTTP response for %s", m_port, request.pathUrl.c_str());
+    return MHD_NO;
+  }
+
+  context.release(); // ownership was passed to mhd
+
+  return MHD_YES;
+}
+
 int CWebServer::CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response) const
 {
   size_t payloadSize = 0;
@@ -926,7 +1090,53 @@ void* CWebServer::UriRequestLogger(void *cls, const char *uri)
     webServer->LogRequest(uri);
 
   // create and return a new connection handler
-  return new ConnectionHandler(uri);
+  ConnectionHandler* connectionHandler = new ConnectionHandler(uri);
+  connectionHandler->startTime = XbmcThreads::SystemClockMillis();
+  if (webServer != nullptr)
+    webServer->RequestStarted();
+
+  return connectionHandler;
+}
+
+void CWebServer::RequestCompleted(void *cls, struct MHD_Connection *connection, void **con_cls, enum MHD_RequestTerminationCode toe)
+{
+  CWebServer *webServer = reinterpret_cast<CWebServer*>(cls);
+  if (webServer == nullptr || con_cls == nullptr || *con_cls == nullptr)
+    return;
+
+  // the request was aborted before it has been answered
+  ConnectionHandler* connectionHandler = reinterpret_cast<ConnectionHandler*>(*con_cls);
+  webServer->FinalizePostDataProcessing(connectionHandler);
+  webServer->RequestFinished(connectionHandler->startTime);
+  delete connectionHandler;
+  *con_cls = nullptr;
+}
+
+void CWebServer::RequestStarted()
+{
+  CSingleLock lock(m_statsSection);
+  m_stats.activeRequests++;
+  m_stats.peakActiveRequests = std::max(m_stats.peakActiveRequests, m_stats.activeRequests);
+}
+
+void CWebServer::RequestFinished(unsigned int startTime)
+{
+  const unsigned int latency = XbmcThreads::SystemClockMillis() - startTime;
+
+  CSingleLock lock(m_statsSection);
+  if (m_stats.activeRequests > 0)
+    m_stats.activeRequests--;
+  m_stats.requests++;
+  m_stats.totalLatency += latency;
+  m_stats.maxLatency = std::max(m_stats.maxLatency, latency);
+}
+
+CWebServer::Stats CWebServer::GetStats() const
+{
+  CSingleLock lock(m_statsSection);
+  Stats stats = m_stats;
+  stats.pendingJobs = m_pendingJobs;
+  return stats;
 }
 
 void CWebServer::LogRequest(const char* uri) const
@@ -1036,6 +1246,31 @@ void CWebServer::ContentReaderFreeCallback(void *cls)
   CLog::Log(LOGDEBUG, LOGWEBSERVER, "CWebServer [OUT] done");
 }
 
+ssize_t CWebServer::StreamReaderCallback(void *cls, uint64_t pos, char *buf, size_t max)
+{
+  HttpStreamDownloadContext *context = (HttpStreamDownloadContext *)cls;
+  if (context == nullptr || context->handler == nullptr)
+    return MHD_CONTENT_READER_END_WITH_ERROR;
+
+  ssize_t written = context->handler->GetResponseStreamData(buf, max);
+  CLog::Log(LOGDEBUG, LOGWEBSERVER, "CWebServer [OUT] streamed %zd bytes at %" PRIu64, written, pos);
+
+  if (written < 0)
+    return MHD_CONTENT_READER_END_WITH_ERROR;
+  if (written == 0)
+    return MHD_CONTENT_READER_END_OF_STREAM;
+
+  return written;
+}
+
+void CWebServer::StreamReaderFreeCallback(void *cls)
+{
+  HttpStreamDownloadContext *context = (HttpStreamDownloadContext *)cls;
+  delete context;
+
+  CLog::Log(LOGDEBUG, LOGWEBSERVER, "CWebServer [OUT] done");
+}
+
 // local helper
 static void panicHandlerForMHD(void* unused, const char* file, unsigned int line, const char *reason)
 {
@@ -1108,18 +1343,34 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
 
   MHD_set_panic_func(&panicHandlerForMHD, nullptr);
 
+  if (m_threadPoolSize > 0)
+  {
+    // a fixed number of threads serves all connections, blocking requests are suspended
+    // while the job manager takes care of them
+    flags |= MHD_USE_SUSPEND_RESUME
+#if (MHD_VERSION >= 0x00095300)
+          | MHD_USE_INTERNAL_POLLING_THREAD | MHD_USE_AUTO;
+#else
+          | MHD_USE_SELECT_INTERNALLY;
+#endif
+  }
+  else
+  {
+    // one thread per connection
+    // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
+    // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
+    flags |= MHD_USE_THREAD_PER_CONNECTION
+#if (MHD_VERSION >= 0x00095207)
+          | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
+#endif
+          ;
+  }
+
   if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_SERVICES_WEBSERVERSSL) &&
       MHD_is_feature_supported(MHD_FEATURE_SSL) == MHD_YES &&
       LoadCert(m_key, m_cert))
     // SSL enabled
-    return MHD_start_daemon(flags |
-                          // one thread per connection
-                          // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-                          // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-                          MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-                          | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
+    return MHD_start_daemon(flags
                           | MHD_USE_DEBUG /* Print MHD error messages to log */
                           | MHD_USE_SSL
                           ,
@@ -1132,22 +1383,17 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
                           MHD_OPTION_CONNECTION_LIMIT, 512,
                           MHD_OPTION_CONNECTION_TIMEOUT, timeout,
                           MHD_OPTION_URI_LOG_CALLBACK, &CWebServer::UriRequestLogger, this,
+                          MHD_OPTION_NOTIFY_COMPLETED, &CWebServer::RequestCompleted, this,
                           MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0,
                           MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
+                          MHD_OPTION_THREAD_POOL_SIZE, m_threadPoolSize,
                           MHD_OPTION_HTTPS_MEM_KEY, m_key.c_str(),
                           MHD_OPTION_HTTPS_MEM_CERT, m_cert.c_str(),
                           MHD_OPTION_HTTPS_PRIORITIES, ciphers,
                           MHD_OPTION_END);
 
   // No SSL
-  return MHD_start_daemon(flags |
-                          // one thread per connection
-                          // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-                          // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-                          MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-                          | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
+  return MHD_start_daemon(flags
                           | MHD_USE_DEBUG /* Print MHD error messages to log */
                           ,
                           port,
@@ -1159,8 +1405,10 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
                           MHD_OPTION_CONNECTION_LIMIT, 512,
                           MHD_OPTION_CONNECTION_TIMEOUT, timeout,
                           MHD_OPTION_URI_LOG_CALLBACK, &CWebServer::UriRequestLogger, this,
+                          MHD_OPTION_NOTIFY_COMPLETED, &CWebServer::RequestCompleted, this,
                           MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0,
                           MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
+                          MHD_OPTION_THREAD_POOL_SIZE, m_threadPoolSize,
                           MHD_OPTION_END);
 }
 
@@ -1169,6 +1417,12 @@ bool CWebServer::Start(uint16_t port, const std::string &username, const std::st
   SetCredentials(username, password);
   if (!m_running)
   {
+    m_threadPool = m_threadPoolSize > 0;
+    {
+      CSingleLock lock(m_statsSection);
+      m_stats = Stats();
+    }
+
     int v6testSock;
     if ((v6testSock = socket(AF_INET6, SOCK_STREAM, 0)) >= 0)
     {
@@ -1181,7 +1435,10 @@ bool CWebServer::Start(uint16_t port, const std::string &username, const std::st
     if (m_running)
     {
       m_port = port;
-      CLog::Log(LOGNOTICE, "CWebServer[%hu]: Started", m_port);
+      if (m_threadPool)
+        CLog::Log(LOGNOTICE, "CWebServer[%hu]: Started with %u threads", m_port, m_threadPoolSize);
+      else
+        CLog::Log(LOGNOTICE, "CWebServer[%hu]: Started", m_port);
     }
     else
       CLog::Log(LOGERROR, "CWebServer[%hu]: Failed to start", port);
@@ -1195,13 +1452,29 @@ bool CWebServer::Stop()
   if (!m_running)
     return true;
 
+  // suspended connections have to be resumed by their jobs before the daemons can go away
+  {
+    XbmcThreads::EndTime timeout(MAX_PENDING_JOBS_WAIT_MS);
+    CSingleLock lock(m_statsSection);
+    while (m_pendingJobs > 0 && !timeout.IsTimePast())
+      m_jobsDone.wait(lock, timeout.MillisLeft());
+    if (m_pendingJobs > 0)
+      CLog::Log(LOGWARNING, "CWebServer[%hu]: stopping with %u requests still being handled", m_port, static_cast<unsigned int>(m_pendingJobs));
+  }
+
   if (m_daemon_ip6 != nullptr)
     MHD_stop_daemon(m_daemon_ip6);
 
   if (m_daemon_ip4 != nullptr)
     MHD_stop_daemon(m_daemon_ip4);
 
+  m_daemon_ip6 = nullptr;
+  m_daemon_ip4 = nullptr;
   m_running = false;
+
+  const Stats stats = GetStats();
+  CLog::Log(LOGDEBUG, "CWebServer[%hu]: handled %" PRIu64 " requests, average latency %" PRIu64 " ms, maximum latency %u ms, at most %u at once",
+            m_port, stats.requests, stats.requests > 0 ? stats.totalLatency / stats.requests : 0, stats.maxLatency, stats.peakActiveRequests);
   CLog::Log(LOGNOTICE, "CWebServer[%hu]: Stopped", m_port);
   m_port = 0;
 
@@ -9,9 +9,12 @@
 #pragma once
 
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
+#include "threads/Condition.h"
 #include "threads/CriticalSection.h"
 
+#include <atomic>
 #include <memory>
+#include <stdint.h>
 #include <vector>
 
 namespace XFILE
@@ -24,6 +27,16 @@ class CVariant;
 class CWebServer
 {
 public:
+  struct Stats
+  {
+    uint64_t requests = 0; ///< finished requests
+    unsigned int activeRequests = 0;
+    unsigned int peakActiveRequests = 0;
+    unsigned int pendingJobs = 0; ///< requests handed to the job manager that aren't done yet
+    uint64_t totalLatency = 0; ///< ms from receiving a request until its response was queued
+    unsigned int maxLatency = 0; ///< ms
+  };
+
   CWebServer();
   virtual ~CWebServer() = default;
 
@@ -36,6 +49,15 @@ public:
   void RegisterRequestHandler(IHTTPRequestHandler *handler);
   void UnregisterRequestHandler(IHTTPRequestHandler *handler);
 
+  /*!
+   \brief Number of threads serving all connections, 0 to use a thread per connection.
+   In thread pool mode blocking request handlers run on the job manager while their connection
+   is suspended. Takes effect on the next Start().
+   */
+  void SetThreadPoolSize(unsigned int threads) { m_threadPoolSize = threads; }
+
+  Stats GetStats() const;
+
 protected:
   typedef struct ConnectionHandler
   {
@@ -44,6 +66,10 @@ protected:
     std::shared_ptr<IHTTPRequestHandler> requestHandler;
     struct MHD_PostProcessor *postprocessor;
     int errorStatus;
+    unsigned int startTime;
+    bool isHandledAsync; ///< the request handler has been created and run by a job
+    int asyncStatus; ///< MHD_HTTP_OK or the status of a conditional request answered without handling it
+    int asyncResult; ///< return value of IHTTPRequestHandler::HandleRequest() of the job
 
     explicit ConnectionHandler(const std::string& uri)
       : fullUri(uri)
@@ -51,6 +77,10 @@ protected:
       , requestHandler(nullptr)
       , postprocessor(nullptr)
       , errorStatus(MHD_HTTP_OK)
+      , startTime(0)
+      , isHandledAsync(false)
+      , asyncStatus(MHD_HTTP_OK)
+      , asyncResult(MHD_NO)
     { }
   } ConnectionHandler;
 
@@ -64,8 +94,21 @@ protected:
 private:
   struct MHD_Daemon* StartMHD(unsigned int flags, int port);
 
+  IHTTPRequestHandler* GetRequestHandler(const HTTPRequest& request) const;
   std::shared_ptr<IHTTPRequestHandler> FindRequestHandler(const HTTPRequest& request) const;
 
+  int CheckConditionalRequest(const std::shared_ptr<IHTTPRequestHandler>& handler) const;
+  int AnswerConditionalRequest(const std::shared_ptr<IHTTPRequestHandler>& handler, int status);
+  int RespondToRequest(const std::shared_ptr<IHTTPRequestHandler>& handler, int ret);
+
+  class CAsyncRequestJob;
+  int HandleRequestAsync(ConnectionHandler *connectionHandler, const HTTPRequest& request, const IHTTPRequestHandler *requestHandler, void **con_cls);
+  void ResumeAsyncRequest(struct MHD_Connection *connection);
+  int FinishAsyncRequest(const HTTPRequest& request, ConnectionHandler *connectionHandler);
+
+  void RequestStarted();
+  void RequestFinished(unsigned int startTime);
+
   int AskForAuthentication(const HTTPRequest& request) const;
   bool IsAuthenticated(const HTTPRequest& request) const;
 
@@ -81,6 +124,7 @@ private:
 
   int CreateRedirect(struct MHD_Connection *connection, const std::string &strURL, struct MHD_Response *&response) const;
   int CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const;
+  int CreateStreamDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response) const;
   int CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response) const;
   int CreateMemoryDownloadResponse(struct MHD_Connection *connection, const void *data, size_t size, bool free, bool copy, struct MHD_Response *&response) const;
 
@@ -96,9 +140,12 @@ private:
 
   // MHD callback implementations
   static void* UriRequestLogger(void *cls, const char *uri);
+  static void RequestCompleted(void *cls, struct MHD_Connection *connection, void **con_cls, enum MHD_RequestTerminationCode toe);
 
   static ssize_t ContentReaderCallback (void *cls, uint64_t pos, char *buf, size_t max);
   static void ContentReaderFreeCallback(void *cls);
+  static ssize_t StreamReaderCallback(void *cls, uint64_t pos, char *buf, size_t max);
+  static void StreamReaderFreeCallback(void *cls);
 
   static int AnswerToConnection (void *cls, struct MHD_Connection *connection,
                         const char *url, const char *method,
@@ -123,4 +170,11 @@ private:
   std::string m_cert;
   mutable CCriticalSection m_critSection;
   std::vector<IHTTPRequestHandler *> m_requestHandlers;
+
+  unsigned int m_threadPoolSize = 0;
+  bool m_threadPool = false; ///< the running daemons use a thread pool
+  std::atomic<unsigned int> m_pendingJobs{0};
+  mutable CCriticalSection m_statsSection;
+  XbmcThreads::ConditionVariable m_jobsDone; ///< notified under m_statsSection when m_pendingJobs drops to 0
+  Stats m_stats;
 };
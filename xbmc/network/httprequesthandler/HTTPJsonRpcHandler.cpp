@@ -71,12 +71,25 @@ int CHTTPJsonRpcHandler::HandleRequest()
       jsonpCallback = argument->second;
   }
 
-  if (isRequest)
+  if (isRequest && jsonpCallback.empty())
   {
-    m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
+    // send the response while it is being serialized instead of building it in memory first
+    m_responseStream = JSONRPC::CJSONRPC::MethodCallStream(m_requestData, &m_transportLayer, &client);
+    m_requestData.clear();
+
+    if (m_responseStream != nullptr)
+    {
+      m_response.type = HTTPStreamDownload;
+      m_response.status = MHD_HTTP_OK;
+      m_response.contentType = "application/json";
 
-    if (!jsonpCallback.empty())
-      m_responseData = jsonpCallback + "(" + m_responseData + ");";
+      return MHD_YES;
+    }
+  }
+  else if (isRequest)
+  {
+    m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
+    m_responseData = jsonpCallback + "(" + m_responseData + ");";
   }
   else if (jsonpCallback.empty())
   {
@@ -119,6 +132,21 @@ HttpResponseRanges CHTTPJsonRpcHandler::GetResponseData() const
   return ranges;
 }
 
+ssize_t CHTTPJsonRpcHandler::GetResponseStreamData(char *buffer, size_t size)
+{
+  if (m_responseStream == nullptr)
+    return -1;
+
+  size_t written = m_responseStream->Write(buffer, size);
+  if (m_responseStream->HasFailed())
+  {
+    CLog::Log(LOGERROR, "CHTTPJsonRpcHandler: failed to serialize the JSON-RPC response");
+    return -1;
+  }
+
+  return written;
+}
+
 bool CHTTPJsonRpcHandler::appendPostData(const char *data, size_t size)
 {
   if (m_requestData.size() + size > MAX_HTTP_POST_SIZE)
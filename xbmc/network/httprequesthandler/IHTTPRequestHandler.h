@@ -54,7 +54,10 @@ typedef enum HTTPResponseType
   HTTPMemoryDownloadFreeNoCopy,
   // creates a HTTP response from a buffer by copying followed by freeing the buffer
   // the buffer must have been malloc'ed and not new'ed
-  HTTPMemoryDownloadFreeCopy
+  HTTPMemoryDownloadFreeCopy,
+  // creates a HTTP response of unknown length with the content provided piece by piece
+  // by the request handler
+  HTTPStreamDownload
 } HTTPResponseType;
 
 typedef struct HTTPRequest
@@ -116,6 +119,15 @@ public:
    */
   virtual int HandleRequest() = 0;
 
+  /*!
+   * \brief Whether creating the HTTP request handler and handling the request
+   * may block for a while, e.g. because of file system access.
+   *
+   * \details If the web server uses a thread pool, such requests are handled
+   * by the job manager instead of occupying one of the pool's threads.
+   */
+  virtual bool IsBlocking() const { return false; }
+
   /*!
    * \brief Whether the HTTP response could also be provided in ranges.
    */
@@ -147,6 +159,17 @@ public:
    */
   virtual HttpResponseRanges GetResponseData() const { return HttpResponseRanges(); };
 
+  /*!
+   * \brief Fills the given buffer with the next part of the response data.
+   *
+   * \details This is only used if the response type is HTTPStreamDownload.
+   *
+   * \param buffer Buffer to fill
+   * \param size Size of the buffer
+   * \return Number of bytes written to the buffer, 0 at the end of the response or -1 on error.
+   */
+  virtual ssize_t GetResponseStreamData(char *buffer, size_t size) { return -1; }
+
   /*!
   * \brief Returns the URL to which the request should be redirected.
   *
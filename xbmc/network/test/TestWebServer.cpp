@@ -897,3 +897,27 @@ TEST_F(TestWebServer, CanGetCachedRangedFileWithNewerIfRange)
   ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
   CheckRangesTestFileResponse(curl, result, ranges);
 }
+
+TEST_F(TestWebServer, CanGetFileWithThreadPool)
+{
+  // restart with a thread pool so the vfs handler runs as a job
+  webserver.Stop();
+  webserver.SetThreadPoolSize(2);
+  ASSERT_TRUE(webserver.Start(webserverPort, "", ""));
+
+  for (int i = 0; i < 4; i++)
+  {
+    std::string result;
+    CCurlFile curl;
+    curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+    ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_HTML), result));
+    ASSERT_STREQ(TEST_FILES_DATA, result.c_str());
+
+    CheckHtmlTestFileResponse(curl);
+  }
+
+  const CWebServer::Stats stats = webserver.GetStats();
+  EXPECT_EQ(4u, stats.requests);
+  EXPECT_EQ(0u, stats.activeRequests);
+  EXPECT_EQ(0u, stats.pendingJobs);
+}
@@ -330,6 +330,7 @@ bool CProfileManager::LoadProfile(unsigned int index)
   {
     CGUIInfoManager& infoMgr = gui->GetInfoManager();
     infoMgr.ResetCache();
+    infoMgr.InvalidateSources(INFO::INFO_SOURCE_ALL);
     infoMgr.GetInfoProviders().GetGUIControlsInfoProvider().ResetContainerMovingCache();
     infoMgr.GetInfoProviders().GetLibraryInfoProvider().ResetLibraryBools();
   }
@@ -440,6 +441,8 @@ void CProfileManager::LogOff()
 
   g_application.StopPlaying();
 
+  g_application.StopLibraryWatcher();
+
   if (g_application.IsMusicScanning())
     g_application.StopMusicScan();
 
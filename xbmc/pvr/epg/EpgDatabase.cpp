@@ -13,6 +13,7 @@
 #include "pvr/epg/Epg.h"
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/epg/EpgSearchData.h"
+#include "pvr/epg/EpgSearchTermConverter.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
@@ -112,6 +113,17 @@ void CPVREpgDatabase::CreateAnalytics()
   CSingleLock lock(m_critSection);
   m_pDS->exec("CREATE UNIQUE INDEX idx_epg_idEpg_iStartTime on epgtags(idEpg, iStartTime desc);");
   m_pDS->exec("CREATE INDEX idx_epg_iEndTime on epgtags(iEndTime);");
+
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Creating EPG search index");
+  if (CreateFullTextIndex("epgsearch", "epgtags", "idBroadcast", {"sTitle", "sPlotOutline", "sPlot"}))
+  {
+    // REPLACE INTO epgtags removes the tag at the same start time without firing the delete trigger
+    m_pDS->exec("CREATE TRIGGER epgsearch_replace BEFORE INSERT ON epgtags FOR EACH ROW BEGIN "
+                "INSERT INTO epgsearch (epgsearch, rowid, sTitle, sPlotOutline, sPlot) "
+                "SELECT 'delete', idBroadcast, sTitle, sPlotOutline, sPlot FROM epgtags "
+                "WHERE (idEpg = new.idEpg AND iStartTime = new.iStartTime) OR idBroadcast = new.idBroadcast; "
+                "END");
+  }
 }
 
 void CPVREpgDatabase::UpdateTables(int iVersion)
@@ -474,126 +486,6 @@ CDateTime ConvertLocalTimeToUTC(const CDateTime& local)
   return CDateTime(mktime(tms));
 }
 
-class CSearchTermConverter
-{
-public:
-  CSearchTermConverter(const std::string& strSearchTerm) { Parse(strSearchTerm); }
-
-  std::string ToSQL(const std::string& strFieldName) const
-  {
-    std::string result = "(";
-
-    for (auto it = m_fragments.cbegin(); it != m_fragments.cend();)
-    {
-      result += (*it);
-
-      ++it;
-      if (it != m_fragments.cend())
-        result += strFieldName;
-    }
-
-    StringUtils::TrimRight(result);
-    result += ")";
-    return result;
-  }
-
-private:
-  void Parse(const std::string& strSearchTerm)
-  {
-    std::string strParsedSearchTerm(strSearchTerm);
-    StringUtils::Trim(strParsedSearchTerm);
-
-    std::string strFragment;
-
-    bool bNextOR = false;
-    while (!strParsedSearchTerm.empty())
-    {
-      StringUtils::TrimLeft(strParsedSearchTerm);
-
-      if (StringUtils::StartsWith(strParsedSearchTerm, "!") ||
-          StringUtils::StartsWithNoCase(strParsedSearchTerm, "not"))
-      {
-        std::string strDummy;
-        GetAndCutNextTerm(strParsedSearchTerm, strDummy);
-        strFragment += " NOT ";
-        bNextOR = false;
-      }
-      else if (StringUtils::StartsWith(strParsedSearchTerm, "+") ||
-               StringUtils::StartsWithNoCase(strParsedSearchTerm, "and"))
-      {
-        std::string strDummy;
-        GetAndCutNextTerm(strParsedSearchTerm, strDummy);
-        strFragment += " AND ";
-        bNextOR = false;
-      }
-      else if (StringUtils::StartsWith(strParsedSearchTerm, "|") ||
-               StringUtils::StartsWithNoCase(strParsedSearchTerm, "or"))
-      {
-        std::string strDummy;
-        GetAndCutNextTerm(strParsedSearchTerm, strDummy);
-        strFragment += " OR ";
-        bNextOR = false;
-      }
-      else
-      {
-        std::string strTerm;
-        GetAndCutNextTerm(strParsedSearchTerm, strTerm);
-        if (!strTerm.empty())
-        {
-          if (bNextOR && !m_fragments.empty())
-            strFragment += " OR "; // default operator
-
-          strFragment += "(UPPER(";
-
-          m_fragments.emplace_back(strFragment);
-          strFragment.clear();
-
-          strFragment += ") LIKE UPPER('%";
-          StringUtils::Replace(strTerm, "'", "''"); // escape '
-          strFragment += strTerm;
-          strFragment += "%')) ";
-
-          bNextOR = true;
-        }
-        else
-        {
-          break;
-        }
-      }
-
-      StringUtils::TrimLeft(strParsedSearchTerm);
-    }
-
-    if (!strFragment.empty())
-      m_fragments.emplace_back(strFragment);
-  }
-
-  static void GetAndCutNextTerm(std::string& strSearchTerm, std::string& strNextTerm)
-  {
-    std::string strFindNext(" ");
-
-    if (StringUtils::EndsWith(strSearchTerm, "\""))
-    {
-      strSearchTerm.erase(0, 1);
-      strFindNext = "\"";
-    }
-
-    const size_t iNextPos = strSearchTerm.find(strFindNext);
-    if (iNextPos != std::string::npos)
-    {
-      strNextTerm = strSearchTerm.substr(0, iNextPos);
-      strSearchTerm.erase(0, iNextPos + 1);
-    }
-    else
-    {
-      strNextTerm = strSearchTerm;
-      strSearchTerm.clear();
-    }
-  }
-
-  std::vector<std::string> m_fragments;
-};
-
 } // unnamed namespace
 
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
@@ -601,7 +493,7 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
 {
   CSingleLock lock(m_critSection);
 
-  std::string strQuery = PrepareSQL("SELECT * FROM epgtags");
+  std::string strQuery = PrepareSQL("SELECT epgtags.* FROM epgtags ");
 
   Filter filter;
 
@@ -651,21 +543,33 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
   {
     const CSearchTermConverter conv(searchData.m_strSearchTerm);
 
-    // title
-    std::string strWhere = conv.ToSQL("sTitle");
-
-    // plot outline
-    strWhere += " OR ";
-    strWhere += conv.ToSQL("sPlotOutline");
-
+    std::vector<std::string> columns = {"sTitle", "sPlotOutline"};
     if (searchData.m_bSearchInDescription)
+      columns.emplace_back("sPlot");
+
+    const std::string strMatch = conv.ToFTS(columns);
+    if (!strMatch.empty() && HasFullTextIndex("epgsearch"))
     {
-      // plot
-      strWhere += " OR ";
-      strWhere += conv.ToSQL("sPlot");
+      AppendFullTextSearch(filter, "epgsearch", "epgtags.idBroadcast", strMatch);
     }
+    else
+    {
+      // title
+      std::string strWhere = conv.ToSQL("sTitle");
+
+      // plot outline
+      strWhere += " OR ";
+      strWhere += conv.ToSQL("sPlotOutline");
 
-    filter.AppendWhere(strWhere);
+      if (searchData.m_bSearchInDescription)
+      {
+        // plot
+        strWhere += " OR ";
+        strWhere += conv.ToSQL("sPlot");
+      }
+
+      filter.AppendWhere(strWhere);
+    }
   }
 
   if (BuildSQL(strQuery, filter, strQuery))
@@ -0,0 +1,151 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgSearchTermConverter.h"
+
+#include "dbwrappers/Database.h"
+#include "utils/StringUtils.h"
+
+using namespace PVR;
+
+std::string CSearchTermConverter::ToSQL(const std::string& strFieldName) const
+{
+  std::string result = "(";
+
+  for (auto it = m_fragments.cbegin(); it != m_fragments.cend();)
+  {
+    result += (*it);
+
+    ++it;
+    if (it != m_fragments.cend())
+      result += strFieldName;
+  }
+
+  StringUtils::TrimRight(result);
+  result += ")";
+  return result;
+}
+
+std::string CSearchTermConverter::ToFTS(const std::vector<std::string>& columns) const
+{
+  // an operator without a term after it, e.g. "a !b" where the NOT took the term along
+  if (!m_bFTSSupported || m_strFTSQuery.empty() || StringUtils::EndsWith(m_strFTSQuery, " "))
+    return {};
+
+  return "{" + StringUtils::Join(columns, " ") + "} : (" + m_strFTSQuery + ")";
+}
+
+void CSearchTermConverter::Parse(const std::string& strSearchTerm)
+{
+  std::string strParsedSearchTerm(strSearchTerm);
+  StringUtils::Trim(strParsedSearchTerm);
+
+  std::string strFragment;
+
+  bool bNextOR = false;
+  while (!strParsedSearchTerm.empty())
+  {
+    StringUtils::TrimLeft(strParsedSearchTerm);
+
+    if (StringUtils::StartsWith(strParsedSearchTerm, "!") ||
+        StringUtils::StartsWithNoCase(strParsedSearchTerm, "not"))
+    {
+      std::string strDummy;
+      GetAndCutNextTerm(strParsedSearchTerm, strDummy);
+      strFragment += " NOT ";
+      bNextOR = false;
+
+      // FTS5 NOT is binary, "a AND NOT b" is "a NOT b" and there is no "NOT a" or "a OR NOT b"
+      if (StringUtils::EndsWith(m_strFTSQuery, " AND "))
+        m_strFTSQuery.erase(m_strFTSQuery.size() - 5);
+      if (m_strFTSQuery.empty() || StringUtils::EndsWith(m_strFTSQuery, " "))
+        m_bFTSSupported = false;
+      m_strFTSQuery += " NOT ";
+    }
+    else if (StringUtils::StartsWith(strParsedSearchTerm, "+") ||
+             StringUtils::StartsWithNoCase(strParsedSearchTerm, "and"))
+    {
+      std::string strDummy;
+      GetAndCutNextTerm(strParsedSearchTerm, strDummy);
+      strFragment += " AND ";
+      bNextOR = false;
+      m_strFTSQuery += " AND ";
+    }
+    else if (StringUtils::StartsWith(strParsedSearchTerm, "|") ||
+             StringUtils::StartsWithNoCase(strParsedSearchTerm, "or"))
+    {
+      std::string strDummy;
+      GetAndCutNextTerm(strParsedSearchTerm, strDummy);
+      strFragment += " OR ";
+      bNextOR = false;
+      m_strFTSQuery += " OR ";
+    }
+    else
+    {
+      std::string strTerm;
+      GetAndCutNextTerm(strParsedSearchTerm, strTerm);
+      if (!strTerm.empty())
+      {
+        if (bNextOR && !m_fragments.empty())
+        {
+          strFragment += " OR "; // default operator
+          m_strFTSQuery += " OR ";
+        }
+
+        const std::string strPhrase = CDatabase::GetFullTextQuery(strTerm);
+        if (strPhrase.empty())
+          m_bFTSSupported = false;
+        m_strFTSQuery += strPhrase;
+
+        strFragment += "(UPPER(";
+
+        m_fragments.emplace_back(strFragment);
+        strFragment.clear();
+
+        strFragment += ") LIKE UPPER('%";
+        StringUtils::Replace(strTerm, "'", "''"); // escape '
+        strFragment += strTerm;
+        strFragment += "%')) ";
+
+        bNextOR = true;
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    StringUtils::TrimLeft(strParsedSearchTerm);
+  }
+
+  if (!strFragment.empty())
+    m_fragments.emplace_back(strFragment);
+}
+
+void CSearchTermConverter::GetAndCutNextTerm(std::string& strSearchTerm, std::string& strNextTerm)
+{
+  std::string strFindNext(" ");
+
+  if (StringUtils::EndsWith(strSearchTerm, "\""))
+  {
+    strSearchTerm.erase(0, 1);
+    strFindNext = "\"";
+  }
+
+  const size_t iNextPos = strSearchTerm.find(strFindNext);
+  if (iNextPos != std::string::npos)
+  {
+    strNextTerm = strSearchTerm.substr(0, iNextPos);
+    strSearchTerm.erase(0, iNextPos + 1);
+  }
+  else
+  {
+    strNextTerm = strSearchTerm;
+    strSearchTerm.clear();
+  }
+}
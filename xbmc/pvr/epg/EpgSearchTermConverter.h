@@ -0,0 +1,48 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace PVR
+{
+/*!
+ * @brief Converts an EPG search term to SQL and FTS5 conditions.
+ *        Terms are separated by spaces or quoted, and combined with AND (+), OR (|) and NOT (!).
+ *        Terms without an operator in between are ORed.
+ */
+class CSearchTermConverter
+{
+public:
+  explicit CSearchTermConverter(const std::string& strSearchTerm) { Parse(strSearchTerm); }
+
+  /*!
+   * @brief The search as LIKE conditions on a field.
+   * @param strFieldName The field to search in.
+   * @return The condition.
+   */
+  std::string ToSQL(const std::string& strFieldName) const;
+
+  /*!
+   * @brief The search as FTS5 query, matching the terms at the start of words.
+   * @param columns The columns to search in.
+   * @return The query, or an empty string if the search can't be expressed in FTS5.
+   */
+  std::string ToFTS(const std::vector<std::string>& columns) const;
+
+private:
+  void Parse(const std::string& strSearchTerm);
+  static void GetAndCutNextTerm(std::string& strSearchTerm, std::string& strNextTerm);
+
+  std::vector<std::string> m_fragments;
+  std::string m_strFTSQuery;
+  bool m_bFTSSupported = true;
+};
+} // namespace PVR
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/epg/EpgSearchTermConverter.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::string ToFTS(const std::string& searchTerm)
+{
+  return PVR::CSearchTermConverter(searchTerm).ToFTS({"sTitle", "sPlot"});
+}
+} // unnamed namespace
+
+TEST(TestEpgSearchTermConverter, SQL)
+{
+  EXPECT_EQ("((UPPER(sTitle) LIKE UPPER('%news%')))", PVR::CSearchTermConverter("news").ToSQL("sTitle"));
+  EXPECT_EQ("((UPPER(sTitle) LIKE UPPER('%it''s%')))", PVR::CSearchTermConverter("it's").ToSQL("sTitle"));
+}
+
+TEST(TestEpgSearchTermConverter, FTS)
+{
+  EXPECT_EQ("{sTitle sPlot} : (\"news\"*)", ToFTS("news"));
+  EXPECT_EQ("{sTitle sPlot} : (\"news\"* OR \"weather\"*)", ToFTS("news weather"));
+  EXPECT_EQ("{sTitle sPlot} : (\"news\"* OR \"weather\"*)", ToFTS("news | weather"));
+  EXPECT_EQ("{sTitle sPlot} : (\"news\"* AND \"weather\"*)", ToFTS("news + weather"));
+  EXPECT_EQ("{sTitle sPlot} : (\"late show\"*)", ToFTS("\"late show\""));
+}
+
+TEST(TestEpgSearchTermConverter, FTSQuoting)
+{
+  // terms are phrases, FTS5 syntax in them is just text
+  EXPECT_EQ("{sTitle sPlot} : (\"it's\"*)", ToFTS("it's"));
+  EXPECT_EQ("{sTitle sPlot} : (\"a\"\"b\"*)", ToFTS("a\"b"));
+  EXPECT_EQ("{sTitle sPlot} : (\"x*\"* OR \"^y\"*)", ToFTS("x* ^y"));
+}
+
+TEST(TestEpgSearchTermConverter, FTSNot)
+{
+  EXPECT_EQ("{sTitle sPlot} : (\"news\"* NOT \"weather\"*)", ToFTS("news ! weather"));
+  EXPECT_EQ("{sTitle sPlot} : (\"news\"* NOT \"weather\"*)", ToFTS("news + ! weather"));
+  EXPECT_EQ("{sTitle sPlot} : (\"news\"* NOT \"weather\"*)", ToFTS("news AND NOT weather"));
+}
+
+TEST(TestEpgSearchTermConverter, FallsBackToSQL)
+{
+  // FTS5 NOT is binary, there is nothing to take a leading NOT or OR NOT from
+  EXPECT_EQ("", ToFTS("! weather"));
+  EXPECT_EQ("", ToFTS("NOT weather"));
+  EXPECT_EQ("", ToFTS("news | ! weather"));
+  EXPECT_EQ("", ToFTS("news OR NOT weather"));
+
+  // an operator needs a term of its own, "!weather" is just the operator
+  EXPECT_EQ("", ToFTS("news !weather"));
+  EXPECT_EQ("", ToFTS("news +"));
+
+  // terms without words can't be matched, the whole search uses LIKE then
+  EXPECT_EQ("", ToFTS("--"));
+  EXPECT_EQ("", ToFTS("news ??"));
+  EXPECT_EQ("", ToFTS(""));
+
+  EXPECT_EQ("((UPPER(sTitle) LIKE UPPER('%news%'))  OR (UPPER(sTitle) LIKE UPPER('%??%')))",
+            PVR::CSearchTermConverter("news ??").ToSQL("sTitle"));
+}
@@ -276,6 +276,11 @@ bool CRenderSystemGL::SupportsNPOT(bool dxt) const
   return true;
 }
 
+bool CRenderSystemGL::SupportsDXT() const
+{
+  return IsExtSupported("GL_EXT_texture_compression_s3tc");
+}
+
 void CRenderSystemGL::PresentRender(bool rendered, bool videoLayer)
 {
   SetVSync(true);
@@ -291,6 +291,7 @@ void CAdvancedSettings::Initialize()
   m_musicArtistSeparators = { ";", " feat. ", " ft. " };
   m_videoItemSeparator = " / ";
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
+  m_iMusicLibraryTagReadThreads = 4;
   m_bMusicLibraryUseISODates = false;
 
   m_bVideoLibraryAllItemsOnBottom = false;
@@ -300,8 +301,13 @@ void CAdvancedSettings::Initialize()
   m_bVideoLibraryImportWatchedState = false;
   m_bVideoLibraryImportResumePoint = false;
   m_bVideoScannerIgnoreErrors = false;
+  m_iVideoScannerPrefetchThreads = 4;
   m_iVideoLibraryDateAdded = 1; // prefer mtime over ctime and current time
 
+  m_bLibraryWatcherEnabled = false;
+  m_iLibraryWatcherDelay = 10;
+  m_iLibraryWatcherPollInterval = 900;
+
   m_videoEpisodeExtraArt = {};
   m_videoTvShowExtraArt = {};
   m_videoTvSeasonExtraArt = {};
@@ -388,18 +394,29 @@ void CAdvancedSettings::Initialize()
   // the following setting determines the readRate of a player data
   // as multiply of the default data read rate
   m_cacheReadFactor = 4.0f;
+  // number of independently filled memory cache segments, each gets an equal
+  // share of the memory size. 1 keeps a single read window.
+  m_cacheSegments = 1;
 
   m_addonPackageFolderSize = 200;
 
   m_jsonOutputCompact = true;
   m_jsonTcpPort = 9090;
 
+  m_webserverThreadPoolSize = 0;
+
+  m_jobManagerWorkStealing = false;
+  m_jobManagerWorkers = 0;
+
+  m_directoryCacheItems = 10000;
+
   m_enableMultimediaKeys = false;
 
   m_canWindowed = true;
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiTextureMemoryBudget = 0;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
@@ -751,6 +768,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "albumformat", m_strMusicLibraryAlbumFormat);
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "tagreadthreads", m_iMusicLibraryTagReadThreads, 1, 32);
     XMLUtils::GetBoolean(pElement, "useisodates", m_bMusicLibraryUseISODates);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
@@ -794,6 +812,15 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   if (pElement)
   {
     XMLUtils::GetBoolean(pElement, "ignoreerrors", m_bVideoScannerIgnoreErrors);
+    XMLUtils::GetInt(pElement, "prefetchthreads", m_iVideoScannerPrefetchThreads, 0, 32);
+  }
+
+  pElement = pRootElement->FirstChildElement("librarywatcher");
+  if (pElement)
+  {
+    XMLUtils::GetBoolean(pElement, "enabled", m_bLibraryWatcherEnabled);
+    XMLUtils::GetInt(pElement, "delay", m_iLibraryWatcherDelay, 1, 3600);
+    XMLUtils::GetInt(pElement, "pollinterval", m_iLibraryWatcherPollInterval, 0, 86400);
   }
 
   // Backward-compatibility of ExternalPlayer config
@@ -827,6 +854,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "buffermode", m_cacheBufferMode, 0, 4);
     XMLUtils::GetUInt(pElement, "chunksize", m_cacheChunkSize, 256, 1024 * 1024);
     XMLUtils::GetFloat(pElement, "readfactor", m_cacheReadFactor);
+    XMLUtils::GetUInt(pElement, "segments", m_cacheSegments, 1, 8);
   }
 
   pElement = pRootElement->FirstChildElement("jsonrpc");
@@ -836,6 +864,25 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "tcpport", m_jsonTcpPort);
   }
 
+  pElement = pRootElement->FirstChildElement("webserver");
+  if (pElement)
+  {
+    XMLUtils::GetUInt(pElement, "threadpoolsize", m_webserverThreadPoolSize, 0, 64);
+  }
+
+  pElement = pRootElement->FirstChildElement("jobmanager");
+  if (pElement)
+  {
+    XMLUtils::GetBoolean(pElement, "workstealing", m_jobManagerWorkStealing);
+    XMLUtils::GetUInt(pElement, "workers", m_jobManagerWorkers, 0, 256);
+  }
+
+  pElement = pRootElement->FirstChildElement("directorycache");
+  if (pElement)
+  {
+    XMLUtils::GetUInt(pElement, "maxitems", m_directoryCacheItems, 100, 1000000);
+  }
+
   pElement = pRootElement->FirstChildElement("samba");
   if (pElement)
   {
@@ -1174,6 +1221,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetUInt(pElement, "texturememorybudget", m_guiTextureMemoryBudget);
   }
 
   std::string seekSteps;
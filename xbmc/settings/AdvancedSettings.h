@@ -240,6 +240,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     int m_iMusicLibraryRecentlyAddedItems;
     int m_iMusicLibraryDateAdded;
+    int m_iMusicLibraryTagReadThreads;
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
     bool m_bMusicLibraryArtistSortOnUpdate;
@@ -265,8 +266,13 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     std::vector<std::string> m_videoMusicVideoExtraArt;
 
     bool m_bVideoScannerIgnoreErrors;
+    int m_iVideoScannerPrefetchThreads;
     int m_iVideoLibraryDateAdded;
 
+    bool m_bLibraryWatcherEnabled;
+    int m_iLibraryWatcherDelay;
+    int m_iLibraryWatcherPollInterval;
+
     std::set<std::string> m_vecTokens;
 
     int m_iEpgUpdateCheckInterval;  // seconds
@@ -325,16 +331,25 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    unsigned int m_guiTextureMemoryBudget; ///< in MB, released textures are freed early above it, 0 = no limit
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
     unsigned int m_cacheBufferMode;
     unsigned int m_cacheChunkSize;
     float m_cacheReadFactor;
+    unsigned int m_cacheSegments;
 
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
 
+    unsigned int m_webserverThreadPoolSize; ///< 0 = a thread per connection
+
+    bool m_jobManagerWorkStealing;
+    unsigned int m_jobManagerWorkers; ///< size of the work-stealing pool, 0 = number of CPUs
+
+    unsigned int m_directoryCacheItems; ///< items the directory cache holds, each directory counts as one
+
     bool m_enableMultimediaKeys;
     std::vector<std::string> m_settingsFiles;
     void ParseSettingsFile(const std::string &file);
@@ -0,0 +1,176 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "LibraryWatcher.h"
+#include "filesystem/SpecialProtocol.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include <string>
+#include <vector>
+
+#if defined(TARGET_POSIX)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// records the scans instead of starting them
+class CTestLibraryWatcher : public CLibraryWatcher
+{
+public:
+  CTestLibraryWatcher()
+  {
+    AddSource("/music/", false);
+    AddSource("/video/", true);
+    AddSource("/tv/", true);
+  }
+
+  void AddSource(const std::string& path, bool video)
+  {
+    SSource source;
+    source.path = path;
+    source.video = video;
+    m_sources.push_back(source);
+  }
+
+  using CLibraryWatcher::AddPolledDirectory;
+  using CLibraryWatcher::OnChanged;
+  using CLibraryWatcher::ScanChanges;
+  using CLibraryWatcher::m_changes;
+  using CLibraryWatcher::m_delay;
+  using CLibraryWatcher::m_polledDirs;
+
+  bool m_videoScanning = false;
+  bool m_musicScanning = false;
+  std::vector<std::string> m_videoScans;
+  std::vector<std::string> m_musicScans;
+
+protected:
+  bool IsScanning(bool video) const override { return video ? m_videoScanning : m_musicScanning; }
+
+  void StartScan(const std::string& path, bool video) override
+  {
+    (video ? m_videoScans : m_musicScans).push_back(path);
+  }
+
+  // the folders right below /tv/ are tv shows, everything else is scanned as it is
+  std::string GetVideoScanPath(const std::string& directory) const override
+  {
+    if (!StringUtils::StartsWith(directory, "/tv/"))
+      return directory;
+    const size_t end = directory.find('/', 4);
+    return end == std::string::npos ? "" : directory.substr(0, end + 1);
+  }
+};
+}
+
+TEST(TestLibraryWatcher, CoalescesChanges)
+{
+  CTestLibraryWatcher watcher;
+  watcher.OnChanged("/music/a/");
+  watcher.OnChanged("/music/a/");
+  watcher.OnChanged("/music/c/");
+  watcher.OnChanged("/music/a/");
+  watcher.OnChanged("/elsewhere/");
+  EXPECT_EQ(2u, watcher.m_changes.size());
+
+  // one scan at a time per library
+  watcher.ScanChanges();
+  ASSERT_EQ(1u, watcher.m_musicScans.size());
+  EXPECT_EQ("/music/a/", watcher.m_musicScans[0]);
+  EXPECT_EQ(1u, watcher.m_changes.size());
+
+  watcher.ScanChanges();
+  ASSERT_EQ(2u, watcher.m_musicScans.size());
+  EXPECT_EQ("/music/c/", watcher.m_musicScans[1]);
+  EXPECT_TRUE(watcher.m_changes.empty());
+  EXPECT_TRUE(watcher.m_videoScans.empty());
+}
+
+TEST(TestLibraryWatcher, ParentClearsChildren)
+{
+  CTestLibraryWatcher watcher;
+  watcher.OnChanged("/music/a/b/");
+  watcher.OnChanged("/music/a/");
+  watcher.OnChanged("/music/a/b/c/");
+  watcher.OnChanged("/music/ab/");
+  EXPECT_EQ(4u, watcher.m_changes.size());
+
+  watcher.ScanChanges();
+  ASSERT_EQ(1u, watcher.m_musicScans.size());
+  EXPECT_EQ("/music/a/", watcher.m_musicScans[0]);
+  // a sibling that merely shares the prefix isn't covered
+  ASSERT_EQ(1u, watcher.m_changes.size());
+  EXPECT_EQ("/music/ab/", watcher.m_changes.begin()->first);
+}
+
+TEST(TestLibraryWatcher, ScansWholeTvShows)
+{
+  CTestLibraryWatcher watcher;
+  watcher.OnChanged("/tv/show/season 2/");
+  watcher.OnChanged("/tv/show/season 1/");
+  watcher.OnChanged("/video/movie/");
+
+  watcher.ScanChanges();
+  watcher.ScanChanges();
+  ASSERT_EQ(2u, watcher.m_videoScans.size());
+  EXPECT_EQ("/tv/show/", watcher.m_videoScans[0]);
+  EXPECT_EQ("/video/movie/", watcher.m_videoScans[1]);
+  EXPECT_TRUE(watcher.m_changes.empty());
+}
+
+TEST(TestLibraryWatcher, WaitsForScannersAndDelay)
+{
+  CTestLibraryWatcher watcher;
+  watcher.m_musicScanning = true;
+  watcher.OnChanged("/music/a/");
+  watcher.OnChanged("/video/b/");
+
+  // the video scanner is idle, the music one isn't
+  watcher.ScanChanges();
+  EXPECT_TRUE(watcher.m_musicScans.empty());
+  ASSERT_EQ(1u, watcher.m_videoScans.size());
+  EXPECT_EQ(1u, watcher.m_changes.size());
+
+  // nothing is scanned until the directory was quiet for the delay
+  watcher.m_musicScanning = false;
+  watcher.m_delay = 3600 * 1000;
+  watcher.ScanChanges();
+  EXPECT_TRUE(watcher.m_musicScans.empty());
+
+  watcher.m_delay = 0;
+  watcher.ScanChanges();
+  EXPECT_EQ(1u, watcher.m_musicScans.size());
+  EXPECT_TRUE(watcher.m_changes.empty());
+}
+
+#if defined(TARGET_POSIX)
+TEST(TestLibraryWatcher, PollingStopsAtSymlinkLoops)
+{
+  std::string root = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"), "TestLibraryWatcher/");
+  const std::string subdir = URIUtils::AddFileToFolder(root, "sub/");
+  const std::string loop = URIUtils::AddFileToFolder(subdir, "loop");
+  ASSERT_EQ(0, mkdir(root.c_str(), 0755));
+  ASSERT_EQ(0, mkdir(subdir.c_str(), 0755));
+  ASSERT_EQ(0, symlink("..", loop.c_str()));
+
+  CTestLibraryWatcher watcher;
+  watcher.AddPolledDirectory(root);
+  EXPECT_EQ(2u, watcher.m_polledDirs.size());
+  EXPECT_TRUE(watcher.m_polledDirs.find(root) != watcher.m_polledDirs.end());
+  EXPECT_TRUE(watcher.m_polledDirs.find(subdir) != watcher.m_polledDirs.end());
+
+  unlink(loop.c_str());
+  rmdir(subdir.c_str());
+  rmdir(root.c_str());
+}
+#endif
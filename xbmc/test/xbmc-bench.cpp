@@ -0,0 +1,28 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TestBasicEnvironment.h"
+#include "TestUtils.h"
+#include "settings/SettingsComponent.h"
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char **argv)
+{
+  benchmark::Initialize(&argc, argv);
+  CXBMCTestUtils::Instance().ParseArgs(argc, argv);
+
+  // benchmarks run in the same basic environment as the unit tests
+  TestBasicEnvironment environment;
+  environment.SetUp();
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  environment.TearDown();
+  return 0;
+}
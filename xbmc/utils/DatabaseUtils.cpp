@@ -384,7 +384,7 @@ bool DatabaseUtils::GetDatabaseResults(const MediaType &mediaType, const FieldLi
   if (fields.empty())
   {
     DatabaseResult result;
-    for (unsigned int index = 0; index < resultSet.records.size(); index++)
+    for (unsigned int index = 0; index < resultSet.size(); index++)
     {
       result[FieldRow] = index + offset;
       results.push_back(result);
@@ -401,12 +401,14 @@ bool DatabaseUtils::GetDatabaseResults(const MediaType &mediaType, const FieldLi
   for (FieldList::const_iterator it = fields.begin(); it != fields.end(); ++it)
     fieldIndexLookup.push_back(GetFieldIndex(*it, mediaType));
 
-  results.reserve(resultSet.records.size() + offset);
-  for (unsigned int index = 0; index < resultSet.records.size(); index++)
+  results.reserve(resultSet.size() + offset);
+  dbiplus::field_value fieldValue;
+  for (unsigned int index = 0; index < resultSet.size(); index++)
   {
     DatabaseResult result;
     result[FieldRow] = index + offset;
 
+    const dbiplus::row_view record = resultSet.row(index);
     unsigned int lookupIndex = 0;
     for (FieldList::const_iterator it = fields.begin(); it != fields.end(); ++it)
     {
@@ -416,7 +418,8 @@ bool DatabaseUtils::GetDatabaseResults(const MediaType &mediaType, const FieldLi
 
       std::pair<Field, CVariant> value;
       value.first = *it;
-      if (!GetFieldValue(resultSet.records[index]->at(fieldIndex), value.second))
+      record.at(fieldIndex).get(fieldValue);
+      if (!GetFieldValue(fieldValue, value.second))
         CLog::Log(LOGWARNING, "GetDatabaseResults: unable to retrieve value of field %s", resultSet.record_header[fieldIndex].name.c_str());
 
       if (value.first == FieldYear &&
@@ -10,10 +10,31 @@
 
 #include "utils/Variant.h"
 
+#include <algorithm>
+#include <string.h>
+
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+namespace
+{
+// rapidjson output stream appending to a std::string
+class CStringOutputStream
+{
+public:
+  typedef char Ch;
+
+  explicit CStringOutputStream(std::string &output) : m_output(output) {}
+
+  void Put(char c) { m_output.push_back(c); }
+  void Flush() {}
+
+private:
+  std::string &m_output;
+};
+}
+
 template<class TWriter>
 bool InternalWrite(TWriter& writer, const CVariant &value)
 {
@@ -90,3 +111,129 @@ bool CJSONVariantWriter::Write(const CVariant &value, std::string& output, bool
   output = stringBuffer.GetString();
   return true;
 }
+
+CJSONVariantStreamWriter::CJSONVariantStreamWriter(CVariant &&value, bool compact)
+  : m_value(std::move(value)),
+    m_compact(compact)
+{
+}
+
+size_t CJSONVariantStreamWriter::Write(char *buffer, size_t size)
+{
+  // drop what has already been handed out before serializing more
+  if (m_pendingOffset > 0)
+  {
+    m_pending.erase(0, m_pendingOffset);
+    m_pendingOffset = 0;
+  }
+
+  while (m_pending.size() < size && Advance())
+    ;
+
+  if (m_failed)
+    return 0;
+
+  size_t length = std::min(size, m_pending.size());
+  memcpy(buffer, m_pending.c_str(), length);
+  m_pendingOffset = length;
+
+  return length;
+}
+
+bool CJSONVariantStreamWriter::IsComplete() const
+{
+  return m_started && !m_failed && m_levels.empty() && m_pendingOffset == m_pending.size();
+}
+
+bool CJSONVariantStreamWriter::Advance()
+{
+  if (m_failed)
+    return false;
+
+  if (!m_started)
+  {
+    m_started = true;
+    return WriteValue(m_value);
+  }
+
+  if (m_levels.empty())
+    return false;
+
+  // the same separators and indentation as rapidjson's Writer and PrettyWriter
+  Level &level = m_levels.back();
+  if (level.value->isArray())
+  {
+    if (level.array != level.value->end_array())
+    {
+      if (!level.empty)
+        m_pending.push_back(',');
+      level.empty = false;
+      WriteNewline(m_levels.size());
+
+      const CVariant &value = *level.array++;
+      return WriteValue(value);
+    }
+  }
+  else if (level.member != level.value->end_map())
+  {
+    if (!level.empty)
+      m_pending.push_back(',');
+    level.empty = false;
+    WriteNewline(m_levels.size());
+
+    CVariant::const_iterator_map member = level.member++;
+    CStringOutputStream stream(m_pending);
+    rapidjson::Writer<CStringOutputStream> writer(stream);
+    writer.String(member->first.c_str());
+    m_pending.append(m_compact ? ":" : ": ");
+
+    return WriteValue(member->second);
+  }
+
+  // all values of the current array or object have been written
+  const bool isArray = level.value->isArray();
+  const bool empty = level.empty;
+  m_levels.pop_back();
+
+  if (!empty)
+    WriteNewline(m_levels.size());
+  m_pending.push_back(isArray ? ']' : '}');
+
+  return true;
+}
+
+bool CJSONVariantStreamWriter::WriteValue(const CVariant &value)
+{
+  if (value.isArray())
+  {
+    m_pending.push_back('[');
+    m_levels.push_back({ &value, value.begin_array(), CVariant::const_iterator_map(), true });
+    return true;
+  }
+
+  if (value.isObject())
+  {
+    m_pending.push_back('{');
+    m_levels.push_back({ &value, CVariant::const_iterator_array(), value.begin_map(), true });
+    return true;
+  }
+
+  CStringOutputStream stream(m_pending);
+  rapidjson::Writer<CStringOutputStream> writer(stream);
+  if (!InternalWrite(writer, value))
+  {
+    m_failed = true;
+    return false;
+  }
+
+  return true;
+}
+
+void CJSONVariantStreamWriter::WriteNewline(size_t depth)
+{
+  if (m_compact)
+    return;
+
+  m_pending.push_back('\n');
+  m_pending.append(depth, '\t');
+}
@@ -8,9 +8,10 @@
 
 #pragma once
 
-#include <string>
+#include "utils/Variant.h"
 
-class CVariant;
+#include <string>
+#include <vector>
 
 class CJSONVariantWriter
 {
@@ -19,3 +20,62 @@ public:
 
   static bool Write(const CVariant &value, std::string& output, bool compact);
 };
+
+/*!
+ \brief Serializes a CVariant piece by piece into caller provided buffers.
+
+ Produces the same output as CJSONVariantWriter::Write() but never holds more than roughly one
+ buffer worth of serialized data, so large responses can be sent while they are being written.
+ */
+class CJSONVariantStreamWriter
+{
+public:
+  /*!
+   \brief Creates a writer for the given value.
+   \param value Value to serialize, the writer takes ownership of it
+   \param compact Whether to write compact or indented JSON
+   */
+  CJSONVariantStreamWriter(CVariant &&value, bool compact);
+
+  CJSONVariantStreamWriter(const CJSONVariantStreamWriter&) = delete;
+  CJSONVariantStreamWriter& operator=(const CJSONVariantStreamWriter&) = delete;
+
+  /*!
+   \brief Writes the next part of the serialized value.
+   \param buffer Buffer to write to
+   \param size Size of the buffer
+   \return Number of bytes written, 0 once everything has been written or writing failed
+   */
+  size_t Write(char *buffer, size_t size);
+
+  /*!
+   \brief Whether the whole value has been serialized and returned by Write().
+   */
+  bool IsComplete() const;
+
+  /*!
+   \brief Whether the value contains something that can't be serialized (e.g. NaN).
+   */
+  bool HasFailed() const { return m_failed; }
+
+private:
+  struct Level
+  {
+    const CVariant *value;
+    CVariant::const_iterator_array array;
+    CVariant::const_iterator_map member;
+    bool empty;
+  };
+
+  bool Advance();
+  bool WriteValue(const CVariant &value);
+  void WriteNewline(size_t depth);
+
+  CVariant m_value;
+  bool m_compact;
+  bool m_started = false;
+  bool m_failed = false;
+  std::vector<Level> m_levels;
+  std::string m_pending;
+  size_t m_pendingOffset = 0;
+};
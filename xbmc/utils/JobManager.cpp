@@ -62,6 +62,41 @@ void CJobWorker::Process()
   }
 }
 
+CJobPoolWorker::CJobPoolWorker(CJobManager *manager, unsigned int index) : CThread("JobPoolWorker")
+{
+  m_jobManager = manager;
+  m_index = index;
+  Create();
+}
+
+CJobPoolWorker::~CJobPoolWorker()
+{
+  StopThread();
+}
+
+void CJobPoolWorker::Process()
+{
+  SetPriority( GetMinPriority() );
+  while (!m_bStop)
+  {
+    // request an item from our manager (this call is blocking)
+    CJob *job = m_jobManager->GetNextPoolJob(m_index);
+    if (!job)
+      break;
+
+    bool success = false;
+    try
+    {
+      success = job->DoWork();
+    }
+    catch (...)
+    {
+      CLog::Log(LOGERROR, "%s error processing job %s", __FUNCTION__, job->GetType());
+    }
+    m_jobManager->OnPoolJobComplete(m_index, success, job);
+  }
+}
+
 void CJobQueue::CJobPointer::CancelJob()
 {
   CJobManager::GetInstance().CancelJob(m_id);
@@ -170,6 +205,19 @@ CJobManager::CJobManager()
   m_jobCounter = 0;
   m_running = true;
   m_pauseJobs = false;
+  m_workStealing = false;
+  m_poolRunning = false;
+  m_poolNext = 0;
+  m_poolQueued = 0;
+  m_poolBusy = 0;
+}
+
+CJobManager::~CJobManager()
+{
+  // CancelJobs() stops the pool workers on shutdown. Don't wait for threads during static
+  // destruction if that didn't happen.
+  for (auto& worker : m_poolWorkers)
+    worker.release();
 }
 
 void CJobManager::Restart()
@@ -179,6 +227,101 @@ void CJobManager::Restart()
   if (m_running)
     throw std::logic_error("CJobManager already running");
   m_running = true;
+
+  if (m_workStealing)
+    StartPoolWorkers();
+}
+
+void CJobManager::EnableWorkStealing(unsigned int workers)
+{
+  {
+    CExclusiveLock poolLock(m_poolSection);
+    if (m_workStealing)
+      return;
+
+    // never run fewer workers than the on-demand scheduler allows, so the per-priority limits still hold
+    workers = std::max(workers, GetMaxWorkers(CJob::PRIORITY_HIGH));
+    for (unsigned int i = 0; i < workers; ++i)
+      m_poolSlots.emplace_back(new CPoolSlot);
+    m_workStealing = true;
+  }
+
+  CSingleLock lock(m_section);
+  if (m_running)
+    StartPoolWorkers();
+
+  CLog::Log(LOGINFO, "CJobManager: using work-stealing pool with %u workers", workers);
+}
+
+void CJobManager::DisableWorkStealing()
+{
+  {
+    CSingleLock lock(m_section);
+    if (!m_workStealing)
+      return;
+  }
+
+  // let the pool workers finish the jobs they are running
+  StopPoolWorkers();
+
+  // wait for AddJob() calls that still use the pool, later ones go to on-demand workers
+  std::vector<std::unique_ptr<CPoolSlot>> slots;
+  {
+    CExclusiveLock poolLock(m_poolSection);
+    m_workStealing = false;
+    slots.swap(m_poolSlots);
+    m_poolQueued = 0;
+    m_poolBusy = 0;
+  }
+
+  // and hand the jobs still queued over to on-demand workers
+  CSingleLock lock(m_section);
+  for (auto& slot : slots)
+  {
+    for (int priority = CJob::PRIORITY_LOW_PAUSABLE; priority < CJob::PRIORITY_DEDICATED; ++priority)
+    {
+      JobQueue& queue = slot->m_jobQueue[priority];
+      m_jobQueue[priority].insert(m_jobQueue[priority].end(), queue.begin(), queue.end());
+    }
+  }
+
+  if (m_running)
+  {
+    for (int priority = CJob::PRIORITY_LOW_PAUSABLE; priority < CJob::PRIORITY_DEDICATED; ++priority)
+    {
+      if (!m_jobQueue[priority].empty())
+        StartWorkers(CJob::PRIORITY(priority));
+    }
+  }
+
+  CLog::Log(LOGINFO, "CJobManager: work-stealing pool disabled");
+}
+
+void CJobManager::StartPoolWorkers()
+{
+  CSharedLock poolLock(m_poolSection);
+  m_poolRunning = true;
+  for (unsigned int i = 0; i < m_poolSlots.size(); ++i)
+    m_poolWorkers.emplace_back(new CJobPoolWorker(this, i));
+}
+
+void CJobManager::StopPoolWorkers()
+{
+  std::vector<std::unique_ptr<CJobPoolWorker>> workers;
+  {
+    CSingleLock lock(m_section);
+    workers.swap(m_poolWorkers);
+  }
+
+  // waking the workers is enough to make them exit
+  m_poolRunning = false;
+  {
+    CSharedLock poolLock(m_poolSection);
+    for (auto& slot : m_poolSlots)
+      slot->m_jobEvent.Set();
+  }
+  for (auto& worker : workers)
+    worker->StopThread();
 }
 
 void CJobManager::CancelJobs()
@@ -196,6 +339,23 @@ void CJobManager::CancelJobs()
   // cancel any callbacks on jobs still processing
   for_each(m_processing.begin(), m_processing.end(), [](CWorkItem& wi) { wi.Cancel(); });
 
+  // and the same for the work-stealing pool
+  CSharedLock poolLock(m_poolSection);
+  if (m_workStealing)
+  {
+    for (auto& slot : m_poolSlots)
+    {
+      CSingleLock slotLock(slot->m_section);
+      for (JobQueue& queue : slot->m_jobQueue)
+      {
+        m_poolQueued -= queue.size();
+        for_each(queue.begin(), queue.end(), [](CWorkItem& wi) { wi.FreeJob(); });
+        queue.clear();
+      }
+      for_each(slot->m_processing.begin(), slot->m_processing.end(), [](CWorkItem& wi) { wi.Cancel(); });
+    }
+  }
+
   // tell our workers to finish
   while (m_workers.size())
   {
@@ -204,28 +364,85 @@ void CJobManager::CancelJobs()
     std::this_thread::yield(); // yield after setting the event to give the workers some time to die
     lock.Enter();
   }
+
+  if (m_workStealing)
+  {
+    poolLock.Leave();
+    lock.Leave();
+    StopPoolWorkers();
+  }
+}
+
+unsigned int CJobManager::NextJobID()
+{
+  // increment the job counter, ensuring 0 (invalid job) is never hit
+  unsigned int id = ++m_jobCounter;
+  while (id == 0)
+    id = ++m_jobCounter;
+  return id;
 }
 
 unsigned int CJobManager::AddJob(CJob *job, IJobCallback *callback, CJob::PRIORITY priority)
 {
+  if (m_workStealing && priority != CJob::PRIORITY_DEDICATED)
+  {
+    // the pool can't go away while we add to it
+    CSharedLock poolLock(m_poolSection);
+    if (m_workStealing)
+    {
+      if (!m_running)
+        return 0;
+
+      CWorkItem work(job, NextJobID(), priority, callback);
+      return AddPoolJob(work);
+    }
+  }
+
   CSingleLock lock(m_section);
 
   if (!m_running)
     return 0;
 
-  // increment the job counter, ensuring 0 (invalid job) is never hit
-  m_jobCounter++;
-  if (m_jobCounter == 0)
-    m_jobCounter++;
-
   // create a work item for this job
-  CWorkItem work(job, m_jobCounter, priority, callback);
+  CWorkItem work(job, NextJobID(), priority, callback);
   m_jobQueue[priority].push_back(work);
 
   StartWorkers(priority);
   return work.m_id;
 }
 
+unsigned int CJobManager::AddPoolJob(CWorkItem &work)
+{
+  // spread new jobs over the workers, idle workers will steal them from busy ones
+  const unsigned int index = m_poolNext++ % m_poolSlots.size();
+  CPoolSlot &slot = *m_poolSlots[index];
+  {
+    CSingleLock lock(slot.m_section);
+    slot.m_jobQueue[work.m_priority].push_back(work);
+    m_poolQueued++;
+  }
+  WakePoolWorker(index);
+  return work.m_id;
+}
+
+void CJobManager::WakePoolWorker(unsigned int preferred)
+{
+  // prefer the owner of the queue, otherwise any idle worker will do
+  if (m_poolSlots[preferred]->m_idle)
+  {
+    m_poolSlots[preferred]->m_jobEvent.Set();
+    return;
+  }
+  for (auto& slot : m_poolSlots)
+  {
+    if (slot->m_idle)
+    {
+      slot->m_jobEvent.Set();
+      return;
+    }
+  }
+}
+
 void CJobManager::CancelJob(unsigned int jobID)
 {
   CSingleLock lock(m_section);
@@ -244,7 +461,37 @@ void CJobManager::CancelJob(unsigned int jobID)
   // or if we're processing it
   Processing::iterator it = find(m_processing.begin(), m_processing.end(), jobID);
   if (it != m_processing.end())
+  {
     it->m_callback = NULL; // job is in progress, so only thing to do is to remove callback
+    return;
+  }
+  lock.Leave();
+
+  CSharedLock poolLock(m_poolSection);
+  if (!m_workStealing)
+    return;
+
+  for (auto& slot : m_poolSlots)
+  {
+    CSingleLock slotLock(slot->m_section);
+    for (JobQueue& queue : slot->m_jobQueue)
+    {
+      JobQueue::iterator i = find(queue.begin(), queue.end(), jobID);
+      if (i != queue.end())
+      {
+        delete i->m_job;
+        queue.erase(i);
+        m_poolQueued--;
+        return;
+      }
+    }
+    Processing::iterator i = find(slot->m_processing.begin(), slot->m_processing.end(), jobID);
+    if (i != slot->m_processing.end())
+    {
+      i->m_callback = NULL;
+      return;
+    }
+  }
 }
 
 void CJobManager::StartWorkers(CJob::PRIORITY priority)
@@ -290,6 +537,116 @@ CJob *CJobManager::PopJob()
   return NULL;
 }
 
+bool CJobManager::ReservePoolWorker(CJob::PRIORITY priority)
+{
+  // keep workers free for higher priority jobs, as GetMaxWorkers() does for on-demand workers
+  const unsigned int maxBusy = m_poolSlots.size() - (CJob::PRIORITY_HIGH - priority);
+  unsigned int busy = m_poolBusy;
+  do
+  {
+    if (busy >= maxBusy)
+      return false;
+  } while (!m_poolBusy.compare_exchange_weak(busy, busy + 1));
+  return true;
+}
+
+CJob *CJobManager::PopPoolJob(unsigned int index)
+{
+  const unsigned int count = m_poolSlots.size();
+  for (int priority = CJob::PRIORITY_HIGH; priority >= CJob::PRIORITY_LOW_PAUSABLE; --priority)
+  {
+    // Check whether we're pausing pausable jobs
+    if (priority == CJob::PRIORITY_LOW_PAUSABLE && m_pauseJobs)
+      continue;
+
+    // our own queue first, oldest job first, then steal the newest job of the other workers
+    for (unsigned int n = 0; n < count && m_poolQueued > 0; ++n)
+    {
+      const unsigned int victim = (index + n) % count;
+      JobQueue &queue = m_poolSlots[victim]->m_jobQueue[priority];
+
+      // lock both slots in index order so two stealing workers can't deadlock
+      CSingleLock first(m_poolSlots[std::min(index, victim)]->m_section);
+      CSingleLock second(m_poolSlots[std::max(index, victim)]->m_section);
+      if (queue.empty())
+        continue;
+
+      if (!ReservePoolWorker(CJob::PRIORITY(priority)))
+        return NULL; // lower priorities have even fewer workers available
+
+      CWorkItem job = victim == index ? queue.front() : queue.back();
+      if (victim == index)
+        queue.pop_front();
+      else
+        queue.pop_back();
+      m_poolQueued--;
+
+      // add to the processing vector
+      m_poolSlots[index]->m_processing.push_back(job);
+      job.m_job->m_callback = this;
+      return job.m_job;
+    }
+  }
+  return NULL;
+}
+
+CJob *CJobManager::GetNextPoolJob(unsigned int index)
+{
+  CPoolSlot &slot = *m_poolSlots[index];
+  while (m_poolRunning)
+  {
+    // mark ourselves idle before looking, so a job queued after the lookup wakes us up
+    slot.m_idle = true;
+    CJob *job = PopPoolJob(index);
+    if (job)
+    {
+      slot.m_idle = false;
+      // more work queued? let another idle worker have it
+      if (m_poolQueued > 0)
+        WakePoolWorker(index);
+      return job;
+    }
+    // AddJob(), job completion, UnPauseJobs() and StopPoolWorkers() wake us up
+    slot.m_jobEvent.Wait();
+  }
+  slot.m_idle = false;
+  return NULL;
+}
+
+void CJobManager::OnPoolJobComplete(unsigned int index, bool success, CJob *job)
+{
+  CPoolSlot &slot = *m_poolSlots[index];
+  CSingleLock lock(slot.m_section);
+  // remove the job from the processing queue
+  Processing::iterator i = find(slot.m_processing.begin(), slot.m_processing.end(), job);
+  if (i != slot.m_processing.end())
+  {
+    // tell any listeners we're done with the job, then delete it
+    CWorkItem item(*i);
+    lock.Leave();
+    try
+    {
+      if (item.m_callback)
+        item.m_callback->OnJobComplete(item.m_id, success, item.m_job);
+    }
+    catch (...)
+    {
+      CLog::Log(LOGERROR, "%s error processing job %s", __FUNCTION__, item.m_job->GetType());
+    }
+    lock.Enter();
+    Processing::iterator j = find(slot.m_processing.begin(), slot.m_processing.end(), job);
+    if (j != slot.m_processing.end())
+      slot.m_processing.erase(j);
+    lock.Leave();
+    item.FreeJob();
+  }
+  m_poolBusy--;
+
+  // queued jobs may have been waiting for a worker of their priority to become free
+  if (m_poolQueued > 0)
+    WakePoolWorker(index);
+}
+
 void CJobManager::PauseJobs()
 {
   CSingleLock lock(m_section);
@@ -300,6 +657,14 @@ void CJobManager::UnPauseJobs()
 {
   CSingleLock lock(m_section);
   m_pauseJobs = false;
+
+  // pool workers may be sleeping on paused jobs
+  CSharedLock poolLock(m_poolSection);
+  if (m_workStealing)
+  {
+    for (auto& slot : m_poolSlots)
+      slot->m_jobEvent.Set();
+  }
 }
 
 bool CJobManager::IsProcessing(const CJob::PRIORITY &priority) const
@@ -314,6 +679,21 @@ bool CJobManager::IsProcessing(const CJob::PRIORITY &priority) const
     if (priority == it->m_priority)
       return true;
   }
+  lock.Leave();
+
+  CSharedLock poolLock(m_poolSection);
+  if (m_workStealing)
+  {
+    for (const auto& slot : m_poolSlots)
+    {
+      CSingleLock slotLock(slot->m_section);
+      for (const CWorkItem& item : slot->m_processing)
+      {
+        if (priority == item.m_priority)
+          return true;
+      }
+    }
+  }
   return false;
 }
 
@@ -330,6 +710,21 @@ int CJobManager::IsProcessing(const std::string &type) const
     if (type == std::string(it->m_job->GetType()))
       jobsMatched++;
   }
+  lock.Leave();
+
+  CSharedLock poolLock(m_poolSection);
+  if (m_workStealing)
+  {
+    for (const auto& slot : m_poolSlots)
+    {
+      CSingleLock slotLock(slot->m_section);
+      for (const CWorkItem& item : slot->m_processing)
+      {
+        if (type == std::string(item.m_job->GetType()))
+          jobsMatched++;
+      }
+    }
+  }
   return jobsMatched;
 }
 
@@ -361,6 +756,29 @@ CJob *CJobManager::GetNextJob(const CJobWorker *worker)
 
 bool CJobManager::OnJobProgress(unsigned int progress, unsigned int total, const CJob *job) const
 {
+  CSharedLock poolLock(m_poolSection);
+  if (m_workStealing)
+  {
+    for (const auto& slot : m_poolSlots)
+    {
+      CSingleLock slotLock(slot->m_section);
+      Processing::const_iterator i = find(slot->m_processing.begin(), slot->m_processing.end(), job);
+      if (i != slot->m_processing.end())
+      {
+        CWorkItem item(*i);
+        slotLock.Leave(); // leave sections prior to call
+        poolLock.Leave();
+        if (item.m_callback)
+        {
+          item.m_callback->OnJobProgress(item.m_id, progress, total, job);
+          return false;
+        }
+        return true; // cancelled
+      }
+    }
+  }
+  poolLock.Leave();
+
   CSingleLock lock(m_section);
   // find the job in the processing queue, and check whether it's cancelled (no callback)
   Processing::const_iterator i = find(m_processing.begin(), m_processing.end(), job);
@@ -10,8 +10,11 @@
 
 #include "Job.h"
 #include "threads/CriticalSection.h"
+#include "threads/SharedSection.h"
 #include "threads/Thread.h"
 
+#include <atomic>
+#include <memory>
 #include <queue>
 #include <string>
 #include <vector>
@@ -29,6 +32,25 @@ private:
   CJobManager  *m_jobManager;
 };
 
+/*!
+ \ingroup jobs
+ \brief Worker thread of the work-stealing pool.
+ Pool workers live as long as the job manager is running and take jobs from their own
+ queue first, stealing from the other workers' queues when it is empty.
+ \sa CJobManager::EnableWorkStealing()
+ */
+class CJobPoolWorker : public CThread
+{
+public:
+  CJobPoolWorker(CJobManager *manager, unsigned int index);
+  ~CJobPoolWorker() override;
+
+  void Process() override;
+private:
+  CJobManager  *m_jobManager;
+  unsigned int  m_index;
+};
+
 template<typename F>
 class CLambdaJob : public CJob
 {
@@ -309,8 +331,28 @@ public:
    */
   bool IsProcessing(const CJob::PRIORITY &priority) const;
 
+  /*!
+   \brief Run all but PRIORITY_DEDICATED jobs on a fixed pool of work-stealing workers.
+   Every pool worker has its own job queues, so adding and fetching jobs no longer contend
+   on a single lock, and idle workers steal queued jobs from busy ones. Dedicated jobs still
+   get a worker of their own. Does nothing if the pool is already enabled.
+   \param workers number of pool workers. Raised to the number of workers allowed for
+   PRIORITY_HIGH jobs if smaller.
+   \sa DisableWorkStealing()
+   */
+  void EnableWorkStealing(unsigned int workers);
+
+  /*!
+   \brief Go back to starting workers on demand.
+   Waits for the pool workers to finish their current job and moves the jobs still queued
+   in the pool to the on-demand queues. Must not be called from a job.
+   \sa EnableWorkStealing()
+   */
+  void DisableWorkStealing();
+
 protected:
   friend class CJobWorker;
+  friend class CJobPoolWorker;
   friend class CJob;
   friend class CJobQueue;
 
@@ -341,9 +383,23 @@ protected:
    */
   bool  OnJobProgress(unsigned int progress, unsigned int total, const CJob *job) const;
 
+  /*!
+   \brief Get a new job for a pool worker. Blocks until a job is available or the manager is stopped.
+   \param index index of the calling pool worker
+   \return the job to process, NULL if the worker should exit
+   */
+  CJob *GetNextPoolJob(unsigned int index);
+
+  /*!
+   \brief Callback from CJobPoolWorker after a job has completed.
+   \sa OnJobComplete()
+   */
+  void  OnPoolJobComplete(unsigned int index, bool success, CJob *job);
+
 private:
   // private construction, and no assignments; use the provided singleton methods
   CJobManager();
+  ~CJobManager();
   CJobManager(const CJobManager&) = delete;
   CJobManager const& operator=(CJobManager const&) = delete;
 
@@ -355,19 +411,53 @@ private:
   void StartWorkers(CJob::PRIORITY priority);
   void RemoveWorker(const CJobWorker *worker);
   static unsigned int GetMaxWorkers(CJob::PRIORITY priority);
+  unsigned int NextJobID();
+
+  unsigned int AddPoolJob(CWorkItem &work);
+  CJob *PopPoolJob(unsigned int index);
+  bool ReservePoolWorker(CJob::PRIORITY priority);
+  void WakePoolWorker(unsigned int preferred);
+  void StartPoolWorkers();
+  void StopPoolWorkers();
 
-  unsigned int m_jobCounter;
+  std::atomic<unsigned int> m_jobCounter;
 
   typedef std::deque<CWorkItem>    JobQueue;
   typedef std::vector<CWorkItem>   Processing;
   typedef std::vector<CJobWorker*> Workers;
 
+  /*!
+   \brief Queues of a single pool worker, protected by their own lock.
+   m_processing holds the job the worker is currently running, if any.
+   */
+  struct CPoolSlot
+  {
+    JobQueue   m_jobQueue[CJob::PRIORITY_DEDICATED];
+    Processing m_processing;
+    std::atomic<bool> m_idle{false};
+    CEvent     m_jobEvent;
+    mutable CCriticalSection m_section;
+  };
+
   JobQueue   m_jobQueue[CJob::PRIORITY_DEDICATED + 1];
-  bool       m_pauseJobs;
+  std::atomic<bool> m_pauseJobs;
   Processing m_processing;
   Workers    m_workers;
 
+  std::atomic<bool> m_workStealing;
+  /*!
+   \brief Held shared while m_poolSlots is used, exclusively to change it and m_workStealing.
+   m_section is never taken while holding this exclusively.
+   */
+  mutable CSharedSection m_poolSection;
+  std::vector<std::unique_ptr<CPoolSlot>>      m_poolSlots;
+  std::vector<std::unique_ptr<CJobPoolWorker>> m_poolWorkers;
+  std::atomic<unsigned int> m_poolNext;   ///< round robin index for new pool jobs
+  std::atomic<unsigned int> m_poolQueued; ///< jobs waiting in the pool queues
+  std::atomic<unsigned int> m_poolBusy;   ///< pool workers running a job
+  std::atomic<bool> m_poolRunning;        ///< pool workers wait for jobs while set
+
   mutable CCriticalSection m_section;
   CEvent           m_jobEvent;
-  bool             m_running;
+  std::atomic<bool> m_running;
 };
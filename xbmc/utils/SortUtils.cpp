@@ -11,12 +11,21 @@
 #include "LangInfo.h"
 #include "URL.h"
 #include "Util.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
 #include "utils/CharsetConverter.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
 #include <algorithm>
+#include <atomic>
 #include <inttypes.h>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
 
 std::string ArrayToString(SortAttribute attributes, const CVariant &variant, const std::string &separator = " / ")
 {
@@ -458,130 +467,361 @@ std::string ByBPM(SortAttribute attributes, const SortItem& values)
                              ByLabel(attributes, values));
 }
 
-bool preliminarySort(const SortItem &left, const SortItem &right, bool handleFolder, bool &result, std::wstring &labelLeft, std::wstring &labelRight)
+namespace
 {
-  // make sure both items have the necessary data to do the sorting
-  SortItem::const_iterator itLeftSort, itRightSort;
-  if ((itLeftSort = left.find(FieldSort)) == left.end())
+// lists with at least this many items are sorted by several threads
+const size_t ParallelSortMinItems = 10000;
+const unsigned int ParallelSortMaxThreads = 8;
+
+/*!
+ \brief Sort criteria of all items of a list, extracted once before sorting.
+
+ The sort labels are turned into compact keys holding the collation rank of every
+ character (and the value of digits), so comparing two keys gives the same result as
+ StringUtils::AlphaNumericCompare() on the labels without converting or collating
+ anything during the sort.
+ */
+class CSortKeys
+{
+public:
+  CSortKeys(SortOrder sortOrder, SortAttribute attributes, size_t count)
+    : m_descending(sortOrder == SortOrderDescending),
+      m_handleFolders(!(attributes & SortAttributeIgnoreFolders))
   {
-    result = false;
-    return true;
+    m_keys.reserve(count);
+    m_labels.reserve(count);
   }
-  if ((itRightSort = right.find(FieldSort)) == right.end())
+
+  void Add(const SortItem &item, std::wstring label);
+
+  /*!
+   \brief Sorts the added items.
+   \return Indices of the added items in sorted order
+   */
+  std::vector<uint32_t> Sort();
+
+private:
+  struct Key
   {
-    result = true;
-    return true;
-  }
+    SortSpecial special;
+    int8_t folder; ///< -1 if unknown
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  static bool IsDigit(uint32_t unit) { return (unit & 0xf) != 0; }
+  static int64_t Digit(uint32_t unit) { return (unit & 0xf) - 1; }
+  static uint32_t Rank(uint32_t unit) { return unit >> 4; }
+
+  void BuildLabelKeys();
+  bool Less(uint32_t left, uint32_t right) const;
+  int64_t CompareLabels(const Key &left, const Key &right) const;
+
+  bool m_descending;
+  bool m_handleFolders;
+  std::vector<Key> m_keys;
+  std::vector<std::wstring> m_labels;
+  std::vector<uint32_t> m_labelUnits; ///< keys of all labels, (rank << 4) | (digit + 1)
+};
 
-  // look at special sorting behaviour
-  SortItem::const_iterator itLeft, itRight;
-  SortSpecial leftSortSpecial = SortSpecialNone;
-  SortSpecial rightSortSpecial = SortSpecialNone;
-  if ((itLeft = left.find(FieldSortSpecial)) != left.end() && itLeft->second.asInteger() <= (int64_t)SortSpecialOnBottom)
-    leftSortSpecial = (SortSpecial)itLeft->second.asInteger();
-  if ((itRight = right.find(FieldSortSpecial)) != right.end() && itRight->second.asInteger() <= (int64_t)SortSpecialOnBottom)
-    rightSortSpecial = (SortSpecial)itRight->second.asInteger();
+void CSortKeys::Add(const SortItem &item, std::wstring label)
+{
+  Key key;
+  key.special = SortSpecialNone;
+  key.folder = -1;
+  key.offset = 0;
+  key.length = 0;
 
-  // one has a special sort
-  if (leftSortSpecial != rightSortSpecial)
+  SortItem::const_iterator it = item.find(FieldSortSpecial);
+  if (it != item.end() && it->second.asInteger() <= (int64_t)SortSpecialOnBottom)
+    key.special = (SortSpecial)it->second.asInteger();
+
+  it = item.find(FieldFolder);
+  if (it != item.end())
+    key.folder = it->second.asBoolean() ? 1 : 0;
+
+  m_keys.push_back(key);
+  m_labels.push_back(std::move(label));
+}
+
+void CSortKeys::BuildLabelKeys()
+{
+  // only upper case ASCII letters are folded, like AlphaNumericCompare() does
+  auto fold = [](wchar_t c) { return c >= L'A' && c <= L'Z' ? static_cast<wchar_t>(c + (L'a' - L'A')) : c; };
+
+  // collect all characters used by the labels, ASCII in a table and the rest in a map
+  uint32_t asciiRanks[128] = {};
+  bool asciiUsed[128] = {};
+  std::unordered_map<wchar_t, uint32_t> ranks;
+  size_t units = 0;
+  for (const std::wstring &label : m_labels)
   {
-    // left should be sorted on top
-    // or right should be sorted on bottom
-    // => left is sorted above right
-    if (leftSortSpecial == SortSpecialOnTop ||
-        rightSortSpecial == SortSpecialOnBottom)
+    for (wchar_t c : label)
     {
-      result = true;
-      return true;
+      if (c == 0)
+        break;
+      c = fold(c);
+      if (c >= 0 && c < 128)
+        asciiUsed[c] = true;
+      else
+        ranks.emplace(c, 0);
+      units++;
     }
+  }
 
-    // otherwise right is sorted above left
-    result = false;
-    return true;
+  std::vector<wchar_t> characters;
+  for (wchar_t c = 0; c < 128; ++c)
+  {
+    if (asciiUsed[c])
+      characters.push_back(c);
   }
-  // both have either sort on top or sort on bottom -> leave as-is
-  else if (leftSortSpecial != SortSpecialNone && leftSortSpecial == rightSortSpecial)
+  for (const auto &rank : ranks)
+    characters.push_back(rank.first);
+
+  // rank the characters the way the locale collates them, characters collating equal share a rank
+  const std::collate<wchar_t>& coll = std::use_facet<std::collate<wchar_t> >(g_langInfo.GetSystemLocale());
+  auto compare = [&coll](wchar_t left, wchar_t right) { return coll.compare(&left, &left + 1, &right, &right + 1); };
+  std::sort(characters.begin(), characters.end(), [&compare](wchar_t left, wchar_t right) { return compare(left, right) < 0; });
+
+  uint32_t rank = 0;
+  for (size_t i = 0; i < characters.size(); ++i)
   {
-    result = false;
-    return true;
+    if (i > 0 && compare(characters[i - 1], characters[i]) != 0)
+      rank++;
+
+    if (characters[i] >= 0 && characters[i] < 128)
+      asciiRanks[characters[i]] = rank;
+    else
+      ranks[characters[i]] = rank;
   }
 
-  if (handleFolder)
+  m_labelUnits.reserve(units);
+  for (size_t i = 0; i < m_labels.size(); ++i)
   {
-    itLeft = left.find(FieldFolder);
-    itRight = right.find(FieldFolder);
-    if (itLeft != left.end() && itRight != right.end() &&
-        itLeft->second.asBoolean() != itRight->second.asBoolean())
+    Key &key = m_keys[i];
+    key.offset = static_cast<uint32_t>(m_labelUnits.size());
+    for (wchar_t c : m_labels[i])
     {
-      result = itLeft->second.asBoolean();
-      return true;
+      if (c == 0)
+        break;
+
+      const wchar_t folded = fold(c);
+      uint32_t unit = (folded >= 0 && folded < 128 ? asciiRanks[folded] : ranks[folded]) << 4;
+      if (c >= L'0' && c <= L'9')
+        unit |= c - L'0' + 1;
+      m_labelUnits.push_back(unit);
     }
+    key.length = static_cast<uint32_t>(m_labelUnits.size()) - key.offset;
   }
 
-  labelLeft = itLeftSort->second.asWideString();
-  labelRight = itRightSort->second.asWideString();
-
-  return false;
+  // the labels aren't needed anymore
+  std::vector<std::wstring>().swap(m_labels);
 }
 
-bool SorterAscending(const SortItem &left, const SortItem &right)
+int64_t CSortKeys::CompareLabels(const Key &left, const Key &right) const
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
+  // same algorithm as StringUtils::AlphaNumericCompare()
+  const uint32_t *l = m_labelUnits.data() + left.offset;
+  const uint32_t *r = m_labelUnits.data() + right.offset;
+  const uint32_t *lEnd = l + left.length;
+  const uint32_t *rEnd = r + right.length;
+  while (l != lEnd && r != rEnd)
+  {
+    // compare numbers by their value
+    if (IsDigit(*l) && IsDigit(*r))
+    {
+      const uint32_t *ld = l;
+      int64_t lnum = 0;
+      while (ld != lEnd && IsDigit(*ld) && ld < l + 15)
+        lnum = lnum * 10 + Digit(*ld++);
+
+      const uint32_t *rd = r;
+      int64_t rnum = 0;
+      while (rd != rEnd && IsDigit(*rd) && rd < r + 15)
+        rnum = rnum * 10 + Digit(*rd++);
+
+      if (lnum != rnum)
+        return lnum - rnum;
+
+      l = ld;
+      r = rd;
+      continue;
+    }
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
-}
+    if (Rank(*l) != Rank(*r))
+      return Rank(*l) < Rank(*r) ? -1 : 1;
 
-bool SorterDescending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
+    l++;
+    r++;
+  }
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
+  if (r != rEnd)
+    return -1;
+  if (l != lEnd)
+    return 1;
+  return 0;
 }
 
-bool SorterIgnoreFoldersAscending(const SortItem &left, const SortItem &right)
+bool CSortKeys::Less(uint32_t leftIndex, uint32_t rightIndex) const
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
+  const Key &left = m_keys[leftIndex];
+  const Key &right = m_keys[rightIndex];
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
-}
+  // one has a special sort
+  if (left.special != right.special)
+  {
+    // left should be sorted on top or right should be sorted on bottom
+    return left.special == SortSpecialOnTop || right.special == SortSpecialOnBottom;
+  }
+  // both have either sort on top or sort on bottom -> leave as-is
+  if (left.special != SortSpecialNone)
+    return false;
 
-bool SorterIgnoreFoldersDescending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
+  if (m_handleFolders && left.folder >= 0 && right.folder >= 0 && left.folder != right.folder)
+    return left.folder > 0;
 
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
+  const int64_t result = CompareLabels(left, right);
+  return m_descending ? result > 0 : result < 0;
 }
 
-bool SorterIndirectAscending(const SortItemPtr &left, const SortItemPtr &right)
+/*! \brief Consecutive ranges of the values that are sorted or merged independently of each
+ other, by the calling thread and jobs together. Jobs that start after the batch is done leave
+ right away, so they never touch the values or the comparison.
+ */
+template<typename Compare>
+class CSortBatch
 {
-  return SorterAscending(*left, *right);
-}
+public:
+  CSortBatch(std::vector<uint32_t>& values, const Compare& less, bool merge)
+    : m_values(values), m_less(less), m_merge(merge)
+  {
+  }
+
+  //! sort [first, last) or merge its sorted halves [first, middle) and [middle, last)
+  void AddRange(size_t first, size_t middle, size_t last) { m_ranges.push_back({first, middle, last}); }
 
-bool SorterIndirectDescending(const SortItemPtr &left, const SortItemPtr &right)
+  //! handle ranges for as long as there are ranges left
+  void Work()
+  {
+    {
+      CSingleLock lock(m_section);
+      if (m_done)
+        return;
+      m_busy++;
+    }
+
+    Run();
+
+    CSingleLock lock(m_section);
+    if (--m_busy == 0)
+      m_idle.Set();
+  }
+
+  void Run()
+  {
+    auto values = m_values.begin();
+    for (size_t i = m_next++; i < m_ranges.size(); i = m_next++)
+    {
+      const Range& range = m_ranges[i];
+      if (m_merge)
+        std::inplace_merge(values + range.first, values + range.middle, values + range.last, m_less);
+      else
+        std::stable_sort(values + range.first, values + range.last, m_less);
+    }
+  }
+
+  //! wait for the jobs that are working, the ones that didn't start yet won't do anything
+  void Finish()
+  {
+    {
+      CSingleLock lock(m_section);
+      m_done = true;
+      if (m_busy == 0)
+        return;
+      m_idle.Reset();
+    }
+    m_idle.Wait();
+  }
+
+private:
+  struct Range
+  {
+    size_t first;
+    size_t middle;
+    size_t last;
+  };
+
+  std::vector<uint32_t>& m_values;
+  Compare m_less;
+  const bool m_merge;
+  std::vector<Range> m_ranges;
+  std::atomic<size_t> m_next{0};
+  CCriticalSection m_section;
+  unsigned int m_busy = 0;
+  bool m_done = false;
+  CEvent m_idle;
+};
+
+//! hand the ranges of the batch to the job manager's workers and work on them as well
+template<typename Compare>
+void RunSortBatch(const std::shared_ptr<CSortBatch<Compare>>& batch, size_t ranges)
 {
-  return SorterDescending(*left, *right);
+  for (size_t i = 1; i < ranges; ++i)
+    CJobManager::GetInstance().Submit([batch]() { batch->Work(); }, CJob::PRIORITY_HIGH);
+  batch->Run();
+  batch->Finish();
 }
 
-bool SorterIndirectIgnoreFoldersAscending(const SortItemPtr &left, const SortItemPtr &right)
+template<typename Compare>
+void ParallelStableSort(std::vector<uint32_t> &values, Compare less)
 {
-  return SorterIgnoreFoldersAscending(*left, *right);
+  const unsigned int threads = std::min(std::thread::hardware_concurrency(), ParallelSortMaxThreads);
+  if (values.size() < ParallelSortMinItems || threads < 2)
+  {
+    std::stable_sort(values.begin(), values.end(), less);
+    return;
+  }
+
+  // sort consecutive chunks in parallel and then merge neighbouring chunks until only one
+  // is left, merging keeps equal values in order so the result is the same as stable_sort's
+  std::vector<size_t> bounds;
+  for (unsigned int i = 0; i <= threads; ++i)
+    bounds.push_back(values.size() * i / threads);
+
+  auto sort = std::make_shared<CSortBatch<Compare>>(values, less, false);
+  for (size_t i = 0; i + 1 < bounds.size(); ++i)
+    sort->AddRange(bounds[i], bounds[i + 1], bounds[i + 1]);
+  RunSortBatch(sort, bounds.size() - 1);
+
+  while (bounds.size() > 2)
+  {
+    auto merge = std::make_shared<CSortBatch<Compare>>(values, less, true);
+    std::vector<size_t> merged;
+    for (size_t i = 0; i + 2 < bounds.size(); i += 2)
+    {
+      merge->AddRange(bounds[i], bounds[i + 1], bounds[i + 2]);
+      merged.push_back(bounds[i]);
+    }
+    RunSortBatch(merge, merged.size());
+
+    // an odd chunk at the end is merged in the next round
+    if (bounds.size() % 2 == 0)
+      merged.push_back(bounds[bounds.size() - 2]);
+    merged.push_back(bounds.back());
+    bounds.swap(merged);
+  }
 }
 
-bool SorterIndirectIgnoreFoldersDescending(const SortItemPtr &left, const SortItemPtr &right)
+std::vector<uint32_t> CSortKeys::Sort()
 {
-  return SorterIgnoreFoldersDescending(*left, *right);
+  BuildLabelKeys();
+
+  std::vector<uint32_t> order(m_keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  ParallelStableSort(order, [this](uint32_t left, uint32_t right) { return Less(left, right); });
+
+  return order;
+}
 }
 
 //clang format off
@@ -941,6 +1181,7 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
     if (preparator != NULL)
     {
       Fields sortingFields = GetFieldsForSorting(sortBy);
+      CSortKeys keys(sortOrder, attributes, items.size());
 
       // Prepare the string used for sorting and store it under FieldSort
       for (DatabaseResults::iterator item = items.begin(); item != items.end(); ++item)
@@ -954,11 +1195,19 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
 
         std::wstring sortLabel;
         g_charsetConverter.utf8ToW(preparator(attributes, *item), sortLabel, false);
-        item->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        auto sortField = item->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        if (!sortField.second)
+          sortLabel = sortField.first->second.asWideString();
+        keys.Add(*item, std::move(sortLabel));
       }
 
       // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorter(sortOrder, attributes));
+      std::vector<uint32_t> order = keys.Sort();
+      DatabaseResults sorted;
+      sorted.reserve(items.size());
+      for (uint32_t index : order)
+        sorted.push_back(std::move(items[index]));
+      items.swap(sorted);
     }
   }
 
@@ -980,6 +1229,7 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
     if (preparator != NULL)
     {
       Fields sortingFields = GetFieldsForSorting(sortBy);
+      CSortKeys keys(sortOrder, attributes, items.size());
 
       // Prepare the string used for sorting and store it under FieldSort
       for (SortItems::iterator item = items.begin(); item != items.end(); ++item)
@@ -993,11 +1243,19 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
 
         std::wstring sortLabel;
         g_charsetConverter.utf8ToW(preparator(attributes, **item), sortLabel, false);
-        (*item)->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        auto sortField = (*item)->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        if (!sortField.second)
+          sortLabel = sortField.first->second.asWideString();
+        keys.Add(**item, std::move(sortLabel));
       }
 
       // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorterIndirect(sortOrder, attributes));
+      std::vector<uint32_t> order = keys.Sort();
+      SortItems sorted;
+      sorted.reserve(items.size());
+      for (uint32_t index : order)
+        sorted.push_back(std::move(items[index]));
+      items.swap(sorted);
     }
   }
 
@@ -1050,22 +1308,6 @@ const SortUtils::SortPreparator& SortUtils::getPreparator(SortBy sortBy)
   return m_preparators[SortByNone];
 }
 
-SortUtils::Sorter SortUtils::getSorter(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrderDescending ? SorterIgnoreFoldersDescending : SorterIgnoreFoldersAscending;
-
-  return sortOrder == SortOrderDescending ? SorterDescending : SorterAscending;
-}
-
-SortUtils::SorterIndirect SortUtils::getSorterIndirect(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrderDescending ? SorterIndirectIgnoreFoldersDescending : SorterIndirectIgnoreFoldersAscending;
-
-  return sortOrder == SortOrderDescending ? SorterIndirectDescending : SorterIndirectAscending;
-}
-
 const Fields& SortUtils::GetFieldsForSorting(SortBy sortBy)
 {
   std::map<SortBy, Fields>::const_iterator it = m_sortingFields.find(sortBy);
@@ -8,6 +8,10 @@
 
 #include "Variant.h"
 
+#include <algorithm>
+#include <assert.h>
+#include <map>
+#include <new>
 #include <stdlib.h>
 #include <string.h>
 #include <utility>
@@ -116,6 +120,332 @@ double str2double(const std::wstring &str, double fallback /* = 0.0 */)
   return fallback;
 }
 
+/*!
+ \brief Bump allocator backing a CArenaScope.
+ Memory is never handed back individually, the arena frees all its chunks when it is deleted.
+ The chunks are kept in a side table so that a pointer can be told to belong to the arena
+ without any bookkeeping in the allocations themselves.
+ */
+class CVariant::CArena
+{
+public:
+  explicit CArena(CArena *previous) : m_previous(previous) {}
+
+  ~CArena()
+  {
+    for (const auto& chunk : m_chunks)
+      ::operator delete(reinterpret_cast<void*>(chunk.second));
+  }
+
+  //! innermost arena of the scopes alive on this thread, the outer ones follow through Previous()
+  static CArena *&Top()
+  {
+    static thread_local CArena *top = nullptr;
+    return top;
+  }
+
+  //! arenas of ended scopes that still had live allocations, see CArenaScope
+  static CArena *&Leaked()
+  {
+    static thread_local CArena *leaked = nullptr;
+    return leaked;
+  }
+
+  CArena *Previous() const { return m_previous; }
+  void SetPrevious(CArena *previous) { m_previous = previous; }
+
+  bool IsAllocating() const { return m_heapScopes == 0; }
+  void PushHeapScope() { m_heapScopes++; }
+  void PopHeapScope() { m_heapScopes--; }
+
+  unsigned int Live() const { return m_live; }
+
+  void *Allocate(size_t size)
+  {
+    size = (size + Alignment - 1) & ~(Alignment - 1);
+    if (m_chunk == nullptr || m_used + size > m_chunkSize)
+    {
+      m_chunkSize = size > ChunkSize ? size : ChunkSize;
+      m_chunk = static_cast<char*>(::operator new(m_chunkSize));
+      m_chunks[reinterpret_cast<uintptr_t>(m_chunk) + m_chunkSize] = reinterpret_cast<uintptr_t>(m_chunk);
+      m_used = 0;
+    }
+    void *ptr = m_chunk + m_used;
+    m_used += size;
+    m_live++;
+    return ptr;
+  }
+
+  //! returns false if ptr wasn't allocated from this arena
+  bool Free(void *ptr)
+  {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    const auto chunk = m_chunks.upper_bound(address);
+    if (chunk == m_chunks.end() || address < chunk->second)
+      return false;
+
+    m_live--;
+    return true;
+  }
+
+private:
+  static const size_t Alignment = 16;
+  static const size_t ChunkSize = 64 * 1024;
+
+  CArena *m_previous;
+  std::map<uintptr_t, uintptr_t> m_chunks; ///< start of the chunks by their end
+  char *m_chunk = nullptr;                 ///< the chunk allocations are taken from
+  size_t m_chunkSize = 0;
+  size_t m_used = 0;
+  unsigned int m_live = 0;                 ///< allocations that weren't freed yet
+  unsigned int m_heapScopes = 0;
+};
+
+CVariant::CArenaScope::CArenaScope()
+  : m_arena(new CArena(CArena::Top()))
+{
+  CArena::Top() = m_arena;
+}
+
+CVariant::CArenaScope::~CArenaScope()
+{
+  assert(CArena::Top() == m_arena);
+  CArena::Top() = m_arena->Previous();
+
+  // a value outlived the scope, the memory has to stay until it is freed
+  assert(m_arena->Live() == 0);
+  if (m_arena->Live() > 0)
+  {
+    m_arena->SetPrevious(CArena::Leaked());
+    CArena::Leaked() = m_arena;
+    return;
+  }
+  delete m_arena;
+}
+
+CVariant::CHeapScope::CHeapScope()
+  : m_arena(CArena::Top())
+{
+  if (m_arena)
+    m_arena->PushHeapScope();
+}
+
+CVariant::CHeapScope::~CHeapScope()
+{
+  if (m_arena)
+    m_arena->PopHeapScope();
+}
+
+/*!
+ \brief Members of an object, sorted by key.
+
+ The members live in blocks that never move, so references to members stay valid while
+ other members are added, just like they did with std::map. Lookups go through a flat,
+ sorted index of member pointers. Erased members leave a hole in their block until the
+ object is cleared or destroyed.
+ */
+class CVariant::VariantMap
+{
+public:
+  VariantMap() = default;
+  VariantMap(const VariantMap &rhs);
+  ~VariantMap();
+  VariantMap &operator=(const VariantMap&) = delete;
+
+  static void *operator new(size_t size) { return Allocate(size); }
+  static void operator delete(void *ptr) { Free(ptr); }
+
+  VariantMember* const* begin() const { return m_index; }
+  VariantMember* const* end() const { return m_index + m_size; }
+  unsigned int size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  CVariant &operator[](const std::string &key);
+  const VariantMember *find(const std::string &key) const;
+  void append(const std::string &key, CVariant &&value);
+  void erase(const std::string &key);
+  void clear();
+  bool operator==(const VariantMap &rhs) const;
+
+private:
+  struct alignas(VariantMember) Block
+  {
+    Block *next;
+    unsigned int capacity;
+    unsigned int used;
+    VariantMember *slots() { return reinterpret_cast<VariantMember*>(this + 1); }
+  };
+
+  static void *Allocate(size_t size);
+  static void Free(void *ptr);
+
+  void Reserve(unsigned int count);
+  void *NewSlot() { return m_blocks->slots() + m_blocks->used++; }
+  VariantMember **LowerBound(const std::string &key) const;
+
+  VariantMember **m_index = nullptr;
+  unsigned int m_size = 0;
+  unsigned int m_capacity = 0;
+  Block *m_blocks = nullptr; ///< newest first
+};
+
+void *CVariant::VariantMap::Allocate(size_t size)
+{
+  CArena *arena = CArena::Top();
+  if (arena && arena->IsAllocating())
+    return arena->Allocate(size);
+  return ::operator new(size);
+}
+
+void CVariant::VariantMap::Free(void *ptr)
+{
+  if (!ptr)
+    return;
+
+  for (CArena *arena = CArena::Top(); arena; arena = arena->Previous())
+  {
+    if (arena->Free(ptr))
+      return;
+  }
+
+  CArena *previous = nullptr;
+  for (CArena *arena = CArena::Leaked(); arena; previous = arena, arena = arena->Previous())
+  {
+    if (!arena->Free(ptr))
+      continue;
+
+    if (arena->Live() == 0)
+    {
+      if (previous)
+        previous->SetPrevious(arena->Previous());
+      else
+        CArena::Leaked() = arena->Previous();
+      delete arena;
+    }
+    return;
+  }
+
+  ::operator delete(ptr);
+}
+
+CVariant::VariantMap::VariantMap(const VariantMap &rhs)
+{
+  if (rhs.m_size == 0)
+    return;
+
+  Reserve(rhs.m_size);
+  for (const VariantMember *member : rhs)
+    m_index[m_size++] = new (NewSlot()) VariantMember(*member);
+}
+
+CVariant::VariantMap::~VariantMap()
+{
+  clear();
+  Free(m_index);
+}
+
+void CVariant::VariantMap::Reserve(unsigned int count)
+{
+  // make sure there are count free member slots and room for them in the index
+  unsigned int freeSlots = m_blocks ? m_blocks->capacity - m_blocks->used : 0;
+  if (freeSlots < count)
+  {
+    // grow geometrically but keep blocks small enough not to waste much on holes
+    const unsigned int capacity = std::max(count, std::min(std::max(m_capacity, 4u), 64u));
+    Block *block = static_cast<Block*>(Allocate(sizeof(Block) + capacity * sizeof(VariantMember)));
+    block->next = m_blocks;
+    block->capacity = capacity;
+    block->used = 0;
+    m_blocks = block;
+    freeSlots = capacity;
+  }
+
+  if (m_size + count > m_capacity)
+  {
+    const unsigned int capacity = m_size + freeSlots;
+    VariantMember **index = static_cast<VariantMember**>(Allocate(capacity * sizeof(VariantMember*)));
+    if (m_size > 0)
+      memcpy(index, m_index, m_size * sizeof(VariantMember*));
+    Free(m_index);
+    m_index = index;
+    m_capacity = capacity;
+  }
+}
+
+CVariant::VariantMember **CVariant::VariantMap::LowerBound(const std::string &key) const
+{
+  return std::lower_bound(m_index, m_index + m_size, key,
+                          [](const VariantMember *member, const std::string &key) { return member->first < key; });
+}
+
+CVariant &CVariant::VariantMap::operator[](const std::string &key)
+{
+  VariantMember **it = LowerBound(key);
+  if (it != m_index + m_size && (*it)->first == key)
+    return (*it)->second;
+
+  const size_t position = it - m_index;
+  Reserve(1);
+  it = m_index + position;
+  memmove(it + 1, it, (m_size - position) * sizeof(VariantMember*));
+  *it = new (NewSlot()) VariantMember(key, CVariant());
+  m_size++;
+  return (*it)->second;
+}
+
+const CVariant::VariantMember *CVariant::VariantMap::find(const std::string &key) const
+{
+  VariantMember **it = LowerBound(key);
+  if (it != m_index + m_size && (*it)->first == key)
+    return *it;
+  return nullptr;
+}
+
+void CVariant::VariantMap::append(const std::string &key, CVariant &&value)
+{
+  // only for filling from an already sorted source with unique keys
+  Reserve(1);
+  m_index[m_size++] = new (NewSlot()) VariantMember(key, std::move(value));
+}
+
+void CVariant::VariantMap::erase(const std::string &key)
+{
+  VariantMember **it = LowerBound(key);
+  if (it == m_index + m_size || (*it)->first != key)
+    return;
+
+  (*it)->~VariantMember();
+  memmove(it, it + 1, (m_index + m_size - it - 1) * sizeof(VariantMember*));
+  m_size--;
+}
+
+void CVariant::VariantMap::clear()
+{
+  for (unsigned int i = 0; i < m_size; ++i)
+    m_index[i]->~VariantMember();
+  m_size = 0;
+
+  while (m_blocks)
+  {
+    Block *next = m_blocks->next;
+    Free(m_blocks);
+    m_blocks = next;
+  }
+}
+
+bool CVariant::VariantMap::operator==(const VariantMap &rhs) const
+{
+  if (m_size != rhs.m_size)
+    return false;
+
+  for (unsigned int i = 0; i < m_size; ++i)
+  {
+    if (m_index[i]->first != rhs.m_index[i]->first || m_index[i]->second != rhs.m_index[i]->second)
+      return false;
+  }
+  return true;
+}
+
 CVariant::CVariant()
   : CVariant(VariantTypeNull)
 {
@@ -123,7 +453,6 @@ CVariant::CVariant()
 
 CVariant CVariant::ConstNullVariant = CVariant::VariantTypeConstNull;
 CVariant::VariantArray CVariant::EMPTY_ARRAY;
-CVariant::VariantMap CVariant::EMPTY_MAP;
 
 CVariant::CVariant(VariantType type)
 {
@@ -267,13 +596,15 @@ CVariant::CVariant(const std::map<std::string, std::string> &strMap)
   m_type = VariantTypeObject;
   m_data.map = new VariantMap;
   for (std::map<std::string, std::string>::const_iterator it = strMap.begin(); it != strMap.end(); ++it)
-    m_data.map->insert(make_pair(it->first, CVariant(it->second)));
+    m_data.map->append(it->first, CVariant(it->second));
 }
 
 CVariant::CVariant(const std::map<std::string, CVariant> &variantMap)
 {
   m_type = VariantTypeObject;
-  m_data.map = new VariantMap(variantMap.begin(), variantMap.end());
+  m_data.map = new VariantMap;
+  for (std::map<std::string, CVariant>::const_iterator it = variantMap.begin(); it != variantMap.end(); ++it)
+    m_data.map->append(it->first, CVariant(it->second));
 }
 
 CVariant::CVariant(const CVariant &variant)
@@ -559,9 +890,9 @@ CVariant &CVariant::operator[](const std::string &key)
 
 const CVariant &CVariant::operator[](const std::string &key) const
 {
-  VariantMap::const_iterator it;
-  if (m_type == VariantTypeObject && (it = m_data.map->find(key)) != m_data.map->end())
-    return it->second;
+  const VariantMember *member;
+  if (m_type == VariantTypeObject && (member = m_data.map->find(key)) != nullptr)
+    return member->second;
   else
     return ConstNullVariant;
 }
@@ -615,7 +946,7 @@ CVariant &CVariant::operator=(const CVariant &rhs)
     m_data.array = new VariantArray(rhs.m_data.array->begin(), rhs.m_data.array->end());
     break;
   case VariantTypeObject:
-    m_data.map = new VariantMap(rhs.m_data.map->begin(), rhs.m_data.map->end());
+    m_data.map = new VariantMap(*rhs.m_data.map);
     break;
   default:
     break;
@@ -771,33 +1102,33 @@ CVariant::const_iterator_array CVariant::end_array() const
 CVariant::iterator_map CVariant::begin_map()
 {
   if (m_type == VariantTypeObject)
-    return m_data.map->begin();
+    return iterator_map(m_data.map->begin());
   else
-    return EMPTY_MAP.begin();
+    return iterator_map();
 }
 
 CVariant::const_iterator_map CVariant::begin_map() const
 {
   if (m_type == VariantTypeObject)
-    return m_data.map->begin();
+    return const_iterator_map(m_data.map->begin());
   else
-    return EMPTY_MAP.begin();
+    return const_iterator_map();
 }
 
 CVariant::iterator_map CVariant::end_map()
 {
   if (m_type == VariantTypeObject)
-    return m_data.map->end();
+    return iterator_map(m_data.map->end());
   else
-    return EMPTY_MAP.end();
+    return iterator_map();
 }
 
 CVariant::const_iterator_map CVariant::end_map() const
 {
   if (m_type == VariantTypeObject)
-    return m_data.map->end();
+    return const_iterator_map(m_data.map->end());
   else
-    return EMPTY_MAP.end();
+    return const_iterator_map();
 }
 
 unsigned int CVariant::size() const
@@ -868,7 +1199,7 @@ void CVariant::erase(unsigned int position)
 bool CVariant::isMember(const std::string &key) const
 {
   if (m_type == VariantTypeObject)
-    return m_data.map->find(key) != m_data.map->end();
+    return m_data.map->find(key) != nullptr;
 
   return false;
 }
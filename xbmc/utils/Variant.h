@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include <iterator>
 #include <map>
 #include <stdint.h>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <wchar.h>
 
@@ -113,14 +116,89 @@ public:
 
 private:
   typedef std::vector<CVariant> VariantArray;
-  typedef std::map<std::string, CVariant> VariantMap;
+  typedef std::pair<const std::string, CVariant> VariantMember;
+  class VariantMap;
+  class CArena;
+
+  /*!
+   \brief Iterator over the members of an object, in key order.
+   Walks the sorted member index of the object, dereferencing to the member itself.
+   */
+  template<typename T>
+  class CMemberIterator
+  {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+
+    CMemberIterator() = default;
+    explicit CMemberIterator(VariantMember* const* slot) : m_slot(slot) {}
+    template<typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+    CMemberIterator(const CMemberIterator<U>& other) : m_slot(other.m_slot) {}
+
+    reference operator*() const { return **m_slot; }
+    pointer operator->() const { return *m_slot; }
+    CMemberIterator& operator++() { ++m_slot; return *this; }
+    CMemberIterator operator++(int) { CMemberIterator tmp(*this); ++m_slot; return tmp; }
+    CMemberIterator& operator--() { --m_slot; return *this; }
+    CMemberIterator operator--(int) { CMemberIterator tmp(*this); --m_slot; return tmp; }
+    bool operator==(const CMemberIterator& rhs) const { return m_slot == rhs.m_slot; }
+    bool operator!=(const CMemberIterator& rhs) const { return m_slot != rhs.m_slot; }
+
+  private:
+    template<typename> friend class CMemberIterator;
+    VariantMember* const* m_slot = nullptr;
+  };
 
 public:
   typedef VariantArray::iterator        iterator_array;
   typedef VariantArray::const_iterator  const_iterator_array;
 
-  typedef VariantMap::iterator          iterator_map;
-  typedef VariantMap::const_iterator    const_iterator_map;
+  typedef CMemberIterator<VariantMember>       iterator_map;
+  typedef CMemberIterator<const VariantMember> const_iterator_map;
+
+  /*!
+   \brief Lets all objects created on this thread share one arena while in scope.
+
+   Object storage of variants created while the scope is alive is taken from a single arena
+   instead of separate heap allocations, and the arena is released as a whole when the scope
+   ends. It is meant for large, short lived trees that are thrown away together.
+
+   Every variant whose object storage came from the arena must be destroyed before the scope
+   ends and on the thread that opened it. Values that have to outlive the scope are copied out
+   under a CHeapScope. Debug builds assert this when the scope ends, release builds leak the
+   arena instead of freeing memory that is still in use.
+   */
+  class CArenaScope
+  {
+  public:
+    CArenaScope();
+    ~CArenaScope();
+    CArenaScope(const CArenaScope&) = delete;
+    CArenaScope& operator=(const CArenaScope&) = delete;
+
+  private:
+    CArena *m_arena;
+  };
+
+  /*!
+   \brief Makes objects created on this thread use the heap again while in scope, even though
+   a CArenaScope is still alive. Objects from the arena can still be read and freed meanwhile.
+   */
+  class CHeapScope
+  {
+  public:
+    CHeapScope();
+    ~CHeapScope();
+    CHeapScope(const CHeapScope&) = delete;
+    CHeapScope& operator=(const CHeapScope&) = delete;
+
+  private:
+    CArena *m_arena;
+  };
 
   iterator_array begin_array();
   const_iterator_array begin_array() const;
@@ -144,6 +222,7 @@ public:
 
 private:
   void cleanup();
+
   union VariantUnion
   {
     int64_t integer;
@@ -160,7 +239,6 @@ private:
   VariantUnion m_data;
 
   static VariantArray EMPTY_ARRAY;
-  static VariantMap EMPTY_MAP;
 };
 
 #ifdef TARGET_WINDOWS_STORE
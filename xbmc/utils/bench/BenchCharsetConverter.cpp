@@ -0,0 +1,67 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BenchData.h"
+#include "utils/CharsetConverter.h"
+
+#include <benchmark/benchmark.h>
+
+static void BM_CharsetConverter_utf8ToW(benchmark::State& state)
+{
+  const std::vector<std::string>& titles = BenchData::Titles();
+  for (auto _ : state)
+  {
+    for (const std::string& title : titles)
+    {
+      std::wstring result;
+      g_charsetConverter.utf8ToW(title, result, false);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * titles.size());
+}
+BENCHMARK(BM_CharsetConverter_utf8ToW);
+
+static void BM_CharsetConverter_wToUTF8(benchmark::State& state)
+{
+  std::vector<std::wstring> titles;
+  for (const std::string& title : BenchData::Titles())
+  {
+    std::wstring wtitle;
+    g_charsetConverter.utf8ToW(title, wtitle, false);
+    titles.push_back(wtitle);
+  }
+
+  for (auto _ : state)
+  {
+    for (const std::wstring& title : titles)
+    {
+      std::string result;
+      g_charsetConverter.wToUTF8(title, result);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * titles.size());
+}
+BENCHMARK(BM_CharsetConverter_wToUTF8);
+
+static void BM_CharsetConverter_utf8ToUtf32(benchmark::State& state)
+{
+  const std::vector<std::string>& titles = BenchData::Titles();
+  for (auto _ : state)
+  {
+    for (const std::string& title : titles)
+    {
+      std::u32string result;
+      g_charsetConverter.utf8ToUtf32(title, result);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * titles.size());
+}
+BENCHMARK(BM_CharsetConverter_utf8ToUtf32);
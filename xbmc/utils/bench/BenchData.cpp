@@ -0,0 +1,164 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BenchData.h"
+
+#include "utils/StringUtils.h"
+
+#include <stdint.h>
+
+namespace
+{
+// simple LCG so the data is identical on every platform and standard library
+class CBenchRandom
+{
+public:
+  explicit CBenchRandom(uint32_t seed) : m_state(seed) {}
+  uint32_t Next(uint32_t range)
+  {
+    m_state = m_state * 1664525u + 1013904223u;
+    return (m_state >> 8) % range;
+  }
+private:
+  uint32_t m_state;
+};
+
+const char* const Words[] = {
+  "Night", "Return", "Star", "Empire", "Lost", "City", "Dark", "River", "Last", "King",
+  "Summer", "Ghost", "Island", "Iron", "Silent", "Road", "Winter", "Shadow", "Garden", "Storm",
+  "Über", "Café", "Noël", "Fjörd", "Amélie", "Señor", "Zoë", "Ærø"
+};
+const char* const Articles[] = { "", "", "", "The ", "A ", "An " };
+const char* const Roots[] = {
+  "/home/user/Videos/Movies/", "smb://nas/media/movies/", "nfs://192.168.1.10/export/video/",
+  "http://server:8080/library/", "/storage/TV Shows/"
+};
+const char* const Extensions[] = { ".mkv", ".mp4", ".avi", ".m2ts", ".iso" };
+
+template<typename T, size_t N>
+constexpr uint32_t Count(T (&)[N])
+{
+  return N;
+}
+}
+
+const std::vector<std::string>& BenchData::Titles()
+{
+  static const std::vector<std::string> titles = []
+  {
+    CBenchRandom random(0x4b4f4449);
+    std::vector<std::string> result;
+    result.reserve(LibrarySize);
+    for (unsigned int i = 0; i < LibrarySize; ++i)
+    {
+      std::string title = Articles[random.Next(Count(Articles))];
+      const uint32_t words = 1 + random.Next(4);
+      for (uint32_t w = 0; w < words; ++w)
+      {
+        if (w > 0)
+          title += ' ';
+        title += Words[random.Next(Count(Words))];
+      }
+      if (random.Next(4) == 0)
+        title += StringUtils::Format(" %u", 1 + random.Next(12));
+      result.push_back(title);
+    }
+    return result;
+  }();
+  return titles;
+}
+
+const std::vector<std::string>& BenchData::Paths()
+{
+  static const std::vector<std::string> paths = []
+  {
+    CBenchRandom random(0x50415448);
+    const std::vector<std::string>& titles = Titles();
+    std::vector<std::string> result;
+    result.reserve(LibrarySize);
+    for (unsigned int i = 0; i < LibrarySize; ++i)
+    {
+      std::string path = Roots[random.Next(Count(Roots))];
+      path += titles[i] + StringUtils::Format(" (%u)/", 1950 + random.Next(70));
+      path += StringUtils::Format("%s.S%02uE%02u.1080p", titles[i].c_str(), 1 + random.Next(10),
+                                  1 + random.Next(24));
+      path += Extensions[random.Next(Count(Extensions))];
+      result.push_back(path);
+    }
+    return result;
+  }();
+  return paths;
+}
+
+const std::vector<std::string>& BenchData::Dates()
+{
+  static const std::vector<std::string> dates = []
+  {
+    CBenchRandom random(0x44415445);
+    std::vector<std::string> result;
+    result.reserve(LibrarySize);
+    for (unsigned int i = 0; i < LibrarySize; ++i)
+      result.push_back(StringUtils::Format("%04u-%02u-%02u %02u:%02u:%02u", 2000 + random.Next(21),
+                                           1 + random.Next(12), 1 + random.Next(28),
+                                           random.Next(24), random.Next(60), random.Next(60)));
+    return result;
+  }();
+  return dates;
+}
+
+const std::string& BenchData::LibraryJson()
+{
+  static const std::string json = []
+  {
+    const std::vector<std::string>& titles = Titles();
+    const std::vector<std::string>& paths = Paths();
+    const std::vector<std::string>& dates = Dates();
+    std::string result = "{\"limits\":{\"start\":0,\"end\":" + std::to_string(LibrarySize) +
+                         ",\"total\":" + std::to_string(LibrarySize) + "},\"movies\":[";
+    for (unsigned int i = 0; i < LibrarySize; ++i)
+    {
+      if (i > 0)
+        result += ',';
+      result += StringUtils::Format("{\"movieid\":%u,\"label\":\"%s\",\"title\":\"%s\",\"file\":\"%s\","
+                                    "\"dateadded\":\"%s\",\"rating\":%.1f,\"playcount\":%u,"
+                                    "\"genre\":[\"Drama\",\"Action\"],\"runtime\":%u}",
+                                    i + 1, titles[i].c_str(), titles[i].c_str(), paths[i].c_str(),
+                                    dates[i].c_str(), (i % 100) / 10.0, i % 3, 5400 + i % 3600);
+    }
+    result += "]}";
+    return result;
+  }();
+  return json;
+}
+
+const std::string& BenchData::LibraryXml()
+{
+  static const std::string xml = []
+  {
+    const std::vector<std::string>& titles = Titles();
+    const std::vector<std::string>& paths = Paths();
+    const std::vector<std::string>& dates = Dates();
+    std::string result = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<videodb>\n";
+    for (unsigned int i = 0; i < LibrarySize; ++i)
+    {
+      result += StringUtils::Format("  <movie id=\"%u\">\n"
+                                    "    <title>%s</title>\n"
+                                    "    <filenameandpath>%s</filenameandpath>\n"
+                                    "    <dateadded>%s</dateadded>\n"
+                                    "    <ratings><rating name=\"default\" max=\"10\"><value>%.1f</value></rating></ratings>\n"
+                                    "    <genre>Drama</genre>\n"
+                                    "    <genre>Action</genre>\n"
+                                    "  </movie>\n",
+                                    i + 1, titles[i].c_str(), paths[i].c_str(), dates[i].c_str(),
+                                    (i % 100) / 10.0);
+    }
+    result += "</videodb>\n";
+    return result;
+  }();
+  return xml;
+}
@@ -0,0 +1,43 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ \brief Synthetic datasets shared by the benchmarks.
+
+ All data is generated from a fixed seed and sized like a large library, so results
+ of different runs and builds can be compared. Every dataset is built once on first use.
+ */
+namespace BenchData
+{
+/*! \brief Number of items in the synthetic library */
+constexpr unsigned int LibrarySize = 20000;
+
+/*! \brief Item titles, some with leading articles, digits and non-ASCII characters */
+const std::vector<std::string>& Titles();
+
+/*! \brief Item file paths, a mix of local, smb://, nfs:// and http:// locations */
+const std::vector<std::string>& Paths();
+
+/*! \brief Date added of the items in database format (YYYY-MM-DD hh:mm:ss) */
+const std::vector<std::string>& Dates();
+
+/*! \brief A VideoLibrary.GetMovies style JSON-RPC result holding all items */
+const std::string& LibraryJson();
+
+/*! \brief An nfo style XML document holding all items */
+const std::string& LibraryXml();
+
+/*! \brief Number of heap allocations made by the process so far */
+uint64_t AllocationCount();
+}
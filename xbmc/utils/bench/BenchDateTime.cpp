@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BenchData.h"
+#include "XBDateTime.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+std::vector<CDateTime> CreateDates()
+{
+  std::vector<CDateTime> dates;
+  for (const std::string& date : BenchData::Dates())
+  {
+    CDateTime dateTime;
+    dateTime.SetFromDBDateTime(date);
+    dates.push_back(dateTime);
+  }
+  return dates;
+}
+}
+
+static void BM_DateTime_SetFromDBDateTime(benchmark::State& state)
+{
+  const std::vector<std::string>& dates = BenchData::Dates();
+  for (auto _ : state)
+  {
+    for (const std::string& date : dates)
+    {
+      CDateTime dateTime;
+      benchmark::DoNotOptimize(dateTime.SetFromDBDateTime(date));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * dates.size());
+}
+BENCHMARK(BM_DateTime_SetFromDBDateTime);
+
+static void BM_DateTime_GetAsDBDateTime(benchmark::State& state)
+{
+  const std::vector<CDateTime> dates = CreateDates();
+  for (auto _ : state)
+  {
+    for (const CDateTime& date : dates)
+      benchmark::DoNotOptimize(date.GetAsDBDateTime());
+  }
+  state.SetItemsProcessed(state.iterations() * dates.size());
+}
+BENCHMARK(BM_DateTime_GetAsDBDateTime);
+
+static void BM_DateTime_GetAsW3CDateTime(benchmark::State& state)
+{
+  const std::vector<CDateTime> dates = CreateDates();
+  for (auto _ : state)
+  {
+    for (const CDateTime& date : dates)
+      benchmark::DoNotOptimize(date.GetAsW3CDateTime());
+  }
+  state.SetItemsProcessed(state.iterations() * dates.size());
+}
+BENCHMARK(BM_DateTime_GetAsW3CDateTime);
+
+static void BM_DateTime_GetAsLocalizedDate(benchmark::State& state)
+{
+  const std::vector<CDateTime> dates = CreateDates();
+  const std::string format("dd-mm-yyyy");
+  for (auto _ : state)
+  {
+    for (const CDateTime& date : dates)
+      benchmark::DoNotOptimize(date.GetAsLocalizedDate(format));
+  }
+  state.SetItemsProcessed(state.iterations() * dates.size());
+}
+BENCHMARK(BM_DateTime_GetAsLocalizedDate);
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BenchData.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/Variant.h"
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+static void BM_JSONVariantParser_Parse(benchmark::State& state)
+{
+  const std::string& json = BenchData::LibraryJson();
+  const bool useArena = state.range(0) != 0;
+
+  const uint64_t allocations = BenchData::AllocationCount();
+  for (auto _ : state)
+  {
+    std::unique_ptr<CVariant::CArenaScope> arena;
+    if (useArena)
+      arena.reset(new CVariant::CArenaScope);
+
+    CVariant result;
+    CJSONVariantParser::Parse(json, result);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["allocs"] = benchmark::Counter(static_cast<double>(BenchData::AllocationCount() - allocations),
+                                                benchmark::Counter::kAvgIterations);
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JSONVariantParser_Parse)->ArgName("arena")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_JSONVariantWriter_Write(benchmark::State& state)
+{
+  CVariant library;
+  CJSONVariantParser::Parse(BenchData::LibraryJson(), library);
+  const bool compact = state.range(0) != 0;
+
+  for (auto _ : state)
+  {
+    std::string output;
+    CJSONVariantWriter::Write(library, output, compact);
+    benchmark::DoNotOptimize(output);
+  }
+  state.SetBytesProcessed(state.iterations() * BenchData::LibraryJson().size());
+}
+BENCHMARK(BM_JSONVariantWriter_Write)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
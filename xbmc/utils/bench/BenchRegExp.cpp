@@ -0,0 +1,66 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BenchData.h"
+#include "utils/RegExp.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// default tvshowmatching expression of the advanced settings
+const char* const EpisodeRegExp = "s([0-9]+)[ ._x-]*e([0-9]+(?:(?:[a-i]|\\.[1-9])(?![0-9]))?)";
+}
+
+static void BM_RegExp_Compile(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    CRegExp reg(true, CRegExp::autoUtf8);
+    benchmark::DoNotOptimize(reg.RegComp(EpisodeRegExp));
+  }
+}
+BENCHMARK(BM_RegExp_Compile);
+
+static void BM_RegExp_Find(benchmark::State& state)
+{
+  const std::vector<std::string>& paths = BenchData::Paths();
+  CRegExp reg(true, CRegExp::autoUtf8);
+  reg.RegComp(EpisodeRegExp, state.range(0) ? CRegExp::StudyRegExp : CRegExp::NoStudy);
+
+  for (auto _ : state)
+  {
+    unsigned int matches = 0;
+    for (const std::string& path : paths)
+    {
+      if (reg.RegFind(path) >= 0)
+        matches++;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() * paths.size());
+}
+BENCHMARK(BM_RegExp_Find)->Arg(0)->Arg(1);
+
+static void BM_RegExp_GetMatch(benchmark::State& state)
+{
+  const std::vector<std::string>& paths = BenchData::Paths();
+  CRegExp reg(true, CRegExp::autoUtf8);
+  reg.RegComp(EpisodeRegExp, CRegExp::StudyRegExp);
+
+  for (auto _ : state)
+  {
+    for (const std::string& path : paths)
+    {
+      if (reg.RegFind(path) >= 0)
+        benchmark::DoNotOptimize(reg.GetMatch(2));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * paths.size());
+}
+BENCHMARK(BM_RegExp_GetMatch);
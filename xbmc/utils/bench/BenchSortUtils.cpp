@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BenchData.h"
+#include "utils/SortUtils.h"
+#include "utils/Variant.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+SortItems CreateItems()
+{
+  SortItems items;
+  items.reserve(BenchData::LibrarySize);
+  for (unsigned int i = 0; i < BenchData::LibrarySize; ++i)
+  {
+    SortItemPtr item(new SortItem());
+    (*item)[FieldLabel] = BenchData::Titles()[i];
+    (*item)[FieldTitle] = BenchData::Titles()[i];
+    (*item)[FieldPath] = BenchData::Paths()[i];
+    (*item)[FieldDateAdded] = BenchData::Dates()[i];
+    (*item)[FieldYear] = 1950 + i % 70;
+    items.push_back(item);
+  }
+  return items;
+}
+
+void SortBenchmark(benchmark::State& state, SortBy sortBy, SortAttribute attributes)
+{
+  const SortItems items = CreateItems();
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    SortItems sorted(items);
+    state.ResumeTiming();
+    SortUtils::Sort(sortBy, SortOrderAscending, attributes, sorted);
+    benchmark::DoNotOptimize(sorted);
+  }
+  state.SetItemsProcessed(state.iterations() * items.size());
+}
+}
+
+static void BM_SortUtils_SortByTitle(benchmark::State& state)
+{
+  SortBenchmark(state, SortByTitle, SortAttributeIgnoreArticle);
+}
+BENCHMARK(BM_SortUtils_SortByTitle)->Unit(benchmark::kMillisecond);
+
+static void BM_SortUtils_SortByLabel(benchmark::State& state)
+{
+  SortBenchmark(state, SortByLabel, SortAttributeNone);
+}
+BENCHMARK(BM_SortUtils_SortByLabel)->Unit(benchmark::kMillisecond);
+
+static void BM_SortUtils_SortByFile(benchmark::State& state)
+{
+  SortBenchmark(state, SortByFile, SortAttributeNone);
+}
+BENCHMARK(BM_SortUtils_SortByFile)->Unit(benchmark::kMillisecond);
+
+static void BM_SortUtils_SortByDateAdded(benchmark::State& state)
+{
+  SortBenchmark(state, SortByDateAdded, SortAttributeNone);
+}
+BENCHMARK(BM_SortUtils_SortByDateAdded)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BenchData.h"
+#include "utils/StringUtils.h"
+
+#include <benchmark/benchmark.h>
+
+static void BM_StringUtils_ToLower(benchmark::State& state)
+{
+  const std::vector<std::string>& titles = BenchData::Titles();
+  for (auto _ : state)
+  {
+    for (std::string title : titles)
+    {
+      StringUtils::ToLower(title);
+      benchmark::DoNotOptimize(title);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * titles.size());
+}
+BENCHMARK(BM_StringUtils_ToLower);
+
+static void BM_StringUtils_EqualsNoCase(benchmark::State& state)
+{
+  const std::vector<std::string>& titles = BenchData::Titles();
+  for (auto _ : state)
+  {
+    unsigned int matches = 0;
+    for (size_t i = 1; i < titles.size(); ++i)
+    {
+      if (StringUtils::EqualsNoCase(titles[i - 1], titles[i]))
+        matches++;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() * titles.size());
+}
+BENCHMARK(BM_StringUtils_EqualsNoCase);
+
+static void BM_StringUtils_AlphaNumericCompare(benchmark::State& state)
+{
+  const std::vector<std::string>& titles = BenchData::Titles();
+  std::vector<std::wstring> wtitles;
+  for (const std::string& title : titles)
+    wtitles.push_back(std::wstring(title.begin(), title.end()));
+
+  for (auto _ : state)
+  {
+    int64_t result = 0;
+    for (size_t i = 1; i < wtitles.size(); ++i)
+      result += StringUtils::AlphaNumericCompare(wtitles[i - 1].c_str(), wtitles[i].c_str());
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * titles.size());
+}
+BENCHMARK(BM_StringUtils_AlphaNumericCompare);
+
+static void BM_StringUtils_Split(benchmark::State& state)
+{
+  const std::vector<std::string>& paths = BenchData::Paths();
+  for (auto _ : state)
+  {
+    for (const std::string& path : paths)
+      benchmark::DoNotOptimize(StringUtils::Split(path, "/"));
+  }
+  state.SetItemsProcessed(state.iterations() * paths.size());
+}
+BENCHMARK(BM_StringUtils_Split);
+
+static void BM_StringUtils_Replace(benchmark::State& state)
+{
+  const std::vector<std::string>& paths = BenchData::Paths();
+  for (auto _ : state)
+  {
+    for (std::string path : paths)
+    {
+      StringUtils::Replace(path, "/", "\\");
+      benchmark::DoNotOptimize(path);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * paths.size());
+}
+BENCHMARK(BM_StringUtils_Replace);
+
+static void BM_StringUtils_Format(benchmark::State& state)
+{
+  const std::vector<std::string>& titles = BenchData::Titles();
+  for (auto _ : state)
+  {
+    for (size_t i = 0; i < titles.size(); ++i)
+      benchmark::DoNotOptimize(StringUtils::Format("%s - S%02uE%02u", titles[i].c_str(),
+                                                   static_cast<unsigned int>(i % 10),
+                                                   static_cast<unsigned int>(i % 24)));
+  }
+  state.SetItemsProcessed(state.iterations() * titles.size());
+}
+BENCHMARK(BM_StringUtils_Format);
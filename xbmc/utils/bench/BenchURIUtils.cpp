@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BenchData.h"
+#include "utils/URIUtils.h"
+
+#include <benchmark/benchmark.h>
+
+static void BM_URIUtils_GetExtension(benchmark::State& state)
+{
+  const std::vector<std::string>& paths = BenchData::Paths();
+  for (auto _ : state)
+  {
+    for (const std::string& path : paths)
+      benchmark::DoNotOptimize(URIUtils::GetExtension(path));
+  }
+  state.SetItemsProcessed(state.iterations() * paths.size());
+}
+BENCHMARK(BM_URIUtils_GetExtension);
+
+static void BM_URIUtils_GetFileName(benchmark::State& state)
+{
+  const std::vector<std::string>& paths = BenchData::Paths();
+  for (auto _ : state)
+  {
+    for (const std::string& path : paths)
+      benchmark::DoNotOptimize(URIUtils::GetFileName(path));
+  }
+  state.SetItemsProcessed(state.iterations() * paths.size());
+}
+BENCHMARK(BM_URIUtils_GetFileName);
+
+static void BM_URIUtils_GetParentPath(benchmark::State& state)
+{
+  const std::vector<std::string>& paths = BenchData::Paths();
+  for (auto _ : state)
+  {
+    for (const std::string& path : paths)
+      benchmark::DoNotOptimize(URIUtils::GetParentPath(path));
+  }
+  state.SetItemsProcessed(state.iterations() * paths.size());
+}
+BENCHMARK(BM_URIUtils_GetParentPath);
+
+static void BM_URIUtils_AddFileToFolder(benchmark::State& state)
+{
+  const std::vector<std::string>& paths = BenchData::Paths();
+  for (auto _ : state)
+  {
+    for (const std::string& path : paths)
+      benchmark::DoNotOptimize(URIUtils::AddFileToFolder(URIUtils::GetDirectory(path), "poster.jpg"));
+  }
+  state.SetItemsProcessed(state.iterations() * paths.size());
+}
+BENCHMARK(BM_URIUtils_AddFileToFolder);
+
+static void BM_URIUtils_PathHasParent(benchmark::State& state)
+{
+  const std::vector<std::string>& paths = BenchData::Paths();
+  for (auto _ : state)
+  {
+    unsigned int matches = 0;
+    for (const std::string& path : paths)
+    {
+      if (URIUtils::PathHasParent(path, "smb://nas/media/movies/"))
+        matches++;
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() * paths.size());
+}
+BENCHMARK(BM_URIUtils_PathHasParent);
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BenchData.h"
+#include "utils/Variant.h"
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+CVariant CreateMovie(unsigned int index)
+{
+  CVariant movie(CVariant::VariantTypeObject);
+  movie["movieid"] = index + 1;
+  movie["label"] = BenchData::Titles()[index];
+  movie["title"] = BenchData::Titles()[index];
+  movie["file"] = BenchData::Paths()[index];
+  movie["dateadded"] = BenchData::Dates()[index];
+  movie["rating"] = (index % 100) / 10.0;
+  movie["playcount"] = index % 3;
+  movie["genre"].push_back("Drama");
+  movie["genre"].push_back("Action");
+  return movie;
+}
+
+// heap allocations per iteration since start
+void ReportAllocations(benchmark::State& state, uint64_t start)
+{
+  state.counters["allocs"] = benchmark::Counter(static_cast<double>(BenchData::AllocationCount() - start),
+                                                benchmark::Counter::kAvgIterations);
+}
+}
+
+static void BM_Variant_CreateObjects(benchmark::State& state)
+{
+  const bool useArena = state.range(0) != 0;
+  // build the datasets up front so they don't show up in the allocation count
+  BenchData::Titles();
+  BenchData::Paths();
+  BenchData::Dates();
+
+  const uint64_t allocations = BenchData::AllocationCount();
+  for (auto _ : state)
+  {
+    std::unique_ptr<CVariant::CArenaScope> arena;
+    if (useArena)
+      arena.reset(new CVariant::CArenaScope);
+
+    CVariant movies(CVariant::VariantTypeArray);
+    for (unsigned int i = 0; i < BenchData::LibrarySize; ++i)
+      movies.push_back(CreateMovie(i));
+    benchmark::DoNotOptimize(movies);
+  }
+  ReportAllocations(state, allocations);
+  state.SetItemsProcessed(state.iterations() * BenchData::LibrarySize);
+}
+BENCHMARK(BM_Variant_CreateObjects)->ArgName("arena")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_Variant_Copy(benchmark::State& state)
+{
+  CVariant movies(CVariant::VariantTypeArray);
+  for (unsigned int i = 0; i < BenchData::LibrarySize; ++i)
+    movies.push_back(CreateMovie(i));
+
+  const uint64_t allocations = BenchData::AllocationCount();
+  for (auto _ : state)
+  {
+    CVariant copy(movies);
+    benchmark::DoNotOptimize(copy);
+  }
+  ReportAllocations(state, allocations);
+  state.SetItemsProcessed(state.iterations() * BenchData::LibrarySize);
+}
+BENCHMARK(BM_Variant_Copy)->Unit(benchmark::kMillisecond);
+
+static void BM_Variant_Lookup(benchmark::State& state)
+{
+  CVariant movies(CVariant::VariantTypeArray);
+  for (unsigned int i = 0; i < BenchData::LibrarySize; ++i)
+    movies.push_back(CreateMovie(i));
+
+  for (auto _ : state)
+  {
+    int64_t total = 0;
+    for (CVariant::const_iterator_array it = movies.begin_array(); it != movies.end_array(); ++it)
+    {
+      total += (*it)["movieid"].asInteger();
+      total += (*it)["title"].asString().size();
+      total += (*it)["genre"].size();
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * BenchData::LibrarySize);
+}
+BENCHMARK(BM_Variant_Lookup)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (C) 2005-2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "BenchData.h"
+#include "utils/XBMCTinyXML.h"
+
+#include <cstring>
+
+#include <benchmark/benchmark.h>
+
+static void BM_XBMCTinyXML_Parse(benchmark::State& state)
+{
+  const std::string& xml = BenchData::LibraryXml();
+  for (auto _ : state)
+  {
+    CXBMCTinyXML doc;
+    benchmark::DoNotOptimize(doc.Parse(xml, TIXML_ENCODING_UTF8));
+  }
+  state.SetBytesProcessed(state.iterations() * xml.size());
+}
+BENCHMARK(BM_XBMCTinyXML_Parse)->Unit(benchmark::kMillisecond);
+
+static void BM_XBMCTinyXML_Walk(benchmark::State& state)
+{
+  CXBMCTinyXML doc;
+  doc.Parse(BenchData::LibraryXml(), TIXML_ENCODING_UTF8);
+
+  for (auto _ : state)
+  {
+    size_t total = 0;
+    const TiXmlElement* movie = doc.RootElement()->FirstChildElement("movie");
+    while (movie)
+    {
+      const TiXmlElement* title = movie->FirstChildElement("title");
+      if (title && title->FirstChild())
+        total += std::strlen(title->FirstChild()->Value());
+      movie = movie->NextSiblingElement("movie");
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * BenchData::LibrarySize);
+}
+BENCHMARK(BM_XBMCTinyXML_Walk);
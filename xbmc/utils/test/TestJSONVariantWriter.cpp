@@ -149,3 +149,33 @@ TEST(TestJSONVariantWriter, CanWriteArray)
   ASSERT_TRUE(CJSONVariantWriter::Write(variant, str, false));
   ASSERT_STREQ("[\n\t{\n\t\t\"foo\": \"bar\"\n\t}\n]", str.c_str());
 }
+
+TEST(TestJSONVariantWriter, CanWriteStream)
+{
+  CVariant variant;
+  variant["foo"]["sub-foo"] = "bar";
+  variant["bar"].push_back(true);
+  variant["bar"].push_back(CVariant(CVariant::VariantTypeObject));
+  variant["bar"].push_back(1.5);
+
+  for (bool compact : { true, false })
+  {
+    std::string expected;
+    ASSERT_TRUE(CJSONVariantWriter::Write(variant, expected, compact));
+
+    // use a tiny buffer to make sure values are split across calls
+    CJSONVariantStreamWriter writer(CVariant(variant), compact);
+    std::string str;
+    char buffer[3];
+    size_t size;
+    while ((size = writer.Write(buffer, sizeof(buffer))) > 0)
+    {
+      ASSERT_LE(size, sizeof(buffer));
+      str.append(buffer, size);
+    }
+
+    ASSERT_TRUE(writer.IsComplete());
+    ASSERT_FALSE(writer.HasFailed());
+    ASSERT_STREQ(expected.c_str(), str.c_str());
+  }
+}
@@ -12,6 +12,8 @@
 #include "utils/XTimeUtils.h"
 
 #include <atomic>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -47,6 +49,19 @@ public:
   }
 };
 
+class CountingJob : public CJob
+{
+  std::atomic<unsigned int>& m_count;
+public:
+  inline explicit CountingJob(std::atomic<unsigned int>& count) : m_count(count) {}
+
+  bool DoWork() override
+  {
+    m_count++;
+    return true;
+  }
+};
+
 class ReallyDumbJob : public CJob
 {
   Flags* m_flags;
@@ -213,3 +228,86 @@ TEST_F(TestJobManager, IsProcessing)
 
   job->FinishAndStopBlocking();
 }
+
+namespace
+{
+// the pool never has fewer workers than PRIORITY_HIGH jobs may run at once
+const unsigned int POOL_WORKERS = 5;
+}
+
+class TestJobManagerWorkStealing : public TestJobManager
+{
+protected:
+  void SetUp() override { CJobManager::GetInstance().EnableWorkStealing(POOL_WORKERS); }
+
+  /* Leave the on-demand workers to the tests that run after us */
+  void TearDown() override { CJobManager::GetInstance().DisableWorkStealing(); }
+};
+
+TEST_F(TestJobManagerWorkStealing, AddJob)
+{
+  std::vector<Flags> flags(20);
+  for (Flags& f : flags)
+    CJobManager::GetInstance().AddJob(new ReallyDumbJob(&f), NULL, CJob::PRIORITY_NORMAL);
+  for (Flags& f : flags)
+    ASSERT_TRUE(poll([&f]() -> bool { return f.finished; }));
+}
+
+TEST_F(TestJobManagerWorkStealing, CancelJob)
+{
+  Flags* cancelFlags = new Flags();
+  unsigned int id = CJobManager::GetInstance().AddJob(new DummyJob(cancelFlags), NULL);
+  ASSERT_TRUE(poll([cancelFlags]() -> bool { return cancelFlags->started; }));
+  EXPECT_TRUE(CJobManager::GetInstance().IsProcessing(CJob::PRIORITY_LOW));
+
+  CJobManager::GetInstance().CancelJob(id);
+  cancelFlags->lingerAtWork = false;
+  ASSERT_TRUE(poll([cancelFlags]() -> bool { return cancelFlags->finished; }));
+  EXPECT_TRUE(cancelFlags->wasCanceled);
+  delete cancelFlags;
+}
+
+TEST_F(TestJobManagerWorkStealing, DisableWithQueuedJobs)
+{
+  // keep all pool workers busy so the other jobs stay queued in the pool
+  std::vector<Flags> busy(POOL_WORKERS);
+  for (Flags& f : busy)
+    CJobManager::GetInstance().AddJob(new DummyJob(&f), NULL, CJob::PRIORITY_HIGH);
+  for (Flags& f : busy)
+    ASSERT_TRUE(poll([&f]() -> bool { return f.started; }));
+
+  std::vector<Flags> queued(4);
+  for (Flags& f : queued)
+    CJobManager::GetInstance().AddJob(new ReallyDumbJob(&f), NULL, CJob::PRIORITY_HIGH);
+
+  for (Flags& f : busy)
+    f.lingerAtWork = false;
+  CJobManager::GetInstance().DisableWorkStealing();
+
+  // whatever the pool didn't get to runs on on-demand workers
+  for (Flags& f : queued)
+    ASSERT_TRUE(poll([&f]() -> bool { return f.finished; }));
+  for (Flags& f : busy)
+    EXPECT_TRUE(f.finished);
+}
+
+TEST_F(TestJobManagerWorkStealing, DisableWhileAdding)
+{
+  std::atomic<unsigned int> added{0};
+  std::atomic<unsigned int> done{0};
+  std::thread adder([&added, &done]() {
+    for (int i = 0; i < 5000; i++)
+    {
+      if (CJobManager::GetInstance().AddJob(new CountingJob(done), NULL, CJob::PRIORITY_NORMAL))
+        added++;
+    }
+  });
+
+  ASSERT_TRUE(poll([&added]() -> bool { return added > 100; }));
+  CJobManager::GetInstance().DisableWorkStealing();
+  adder.join();
+
+  // no job is lost, whether it was added before, during or after switching
+  EXPECT_EQ(5000u, added);
+  ASSERT_TRUE(poll([&done]() -> bool { return done == 5000; }));
+}
@@ -7,10 +7,91 @@
  */
 
 #include "utils/SortUtils.h"
+#include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
+#include <algorithm>
+#include <random>
+#include <string>
+
 #include <gtest/gtest.h>
 
+namespace
+{
+// a label of random pieces: letters of both cases, digits, punctuation and non-ASCII text
+std::string RandomLabel(std::mt19937& rng)
+{
+  static const char* const pieces[] = {
+    "a", "B", "z", "Z", "the ", " ", ".", "-", "_", "(", "!", "0", "7", "42", "007", "1999",
+    "\xc3\xa9", "\xc3\x89", "\xc3\xb6", "\xc3\x96", "\xc3\xb1", "\xe2\x82\xac", "\xe4\xb8\xad", "\xd0\x96"};
+  std::string label;
+  const unsigned int length = rng() % 8;
+  for (unsigned int i = 0; i < length; i++)
+    label += pieces[rng() % (sizeof(pieces) / sizeof(pieces[0]))];
+  return label;
+}
+
+/*! Sort random labels and compare the result with what std::stable_sort gives for the rules
+ SortUtils had before it built sort keys: special items first or last, then folders, then
+ StringUtils::AlphaNumericCompare() of the labels. Equal items have to keep their order. */
+void CompareWithStableSort(size_t count, unsigned int seed)
+{
+  std::mt19937 rng(seed);
+  for (SortOrder order : {SortOrderAscending, SortOrderDescending})
+  {
+    for (SortAttribute attributes : {SortAttributeNone, SortAttributeIgnoreFolders})
+    {
+      SortItems items;
+      for (size_t i = 0; i < count; i++)
+      {
+        SortItemPtr item(new SortItem());
+        (*item)[FieldLabel] = RandomLabel(rng);
+        (*item)[FieldId] = static_cast<int64_t>(i);
+        // every item has the folder flag, CFileItem::ToSortable() always sets it
+        (*item)[FieldFolder] = rng() % 4 == 0;
+        if (rng() % 10 == 0)
+          (*item)[FieldSortSpecial] = static_cast<int>(rng() % 3);
+        items.push_back(item);
+      }
+      SortItems expected(items);
+
+      SortUtils::Sort(SortByLabel, order, attributes, items);
+
+      // Sort() stored the wide labels it compared under FieldSort
+      const bool handleFolders = !(attributes & SortAttributeIgnoreFolders);
+      std::stable_sort(expected.begin(), expected.end(), [order, handleFolders](const SortItemPtr& left, const SortItemPtr& right)
+      {
+        SortSpecial leftSpecial = SortSpecialNone, rightSpecial = SortSpecialNone;
+        auto it = left->find(FieldSortSpecial);
+        if (it != left->end())
+          leftSpecial = static_cast<SortSpecial>(it->second.asInteger());
+        it = right->find(FieldSortSpecial);
+        if (it != right->end())
+          rightSpecial = static_cast<SortSpecial>(it->second.asInteger());
+        if (leftSpecial != rightSpecial)
+          return leftSpecial == SortSpecialOnTop || rightSpecial == SortSpecialOnBottom;
+        if (leftSpecial != SortSpecialNone)
+          return false;
+
+        if (handleFolders && left->at(FieldFolder).asBoolean() != right->at(FieldFolder).asBoolean())
+          return left->at(FieldFolder).asBoolean();
+
+        const int64_t result = StringUtils::AlphaNumericCompare(left->at(FieldSort).asWideString().c_str(),
+                                                                right->at(FieldSort).asWideString().c_str());
+        return order == SortOrderDescending ? result > 0 : result < 0;
+      });
+
+      ASSERT_EQ(expected.size(), items.size());
+      for (size_t i = 0; i < items.size(); i++)
+      {
+        ASSERT_EQ(expected[i]->at(FieldId).asInteger(), items[i]->at(FieldId).asInteger())
+            << "position " << i << " of " << count << ", order " << order << ", attributes " << attributes;
+      }
+    }
+  }
+}
+}
+
 TEST(TestSortUtils, Sort_SortBy)
 {
   SortItems items;
@@ -121,3 +202,51 @@ TEST(TestSortUtils, GetFieldsForSorting)
   EXPECT_EQ(FieldTrackNumber, *it);
   EXPECT_EQ((unsigned int)5, fields.size());
 }
+
+TEST(TestSortUtils, Sort_LargeList)
+{
+  // big enough to be sorted in parallel
+  const int count = 25000;
+  SortItems items;
+  for (int i = count; i > 0; --i)
+  {
+    SortItemPtr item(new SortItem());
+    (*item)[FieldLabel] = StringUtils::Format("Item %d", i / 2);
+    (*item)[FieldId] = i;
+    (*item)[FieldFolder] = false;
+    items.push_back(item);
+  }
+  SortItemPtr folder(new SortItem());
+  (*folder)[FieldLabel] = "Z Folder";
+  (*folder)[FieldFolder] = true;
+  items.push_back(folder);
+
+  SortUtils::Sort(SortByLabel, SortOrderAscending, SortAttributeNone, items);
+
+  ASSERT_EQ(static_cast<size_t>(count + 1), items.size());
+  EXPECT_STREQ("Z Folder", (*items.at(0))[FieldLabel].asString().c_str());
+  for (int i = 1; i < count; ++i)
+  {
+    const SortItem &previous = *items.at(i);
+    const SortItem &current = *items.at(i + 1);
+    // numbers are compared by value and equal labels keep their order
+    EXPECT_LE(previous.at(FieldLabel).asString().size(), current.at(FieldLabel).asString().size());
+    if (previous.at(FieldLabel) == current.at(FieldLabel))
+      EXPECT_GT(previous.at(FieldId).asInteger(), current.at(FieldId).asInteger());
+  }
+  EXPECT_STREQ("Item 0", (*items.at(1))[FieldLabel].asString().c_str());
+  EXPECT_STREQ("Item 12500", (*items.at(count))[FieldLabel].asString().c_str());
+}
+
+TEST(TestSortUtils, Sort_RandomLabels)
+{
+  // short lists are sorted by the calling thread only
+  for (unsigned int seed = 1; seed <= 20; seed++)
+    CompareWithStableSort(1 + seed * 15, seed);
+}
+
+TEST(TestSortUtils, Sort_RandomLabelsLargeList)
+{
+  // big enough to be sorted in parallel where there are several cores
+  CompareWithStableSort(20001, 42);
+}
@@ -332,3 +332,83 @@ TEST(TestVariant, isMember)
   EXPECT_TRUE(a.isMember("key1"));
   EXPECT_FALSE(a.isMember("key2"));
 }
+
+TEST(TestVariant, size_of)
+{
+  // strings, arrays and objects are held by pointer, so a variant is no bigger than its type and a value
+  EXPECT_LE(sizeof(CVariant), 2 * sizeof(int64_t));
+}
+
+TEST(TestVariant, ArenaScope)
+{
+  CVariant copy;
+  {
+    CVariant::CArenaScope arena;
+    CVariant object;
+    object["title"] = "movie";
+    object["cast"]["actor"] = "name";
+    object["genre"].push_back("drama");
+    for (int i = 0; i < 100; i++)
+      object["ratings"][std::to_string(i)] = i;
+    EXPECT_EQ("name", object["cast"]["actor"].asString());
+    EXPECT_EQ(100u, object["ratings"].size());
+
+    // values that outlive the scope are copied out on the heap
+    CVariant::CHeapScope heap;
+    copy = object;
+    object.erase("cast");
+    copy["cast"]["role"] = "lead";
+  }
+
+  EXPECT_EQ("movie", copy["title"].asString());
+  EXPECT_EQ("lead", copy["cast"]["role"].asString());
+  EXPECT_EQ(99, copy["ratings"]["99"].asInteger());
+  copy["ratings"].clear();
+  EXPECT_TRUE(copy["ratings"].empty());
+}
+
+TEST(TestVariant, NestedArenaScopes)
+{
+  CVariant::CArenaScope outer;
+  CVariant a;
+  a["key"]["outer"] = 1;
+  {
+    CVariant::CArenaScope inner;
+    CVariant b;
+    b["key"]["inner"] = 2;
+
+    // objects of the outer arena can still be changed and freed
+    a["key"]["more"] = 3;
+    a.erase("key");
+    EXPECT_FALSE(a.isMember("key"));
+    EXPECT_EQ(2, b["key"]["inner"].asInteger());
+  }
+  a["other"] = "value";
+  EXPECT_EQ(1u, a.size());
+}
+
+#ifndef NDEBUG
+TEST(TestVariantDeathTest, ArenaValuesMustNotOutliveTheScope)
+{
+  EXPECT_DEATH(
+      {
+        CVariant escaped;
+        {
+          CVariant::CArenaScope arena;
+          escaped["key"] = "value";
+        }
+      },
+      "");
+}
+#else
+TEST(TestVariant, ArenaValuesOutlivingTheScopeStayValid)
+{
+  CVariant escaped;
+  {
+    CVariant::CArenaScope arena;
+    escaped["key"] = "value";
+  }
+  EXPECT_EQ("value", escaped["key"].asString());
+  escaped.clear();
+}
+#endif
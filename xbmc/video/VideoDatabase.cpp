@@ -334,6 +334,16 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
               "END");
 
+  CLog::Log(LOGINFO, "%s - creating search indices", __FUNCTION__);
+  CreateFullTextIndex("moviesearch", "movie", "idMovie",
+                      {GetColumn(VIDEODB_ID_TITLE), GetColumn(VIDEODB_ID_PLOT),
+                       GetColumn(VIDEODB_ID_PLOTOUTLINE), GetColumn(VIDEODB_ID_TAGLINE)});
+  CreateFullTextIndex("tvshowsearch", "tvshow", "idShow", {GetColumn(VIDEODB_ID_TV_TITLE)});
+  CreateFullTextIndex("episodesearch", "episode", "idEpisode",
+                      {GetColumn(VIDEODB_ID_EPISODE_TITLE), GetColumn(VIDEODB_ID_EPISODE_PLOT)});
+  CreateFullTextIndex("musicvideosearch", "musicvideo", "idMVideo",
+                      {GetColumn(VIDEODB_ID_MUSICVIDEO_TITLE)});
+
   CreateViews();
 }
 
@@ -553,8 +563,8 @@ int CVideoDatabase::GetPathId(const std::string& strPath)
 
     URIUtils::AddSlashAtEnd(strPath1);
 
-    strSQL=PrepareSQL("select idPath from path where strPath='%s'",strPath1.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "select idPath from path where strPath=?";
+    m_pDS->query_with_params(strSQL, { field_value(strPath1.c_str()) });
     if (!m_pDS->eof())
       idPath = m_pDS->fv("path.idPath").get_asInt();
 
@@ -1110,9 +1120,8 @@ int CVideoDatabase::GetFileId(const std::string& strFilenameAndPath)
     int idPath = GetPathId(strPath);
     if (idPath >= 0)
     {
-      std::string strSQL;
-      strSQL=PrepareSQL("select idFile from files where strFileName='%s' and idPath=%i", strFileName.c_str(),idPath);
-      m_pDS->query(strSQL);
+      m_pDS->query_with_params("select idFile from files where strFileName=? and idPath=?",
+                               { field_value(strFileName.c_str()), field_value(idPath) });
       if (m_pDS->num_rows() > 0)
       {
         int idFile = m_pDS->fv("files.idFile").get_asInt();
@@ -3759,40 +3768,40 @@ void CVideoDatabase::DeleteTag(int idTag, VIDEODB_CONTENT_TYPE mediaType)
 
 void CVideoDatabase::GetDetailsFromDB(std::unique_ptr<Dataset> &pDS, int min, int max, const SDbTableOffsets *offsets, CVideoInfoTag &details, int idxOffset)
 {
-  GetDetailsFromDB(pDS->get_sql_record(), min, max, offsets, details, idxOffset);
+  GetDetailsFromDB(pDS->get_row(), min, max, offsets, details, idxOffset);
 }
 
-void CVideoDatabase::GetDetailsFromDB(const dbiplus::sql_record* const record, int min, int max, const SDbTableOffsets *offsets, CVideoInfoTag &details, int idxOffset)
+void CVideoDatabase::GetDetailsFromDB(const dbiplus::row_view& record, int min, int max, const SDbTableOffsets *offsets, CVideoInfoTag &details, int idxOffset)
 {
   for (int i = min + 1; i < max; i++)
   {
     switch (offsets[i].type)
     {
     case VIDEODB_TYPE_STRING:
-      *(std::string*)(((char*)&details)+offsets[i].offset) = record->at(i+idxOffset).get_asString();
+      *(std::string*)(((char*)&details)+offsets[i].offset) = record.at(i+idxOffset).get_asString();
       break;
     case VIDEODB_TYPE_INT:
     case VIDEODB_TYPE_COUNT:
-      *(int*)(((char*)&details)+offsets[i].offset) = record->at(i+idxOffset).get_asInt();
+      *(int*)(((char*)&details)+offsets[i].offset) = record.at(i+idxOffset).get_asInt();
       break;
     case VIDEODB_TYPE_BOOL:
-      *(bool*)(((char*)&details)+offsets[i].offset) = record->at(i+idxOffset).get_asBool();
+      *(bool*)(((char*)&details)+offsets[i].offset) = record.at(i+idxOffset).get_asBool();
       break;
     case VIDEODB_TYPE_FLOAT:
-      *(float*)(((char*)&details)+offsets[i].offset) = record->at(i+idxOffset).get_asFloat();
+      *(float*)(((char*)&details)+offsets[i].offset) = record.at(i+idxOffset).get_asFloat();
       break;
     case VIDEODB_TYPE_STRINGARRAY:
     {
-      std::string value = record->at(i+idxOffset).get_asString();
+      std::string value = record.at(i+idxOffset).get_asString();
       if (!value.empty())
         *(std::vector<std::string>*)(((char*)&details)+offsets[i].offset) = StringUtils::Split(value, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
       break;
     }
     case VIDEODB_TYPE_DATE:
-      ((CDateTime*)(((char*)&details)+offsets[i].offset))->SetFromDBDate(record->at(i+idxOffset).get_asString());
+      ((CDateTime*)(((char*)&details)+offsets[i].offset))->SetFromDBDate(record.at(i+idxOffset).get_asString());
       break;
     case VIDEODB_TYPE_DATETIME:
-      ((CDateTime*)(((char*)&details)+offsets[i].offset))->SetFromDBDateTime(record->at(i+idxOffset).get_asString());
+      ((CDateTime*)(((char*)&details)+offsets[i].offset))->SetFromDBDateTime(record.at(i+idxOffset).get_asString());
       break;
     case VIDEODB_TYPE_UNUSED: // Skip the unused field to avoid populating unused data
       continue;
@@ -3973,45 +3982,45 @@ bool CVideoDatabase::GetResumePoint(CVideoInfoTag& tag)
 
 CVideoInfoTag CVideoDatabase::GetDetailsForMovie(std::unique_ptr<Dataset> &pDS, int getDetails /* = VideoDbDetailsNone */)
 {
-  return GetDetailsForMovie(pDS->get_sql_record(), getDetails);
+  return GetDetailsForMovie(pDS->get_row(), getDetails);
 }
 
-CVideoInfoTag CVideoDatabase::GetDetailsForMovie(const dbiplus::sql_record* const record, int getDetails /* = VideoDbDetailsNone */)
+CVideoInfoTag CVideoDatabase::GetDetailsForMovie(const dbiplus::row_view& record, int getDetails /* = VideoDbDetailsNone */)
 {
   CVideoInfoTag details;
 
-  if (record == NULL)
+  if (!record.valid())
     return details;
 
   DWORD time = XbmcThreads::SystemClockMillis();
-  int idMovie = record->at(0).get_asInt();
+  int idMovie = record.at(0).get_asInt();
 
   GetDetailsFromDB(record, VIDEODB_ID_MIN, VIDEODB_ID_MAX, DbMovieOffsets, details);
 
   details.m_iDbId = idMovie;
   details.m_type = MediaTypeMovie;
 
-  details.m_set.id = record->at(VIDEODB_DETAILS_MOVIE_SET_ID).get_asInt();
-  details.m_set.title = record->at(VIDEODB_DETAILS_MOVIE_SET_NAME).get_asString();
-  details.m_set.overview = record->at(VIDEODB_DETAILS_MOVIE_SET_OVERVIEW).get_asString();
-  details.m_iFileId = record->at(VIDEODB_DETAILS_FILEID).get_asInt();
-  details.m_strPath = record->at(VIDEODB_DETAILS_MOVIE_PATH).get_asString();
-  std::string strFileName = record->at(VIDEODB_DETAILS_MOVIE_FILE).get_asString();
+  details.m_set.id = record.at(VIDEODB_DETAILS_MOVIE_SET_ID).get_asInt();
+  details.m_set.title = record.at(VIDEODB_DETAILS_MOVIE_SET_NAME).get_asString();
+  details.m_set.overview = record.at(VIDEODB_DETAILS_MOVIE_SET_OVERVIEW).get_asString();
+  details.m_iFileId = record.at(VIDEODB_DETAILS_FILEID).get_asInt();
+  details.m_strPath = record.at(VIDEODB_DETAILS_MOVIE_PATH).get_asString();
+  std::string strFileName = record.at(VIDEODB_DETAILS_MOVIE_FILE).get_asString();
   ConstructPath(details.m_strFileNameAndPath,details.m_strPath,strFileName);
-  details.SetPlayCount(record->at(VIDEODB_DETAILS_MOVIE_PLAYCOUNT).get_asInt());
-  details.m_lastPlayed.SetFromDBDateTime(record->at(VIDEODB_DETAILS_MOVIE_LASTPLAYED).get_asString());
-  details.m_dateAdded.SetFromDBDateTime(record->at(VIDEODB_DETAILS_MOVIE_DATEADDED).get_asString());
-  details.SetResumePoint(record->at(VIDEODB_DETAILS_MOVIE_RESUME_TIME).get_asInt(),
-                         record->at(VIDEODB_DETAILS_MOVIE_TOTAL_TIME).get_asInt(),
-                         record->at(VIDEODB_DETAILS_MOVIE_PLAYER_STATE).get_asString());
-  details.m_iUserRating = record->at(VIDEODB_DETAILS_MOVIE_USER_RATING).get_asInt();
-  details.SetRating(record->at(VIDEODB_DETAILS_MOVIE_RATING).get_asFloat(),
-                    record->at(VIDEODB_DETAILS_MOVIE_VOTES).get_asInt(),
-                    record->at(VIDEODB_DETAILS_MOVIE_RATING_TYPE).get_asString(), true);
-  details.SetUniqueID(record->at(VIDEODB_DETAILS_MOVIE_UNIQUEID_VALUE).get_asString(), record->at(VIDEODB_DETAILS_MOVIE_UNIQUEID_TYPE).get_asString() ,true);
-  std::string premieredString = record->at(VIDEODB_DETAILS_MOVIE_PREMIERED).get_asString();
+  details.SetPlayCount(record.at(VIDEODB_DETAILS_MOVIE_PLAYCOUNT).get_asInt());
+  details.m_lastPlayed.SetFromDBDateTime(record.at(VIDEODB_DETAILS_MOVIE_LASTPLAYED).get_asString());
+  details.m_dateAdded.SetFromDBDateTime(record.at(VIDEODB_DETAILS_MOVIE_DATEADDED).get_asString());
+  details.SetResumePoint(record.at(VIDEODB_DETAILS_MOVIE_RESUME_TIME).get_asInt(),
+                         record.at(VIDEODB_DETAILS_MOVIE_TOTAL_TIME).get_asInt(),
+                         record.at(VIDEODB_DETAILS_MOVIE_PLAYER_STATE).get_asString());
+  details.m_iUserRating = record.at(VIDEODB_DETAILS_MOVIE_USER_RATING).get_asInt();
+  details.SetRating(record.at(VIDEODB_DETAILS_MOVIE_RATING).get_asFloat(),
+                    record.at(VIDEODB_DETAILS_MOVIE_VOTES).get_asInt(),
+                    record.at(VIDEODB_DETAILS_MOVIE_RATING_TYPE).get_asString(), true);
+  details.SetUniqueID(record.at(VIDEODB_DETAILS_MOVIE_UNIQUEID_VALUE).get_asString(), record.at(VIDEODB_DETAILS_MOVIE_UNIQUEID_TYPE).get_asString() ,true);
+  std::string premieredString = record.at(VIDEODB_DETAILS_MOVIE_PREMIERED).get_asString();
   if (premieredString.size() == 4)
-    details.SetYear(record->at(VIDEODB_DETAILS_MOVIE_PREMIERED).get_asInt());
+    details.SetYear(record.at(VIDEODB_DETAILS_MOVIE_PREMIERED).get_asInt());
   else
     details.SetPremieredFromDBDate(premieredString);
   movieTime += XbmcThreads::SystemClockMillis() - time; time = XbmcThreads::SystemClockMillis();
@@ -4061,38 +4070,38 @@ CVideoInfoTag CVideoDatabase::GetDetailsForMovie(const dbiplus::sql_record* cons
 
 CVideoInfoTag CVideoDatabase::GetDetailsForTvShow(std::unique_ptr<Dataset> &pDS, int getDetails /* = VideoDbDetailsNone */, CFileItem* item /* = NULL */)
 {
-  return GetDetailsForTvShow(pDS->get_sql_record(), getDetails, item);
+  return GetDetailsForTvShow(pDS->get_row(), getDetails, item);
 }
 
-CVideoInfoTag CVideoDatabase::GetDetailsForTvShow(const dbiplus::sql_record* const record, int getDetails /* = VideoDbDetailsNone */, CFileItem* item /* = NULL */)
+CVideoInfoTag CVideoDatabase::GetDetailsForTvShow(const dbiplus::row_view& record, int getDetails /* = VideoDbDetailsNone */, CFileItem* item /* = NULL */)
 {
   CVideoInfoTag details;
 
-  if (record == NULL)
+  if (!record.valid())
     return details;
 
   DWORD time = XbmcThreads::SystemClockMillis();
-  int idTvShow = record->at(0).get_asInt();
+  int idTvShow = record.at(0).get_asInt();
 
   GetDetailsFromDB(record, VIDEODB_ID_TV_MIN, VIDEODB_ID_TV_MAX, DbTvShowOffsets, details, 1);
   details.m_bHasPremiered = details.m_premiered.IsValid();
   details.m_iDbId = idTvShow;
   details.m_type = MediaTypeTvShow;
-  details.m_strPath = record->at(VIDEODB_DETAILS_TVSHOW_PATH).get_asString();
+  details.m_strPath = record.at(VIDEODB_DETAILS_TVSHOW_PATH).get_asString();
   details.m_basePath = details.m_strPath;
-  details.m_parentPathID = record->at(VIDEODB_DETAILS_TVSHOW_PARENTPATHID).get_asInt();
-  details.m_dateAdded.SetFromDBDateTime(record->at(VIDEODB_DETAILS_TVSHOW_DATEADDED).get_asString());
-  details.m_lastPlayed.SetFromDBDateTime(record->at(VIDEODB_DETAILS_TVSHOW_LASTPLAYED).get_asString());
-  details.m_iSeason = record->at(VIDEODB_DETAILS_TVSHOW_NUM_SEASONS).get_asInt();
-  details.m_iEpisode = record->at(VIDEODB_DETAILS_TVSHOW_NUM_EPISODES).get_asInt();
-  details.SetPlayCount(record->at(VIDEODB_DETAILS_TVSHOW_NUM_WATCHED).get_asInt());
+  details.m_parentPathID = record.at(VIDEODB_DETAILS_TVSHOW_PARENTPATHID).get_asInt();
+  details.m_dateAdded.SetFromDBDateTime(record.at(VIDEODB_DETAILS_TVSHOW_DATEADDED).get_asString());
+  details.m_lastPlayed.SetFromDBDateTime(record.at(VIDEODB_DETAILS_TVSHOW_LASTPLAYED).get_asString());
+  details.m_iSeason = record.at(VIDEODB_DETAILS_TVSHOW_NUM_SEASONS).get_asInt();
+  details.m_iEpisode = record.at(VIDEODB_DETAILS_TVSHOW_NUM_EPISODES).get_asInt();
+  details.SetPlayCount(record.at(VIDEODB_DETAILS_TVSHOW_NUM_WATCHED).get_asInt());
   details.m_strShowTitle = details.m_strTitle;
-  details.m_iUserRating = record->at(VIDEODB_DETAILS_TVSHOW_USER_RATING).get_asInt();
-  details.SetRating(record->at(VIDEODB_DETAILS_TVSHOW_RATING).get_asFloat(),
-                    record->at(VIDEODB_DETAILS_TVSHOW_VOTES).get_asInt(),
-                    record->at(VIDEODB_DETAILS_TVSHOW_RATING_TYPE).get_asString(), true);
-  details.SetUniqueID(record->at(VIDEODB_DETAILS_TVSHOW_UNIQUEID_VALUE).get_asString(), record->at(VIDEODB_DETAILS_TVSHOW_UNIQUEID_TYPE).get_asString(), true);
-  details.SetDuration(record->at(VIDEODB_DETAILS_TVSHOW_DURATION).get_asInt());
+  details.m_iUserRating = record.at(VIDEODB_DETAILS_TVSHOW_USER_RATING).get_asInt();
+  details.SetRating(record.at(VIDEODB_DETAILS_TVSHOW_RATING).get_asFloat(),
+                    record.at(VIDEODB_DETAILS_TVSHOW_VOTES).get_asInt(),
+                    record.at(VIDEODB_DETAILS_TVSHOW_RATING_TYPE).get_asString(), true);
+  details.SetUniqueID(record.at(VIDEODB_DETAILS_TVSHOW_UNIQUEID_VALUE).get_asString(), record.at(VIDEODB_DETAILS_TVSHOW_UNIQUEID_TYPE).get_asString(), true);
+  details.SetDuration(record.at(VIDEODB_DETAILS_TVSHOW_DURATION).get_asInt());
 
   movieTime += XbmcThreads::SystemClockMillis() - time; time = XbmcThreads::SystemClockMillis();
 
@@ -4134,26 +4143,26 @@ CVideoInfoTag CVideoDatabase::GetDetailsForTvShow(const dbiplus::sql_record* con
 
 CVideoInfoTag CVideoDatabase::GetBasicDetailsForEpisode(std::unique_ptr<Dataset> &pDS)
 {
-  return GetBasicDetailsForEpisode(pDS->get_sql_record());
+  return GetBasicDetailsForEpisode(pDS->get_row());
 }
 
-CVideoInfoTag CVideoDatabase::GetBasicDetailsForEpisode(const dbiplus::sql_record* const record)
+CVideoInfoTag CVideoDatabase::GetBasicDetailsForEpisode(const dbiplus::row_view& record)
 {
   CVideoInfoTag details;
 
-  if (record == nullptr)
+  if (!record.valid())
     return details;
 
   unsigned int time = XbmcThreads::SystemClockMillis();
-  int idEpisode = record->at(0).get_asInt();
+  int idEpisode = record.at(0).get_asInt();
 
   GetDetailsFromDB(record, VIDEODB_ID_EPISODE_MIN, VIDEODB_ID_EPISODE_MAX, DbEpisodeOffsets, details);
   details.m_iDbId = idEpisode;
   details.m_type = MediaTypeEpisode;
-  details.m_iFileId = record->at(VIDEODB_DETAILS_FILEID).get_asInt();
-  details.m_iIdShow = record->at(VIDEODB_DETAILS_EPISODE_TVSHOW_ID).get_asInt();
-  details.m_iIdSeason = record->at(VIDEODB_DETAILS_EPISODE_SEASON_ID).get_asInt();
-  details.m_iUserRating = record->at(VIDEODB_DETAILS_EPISODE_USER_RATING).get_asInt();
+  details.m_iFileId = record.at(VIDEODB_DETAILS_FILEID).get_asInt();
+  details.m_iIdShow = record.at(VIDEODB_DETAILS_EPISODE_TVSHOW_ID).get_asInt();
+  details.m_iIdSeason = record.at(VIDEODB_DETAILS_EPISODE_SEASON_ID).get_asInt();
+  details.m_iUserRating = record.at(VIDEODB_DETAILS_EPISODE_USER_RATING).get_asInt();
 
   movieTime += XbmcThreads::SystemClockMillis() - time;
   return details;
@@ -4161,40 +4170,40 @@ CVideoInfoTag CVideoDatabase::GetBasicDetailsForEpisode(const dbiplus::sql_recor
 
 CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(std::unique_ptr<Dataset> &pDS, int getDetails /* = VideoDbDetailsNone */)
 {
-  return GetDetailsForEpisode(pDS->get_sql_record(), getDetails);
+  return GetDetailsForEpisode(pDS->get_row(), getDetails);
 }
 
-CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(const dbiplus::sql_record* const record, int getDetails /* = VideoDbDetailsNone */)
+CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(const dbiplus::row_view& record, int getDetails /* = VideoDbDetailsNone */)
 {
   CVideoInfoTag details;
 
-  if (record == nullptr)
+  if (!record.valid())
     return details;
 
   details = GetBasicDetailsForEpisode(record);
   
   unsigned int time = XbmcThreads::SystemClockMillis();
 
-  details.m_strPath = record->at(VIDEODB_DETAILS_EPISODE_PATH).get_asString();
-  std::string strFileName = record->at(VIDEODB_DETAILS_EPISODE_FILE).get_asString();
+  details.m_strPath = record.at(VIDEODB_DETAILS_EPISODE_PATH).get_asString();
+  std::string strFileName = record.at(VIDEODB_DETAILS_EPISODE_FILE).get_asString();
   ConstructPath(details.m_strFileNameAndPath,details.m_strPath,strFileName);
-  details.SetPlayCount(record->at(VIDEODB_DETAILS_EPISODE_PLAYCOUNT).get_asInt());
-  details.m_lastPlayed.SetFromDBDateTime(record->at(VIDEODB_DETAILS_EPISODE_LASTPLAYED).get_asString());
-  details.m_dateAdded.SetFromDBDateTime(record->at(VIDEODB_DETAILS_EPISODE_DATEADDED).get_asString());
-  details.m_strMPAARating = record->at(VIDEODB_DETAILS_EPISODE_TVSHOW_MPAA).get_asString();
-  details.m_strShowTitle = record->at(VIDEODB_DETAILS_EPISODE_TVSHOW_NAME).get_asString();
-  details.m_genre = StringUtils::Split(record->at(VIDEODB_DETAILS_EPISODE_TVSHOW_GENRE).get_asString(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
-  details.m_studio = StringUtils::Split(record->at(VIDEODB_DETAILS_EPISODE_TVSHOW_STUDIO).get_asString(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
-  details.SetPremieredFromDBDate(record->at(VIDEODB_DETAILS_EPISODE_TVSHOW_AIRED).get_asString());
+  details.SetPlayCount(record.at(VIDEODB_DETAILS_EPISODE_PLAYCOUNT).get_asInt());
+  details.m_lastPlayed.SetFromDBDateTime(record.at(VIDEODB_DETAILS_EPISODE_LASTPLAYED).get_asString());
+  details.m_dateAdded.SetFromDBDateTime(record.at(VIDEODB_DETAILS_EPISODE_DATEADDED).get_asString());
+  details.m_strMPAARating = record.at(VIDEODB_DETAILS_EPISODE_TVSHOW_MPAA).get_asString();
+  details.m_strShowTitle = record.at(VIDEODB_DETAILS_EPISODE_TVSHOW_NAME).get_asString();
+  details.m_genre = StringUtils::Split(record.at(VIDEODB_DETAILS_EPISODE_TVSHOW_GENRE).get_asString(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  details.m_studio = StringUtils::Split(record.at(VIDEODB_DETAILS_EPISODE_TVSHOW_STUDIO).get_asString(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  details.SetPremieredFromDBDate(record.at(VIDEODB_DETAILS_EPISODE_TVSHOW_AIRED).get_asString());
   
-  details.SetResumePoint(record->at(VIDEODB_DETAILS_EPISODE_RESUME_TIME).get_asInt(),
-                         record->at(VIDEODB_DETAILS_EPISODE_TOTAL_TIME).get_asInt(),
-                         record->at(VIDEODB_DETAILS_EPISODE_PLAYER_STATE).get_asString());
-
-  details.SetRating(record->at(VIDEODB_DETAILS_EPISODE_RATING).get_asFloat(),
-                    record->at(VIDEODB_DETAILS_EPISODE_VOTES).get_asInt(),
-                    record->at(VIDEODB_DETAILS_EPISODE_RATING_TYPE).get_asString(), true);
-  details.SetUniqueID(record->at(VIDEODB_DETAILS_EPISODE_UNIQUEID_VALUE).get_asString(), record->at(VIDEODB_DETAILS_EPISODE_UNIQUEID_TYPE).get_asString(), true);
+  details.SetResumePoint(record.at(VIDEODB_DETAILS_EPISODE_RESUME_TIME).get_asInt(),
+                         record.at(VIDEODB_DETAILS_EPISODE_TOTAL_TIME).get_asInt(),
+                         record.at(VIDEODB_DETAILS_EPISODE_PLAYER_STATE).get_asString());
+
+  details.SetRating(record.at(VIDEODB_DETAILS_EPISODE_RATING).get_asFloat(),
+                    record.at(VIDEODB_DETAILS_EPISODE_VOTES).get_asInt(),
+                    record.at(VIDEODB_DETAILS_EPISODE_RATING_TYPE).get_asString(), true);
+  details.SetUniqueID(record.at(VIDEODB_DETAILS_EPISODE_UNIQUEID_VALUE).get_asString(), record.at(VIDEODB_DETAILS_EPISODE_UNIQUEID_TYPE).get_asString(), true);
   movieTime += XbmcThreads::SystemClockMillis() - time; time = XbmcThreads::SystemClockMillis();
 
   if (getDetails)
@@ -4227,37 +4236,37 @@ CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(const dbiplus::sql_record* co
 
 CVideoInfoTag CVideoDatabase::GetDetailsForMusicVideo(std::unique_ptr<Dataset> &pDS, int getDetails /* = VideoDbDetailsNone */)
 {
-  return GetDetailsForMusicVideo(pDS->get_sql_record(), getDetails);
+  return GetDetailsForMusicVideo(pDS->get_row(), getDetails);
 }
 
-CVideoInfoTag CVideoDatabase::GetDetailsForMusicVideo(const dbiplus::sql_record* const record, int getDetails /* = VideoDbDetailsNone */)
+CVideoInfoTag CVideoDatabase::GetDetailsForMusicVideo(const dbiplus::row_view& record, int getDetails /* = VideoDbDetailsNone */)
 {
   CVideoInfoTag details;
 
-  if (record == nullptr)
+  if (!record.valid())
     return details;
 
   unsigned int time = XbmcThreads::SystemClockMillis();
-  int idMVideo = record->at(0).get_asInt();
+  int idMVideo = record.at(0).get_asInt();
 
   GetDetailsFromDB(record, VIDEODB_ID_MUSICVIDEO_MIN, VIDEODB_ID_MUSICVIDEO_MAX, DbMusicVideoOffsets, details);
   details.m_iDbId = idMVideo;
   details.m_type = MediaTypeMusicVideo;
 
-  details.m_iFileId = record->at(VIDEODB_DETAILS_FILEID).get_asInt();
-  details.m_strPath = record->at(VIDEODB_DETAILS_MUSICVIDEO_PATH).get_asString();
-  std::string strFileName = record->at(VIDEODB_DETAILS_MUSICVIDEO_FILE).get_asString();
+  details.m_iFileId = record.at(VIDEODB_DETAILS_FILEID).get_asInt();
+  details.m_strPath = record.at(VIDEODB_DETAILS_MUSICVIDEO_PATH).get_asString();
+  std::string strFileName = record.at(VIDEODB_DETAILS_MUSICVIDEO_FILE).get_asString();
   ConstructPath(details.m_strFileNameAndPath,details.m_strPath,strFileName);
-  details.SetPlayCount(record->at(VIDEODB_DETAILS_MUSICVIDEO_PLAYCOUNT).get_asInt());
-  details.m_lastPlayed.SetFromDBDateTime(record->at(VIDEODB_DETAILS_MUSICVIDEO_LASTPLAYED).get_asString());
-  details.m_dateAdded.SetFromDBDateTime(record->at(VIDEODB_DETAILS_MUSICVIDEO_DATEADDED).get_asString());
-  details.SetResumePoint(record->at(VIDEODB_DETAILS_MUSICVIDEO_RESUME_TIME).get_asInt(),
-                         record->at(VIDEODB_DETAILS_MUSICVIDEO_TOTAL_TIME).get_asInt(),
-                         record->at(VIDEODB_DETAILS_MUSICVIDEO_PLAYER_STATE).get_asString());
-  details.m_iUserRating = record->at(VIDEODB_DETAILS_MUSICVIDEO_USER_RATING).get_asInt();
-  std::string premieredString = record->at(VIDEODB_DETAILS_MUSICVIDEO_PREMIERED).get_asString();
+  details.SetPlayCount(record.at(VIDEODB_DETAILS_MUSICVIDEO_PLAYCOUNT).get_asInt());
+  details.m_lastPlayed.SetFromDBDateTime(record.at(VIDEODB_DETAILS_MUSICVIDEO_LASTPLAYED).get_asString());
+  details.m_dateAdded.SetFromDBDateTime(record.at(VIDEODB_DETAILS_MUSICVIDEO_DATEADDED).get_asString());
+  details.SetResumePoint(record.at(VIDEODB_DETAILS_MUSICVIDEO_RESUME_TIME).get_asInt(),
+                         record.at(VIDEODB_DETAILS_MUSICVIDEO_TOTAL_TIME).get_asInt(),
+                         record.at(VIDEODB_DETAILS_MUSICVIDEO_PLAYER_STATE).get_asString());
+  details.m_iUserRating = record.at(VIDEODB_DETAILS_MUSICVIDEO_USER_RATING).get_asInt();
+  std::string premieredString = record.at(VIDEODB_DETAILS_MUSICVIDEO_PREMIERED).get_asString();
   if (premieredString.size() == 4)
-    details.SetYear(record->at(VIDEODB_DETAILS_MUSICVIDEO_PREMIERED).get_asInt());
+    details.SetYear(record.at(VIDEODB_DETAILS_MUSICVIDEO_PREMIERED).get_asInt());
   else
     details.SetPremieredFromDBDate(premieredString);
 
@@ -5681,7 +5690,7 @@ void CVideoDatabase::UpdateTables(int iVersion)
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 116;
+  return 118;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -7283,11 +7292,11 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
 
     // get data from returned rows
     items.Reserve(results.size());
-    const query_data &data = m_pDS->get_result_set().records;
+    const result_set &data = m_pDS->get_result_set();
     for (const auto &i : results)
     {
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
+      const dbiplus::row_view record = data.row(targetRow);
 
       CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
       if (m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
@@ -7393,11 +7402,11 @@ bool CVideoDatabase::GetTvShowsByWhere(const std::string& strBaseDir, const Filt
 
     // get data from returned rows
     items.Reserve(results.size());
-    const query_data &data = m_pDS->get_result_set().records;
+    const result_set &data = m_pDS->get_result_set();
     for (const auto &i : results)
     {
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
+      const dbiplus::row_view record = data.row(targetRow);
 
       CFileItemPtr pItem(new CFileItem());
       CVideoInfoTag movie = GetDetailsForTvShow(record, getDetails, pItem.get());
@@ -7408,7 +7417,7 @@ bool CVideoDatabase::GetTvShowsByWhere(const std::string& strBaseDir, const Filt
         pItem->SetFromVideoInfoTag(movie);
 
         CVideoDbUrl itemUrl = videoUrl;
-        std::string path = StringUtils::Format("%i/", record->at(0).get_asInt());
+        std::string path = StringUtils::Format("%i/", record.at(0).get_asInt());
         itemUrl.AppendPath(path);
         pItem->SetPath(itemUrl.ToString());
 
@@ -7523,11 +7532,11 @@ bool CVideoDatabase::GetEpisodesByWhere(const std::string& strBaseDir, const Fil
     items.Reserve(results.size());
     CLabelFormatter formatter("%H. %T", "");
 
-    const query_data &data = m_pDS->get_result_set().records;
+    const result_set &data = m_pDS->get_result_set();
     for (const auto &i : results)
     {
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
+      const dbiplus::row_view record = data.row(targetRow);
 
       CVideoInfoTag episode = GetDetailsForEpisode(record, getDetails);
       if (m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
@@ -7537,12 +7546,12 @@ bool CVideoDatabase::GetEpisodesByWhere(const std::string& strBaseDir, const Fil
         CFileItemPtr pItem(new CFileItem(episode));
         formatter.FormatLabel(pItem.get());
 
-        int idEpisode = record->at(0).get_asInt();
+        int idEpisode = record.at(0).get_asInt();
 
         CVideoDbUrl itemUrl = videoUrl;
         std::string path;
         if (appendFullShowPath && videoUrl.GetItemType() != "episodes")
-          path = StringUtils::Format("%i/%i/%i", record->at(VIDEODB_DETAILS_EPISODE_TVSHOW_ID).get_asInt(), episode.m_iSeason, idEpisode);
+          path = StringUtils::Format("%i/%i/%i", record.at(VIDEODB_DETAILS_EPISODE_TVSHOW_ID).get_asInt(), episode.m_iSeason, idEpisode);
         else
           path = StringUtils::Format("%i", idEpisode);
         itemUrl.AppendPath(path);
@@ -8391,11 +8400,11 @@ bool CVideoDatabase::GetMusicVideosByWhere(const std::string &baseDir, const Fil
     // get data from returned rows
     items.Reserve(results.size());
     // get songs from returned subtable
-    const query_data &data = m_pDS->get_result_set().records;
+    const result_set &data = m_pDS->get_result_set();
     for (const auto &i : results)
     {
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
+      const dbiplus::row_view record = data.row(targetRow);
 
       CVideoInfoTag musicvideo = GetDetailsForMusicVideo(record, getDetails);
       if (!checkLocks || m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE || g_passwordManager.bMasterUser ||
@@ -8404,7 +8413,7 @@ bool CVideoDatabase::GetMusicVideosByWhere(const std::string &baseDir, const Fil
         CFileItemPtr item(new CFileItem(musicvideo));
 
         CVideoDbUrl itemUrl = videoUrl;
-        std::string path = StringUtils::Format("%i", record->at(0).get_asInt());
+        std::string path = StringUtils::Format("%i", record.at(0).get_asInt());
         itemUrl.AppendPath(path);
         item->SetPath(itemUrl.ToString());
 
@@ -8508,6 +8517,28 @@ int CVideoDatabase::GetMatchingMusicVideo(const std::string& strArtist, const st
   return -1;
 }
 
+std::string CVideoDatabase::GetColumn(int id)
+{
+  return StringUtils::Format("c%02d", id);
+}
+
+void CVideoDatabase::AppendSearch(Filter& filter, const std::string& table, const std::string& id,
+                                  const std::vector<std::string>& columns, const std::string& search)
+{
+  const std::string index = table + "search";
+  const std::string match = GetFullTextQuery(search, columns);
+  if (!match.empty() && HasFullTextIndex(index))
+  {
+    AppendFullTextSearch(filter, index, table + "." + id, match);
+    return;
+  }
+
+  std::vector<std::string> conditions;
+  for (const auto& column : columns)
+    conditions.push_back(PrepareSQL("%s.%s LIKE '%%%s%%'", table.c_str(), column.c_str(), search.c_str()));
+  filter.AppendWhere(StringUtils::Join(conditions, " OR "));
+}
+
 void CVideoDatabase::GetMoviesByName(const std::string& strSearch, CFileItemList& items)
 {
   std::string strSQL;
@@ -8519,10 +8550,12 @@ void CVideoDatabase::GetMoviesByName(const std::string& strSearch, CFileItemList
     if (nullptr == m_pDS)
       return;
 
+    Filter filter;
+    AppendSearch(filter, "movie", "idMovie", {GetColumn(VIDEODB_ID_TITLE)}, strSearch);
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT movie.idMovie, movie.c%02d, path.strPath, movie.idSet FROM movie INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath WHERE movie.c%02d LIKE '%%%s%%'", VIDEODB_ID_TITLE, VIDEODB_ID_TITLE, strSearch.c_str());
+      BuildSQL(PrepareSQL("SELECT movie.idMovie, movie.c%02d, path.strPath, movie.idSet FROM movie INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath ", VIDEODB_ID_TITLE), filter, strSQL);
     else
-      strSQL = PrepareSQL("select movie.idMovie,movie.c%02d, movie.idSet from movie where movie.c%02d like '%%%s%%'",VIDEODB_ID_TITLE,VIDEODB_ID_TITLE,strSearch.c_str());
+      BuildSQL(PrepareSQL("select movie.idMovie,movie.c%02d, movie.idSet from movie ",VIDEODB_ID_TITLE), filter, strSQL);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8566,10 +8599,12 @@ void CVideoDatabase::GetTvShowsByName(const std::string& strSearch, CFileItemLis
     if (nullptr == m_pDS)
       return;
 
+    Filter filter;
+    AppendSearch(filter, "tvshow", "idShow", {GetColumn(VIDEODB_ID_TV_TITLE)}, strSearch);
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT tvshow.idShow, tvshow.c%02d, path.strPath FROM tvshow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idShow=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath WHERE tvshow.c%02d LIKE '%%%s%%'", VIDEODB_ID_TV_TITLE, VIDEODB_ID_TV_TITLE, strSearch.c_str());
+      BuildSQL(PrepareSQL("SELECT tvshow.idShow, tvshow.c%02d, path.strPath FROM tvshow INNER JOIN tvshowlinkpath ON tvshowlinkpath.idShow=tvshow.idShow INNER JOIN path ON path.idPath=tvshowlinkpath.idPath ", VIDEODB_ID_TV_TITLE), filter, strSQL);
     else
-      strSQL = PrepareSQL("select tvshow.idShow,tvshow.c%02d from tvshow where tvshow.c%02d like '%%%s%%'",VIDEODB_ID_TV_TITLE,VIDEODB_ID_TV_TITLE,strSearch.c_str());
+      BuildSQL(PrepareSQL("select tvshow.idShow,tvshow.c%02d from tvshow ",VIDEODB_ID_TV_TITLE), filter, strSQL);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8609,10 +8644,12 @@ void CVideoDatabase::GetEpisodesByName(const std::string& strSearch, CFileItemLi
     if (nullptr == m_pDS)
       return;
 
+    Filter filter;
+    AppendSearch(filter, "episode", "idEpisode", {GetColumn(VIDEODB_ID_EPISODE_TITLE)}, strSearch);
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath WHERE episode.c%02d LIKE '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_TITLE, strSearch.c_str());
+      BuildSQL(PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath ", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE), filter, strSQL);
     else
-      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow WHERE episode.c%02d like '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_TITLE, strSearch.c_str());
+      BuildSQL(PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow ", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE), filter, strSQL);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8654,10 +8691,12 @@ void CVideoDatabase::GetMusicVideosByName(const std::string& strSearch, CFileIte
     if (nullptr == m_pDS)
       return;
 
+    Filter filter;
+    AppendSearch(filter, "musicvideo", "idMVideo", {GetColumn(VIDEODB_ID_MUSICVIDEO_TITLE)}, strSearch);
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT musicvideo.idMVideo, musicvideo.c%02d, path.strPath FROM musicvideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath WHERE musicvideo.c%02d LIKE '%%%s%%'", VIDEODB_ID_MUSICVIDEO_TITLE, VIDEODB_ID_MUSICVIDEO_TITLE, strSearch.c_str());
+      BuildSQL(PrepareSQL("SELECT musicvideo.idMVideo, musicvideo.c%02d, path.strPath FROM musicvideo INNER JOIN files ON files.idFile=musicvideo.idFile INNER JOIN path ON path.idPath=files.idPath ", VIDEODB_ID_MUSICVIDEO_TITLE), filter, strSQL);
     else
-      strSQL = PrepareSQL("select musicvideo.idMVideo,musicvideo.c%02d from musicvideo where musicvideo.c%02d like '%%%s%%'",VIDEODB_ID_MUSICVIDEO_TITLE,VIDEODB_ID_MUSICVIDEO_TITLE,strSearch.c_str());
+      BuildSQL(PrepareSQL("select musicvideo.idMVideo,musicvideo.c%02d from musicvideo ",VIDEODB_ID_MUSICVIDEO_TITLE), filter, strSQL);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8703,10 +8742,12 @@ void CVideoDatabase::GetEpisodesByPlot(const std::string& strSearch, CFileItemLi
     if (nullptr == m_pDS)
       return;
 
+    Filter filter;
+    AppendSearch(filter, "episode", "idEpisode", {GetColumn(VIDEODB_ID_EPISODE_PLOT)}, strSearch);
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath WHERE episode.c%02d LIKE '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_PLOT, strSearch.c_str());
+      BuildSQL(PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d, path.strPath FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow INNER JOIN files ON files.idFile=episode.idFile INNER JOIN path ON path.idPath=files.idPath ", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE), filter, strSQL);
     else
-      strSQL = PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow WHERE episode.c%02d LIKE '%%%s%%'", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE, VIDEODB_ID_EPISODE_PLOT, strSearch.c_str());
+      BuildSQL(PrepareSQL("SELECT episode.idEpisode, episode.c%02d, episode.c%02d, episode.idShow, tvshow.c%02d FROM episode INNER JOIN tvshow ON tvshow.idShow=episode.idShow ", VIDEODB_ID_EPISODE_TITLE, VIDEODB_ID_EPISODE_SEASON, VIDEODB_ID_TV_TITLE), filter, strSQL);
     m_pDS->query( strSQL );
 
     while (!m_pDS->eof())
@@ -8744,10 +8785,14 @@ void CVideoDatabase::GetMoviesByPlot(const std::string& strSearch, CFileItemList
     if (nullptr == m_pDS)
       return;
 
+    Filter filter;
+    AppendSearch(filter, "movie", "idMovie",
+                 {GetColumn(VIDEODB_ID_PLOT), GetColumn(VIDEODB_ID_PLOTOUTLINE), GetColumn(VIDEODB_ID_TAGLINE)},
+                 strSearch);
     if (m_profileManager.GetMasterProfile().getLockMode() != LOCK_MODE_EVERYONE && !g_passwordManager.bMasterUser)
-      strSQL = PrepareSQL("select movie.idMovie, movie.c%02d, path.strPath FROM movie INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath WHERE movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%'", VIDEODB_ID_TITLE,VIDEODB_ID_PLOT, strSearch.c_str(), VIDEODB_ID_PLOTOUTLINE, strSearch.c_str(), VIDEODB_ID_TAGLINE,strSearch.c_str());
+      BuildSQL(PrepareSQL("select movie.idMovie, movie.c%02d, path.strPath FROM movie INNER JOIN files ON files.idFile=movie.idFile INNER JOIN path ON path.idPath=files.idPath ", VIDEODB_ID_TITLE), filter, strSQL);
     else
-      strSQL = PrepareSQL("SELECT movie.idMovie, movie.c%02d FROM movie WHERE (movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%' OR movie.c%02d LIKE '%%%s%%')", VIDEODB_ID_TITLE, VIDEODB_ID_PLOT, strSearch.c_str(), VIDEODB_ID_PLOTOUTLINE, strSearch.c_str(), VIDEODB_ID_TAGLINE, strSearch.c_str());
+      BuildSQL(PrepareSQL("SELECT movie.idMovie, movie.c%02d FROM movie ", VIDEODB_ID_TITLE), filter, strSQL);
 
     m_pDS->query( strSQL );
 
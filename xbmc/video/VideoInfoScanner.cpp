@@ -36,9 +36,12 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "tags/VideoInfoTagLoaderFactory.h"
+#include "threads/Condition.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "utils/Digest.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/JobManager.h"
 #include "utils/RegExp.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -48,6 +51,8 @@
 #include "video/VideoThumbLoader.h"
 
 #include <algorithm>
+#include <deque>
+#include <map>
 #include <utility>
 
 using namespace XFILE;
@@ -60,6 +65,212 @@ using KODI::UTILITY::CDigest;
 namespace VIDEO
 {
 
+  /*!
+   \brief Lists and hashes the directories the scanner is about to visit, on a few threads.
+
+   Most of a rescan that finds nothing new is spent waiting for the storage to stat and list
+   directories, one at a time. The scanner queues the next paths it is going to scan, and by the
+   time it gets to them the results are usually there. The database is only used on the scanner
+   thread, everything it has to know is looked up when a path is queued.
+   */
+  class CVideoInfoScanner::CDirectoryPrefetcher
+  {
+  public:
+    enum class Mode
+    {
+      EXISTS,       //!< only check whether the directory exists
+      FOLDER,       //!< a movie or music video folder: fast hash, or listing and hash if that changed
+      TVSHOW_ROOT,  //!< a folder of tv shows: listing and hash
+      TVSHOW        //!< a tv show: recursive fast hash
+    };
+
+    struct SDirectory
+    {
+      std::string path;
+      Mode mode = Mode::EXISTS;
+      std::vector<std::string> excludes;
+      std::string dbHash;
+
+      // filled in by the prefetcher
+      bool done = false;
+      bool failed = false;
+      bool exists = false;
+      bool checked = false; //!< exists and .nomedia was looked for, the hashes below are set
+      bool noMedia = false;
+      std::string fastHash;
+      bool listed = false;  //!< items and hash are set
+      CFileItemList items;
+      std::string hash;
+    };
+
+    CDirectoryPrefetcher(const CVideoInfoScanner& scanner, unsigned int threads)
+      : m_scanner(scanner),
+        m_state(std::make_shared<SState>()),
+        m_jobs(false, threads, CJob::PRIORITY_DEDICATED),
+        m_lookahead(threads * 4)
+    {
+    }
+
+    ~CDirectoryPrefetcher()
+    {
+      {
+        CSingleLock lock(m_state->section);
+        m_state->stop = true;
+        m_state->queue.clear();
+      }
+      m_jobs.CancelJobs();
+
+      // jobs that didn't start yet don't touch the scanner, wait for the others
+      CSingleLock lock(m_state->section);
+      while (m_state->busy > 0)
+        m_state->cond.wait(lock);
+    }
+
+    unsigned int GetLookahead() const { return m_lookahead; }
+
+    bool IsQueued(const std::string& path) const
+    {
+      CSingleLock lock(m_state->section);
+      return m_state->directories.find(path) != m_state->directories.end();
+    }
+
+    void Queue(const std::shared_ptr<SDirectory>& directory)
+    {
+      {
+        CSingleLock lock(m_state->section);
+        m_state->directories[directory->path] = directory;
+        m_state->queue.push_back(directory);
+      }
+
+      // each job prefetches the oldest queued directory, so they are done in order
+      std::shared_ptr<SState> state = m_state;
+      CDirectoryPrefetcher* prefetcher = this;
+      m_jobs.Submit([state, prefetcher]() { Run(*state, prefetcher); });
+    }
+
+    /*!
+     \brief Get the results for a path, waiting for them if they aren't there yet.
+     \return the results, nullptr if the path wasn't queued or prefetching it failed
+     */
+    std::shared_ptr<const SDirectory> Get(const std::string& path)
+    {
+      CSingleLock lock(m_state->section);
+      auto it = m_state->directories.find(path);
+      if (it == m_state->directories.end())
+        return nullptr;
+
+      std::shared_ptr<SDirectory> directory = it->second;
+      while (!directory->done)
+        m_state->cond.wait(lock);
+      if (directory->failed)
+        return nullptr;
+      return directory;
+    }
+
+    //! \brief Forget the results of paths that are done and no longer going to be scanned.
+    void Prune(const std::set<std::string>& pathsToScan)
+    {
+      CSingleLock lock(m_state->section);
+      for (auto it = m_state->directories.begin(); it != m_state->directories.end();)
+      {
+        if (it->second->done && pathsToScan.find(it->first) == pathsToScan.end())
+          it = m_state->directories.erase(it);
+        else
+          ++it;
+      }
+    }
+
+  private:
+    //! shared with the jobs, which may start after the prefetcher is gone
+    struct SState
+    {
+      CCriticalSection section;
+      XbmcThreads::ConditionVariable cond;
+      std::deque<std::shared_ptr<SDirectory>> queue;
+      std::map<std::string, std::shared_ptr<SDirectory>> directories;
+      unsigned int busy = 0; //!< jobs that are prefetching, the prefetcher waits for them
+      bool stop = false;
+    };
+
+    //! the prefetcher is only used once a directory was taken, until then it may be gone already
+    static void Run(SState& state, const CDirectoryPrefetcher* prefetcher)
+    {
+      CSingleLock lock(state.section);
+      if (state.stop || state.queue.empty())
+        return;
+
+      std::shared_ptr<SDirectory> directory = state.queue.front();
+      state.queue.pop_front();
+      state.busy++;
+
+      lock.Leave();
+      try
+      {
+        prefetcher->Prefetch(*directory);
+      }
+      catch (...)
+      {
+        CLog::Log(LOGERROR, "VideoInfoScanner: Exception while prefetching '%s'", CURL::GetRedacted(directory->path).c_str());
+        directory->failed = true;
+      }
+      lock.Enter();
+
+      directory->done = true;
+      state.busy--;
+      state.cond.notifyAll();
+    }
+
+    // the same as DoScan() and EnumerateSeriesFolder() do
+    void Prefetch(SDirectory& directory) const
+    {
+      directory.exists = CDirectory::Exists(directory.path);
+      if (!directory.exists || directory.mode == Mode::EXISTS)
+        return;
+
+      directory.noMedia = m_scanner.HasNoMedia(directory.path);
+      directory.checked = true;
+      if (directory.noMedia)
+        return;
+
+      const bool useFastHash = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseFastHash;
+      if (directory.mode == Mode::FOLDER)
+      {
+        if (useFastHash)
+          directory.fastHash = m_scanner.GetFastHash(directory.path, directory.excludes);
+        if (!directory.fastHash.empty() && StringUtils::EqualsNoCase(directory.fastHash, directory.dbHash))
+          return;
+
+        CDirectory::GetDirectory(directory.path, directory.items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
+                                 DIR_FLAG_DEFAULTS);
+        directory.items.Stack();
+
+        if (!m_scanner.CanFastHash(directory.items, directory.excludes) || directory.fastHash.empty())
+          GetPathHash(directory.items, directory.hash);
+        else
+          directory.hash = directory.fastHash;
+        directory.listed = true;
+      }
+      else if (directory.mode == Mode::TVSHOW_ROOT)
+      {
+        CDirectory::GetDirectory(directory.path, directory.items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
+                                 DIR_FLAG_DEFAULTS);
+        directory.items.SetPath(directory.path);
+        GetPathHash(directory.items, directory.hash);
+        directory.listed = true;
+      }
+      else if (directory.mode == Mode::TVSHOW)
+      {
+        if (useFastHash)
+          directory.fastHash = m_scanner.GetRecursiveFastHash(directory.path, directory.excludes);
+      }
+    }
+
+    const CVideoInfoScanner& m_scanner;
+    std::shared_ptr<SState> m_state;
+    CJobQueue m_jobs;
+    const unsigned int m_lookahead;
+  };
+
   CVideoInfoScanner::CVideoInfoScanner()
   {
     m_bStop = false;
@@ -112,9 +323,16 @@ namespace VIDEO
       // result in unexpected behaviour.
       m_bCanInterrupt = false;
 
+      const int prefetchThreads = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iVideoScannerPrefetchThreads;
+      if (prefetchThreads > 0)
+        m_prefetcher.reset(new CDirectoryPrefetcher(*this, prefetchThreads));
+
       bool bCancelled = false;
       while (!bCancelled && !m_pathsToScan.empty())
       {
+        if (m_prefetcher)
+          QueuePrefetch();
+
         /*
          * A copy of the directory path is used because the path supplied is
          * immediately removed from the m_pathsToScan set in DoScan(). If the
@@ -122,11 +340,15 @@ namespace VIDEO
          * occurs.
          */
         std::string directory = *m_pathsToScan.begin();
+        std::shared_ptr<const CDirectoryPrefetcher::SDirectory> prefetched;
+        if (m_prefetcher)
+          prefetched = m_prefetcher->Get(directory);
+
         if (m_bStop)
         {
           bCancelled = true;
         }
-        else if (!CDirectory::Exists(directory))
+        else if (prefetched ? !prefetched->exists : !CDirectory::Exists(directory))
         {
           /*
            * Note that this will skip clean (if m_bClean is enabled) if the directory really
@@ -140,6 +362,8 @@ namespace VIDEO
           bCancelled = true;
       }
 
+      m_prefetcher.reset();
+
       if (!bCancelled)
       {
         if (m_bClean)
@@ -163,6 +387,7 @@ namespace VIDEO
       CLog::Log(LOGERROR, "VideoInfoScanner: Exception while scanning.");
     }
 
+    m_prefetcher.reset();
     m_bRunning = false;
     CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", "OnScanFinished");
 
@@ -216,6 +441,51 @@ namespace VIDEO
     m_bStop = true;
   }
 
+  void CVideoInfoScanner::QueuePrefetch()
+  {
+    m_prefetcher->Prune(m_pathsToScan);
+
+    const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    unsigned int count = 0;
+    for (const std::string& path : m_pathsToScan)
+    {
+      if (count++ >= m_prefetcher->GetLookahead())
+        break;
+      if (m_prefetcher->IsQueued(path))
+        continue;
+
+      // the same checks as in DoScan(), only the directory's existence is prefetched if it's skipped
+      std::shared_ptr<CDirectoryPrefetcher::SDirectory> directory = std::make_shared<CDirectoryPrefetcher::SDirectory>();
+      directory->path = path;
+
+      SScanSettings settings;
+      bool foundDirectly = false;
+      ScraperPtr info = m_database.GetScraperForPath(path, settings, foundDirectly);
+      CONTENT_TYPE content = info ? info->Content() : CONTENT_NONE;
+      directory->excludes = content == CONTENT_TVSHOWS ? advancedSettings->m_tvshowExcludeFromScanRegExps
+                                                       : advancedSettings->m_moviesExcludeFromScanRegExps;
+
+      if (content != CONTENT_NONE && (m_scanAll || !settings.noupdate) && !URIUtils::IsPlugin(path) &&
+          !CUtil::ExcludeFileOrFolder(path, directory->excludes))
+      {
+        if (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS)
+        {
+          directory->mode = CDirectoryPrefetcher::Mode::FOLDER;
+          m_database.GetPathHash(path, directory->dbHash);
+        }
+        else if (content == CONTENT_TVSHOWS)
+        {
+          if (foundDirectly && !settings.parent_name_root)
+            directory->mode = CDirectoryPrefetcher::Mode::TVSHOW_ROOT;
+          else
+            directory->mode = CDirectoryPrefetcher::Mode::TVSHOW;
+        }
+      }
+
+      m_prefetcher->Queue(directory);
+    }
+  }
+
   static void OnDirectoryScanned(const std::string& strDirectory)
   {
     CGUIMessage msg(GUI_MSG_DIRECTORY_SCANNED, 0, 0, 0);
@@ -255,7 +525,15 @@ namespace VIDEO
     if (CUtil::ExcludeFileOrFolder(strDirectory, regexps))
       return true;
 
-    if (HasNoMedia(strDirectory))
+    std::shared_ptr<const CDirectoryPrefetcher::SDirectory> prefetched;
+    if (m_prefetcher)
+    {
+      prefetched = m_prefetcher->Get(strDirectory);
+      if (prefetched && !prefetched->checked)
+        prefetched.reset();
+    }
+
+    if (prefetched ? prefetched->noMedia : HasNoMedia(strDirectory))
       return true;
 
     bool ignoreFolder = !m_scanAll && settings.noupdate;
@@ -278,13 +556,20 @@ namespace VIDEO
       }
 
       std::string fastHash;
-      if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseFastHash && !URIUtils::IsPlugin(strDirectory))
+      if (prefetched)
+        fastHash = prefetched->fastHash;
+      else if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseFastHash && !URIUtils::IsPlugin(strDirectory))
         fastHash = GetFastHash(strDirectory, regexps);
 
       if (m_database.GetPathHash(strDirectory, dbHash) && !fastHash.empty() && StringUtils::EqualsNoCase(fastHash, dbHash))
       { // fast hashes match - no need to process anything
         hash = fastHash;
       }
+      else if (prefetched && prefetched->listed)
+      { // the prefetcher has fetched the folder
+        items.Assign(prefetched->items);
+        hash = prefetched->hash;
+      }
       else
       { // need to fetch the folder
         CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
@@ -326,10 +611,18 @@ namespace VIDEO
 
       if (foundDirectly && !settings.parent_name_root)
       {
-        CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
-                                 DIR_FLAG_DEFAULTS);
-        items.SetPath(strDirectory);
-        GetPathHash(items, hash);
+        if (prefetched && prefetched->listed)
+        {
+          items.Assign(prefetched->items);
+          hash = prefetched->hash;
+        }
+        else
+        {
+          CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
+                                   DIR_FLAG_DEFAULTS);
+          items.SetPath(strDirectory);
+          GetPathHash(items, hash);
+        }
         bSkip = true;
         if (!m_database.GetPathHash(strDirectory, dbHash) || !StringUtils::EqualsNoCase(dbHash, hash))
           bSkip = false;
@@ -859,7 +1152,15 @@ namespace VIDEO
         }
       }
       else if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseFastHash)
-        hash = GetRecursiveFastHash(item->GetPath(), regexps);
+      {
+        std::shared_ptr<const CDirectoryPrefetcher::SDirectory> prefetched;
+        if (m_prefetcher)
+          prefetched = m_prefetcher->Get(item->GetPath());
+        if (prefetched && prefetched->checked && prefetched->mode == CDirectoryPrefetcher::Mode::TVSHOW)
+          hash = prefetched->fastHash;
+        else
+          hash = GetRecursiveFastHash(item->GetPath(), regexps);
+      }
 
       if (m_database.GetPathHash(item->GetPath(), dbHash) && (allowEmptyHash || !hash.empty()) && StringUtils::EqualsNoCase(dbHash, hash))
       {
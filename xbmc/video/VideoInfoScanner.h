@@ -12,6 +12,7 @@
 #include "VideoDatabase.h"
 #include "addons/Scraper.h"
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -235,8 +236,17 @@ namespace VIDEO
     std::set<int> m_pathsToClean;
 
   private:
+    class CDirectoryPrefetcher;
+
     void GetLocalMovieSetArtwork(CGUIListItem::ArtMap& art,
         const std::vector<std::string>& artTypes, const std::string& setTitle);
+
+    /*! \brief Hand the next paths of m_pathsToScan to the prefetcher
+     Decides on the scanner thread, with the database, what has to be done for each path.
+     */
+    void QueuePrefetch();
+
+    std::unique_ptr<CDirectoryPrefetcher> m_prefetcher; //!< lists and hashes directories ahead of the scan, nullptr if disabled
   };
 }
 
@@ -748,6 +748,9 @@ bool CGUIMediaWindow::GetDirectory(const std::string &strDirectory, CFileItemLis
 
     // assign fetched directory items
     items.Assign(dirItems);
+    if (CLog::IsLogLevelLogged(LOGDEBUG))
+      CLog::Log(LOGDEBUG, "CGUIMediaWindow::GetDirectory - %i items, about %zu kB", items.Size(),
+                items.GetMemoryUsage() / 1024);
 
     // took over a second, and not normally cached, so cache it
     if ((XbmcThreads::SystemClockMillis() - time) > 1000  && items.CacheToDiscIfSlow())
@@ -145,6 +145,9 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
       point.y *= CServiceBroker::GetWinSystem()->GetGfxContext().GetGUIScaleY();
       CServiceBroker::GetWinSystem()->GetGfxContext().SetRenderingResolution(CServiceBroker::GetWinSystem()->GetGfxContext().GetResInfo(), false);
     }
+    unsigned int evaluations, registered;
+    CServiceBroker::GetGUI()->GetInfoManager().GetBoolEvaluations(evaluations, registered);
+    info += StringUtils::Format("Conditions: %u of %u evaluated per frame\n", evaluations, registered);
     info += StringUtils::Format("Mouse: (%d,%d)  ", static_cast<int>(point.x), static_cast<int>(point.y));
     if (window)
     {